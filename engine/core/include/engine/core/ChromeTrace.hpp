@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <ios>
+#include <iomanip>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "engine/core/Profiler.hpp"
+
+namespace engine::core {
+
+// Writes profiler frames as Chrome trace-event JSON, loadable in chrome://tracing and
+// ui.perfetto.dev. CPU zones appear per thread under process 1, GPU zones under process 2, and
+// frame times plus ENGINE_PROFILE_COUNTER values as counter tracks. Timestamps are microseconds
+// relative to the start of the first exported frame.
+inline void writeChromeTrace(std::ostream& output,
+                             const std::span<const ProfileFrame> frames,
+                             const std::span<const ProfileThreadInfo> threads) {
+  constexpr int kCpuProcessId = 1;
+  constexpr int kGpuProcessId = 2;
+
+  const auto writeString = [&output](const std::string_view text) {
+    output << '"';
+    for (const char character : text) {
+      switch (character) {
+      case '"':
+        output << "\\\"";
+        break;
+      case '\\':
+        output << "\\\\";
+        break;
+      case '\n':
+        output << "\\n";
+        break;
+      case '\t':
+        output << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(character) < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(character));
+          output << escaped;
+        } else {
+          output << character;
+        }
+      }
+    }
+    output << '"';
+  };
+
+  std::uint64_t originNs = frames.empty() ? 0 : frames.front().startNs;
+  for (const auto& frame : frames) {
+    for (const auto& zone : frame.gpuZones) {
+      originNs = std::min(originNs, zone.startNs);
+    }
+  }
+  const auto toMicros = [originNs](const std::uint64_t timeNs) {
+    return timeNs >= originNs ? static_cast<double>(timeNs - originNs) / 1000.0
+                              : -static_cast<double>(originNs - timeNs) / 1000.0;
+  };
+
+  bool first = true;
+  const auto beginEvent = [&output, &first] {
+    output << (first ? "\n" : ",\n");
+    first = false;
+  };
+  const auto writeMetadata = [&](const int processId, const std::uint32_t threadId, const char* kind, const std::string_view name) {
+    beginEvent();
+    output << R"({"ph":"M","pid":)" << processId << R"(,"tid":)" << threadId << R"(,"name":")" << kind
+           << R"(","args":{"name":)";
+    writeString(name);
+    output << "}}";
+  };
+  const auto writeCounter = [&](const std::string_view name, const std::uint64_t timeNs, const double value) {
+    beginEvent();
+    output << R"({"ph":"C","pid":)" << kCpuProcessId << R"(,"tid":0,"name":)";
+    writeString(name);
+    output << R"(,"ts":)" << toMicros(timeNs) << R"(,"args":{"value":)" << value << "}}";
+  };
+
+  const std::ios_base::fmtflags savedFlags = output.flags();
+  const std::streamsize savedPrecision = output.precision();
+  output << std::fixed << std::setprecision(3);
+
+  output << R"({"displayTimeUnit":"ms","traceEvents":[)";
+  writeMetadata(kCpuProcessId, 0, "process_name", "CPU");
+  writeMetadata(kGpuProcessId, 0, "process_name", "GPU");
+  writeMetadata(kGpuProcessId, 0, "thread_name", "GPU queue");
+  for (const auto& thread : threads) {
+    writeMetadata(kCpuProcessId, thread.threadId, "thread_name", thread.name);
+  }
+
+  for (const auto& frame : frames) {
+    beginEvent();
+    output << R"({"ph":"i","s":"g","pid":)" << kCpuProcessId << R"(,"tid":0,"name":"Frame )" << frame.frameIndex
+           << R"(","ts":)" << toMicros(frame.startNs) << "}";
+
+    writeCounter("CPU frame ms", frame.startNs, frame.cpuFrameMs);
+    if (frame.gpuFrameMs >= 0.0) {
+      writeCounter("GPU frame ms", frame.startNs, frame.gpuFrameMs);
+    }
+    for (const auto& counter : frame.counters) {
+      writeCounter(counter.name, counter.timeNs, counter.value);
+    }
+
+    for (const auto& zone : frame.zones) {
+      beginEvent();
+      output << R"({"ph":"X","pid":)" << kCpuProcessId << R"(,"tid":)" << zone.threadId << R"(,"name":)";
+      writeString(zone.name);
+      output << R"(,"ts":)" << toMicros(zone.startNs) << R"(,"dur":)"
+             << static_cast<double>(zone.endNs - zone.startNs) / 1000.0 << "}";
+    }
+
+    for (const auto& zone : frame.gpuZones) {
+      beginEvent();
+      output << R"({"ph":"X","pid":)" << kGpuProcessId << R"(,"tid":0,"name":)";
+      writeString(zone.name);
+      output << R"(,"ts":)" << toMicros(zone.startNs) << R"(,"dur":)"
+             << static_cast<double>(zone.endNs - zone.startNs) / 1000.0 << "}";
+    }
+  }
+
+  output << "\n]}\n";
+  output.flags(savedFlags);
+  output.precision(savedPrecision);
+}
+
+// Captures the next N frames from a Profiler and writes them to a trace file. Call poll() once
+// per frame after ENGINE_PROFILE_FRAME_MARK(); the file is written a few frames after the last
+// captured frame so GPU timestamp queries have time to resolve.
+class TraceCapture {
+public:
+  static constexpr std::uint32_t kGpuResolveFrames = 4;
+
+  explicit TraceCapture(Profiler& profiler = Profiler::instance()) : profiler_(profiler) {}
+
+  // Returns false if a capture is already in flight, frameCount is zero, or profiling is compiled
+  // out (no frames are marked, so the capture would never finish).
+  bool request(std::string path, const std::uint32_t frameCount) {
+#if !ENGINE_ENABLE_PROFILING
+    return false;
+#endif
+    if (pending_.has_value() || frameCount == 0) {
+      return false;
+    }
+
+    const std::size_t requiredHistory = static_cast<std::size_t>(frameCount) + kGpuResolveFrames + 1;
+    if (profiler_.historyCapacity() < requiredHistory) {
+      profiler_.setHistoryCapacity(requiredHistory);
+    }
+
+    pending_ = PendingCapture{std::move(path), profiler_.currentFrameIndex(), frameCount};
+    return true;
+  }
+
+  [[nodiscard]] bool active() const { return pending_.has_value(); }
+
+  // Returns a status line once the capture has been written (or failed), std::nullopt otherwise.
+  [[nodiscard]] std::optional<std::string> poll() {
+    if (!pending_.has_value()) {
+      return std::nullopt;
+    }
+
+    const PendingCapture& capture = *pending_;
+    const std::uint64_t lastFrame = capture.firstFrame + capture.frameCount;
+    if (profiler_.currentFrameIndex() < lastFrame + kGpuResolveFrames) {
+      return std::nullopt;
+    }
+
+    std::vector<ProfileFrame> frames = profiler_.frameHistory();
+    std::erase_if(frames, [&capture, lastFrame](const ProfileFrame& frame) {
+      return frame.frameIndex < capture.firstFrame || frame.frameIndex >= lastFrame;
+    });
+
+    const PendingCapture finished = std::exchange(pending_, std::nullopt).value();
+    std::ofstream file{finished.path, std::ios::binary | std::ios::trunc};
+    if (!file) {
+      return "Failed to open trace file '" + finished.path + "'";
+    }
+
+    const std::vector<ProfileThreadInfo> threads = profiler_.threads();
+    writeChromeTrace(file, frames, threads);
+    if (!file) {
+      return "Failed to write trace file '" + finished.path + "'";
+    }
+
+    return "Wrote " + std::to_string(frames.size()) + " frame(s) to '" + finished.path + "'";
+  }
+
+private:
+  struct PendingCapture {
+    std::string path;
+    std::uint64_t firstFrame = 0;
+    std::uint32_t frameCount = 0;
+  };
+
+  Profiler& profiler_;
+  std::optional<PendingCapture> pending_;
+};
+
+} // namespace engine::core
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace engine::core {
+
+enum class MemoryTag : std::uint8_t {
+  MeshCpu,
+  GpuBuffer,
+  GpuTexture,
+  Module,
+  Ui,
+  Other,
+  Count,
+};
+
+inline constexpr std::size_t kMemoryTagCount = static_cast<std::size_t>(MemoryTag::Count);
+
+[[nodiscard]] constexpr std::string_view memoryTagName(const MemoryTag tag) {
+  switch (tag) {
+  case MemoryTag::MeshCpu:
+    return "Mesh (CPU)";
+  case MemoryTag::GpuBuffer:
+    return "GPU buffers";
+  case MemoryTag::GpuTexture:
+    return "GPU textures";
+  case MemoryTag::Module:
+    return "Modules";
+  case MemoryTag::Ui:
+    return "UI";
+  case MemoryTag::Other:
+  case MemoryTag::Count:
+  default:
+    return "Other";
+  }
+}
+
+enum class MemoryBudgetPolicy : std::uint8_t {
+  // Over-budget allocations are recorded and reported through the warning handler.
+  Warn,
+  // Over-budget allocations throw std::runtime_error before they are recorded.
+  Fail,
+};
+
+struct MemoryTagUsage {
+  MemoryTag tag = MemoryTag::Other;
+  std::size_t bytes = 0;
+  std::size_t peakBytes = 0;
+  // 0 means unbudgeted.
+  std::size_t budgetBytes = 0;
+};
+
+struct ProcessMemoryUsage {
+  std::size_t residentBytes = 0;
+  std::size_t virtualBytes = 0;
+};
+
+// Reads RSS and VSZ from /proc/self/statm; returns zeros on platforms without procfs.
+[[nodiscard]] inline ProcessMemoryUsage readProcessMemoryUsage() {
+  ProcessMemoryUsage usage{};
+#if defined(__linux__)
+  std::FILE* statm = std::fopen("/proc/self/statm", "r");
+  if (statm == nullptr) {
+    return usage;
+  }
+
+  unsigned long long sizePages = 0;
+  unsigned long long residentPages = 0;
+  if (std::fscanf(statm, "%llu %llu", &sizePages, &residentPages) == 2) {
+    const auto pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    usage.virtualBytes = static_cast<std::size_t>(sizePages) * pageSize;
+    usage.residentBytes = static_cast<std::size_t>(residentPages) * pageSize;
+  }
+  std::fclose(statm);
+#endif
+  return usage;
+}
+
+// Process-wide tagged allocation accounting. Subsystems report the bytes they own per tag;
+// counters are lock-free, budgets are checked on every allocation.
+class MemoryTracker {
+public:
+  using BudgetWarningHandler = std::function<void(MemoryTag tag, std::size_t bytes, std::size_t budgetBytes)>;
+
+  [[nodiscard]] static MemoryTracker& instance() {
+    static MemoryTracker tracker;
+    return tracker;
+  }
+
+  // Throws std::runtime_error where tryAllocate() would return false.
+  void allocate(const MemoryTag tag, const std::size_t bytes) {
+    if (!tryAllocate(tag, bytes)) {
+      const Slot& slot = slots_[index(tag)];
+      throw std::runtime_error("Memory budget exceeded for '" + std::string{memoryTagName(tag)} + "': " +
+                               std::to_string(slot.bytes.load(std::memory_order_relaxed) + bytes) + " > " +
+                               std::to_string(slot.budgetBytes.load(std::memory_order_relaxed)) + " bytes");
+    }
+  }
+
+  // Records the bytes unless MemoryBudgetPolicy::Fail is set and they would push the tag over its
+  // budget. The check and the update are one atomic step, so concurrent callers cannot overshoot
+  // together. Never throws; use it from callbacks that cannot unwind (allocator hooks, C APIs).
+  [[nodiscard]] bool tryAllocate(const MemoryTag tag, const std::size_t bytes) {
+    Slot& slot = slots_[index(tag)];
+    const std::size_t budget = slot.budgetBytes.load(std::memory_order_relaxed);
+    const bool enforced = budget != 0 && policy_.load(std::memory_order_relaxed) == MemoryBudgetPolicy::Fail;
+
+    std::size_t current = slot.bytes.load(std::memory_order_relaxed);
+    std::size_t total = 0;
+    do {
+      total = current + bytes;
+      if (enforced && total > budget) {
+        return false;
+      }
+    } while (!slot.bytes.compare_exchange_weak(current, total, std::memory_order_relaxed));
+
+    std::size_t peak = slot.peakBytes.load(std::memory_order_relaxed);
+    while (total > peak && !slot.peakBytes.compare_exchange_weak(peak, total, std::memory_order_relaxed)) {
+    }
+
+    // Warn once per crossing; the flag re-arms when usage drops back under the budget.
+    if (budget != 0 && total > budget && !slot.overBudget.exchange(true, std::memory_order_relaxed)) {
+      reportOverBudget(tag, total, budget);
+    }
+    return true;
+  }
+
+  void release(const MemoryTag tag, const std::size_t bytes) {
+    Slot& slot = slots_[index(tag)];
+    const std::size_t total = slot.bytes.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+    const std::size_t budget = slot.budgetBytes.load(std::memory_order_relaxed);
+    if (budget == 0 || total <= budget) {
+      slot.overBudget.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  void setBudget(const MemoryTag tag, const std::size_t budgetBytes) {
+    slots_[index(tag)].budgetBytes.store(budgetBytes, std::memory_order_relaxed);
+  }
+
+  void setBudgetPolicy(const MemoryBudgetPolicy policy) { policy_.store(policy, std::memory_order_relaxed); }
+
+  // Replaces the default handler, which prints to std::cerr.
+  void setBudgetWarningHandler(BudgetWarningHandler handler) {
+    std::lock_guard lock{handlerMutex_};
+    warningHandler_ = std::move(handler);
+  }
+
+  [[nodiscard]] MemoryTagUsage usage(const MemoryTag tag) const {
+    const Slot& slot = slots_[index(tag)];
+    return MemoryTagUsage{tag,
+                          slot.bytes.load(std::memory_order_relaxed),
+                          slot.peakBytes.load(std::memory_order_relaxed),
+                          slot.budgetBytes.load(std::memory_order_relaxed)};
+  }
+
+  [[nodiscard]] std::array<MemoryTagUsage, kMemoryTagCount> usageByTag() const {
+    std::array<MemoryTagUsage, kMemoryTagCount> result{};
+    for (std::size_t tagIndex = 0; tagIndex < kMemoryTagCount; ++tagIndex) {
+      result[tagIndex] = usage(static_cast<MemoryTag>(tagIndex));
+    }
+    return result;
+  }
+
+  [[nodiscard]] std::size_t totalBytes() const {
+    std::size_t total = 0;
+    for (const auto& slot : slots_) {
+      total += slot.bytes.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  [[nodiscard]] std::size_t totalBudgetBytes() const {
+    std::size_t total = 0;
+    for (const auto& slot : slots_) {
+      total += slot.budgetBytes.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+private:
+  struct Slot {
+    std::atomic<std::size_t> bytes{0};
+    std::atomic<std::size_t> peakBytes{0};
+    std::atomic<std::size_t> budgetBytes{0};
+    std::atomic<bool> overBudget{false};
+  };
+
+  MemoryTracker() = default;
+
+  [[nodiscard]] static std::size_t index(const MemoryTag tag) {
+    return std::min(static_cast<std::size_t>(tag), kMemoryTagCount - 1);
+  }
+
+  void reportOverBudget(const MemoryTag tag, const std::size_t bytes, const std::size_t budgetBytes) {
+    std::lock_guard lock{handlerMutex_};
+    if (warningHandler_) {
+      warningHandler_(tag, bytes, budgetBytes);
+      return;
+    }
+    std::cerr << "[memory] '" << memoryTagName(tag) << "' over budget: " << bytes << " / " << budgetBytes
+              << " bytes\n";
+  }
+
+  std::array<Slot, kMemoryTagCount> slots_{};
+  std::atomic<MemoryBudgetPolicy> policy_{MemoryBudgetPolicy::Warn};
+  std::mutex handlerMutex_;
+  BudgetWarningHandler warningHandler_;
+};
+
+// Move-only record of bytes charged to a tag; releases them when destroyed. Store one next to the
+// resource it accounts for.
+class TrackedAllocation {
+public:
+  TrackedAllocation() = default;
+
+  TrackedAllocation(const MemoryTag tag, const std::size_t bytes) : tag_(tag), bytes_(bytes) {
+    MemoryTracker::instance().allocate(tag_, bytes_);
+  }
+
+  ~TrackedAllocation() { reset(); }
+
+  TrackedAllocation(TrackedAllocation&& other) noexcept
+      : tag_(other.tag_), bytes_(std::exchange(other.bytes_, 0)) {}
+
+  TrackedAllocation& operator=(TrackedAllocation&& other) noexcept {
+    if (this != &other) {
+      reset();
+      tag_ = other.tag_;
+      bytes_ = std::exchange(other.bytes_, 0);
+    }
+    return *this;
+  }
+
+  TrackedAllocation(const TrackedAllocation&) = delete;
+  TrackedAllocation& operator=(const TrackedAllocation&) = delete;
+
+  [[nodiscard]] MemoryTag tag() const { return tag_; }
+  [[nodiscard]] std::size_t bytes() const { return bytes_; }
+
+  void reset() {
+    if (bytes_ != 0) {
+      MemoryTracker::instance().release(tag_, std::exchange(bytes_, 0));
+    }
+  }
+
+private:
+  MemoryTag tag_ = MemoryTag::Other;
+  std::size_t bytes_ = 0;
+};
+
+} // namespace engine::core
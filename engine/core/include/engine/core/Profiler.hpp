@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace engine::core {
+
+// Zone names are stored by view: pass string literals or strings that outlive the profiler history.
+struct ProfileZoneRecord {
+  std::string_view name;
+  std::uint64_t startNs = 0;
+  std::uint64_t endNs = 0;
+  std::uint32_t threadId = 0;
+  std::uint32_t depth = 0;
+};
+
+// GPU zones are reported on the CPU clock used by Profiler::nowNs(). Names follow the zone rule
+// above; backends pass names through Profiler::internName().
+struct GpuZoneRecord {
+  std::string_view name;
+  std::uint64_t startNs = 0;
+  std::uint64_t endNs = 0;
+  std::uint32_t depth = 0;
+};
+
+// Named per-frame values (draw calls, triangles, staged upload bytes, ...), sampled on the CPU clock.
+struct ProfileCounterSample {
+  std::string_view name;
+  std::uint64_t timeNs = 0;
+  double value = 0.0;
+};
+
+struct ProfileFrame {
+  std::uint64_t frameIndex = 0;
+  std::uint64_t startNs = 0;
+  std::uint64_t endNs = 0;
+  double cpuFrameMs = 0.0;
+  // Negative until the GPU backend has resolved its timestamp queries for this frame.
+  double gpuFrameMs = -1.0;
+  std::vector<ProfileZoneRecord> zones;
+  std::vector<GpuZoneRecord> gpuZones;
+  std::vector<ProfileCounterSample> counters;
+};
+
+struct ProfileThreadInfo {
+  std::uint32_t threadId = 0;
+  std::string name;
+  std::uint64_t droppedZones = 0;
+};
+
+// Single-producer/single-consumer ring owned by one thread. The owning thread pushes completed
+// zones without locking; Profiler::markFrame() drains every ring from the frame thread.
+class ProfileThreadBuffer {
+public:
+  static constexpr std::size_t kCapacity = std::size_t{1} << 14;
+
+  explicit ProfileThreadBuffer(const std::uint32_t threadId)
+      : records_(kCapacity), threadId_(threadId) {}
+
+  void push(const ProfileZoneRecord& record) {
+    const std::uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= kCapacity) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    records_[head & (kCapacity - 1)] = record;
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  template <typename Consumer>
+  void drain(Consumer&& consumer) {
+    std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+    const std::uint64_t head = head_.load(std::memory_order_acquire);
+    for (; tail < head; ++tail) {
+      consumer(records_[tail & (kCapacity - 1)]);
+    }
+    tail_.store(tail, std::memory_order_release);
+  }
+
+  [[nodiscard]] std::uint32_t threadId() const { return threadId_; }
+  [[nodiscard]] std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  // Only touched by the owning thread.
+  std::uint32_t depth = 0;
+
+private:
+  std::vector<ProfileZoneRecord> records_;
+  std::atomic<std::uint64_t> head_{0};
+  std::atomic<std::uint64_t> tail_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::uint32_t threadId_ = 0;
+};
+
+// Process-wide frame profiler. Zones, counters and frame marks are recorded through the
+// ENGINE_PROFILE_* macros, which compile away unless ENGINE_ENABLE_PROFILING is set, so frame
+// history is empty in builds without profiling.
+class Profiler {
+public:
+  static constexpr std::size_t kDefaultHistoryFrames = 240;
+
+  [[nodiscard]] static Profiler& instance() {
+    static Profiler profiler;
+    return profiler;
+  }
+
+  [[nodiscard]] static std::uint64_t nowNs() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  void setThreadName(std::string_view name) {
+    ProfileThreadBuffer& buffer = threadBuffer();
+    std::lock_guard lock{mutex_};
+    threads_[buffer.threadId()].name = std::string{name};
+  }
+
+  void beginZone() { ++threadBuffer().depth; }
+
+  void endZone(const std::string_view name, const std::uint64_t startNs) {
+    ProfileThreadBuffer& buffer = threadBuffer();
+    --buffer.depth;
+    buffer.push(ProfileZoneRecord{name, startNs, nowNs(), buffer.threadId(), buffer.depth});
+  }
+
+  void recordCounter(const std::string_view name, const double value) {
+    const std::uint64_t now = nowNs();
+    std::lock_guard lock{mutex_};
+    pendingCounters_.push_back(ProfileCounterSample{name, now, value});
+  }
+
+  // Returns a view of a copy of name that lives as long as the profiler, for zone names that are not
+  // string literals. Takes the profiler lock; cache the result for names used every frame.
+  [[nodiscard]] std::string_view internName(const std::string_view name) {
+    std::lock_guard lock{mutex_};
+    return *internedNames_.emplace(name).first;
+  }
+
+  // Closes the current frame: drains all thread rings into it and appends it to the history.
+  void markFrame() {
+    const std::uint64_t now = nowNs();
+    std::lock_guard lock{mutex_};
+
+    ProfileFrame frame{};
+    frame.frameIndex = frameIndex_.load(std::memory_order_relaxed);
+    frame.startNs = frameStartNs_ != 0 ? frameStartNs_ : now;
+    frame.endNs = now;
+    frame.cpuFrameMs = static_cast<double>(frame.endNs - frame.startNs) / 1.0e6;
+    for (auto& buffer : buffers_) {
+      buffer->drain([&frame](const ProfileZoneRecord& record) { frame.zones.push_back(record); });
+    }
+    frame.counters = std::exchange(pendingCounters_, {});
+
+    history_.push_back(std::move(frame));
+    while (history_.size() > historyCapacity_) {
+      history_.pop_front();
+    }
+
+    frameStartNs_ = now;
+    frameIndex_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Called by GPU backends once timestamp queries for an earlier frame have resolved.
+  void recordGpuFrame(const std::uint64_t frameIndex, const double gpuFrameMs, std::vector<GpuZoneRecord> zones) {
+    std::lock_guard lock{mutex_};
+    for (auto it = history_.rbegin(); it != history_.rend(); ++it) {
+      if (it->frameIndex == frameIndex) {
+        it->gpuFrameMs = gpuFrameMs;
+        it->gpuZones = std::move(zones);
+        return;
+      }
+    }
+  }
+
+  [[nodiscard]] std::uint64_t currentFrameIndex() const { return frameIndex_.load(std::memory_order_relaxed); }
+
+  [[nodiscard]] std::vector<ProfileFrame> frameHistory() const {
+    std::lock_guard lock{mutex_};
+    return {history_.begin(), history_.end()};
+  }
+
+  [[nodiscard]] std::vector<ProfileThreadInfo> threads() const {
+    std::lock_guard lock{mutex_};
+    std::vector<ProfileThreadInfo> result = threads_;
+    for (const auto& buffer : buffers_) {
+      result[buffer->threadId()].droppedZones = buffer->dropped();
+    }
+    return result;
+  }
+
+  [[nodiscard]] std::size_t historyCapacity() const {
+    std::lock_guard lock{mutex_};
+    return historyCapacity_;
+  }
+
+  void setHistoryCapacity(const std::size_t frames) {
+    std::lock_guard lock{mutex_};
+    historyCapacity_ = std::max<std::size_t>(1, frames);
+    while (history_.size() > historyCapacity_) {
+      history_.pop_front();
+    }
+  }
+
+private:
+  Profiler() = default;
+
+  [[nodiscard]] ProfileThreadBuffer& threadBuffer() {
+    thread_local ProfileThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr) {
+      std::lock_guard lock{mutex_};
+      const auto threadId = static_cast<std::uint32_t>(buffers_.size());
+      buffers_.push_back(std::make_unique<ProfileThreadBuffer>(threadId));
+      threads_.push_back(ProfileThreadInfo{threadId, "thread " + std::to_string(threadId), 0});
+      buffer = buffers_.back().get();
+    }
+    return *buffer;
+  }
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<ProfileThreadBuffer>> buffers_;
+  std::vector<ProfileThreadInfo> threads_;
+  std::vector<ProfileCounterSample> pendingCounters_;
+  std::deque<ProfileFrame> history_;
+  // Node-based, so views of the elements stay valid as it grows.
+  std::unordered_set<std::string> internedNames_;
+  std::size_t historyCapacity_ = kDefaultHistoryFrames;
+  std::uint64_t frameStartNs_ = 0;
+  std::atomic<std::uint64_t> frameIndex_{0};
+};
+
+class ScopedProfileZone {
+public:
+  explicit ScopedProfileZone(const std::string_view name)
+      : name_(name), startNs_(Profiler::nowNs()) {
+    Profiler::instance().beginZone();
+  }
+
+  ~ScopedProfileZone() { Profiler::instance().endZone(name_, startNs_); }
+
+  ScopedProfileZone(const ScopedProfileZone&) = delete;
+  ScopedProfileZone& operator=(const ScopedProfileZone&) = delete;
+
+private:
+  std::string_view name_;
+  std::uint64_t startNs_ = 0;
+};
+
+} // namespace engine::core
+
+#define ENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_INNER(a, b)
+
+#if ENGINE_ENABLE_PROFILING
+#define ENGINE_PROFILE_ZONE(name) \
+  const ::engine::core::ScopedProfileZone ENGINE_PROFILE_CONCAT(engineProfileZone, __LINE__) { name }
+#define ENGINE_PROFILE_THREAD_NAME(name) ::engine::core::Profiler::instance().setThreadName(name)
+#define ENGINE_PROFILE_COUNTER(name, value) ::engine::core::Profiler::instance().recordCounter(name, static_cast<double>(value))
+#define ENGINE_PROFILE_FRAME_MARK() ::engine::core::Profiler::instance().markFrame()
+#else
+#define ENGINE_PROFILE_ZONE(name) static_cast<void>(0)
+#define ENGINE_PROFILE_THREAD_NAME(name) static_cast<void>(0)
+#define ENGINE_PROFILE_COUNTER(name, value) static_cast<void>(sizeof(value))
+#define ENGINE_PROFILE_FRAME_MARK() static_cast<void>(0)
+#endif
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace engine::core {
+
+// Bounded lock-free ring for exactly one producer thread and one consumer thread. Neither side ever
+// blocks or allocates after construction: tryPush() fails when the ring is full and tryPop() when it
+// is empty. Head and tail sit on separate cache lines, and each side caches the other's index so the
+// shared atomics are only re-read when the cached value says the ring looks full or empty.
+template <typename T>
+class SpscQueue {
+public:
+  // capacity is rounded up to a power of two; throws std::runtime_error when it is zero.
+  explicit SpscQueue(std::size_t capacity) {
+    if (capacity == 0) {
+      throw std::runtime_error("SpscQueue capacity must be non-zero");
+    }
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+      rounded <<= 1U;
+    }
+    mask_ = rounded - 1;
+    slots_ = std::make_unique<T[]>(rounded);
+  }
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  [[nodiscard]] std::size_t capacity() const { return mask_ + 1; }
+
+  // Producer thread only.
+  [[nodiscard]] bool tryPush(T value) {
+    const std::size_t tail = producer_.tail.load(std::memory_order_relaxed);
+    if (tail - producer_.cachedHead > mask_) {
+      producer_.cachedHead = consumer_.head.load(std::memory_order_acquire);
+      if (tail - producer_.cachedHead > mask_) {
+        return false;
+      }
+    }
+    slots_[tail & mask_] = std::move(value);
+    producer_.tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer thread only.
+  [[nodiscard]] bool tryPop(T& value) {
+    const std::size_t head = consumer_.head.load(std::memory_order_relaxed);
+    if (head == consumer_.cachedTail) {
+      consumer_.cachedTail = producer_.tail.load(std::memory_order_acquire);
+      if (head == consumer_.cachedTail) {
+        return false;
+      }
+    }
+    value = std::move(slots_[head & mask_]);
+    consumer_.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Approximate when called while the other side is active. head is read first so it can never
+  // pass the tail it is compared with.
+  [[nodiscard]] std::size_t size() const {
+    const std::size_t head = consumer_.head.load(std::memory_order_acquire);
+    return producer_.tail.load(std::memory_order_acquire) - head;
+  }
+
+private:
+  // Not std::hardware_destructive_interference_size: its value may differ between compilers, which
+  // would change this header's layout across translation units.
+  static constexpr std::size_t kCacheLine = 64;
+
+  struct alignas(kCacheLine) ProducerSide {
+    std::atomic<std::size_t> tail{0};
+    std::size_t cachedHead = 0;
+  };
+
+  struct alignas(kCacheLine) ConsumerSide {
+    std::atomic<std::size_t> head{0};
+    std::size_t cachedTail = 0;
+  };
+
+  ProducerSide producer_;
+  ConsumerSide consumer_;
+  std::unique_ptr<T[]> slots_;
+  std::size_t mask_ = 0;
+};
+
+} // namespace engine::core
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "engine/core/Profiler.hpp"
+
+namespace engine::core {
+
+// Fixed set of worker threads for fork/join style data-parallel work. The thread that calls
+// parallelFor() participates as worker 0, so a pool created with one worker runs inline.
+// parallelFor() is not reentrant: tasks must not dispatch onto the same pool. Every task runs even
+// if others throw; the first exception is rethrown once all of them have finished.
+class WorkerPool {
+public:
+  using ParallelTask = std::function<void(std::uint32_t taskIndex, std::uint32_t workerIndex)>;
+
+  explicit WorkerPool(std::uint32_t workerCount = 0);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  [[nodiscard]] std::uint32_t workerCount() const { return static_cast<std::uint32_t>(threads_.size()) + 1; }
+
+  void parallelFor(std::uint32_t taskCount, const ParallelTask& task);
+
+private:
+  void workerLoop(std::uint32_t workerIndex);
+  void drain(std::uint32_t workerIndex);
+
+  std::vector<std::thread> threads_;
+  std::mutex dispatchMutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const ParallelTask* task_ = nullptr;
+  std::uint32_t taskCount_ = 0;
+  std::atomic<std::uint32_t> nextTask_{0};
+  std::uint32_t activeWorkers_ = 0;
+  std::uint64_t generation_ = 0;
+  std::exception_ptr firstError_;
+  bool stopping_ = false;
+};
+
+inline WorkerPool::WorkerPool(std::uint32_t workerCount) {
+  if (workerCount == 0) {
+    workerCount = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  threads_.reserve(workerCount - 1);
+  for (std::uint32_t workerIndex = 1; workerIndex < workerCount; ++workerIndex) {
+    threads_.emplace_back([this, workerIndex] { workerLoop(workerIndex); });
+  }
+}
+
+inline WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+  wake_.notify_all();
+
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+inline void WorkerPool::parallelFor(const std::uint32_t taskCount, const ParallelTask& task) {
+  if (taskCount == 0) {
+    return;
+  }
+
+  if (threads_.empty() || taskCount == 1) {
+    std::exception_ptr firstError;
+    for (std::uint32_t taskIndex = 0; taskIndex < taskCount; ++taskIndex) {
+      try {
+        task(taskIndex, 0);
+      } catch (...) {
+        if (!firstError) {
+          firstError = std::current_exception();
+        }
+      }
+    }
+    if (firstError) {
+      std::rethrow_exception(firstError);
+    }
+    return;
+  }
+
+  std::lock_guard dispatchLock{dispatchMutex_};
+  {
+    std::lock_guard lock{mutex_};
+    task_ = &task;
+    taskCount_ = taskCount;
+    nextTask_.store(0, std::memory_order_relaxed);
+    activeWorkers_ = static_cast<std::uint32_t>(threads_.size());
+    firstError_ = nullptr;
+    ++generation_;
+  }
+  wake_.notify_all();
+
+  drain(0);
+
+  std::unique_lock lock{mutex_};
+  done_.wait(lock, [this] { return activeWorkers_ == 0; });
+  task_ = nullptr;
+
+  if (firstError_) {
+    std::rethrow_exception(std::exchange(firstError_, nullptr));
+  }
+}
+
+inline void WorkerPool::workerLoop(const std::uint32_t workerIndex) {
+  ENGINE_PROFILE_THREAD_NAME("worker " + std::to_string(workerIndex));
+  std::uint64_t seenGeneration = 0;
+  while (true) {
+    {
+      std::unique_lock lock{mutex_};
+      wake_.wait(lock, [&] { return stopping_ || generation_ != seenGeneration; });
+      if (stopping_) {
+        return;
+      }
+      seenGeneration = generation_;
+    }
+
+    drain(workerIndex);
+
+    std::lock_guard lock{mutex_};
+    if (--activeWorkers_ == 0) {
+      done_.notify_one();
+    }
+  }
+}
+
+inline void WorkerPool::drain(const std::uint32_t workerIndex) {
+  while (true) {
+    const std::uint32_t taskIndex = nextTask_.fetch_add(1, std::memory_order_relaxed);
+    if (taskIndex >= taskCount_) {
+      return;
+    }
+
+    try {
+      (*task_)(taskIndex, workerIndex);
+    } catch (...) {
+      std::lock_guard lock{mutex_};
+      if (!firstError_) {
+        firstError_ = std::current_exception();
+      }
+    }
+  }
+}
+
+} // namespace engine::core
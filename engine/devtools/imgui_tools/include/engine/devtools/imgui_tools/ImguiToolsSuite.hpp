@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -12,6 +13,7 @@ namespace engine::devtools::imgui_tools {
 struct FrameDashboardModel {
   std::vector<FrameTimingSample> frameTimes;
   MemoryStats memory{};
+  std::string traceCaptureStatus;
 };
 
 struct ModulePanelModel {
@@ -49,6 +51,7 @@ public:
   [[nodiscard]] const ConfigPanelModel& configPanel() const { return configPanel_; }
 
   bool requestModuleAction(std::string_view moduleId, ModuleAction action);
+  bool requestTraceCapture(std::string_view path, std::uint32_t frameCount);
   bool stageConfigValue(std::string_view key, std::string value);
   bool persistStagedConfig();
   bool discardStagedConfig();
@@ -79,6 +82,7 @@ public:
   [[nodiscard]] const ConfigPanelModel& configPanel() const { return configPanel_; }
 
   bool requestModuleAction(std::string_view, ModuleAction) { return false; }
+  bool requestTraceCapture(std::string_view, std::uint32_t) { return false; }
   bool stageConfigValue(std::string_view, std::string) { return false; }
   bool persistStagedConfig() { return false; }
   bool discardStagedConfig() { return false; }
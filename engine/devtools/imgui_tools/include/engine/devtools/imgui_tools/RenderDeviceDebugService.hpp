@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vector>
+
+#include "engine/devtools/imgui_tools/ToolServices.hpp"
+#include "engine/render/IRenderDevice.hpp"
+
+namespace engine::devtools::imgui_tools {
+
+// IRendererDebugService over a live render device: one entry per buffer, texture, shader and
+// pipeline with its debug name and size, plus the counters of the last completed frame.
+class RenderDeviceDebugService final : public IRendererDebugService {
+public:
+  explicit RenderDeviceDebugService(const render::IRenderDevice& device) : device_(device) {}
+
+  [[nodiscard]] std::vector<RenderResourceStat> resources() const override;
+  [[nodiscard]] DrawStats drawStats() const override;
+
+private:
+  const render::IRenderDevice& device_;
+};
+
+} // namespace engine::devtools::imgui_tools
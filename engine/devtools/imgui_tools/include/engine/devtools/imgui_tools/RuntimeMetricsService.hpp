@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "engine/core/ChromeTrace.hpp"
+#include "engine/core/MemoryTracker.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/devtools/imgui_tools/ToolServices.hpp"
+
+namespace engine::devtools::imgui_tools {
+
+// IMetricsService backed by the engine runtime: frame history comes from engine::core::Profiler
+// (CPU time between frame marks, GPU time once the render backend resolves its timestamps),
+// memory stats from engine::core::MemoryTracker tags plus the process RSS/VSZ.
+// Call update() once per frame after the frame mark to drive pending trace captures.
+class RuntimeMetricsService final : public IMetricsService {
+public:
+  explicit RuntimeMetricsService(core::Profiler& profiler = core::Profiler::instance(), std::size_t historyFrames = 120)
+      : profiler_(profiler), historyFrames_(historyFrames), traceCapture_(profiler) {}
+
+  [[nodiscard]] std::vector<FrameTimingSample> frameHistory() const override;
+  [[nodiscard]] MemoryStats memoryStats() const override;
+
+  bool requestTraceCapture(const std::string& path, std::uint32_t frameCount) override;
+  [[nodiscard]] std::string traceCaptureStatus() const override { return traceCaptureStatus_; }
+
+  void update();
+
+private:
+  core::Profiler& profiler_;
+  std::size_t historyFrames_ = 120;
+  core::TraceCapture traceCapture_;
+  std::string traceCaptureStatus_;
+};
+
+} // namespace engine::devtools::imgui_tools
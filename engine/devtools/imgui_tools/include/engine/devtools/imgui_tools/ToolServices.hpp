@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -10,7 +11,15 @@ namespace engine::devtools::imgui_tools {
 
 struct FrameTimingSample {
   double cpuFrameMs = 0.0;
-  double gpuFrameMs = 0.0;
+  // Unset while the GPU time is unknown: timestamps not resolved yet, dropped, or not measured.
+  std::optional<double> gpuFrameMs;
+};
+
+struct MemoryCategoryStats {
+  std::string name;
+  std::size_t bytes = 0;
+  std::size_t peakBytes = 0;
+  std::size_t budgetBytes = 0;
 };
 
 struct MemoryStats {
@@ -18,6 +27,7 @@ struct MemoryStats {
   std::size_t virtualBytes = 0;
   std::size_t allocatedBytes = 0;
   std::size_t budgetBytes = 0;
+  std::vector<MemoryCategoryStats> categories;
 };
 
 class IMetricsService {
@@ -26,6 +36,10 @@ public:
 
   [[nodiscard]] virtual std::vector<FrameTimingSample> frameHistory() const = 0;
   [[nodiscard]] virtual MemoryStats memoryStats() const = 0;
+
+  // Optional trace export; services without a profiler backend keep the defaults.
+  virtual bool requestTraceCapture(const std::string& /*path*/, std::uint32_t /*frameCount*/) { return false; }
+  [[nodiscard]] virtual std::string traceCaptureStatus() const { return {}; }
 };
 
 struct ModuleRecord {
@@ -59,6 +73,10 @@ struct DrawStats {
   std::uint32_t drawCalls = 0;
   std::uint32_t triangles = 0;
   std::uint32_t pipelinesBound = 0;
+  std::uint32_t drawsSkipped = 0;
+  std::uint32_t pendingDestructions = 0;
+  std::uint32_t stateChangesIssued = 0;
+  std::uint32_t stateChangesFiltered = 0;
 };
 
 class IRendererDebugService {
@@ -9,6 +9,7 @@ namespace engine::devtools::imgui_tools {
 void ImguiToolsSuite::refresh() {
   frameDashboard_.frameTimes = metrics_.frameHistory();
   frameDashboard_.memory = metrics_.memoryStats();
+  frameDashboard_.traceCaptureStatus = metrics_.traceCaptureStatus();
 
   modulePanel_.modules = modules_.modules();
 
@@ -28,6 +29,12 @@ bool ImguiToolsSuite::requestModuleAction(std::string_view moduleId, ModuleActio
   return success;
 }
 
+bool ImguiToolsSuite::requestTraceCapture(std::string_view path, std::uint32_t frameCount) {
+  const bool success = metrics_.requestTraceCapture(std::string(path), frameCount);
+  frameDashboard_.traceCaptureStatus = success ? "Trace capture started" : "Trace capture unavailable";
+  return success;
+}
+
 bool ImguiToolsSuite::stageConfigValue(std::string_view key, std::string value) {
   auto& slot = configPanel_.stagedValues[std::string(key)];
   const bool changed = slot != value;
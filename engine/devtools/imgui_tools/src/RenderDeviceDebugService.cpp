@@ -0,0 +1,132 @@
+#include "engine/devtools/imgui_tools/RenderDeviceDebugService.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace engine::devtools::imgui_tools {
+namespace {
+
+[[nodiscard]] const char* kindName(const render::RenderResourceKind kind) {
+  switch (kind) {
+  case render::RenderResourceKind::Buffer:
+    return "Buffer";
+  case render::RenderResourceKind::Texture:
+    return "Texture";
+  case render::RenderResourceKind::Shader:
+    return "Shader";
+  case render::RenderResourceKind::Pipeline:
+  default:
+    return "Pipeline";
+  }
+}
+
+[[nodiscard]] const char* usageName(const render::BufferUsage usage) {
+  switch (usage) {
+  case render::BufferUsage::Vertex:
+    return "vertex";
+  case render::BufferUsage::Index:
+    return "index";
+  case render::BufferUsage::Uniform:
+    return "uniform";
+  case render::BufferUsage::Storage:
+  default:
+    return "storage";
+  }
+}
+
+[[nodiscard]] const char* formatName(const render::TextureFormat format) {
+  switch (format) {
+  case render::TextureFormat::RGBA8:
+    return "RGBA8";
+  case render::TextureFormat::RGBA16F:
+    return "RGBA16F";
+  case render::TextureFormat::BC1:
+    return "BC1";
+  case render::TextureFormat::BC1RGB:
+    return "BC1 RGB";
+  case render::TextureFormat::BC3:
+    return "BC3";
+  case render::TextureFormat::BC5:
+    return "BC5";
+  case render::TextureFormat::BC7:
+    return "BC7";
+  case render::TextureFormat::ETC2RGB8:
+    return "ETC2 RGB8";
+  case render::TextureFormat::ETC2RGBA8:
+    return "ETC2 RGBA8";
+  case render::TextureFormat::Depth24Stencil8:
+  default:
+    return "D24S8";
+  }
+}
+
+[[nodiscard]] const char* stageName(const render::ShaderStage stage) {
+  switch (stage) {
+  case render::ShaderStage::Vertex:
+    return "vertex";
+  case render::ShaderStage::Fragment:
+    return "fragment";
+  case render::ShaderStage::Compute:
+  default:
+    return "compute";
+  }
+}
+
+[[nodiscard]] std::string describeType(const render::RenderResourceInfo& info) {
+  std::string type = kindName(info.kind);
+  switch (info.kind) {
+  case render::RenderResourceKind::Buffer:
+    type += std::string{" ("} + usageName(info.usage) + ")";
+    break;
+  case render::RenderResourceKind::Texture:
+    type += std::string{" ("} + formatName(info.format) + ", " + std::to_string(info.extent.width) + "x" +
+            std::to_string(info.extent.height) + ", " + std::to_string(info.mipLevels) + " mip";
+    if (info.firstResidentMip != 0) {
+      type += ", resident from " + std::to_string(info.firstResidentMip);
+    }
+    type += ")";
+    break;
+  case render::RenderResourceKind::Shader:
+    type += std::string{" ("} + stageName(info.stage) + ")";
+    break;
+  case render::RenderResourceKind::Pipeline:
+  default:
+    break;
+  }
+  return type;
+}
+
+} // namespace
+
+std::vector<RenderResourceStat> RenderDeviceDebugService::resources() const {
+  auto infos = device_.resources();
+  std::sort(infos.begin(), infos.end(), [](const render::RenderResourceInfo& lhs, const render::RenderResourceInfo& rhs) {
+    return lhs.sizeBytes != rhs.sizeBytes ? lhs.sizeBytes > rhs.sizeBytes : lhs.id < rhs.id;
+  });
+
+  std::vector<RenderResourceStat> stats;
+  stats.reserve(infos.size());
+  for (const auto& info : infos) {
+    std::string name = info.debugName.empty() ? std::string{kindName(info.kind)} + " #" + std::to_string(info.id)
+                                              : info.debugName;
+    stats.push_back(RenderResourceStat{std::move(name), describeType(info), info.sizeBytes, 1});
+  }
+  return stats;
+}
+
+DrawStats RenderDeviceDebugService::drawStats() const {
+  const render::RenderFrameStats frame = device_.frameStats();
+  return DrawStats{frame.drawCalls,
+                   static_cast<std::uint32_t>(
+                       std::min<std::uint64_t>(frame.triangles, std::numeric_limits<std::uint32_t>::max())),
+                   frame.pipelineBinds,
+                   frame.drawsSkipped,
+                   frame.pendingDestructions,
+                   frame.stateChangesIssued,
+                   frame.stateChangesFiltered};
+}
+
+} // namespace engine::devtools::imgui_tools
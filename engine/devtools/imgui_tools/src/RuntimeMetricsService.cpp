@@ -0,0 +1,56 @@
+#include "engine/devtools/imgui_tools/RuntimeMetricsService.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace engine::devtools::imgui_tools {
+
+std::vector<FrameTimingSample> RuntimeMetricsService::frameHistory() const {
+  const auto frames = profiler_.frameHistory();
+  const std::size_t count = std::min(frames.size(), historyFrames_);
+
+  std::vector<FrameTimingSample> samples;
+  samples.reserve(count);
+  for (auto it = frames.end() - static_cast<std::ptrdiff_t>(count); it != frames.end(); ++it) {
+    FrameTimingSample sample{};
+    sample.cpuFrameMs = it->cpuFrameMs;
+    if (it->gpuFrameMs >= 0.0) {
+      sample.gpuFrameMs = it->gpuFrameMs;
+    }
+    samples.push_back(sample);
+  }
+  return samples;
+}
+
+MemoryStats RuntimeMetricsService::memoryStats() const {
+  const core::MemoryTracker& tracker = core::MemoryTracker::instance();
+  const core::ProcessMemoryUsage process = core::readProcessMemoryUsage();
+
+  MemoryStats stats{};
+  stats.residentBytes = process.residentBytes;
+  stats.virtualBytes = process.virtualBytes;
+  stats.allocatedBytes = tracker.totalBytes();
+  stats.budgetBytes = tracker.totalBudgetBytes();
+  for (const auto& usage : tracker.usageByTag()) {
+    stats.categories.push_back(MemoryCategoryStats{
+        std::string{core::memoryTagName(usage.tag)}, usage.bytes, usage.peakBytes, usage.budgetBytes});
+  }
+  return stats;
+}
+
+bool RuntimeMetricsService::requestTraceCapture(const std::string& path, const std::uint32_t frameCount) {
+  if (!traceCapture_.request(path, frameCount)) {
+    return false;
+  }
+
+  traceCaptureStatus_ = "Capturing " + std::to_string(frameCount) + " frame(s) to '" + path + "'";
+  return true;
+}
+
+void RuntimeMetricsService::update() {
+  if (auto status = traceCapture_.poll()) {
+    traceCaptureStatus_ = std::move(*status);
+  }
+}
+
+} // namespace engine::devtools::imgui_tools
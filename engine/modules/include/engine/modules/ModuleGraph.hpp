@@ -0,0 +1,467 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "engine/modules/ModuleContract.hpp"
+#include "engine/modules/ModuleManager.hpp"
+
+namespace engine::modules {
+
+// Dense integer id for a module id string; valid for the lifetime of the table that issued it.
+using ModuleHandle = std::uint32_t;
+
+// Maps module id strings to dense handles. Ids are never forgotten, so a handle stays valid even
+// after its module leaves the graph, and dependencies may be interned before the module itself.
+class ModuleIdTable {
+public:
+  [[nodiscard]] ModuleHandle intern(const std::string_view id) {
+    if (const auto it = handles_.find(id); it != handles_.end()) {
+      return it->second;
+    }
+    const auto handle = static_cast<ModuleHandle>(ids_.size());
+    ids_.emplace_back(id);
+    handles_.emplace(ids_.back(), handle);
+    return handle;
+  }
+
+  [[nodiscard]] std::optional<ModuleHandle> find(const std::string_view id) const {
+    if (const auto it = handles_.find(id); it != handles_.end()) {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+
+  [[nodiscard]] const std::string& id(const ModuleHandle handle) const { return ids_[handle]; }
+  [[nodiscard]] std::size_t size() const { return ids_.size(); }
+
+private:
+  struct IdHash {
+    using is_transparent = void;
+    [[nodiscard]] std::size_t operator()(const std::string_view id) const { return std::hash<std::string_view>{}(id); }
+  };
+
+  std::vector<std::string> ids_;
+  std::unordered_map<std::string, ModuleHandle, IdHash, std::equal_to<>> handles_;
+};
+
+// Persistent counterpart of ModuleManager::validate()/startupOrder() for manifests that change a
+// few descriptors at a time. Each module keeps its own errors plus reverse dependency and conflict
+// edges, so a change revalidates only the module itself and the modules that name it. Any cycle a
+// change introduces runs through the changed module, so validate() searches only that module's
+// dependencies for it; the startup order (Kahn's algorithm over handles) is cached and rebuilt by
+// startupOrder() only after a dependency list changed or a module entered or left the graph.
+class ModuleGraph {
+public:
+  explicit ModuleGraph(Version supportedApiVersion) : supportedApiVersion_(supportedApiVersion) {}
+
+  // Adds module or replaces the descriptor with the same id; a no-op when nothing changed.
+  ModuleHandle upsert(const ModuleDescriptor& module);
+  // Returns false when id is not in the graph.
+  bool remove(std::string_view id);
+  // Brings the graph in line with a full manifest: new and changed descriptors are upserted and
+  // modules missing from it removed. Duplicate ids are reported by validate() until the next assign().
+  void assign(std::span<const ModuleDescriptor> modules);
+
+  // Same checks and messages as ModuleManager::validate(). Missing dependencies do not count as
+  // cycles here.
+  [[nodiscard]] const ValidationResult& validate();
+  // Present modules in dependency order; missing dependencies are ignored and modules on or behind a
+  // cycle are left out.
+  [[nodiscard]] const std::vector<ModuleHandle>& startupOrder();
+  // startupOrder() grouped into waves: a module's wave is one past the deepest wave among its
+  // dependencies, so no module depends on another in its own wave.
+  [[nodiscard]] const std::vector<std::vector<ModuleHandle>>& startupWaves();
+
+  [[nodiscard]] const ModuleDescriptor* find(std::string_view id) const;
+  // Handle of a module present in the graph.
+  [[nodiscard]] std::optional<ModuleHandle> handle(std::string_view id) const;
+  [[nodiscard]] const std::string& id(const ModuleHandle handle) const { return ids_.id(handle); }
+  [[nodiscard]] std::size_t moduleCount() const { return moduleCount_; }
+  // Modules whose checks were re-run by the last validate() that had work to do.
+  [[nodiscard]] std::size_t lastRevalidatedCount() const { return lastRevalidatedCount_; }
+
+private:
+  struct Node {
+    ModuleDescriptor descriptor;
+    std::vector<ModuleHandle> dependencies;
+    std::vector<ModuleHandle> conflicts;
+    // Modules naming this one, whether or not it is present.
+    std::vector<ModuleHandle> dependents;
+    std::vector<ModuleHandle> conflictedBy;
+    std::vector<std::string> errors;
+    std::uint64_t assignGeneration = 0;
+    bool present = false;
+    bool dirty = false;
+  };
+
+  [[nodiscard]] static bool sameVersion(const Version& left, const Version& right) {
+    return left.major == right.major && left.minor == right.minor && left.patch == right.patch;
+  }
+
+  [[nodiscard]] static bool sameDescriptor(const ModuleDescriptor& left, const ModuleDescriptor& right) {
+    return left.category == right.category && sameVersion(left.moduleVersion, right.moduleVersion) &&
+           sameVersion(left.requiredApiVersion, right.requiredApiVersion) && left.swapPolicy == right.swapPolicy &&
+           left.dependencies == right.dependencies && left.conflicts == right.conflicts;
+  }
+
+  static void eraseEdge(std::vector<ModuleHandle>& edges, const ModuleHandle handle) {
+    for (std::size_t index = 0; index < edges.size(); ++index) {
+      if (edges[index] == handle) {
+        edges[index] = edges.back();
+        edges.pop_back();
+        return;
+      }
+    }
+  }
+
+  Node& node(const ModuleHandle handle) {
+    if (handle >= nodes_.size()) {
+      nodes_.resize(static_cast<std::size_t>(handle) + 1);
+    }
+    return nodes_[handle];
+  }
+
+  void markDirty(const ModuleHandle handle) {
+    Node& target = nodes_[handle];
+    if (!target.dirty) {
+      target.dirty = true;
+      dirty_.push_back(handle);
+    }
+  }
+
+  // Presence of handle changed: every module naming it must recheck.
+  void markNeighboursDirty(const ModuleHandle handle) {
+    for (const ModuleHandle dependent : nodes_[handle].dependents) {
+      markDirty(dependent);
+    }
+    for (const ModuleHandle conflicting : nodes_[handle].conflictedBy) {
+      markDirty(conflicting);
+    }
+  }
+
+  void unlinkEdges(const ModuleHandle handle) {
+    Node& source = nodes_[handle];
+    for (const ModuleHandle dependency : source.dependencies) {
+      eraseEdge(nodes_[dependency].dependents, handle);
+    }
+    for (const ModuleHandle conflict : source.conflicts) {
+      eraseEdge(nodes_[conflict].conflictedBy, handle);
+    }
+    source.dependencies.clear();
+    source.conflicts.clear();
+  }
+
+  // Keeps errored_ sorted so validate() visits only modules with errors, in handle order.
+  void trackErrors(const ModuleHandle handle) {
+    const auto it = std::lower_bound(errored_.begin(), errored_.end(), handle);
+    const bool listed = it != errored_.end() && *it == handle;
+    if (nodes_[handle].errors.empty() && listed) {
+      errored_.erase(it);
+    } else if (!nodes_[handle].errors.empty() && !listed) {
+      errored_.insert(it, handle);
+    }
+  }
+
+  void removeHandle(ModuleHandle handle);
+  void checkModule(Node& module) const;
+  [[nodiscard]] bool reachesItself(ModuleHandle handle);
+  void updateCycleState();
+  void rebuildStartupOrder();
+
+  Version supportedApiVersion_;
+  ModuleIdTable ids_;
+  std::vector<Node> nodes_;
+  std::vector<ModuleHandle> dirty_;
+  std::vector<ModuleHandle> errored_;
+  std::vector<std::string> duplicateErrors_;
+  std::vector<ModuleHandle> order_;
+  std::vector<std::vector<ModuleHandle>> waves_;
+  // Modules whose outgoing dependency edges changed since the cycle state was last known.
+  std::vector<ModuleHandle> cycleCandidates_;
+  std::vector<std::uint32_t> visitMark_;
+  std::uint32_t visitGeneration_ = 0;
+  ValidationResult result_;
+  std::uint64_t assignGeneration_ = 0;
+  std::size_t moduleCount_ = 0;
+  std::size_t lastRevalidatedCount_ = 0;
+  bool orderDirty_ = true;
+  bool wavesDirty_ = true;
+  bool cyclic_ = false;
+  bool cycleRecheck_ = false;
+  bool resultDirty_ = true;
+};
+
+inline ModuleHandle ModuleGraph::upsert(const ModuleDescriptor& module) {
+  const ModuleHandle handle = ids_.intern(module.id);
+  Node& target = node(handle);
+  if (target.present && sameDescriptor(target.descriptor, module)) {
+    return handle;
+  }
+
+  const bool wasPresent = target.present;
+  if (!wasPresent || target.descriptor.dependencies != module.dependencies) {
+    orderDirty_ = true;
+    cycleCandidates_.push_back(handle);
+  }
+  unlinkEdges(handle);
+
+  std::vector<ModuleHandle> dependencies;
+  dependencies.reserve(module.dependencies.size());
+  for (const auto& dependency : module.dependencies) {
+    dependencies.push_back(ids_.intern(dependency));
+  }
+  std::vector<ModuleHandle> conflicts;
+  conflicts.reserve(module.conflicts.size());
+  for (const auto& conflict : module.conflicts) {
+    conflicts.push_back(ids_.intern(conflict));
+  }
+  // Interning may have grown the id table; size nodes_ before taking references again.
+  node(static_cast<ModuleHandle>(ids_.size() - 1));
+
+  Node& updated = nodes_[handle];
+  for (const ModuleHandle dependency : dependencies) {
+    nodes_[dependency].dependents.push_back(handle);
+  }
+  for (const ModuleHandle conflict : conflicts) {
+    nodes_[conflict].conflictedBy.push_back(handle);
+  }
+  updated.dependencies = std::move(dependencies);
+  updated.conflicts = std::move(conflicts);
+  updated.descriptor = module;
+  updated.present = true;
+  markDirty(handle);
+  if (!wasPresent) {
+    ++moduleCount_;
+    markNeighboursDirty(handle);
+  }
+  return handle;
+}
+
+inline bool ModuleGraph::remove(const std::string_view id) {
+  const auto handle = ids_.find(id);
+  if (!handle.has_value() || *handle >= nodes_.size() || !nodes_[*handle].present) {
+    return false;
+  }
+  removeHandle(*handle);
+  return true;
+}
+
+inline void ModuleGraph::removeHandle(const ModuleHandle handle) {
+  unlinkEdges(handle);
+  Node& target = nodes_[handle];
+  target.present = false;
+  target.descriptor = {};
+  target.errors.clear();
+  trackErrors(handle);
+  --moduleCount_;
+  orderDirty_ = true;
+  // Removing edges cannot create a cycle, but may break the one that was reported.
+  cycleRecheck_ = cyclic_;
+  resultDirty_ = true;
+  markNeighboursDirty(handle);
+}
+
+inline void ModuleGraph::assign(const std::span<const ModuleDescriptor> modules) {
+  ++assignGeneration_;
+  if (!duplicateErrors_.empty()) {
+    duplicateErrors_.clear();
+    resultDirty_ = true;
+  }
+
+  for (const auto& module : modules) {
+    const ModuleHandle handle = upsert(module);
+    Node& target = nodes_[handle];
+    if (target.assignGeneration == assignGeneration_) {
+      duplicateErrors_.emplace_back("Duplicate module id detected: " + module.id);
+      resultDirty_ = true;
+    }
+    target.assignGeneration = assignGeneration_;
+  }
+
+  for (ModuleHandle handle = 0; handle < nodes_.size(); ++handle) {
+    if (nodes_[handle].present && nodes_[handle].assignGeneration != assignGeneration_) {
+      removeHandle(handle);
+    }
+  }
+}
+
+inline void ModuleGraph::checkModule(Node& module) const {
+  module.errors.clear();
+  if (!module.present) {
+    return;
+  }
+
+  const ModuleDescriptor& descriptor = module.descriptor;
+  if (!descriptor.requiredApiVersion.isCompatibleWith(supportedApiVersion_)) {
+    std::ostringstream message;
+    message << "Module '" << descriptor.id << "' requires incompatible API version " << descriptor.requiredApiVersion.major
+            << '.' << descriptor.requiredApiVersion.minor << '.' << descriptor.requiredApiVersion.patch;
+    module.errors.emplace_back(message.str());
+  }
+  for (std::size_t index = 0; index < module.dependencies.size(); ++index) {
+    if (!nodes_[module.dependencies[index]].present) {
+      module.errors.emplace_back("Module '" + descriptor.id + "' is missing dependency '" + descriptor.dependencies[index] + "'");
+    }
+  }
+  for (std::size_t index = 0; index < module.conflicts.size(); ++index) {
+    if (nodes_[module.conflicts[index]].present) {
+      module.errors.emplace_back("Module '" + descriptor.id + "' conflicts with loaded module '" + descriptor.conflicts[index] + "'");
+    }
+  }
+}
+
+inline void ModuleGraph::rebuildStartupOrder() {
+  std::vector<std::uint32_t> pending(nodes_.size(), 0);
+  order_.clear();
+  order_.reserve(moduleCount_);
+  for (ModuleHandle handle = 0; handle < nodes_.size(); ++handle) {
+    if (!nodes_[handle].present) {
+      continue;
+    }
+    for (const ModuleHandle dependency : nodes_[handle].dependencies) {
+      pending[handle] += nodes_[dependency].present ? 1 : 0;
+    }
+    if (pending[handle] == 0) {
+      order_.push_back(handle);
+    }
+  }
+
+  // order_ doubles as the ready queue.
+  for (std::size_t next = 0; next < order_.size(); ++next) {
+    for (const ModuleHandle dependent : nodes_[order_[next]].dependents) {
+      if (nodes_[dependent].present && --pending[dependent] == 0) {
+        order_.push_back(dependent);
+      }
+    }
+  }
+  orderDirty_ = false;
+  wavesDirty_ = true;
+
+  const bool cyclic = order_.size() != moduleCount_;
+  resultDirty_ = resultDirty_ || cyclic != cyclic_;
+  cyclic_ = cyclic;
+  cycleCandidates_.clear();
+  cycleRecheck_ = false;
+}
+
+inline bool ModuleGraph::reachesItself(const ModuleHandle handle) {
+  if (visitMark_.size() < nodes_.size()) {
+    visitMark_.resize(nodes_.size(), 0);
+  }
+  ++visitGeneration_;
+  std::vector<ModuleHandle> stack{nodes_[handle].dependencies};
+  while (!stack.empty()) {
+    const ModuleHandle current = stack.back();
+    stack.pop_back();
+    if (current == handle) {
+      return true;
+    }
+    if (!nodes_[current].present || visitMark_[current] == visitGeneration_) {
+      continue;
+    }
+    visitMark_[current] = visitGeneration_;
+    stack.insert(stack.end(), nodes_[current].dependencies.begin(), nodes_[current].dependencies.end());
+  }
+  return false;
+}
+
+inline void ModuleGraph::updateCycleState() {
+  // A search per candidate costs up to the whole graph, so bulk changes (such as the first assign())
+  // and any change while a cycle is reported take one full pass instead.
+  if (cycleRecheck_ || (cyclic_ && !cycleCandidates_.empty()) || cycleCandidates_.size() * 8 > moduleCount_) {
+    rebuildStartupOrder();
+    return;
+  }
+  for (const ModuleHandle handle : cycleCandidates_) {
+    if (nodes_[handle].present && reachesItself(handle)) {
+      cyclic_ = true;
+      break;
+    }
+  }
+  cycleCandidates_.clear();
+}
+
+inline const ValidationResult& ModuleGraph::validate() {
+  if (dirty_.empty() && cycleCandidates_.empty() && !cycleRecheck_ && !resultDirty_) {
+    return result_;
+  }
+
+  lastRevalidatedCount_ = dirty_.size();
+  for (const ModuleHandle handle : dirty_) {
+    checkModule(nodes_[handle]);
+    trackErrors(handle);
+    nodes_[handle].dirty = false;
+  }
+  dirty_.clear();
+  updateCycleState();
+
+  result_ = {};
+  result_.errors = duplicateErrors_;
+  for (const ModuleHandle handle : errored_) {
+    result_.errors.insert(result_.errors.end(), nodes_[handle].errors.begin(), nodes_[handle].errors.end());
+  }
+  if (cyclic_) {
+    result_.errors.emplace_back("Module dependency cycle detected");
+  }
+  result_.ok = result_.errors.empty();
+  resultDirty_ = false;
+  return result_;
+}
+
+inline const std::vector<ModuleHandle>& ModuleGraph::startupOrder() {
+  if (orderDirty_) {
+    rebuildStartupOrder();
+  }
+  return order_;
+}
+
+inline const std::vector<std::vector<ModuleHandle>>& ModuleGraph::startupWaves() {
+  if (!orderDirty_ && !wavesDirty_) {
+    return waves_;
+  }
+
+  const std::vector<ModuleHandle>& order = startupOrder();
+  std::vector<std::uint32_t> waveOf(nodes_.size(), 0);
+  waves_.clear();
+  for (const ModuleHandle handle : order) {
+    std::uint32_t wave = 0;
+    for (const ModuleHandle dependency : nodes_[handle].dependencies) {
+      if (nodes_[dependency].present) {
+        wave = std::max(wave, waveOf[dependency] + 1);
+      }
+    }
+    waveOf[handle] = wave;
+    if (waves_.size() <= wave) {
+      waves_.resize(static_cast<std::size_t>(wave) + 1);
+    }
+    waves_[wave].push_back(handle);
+  }
+  wavesDirty_ = false;
+  return waves_;
+}
+
+inline std::optional<ModuleHandle> ModuleGraph::handle(const std::string_view id) const {
+  const auto handle = ids_.find(id);
+  if (!handle.has_value() || *handle >= nodes_.size() || !nodes_[*handle].present) {
+    return std::nullopt;
+  }
+  return handle;
+}
+
+inline const ModuleDescriptor* ModuleGraph::find(const std::string_view id) const {
+  const auto present = handle(id);
+  return present.has_value() ? &nodes_[*present].descriptor : nullptr;
+}
+
+} // namespace engine::modules
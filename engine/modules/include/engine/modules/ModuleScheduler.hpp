@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "engine/core/Profiler.hpp"
+#include "engine/core/WorkerPool.hpp"
+#include "engine/modules/IModule.hpp"
+#include "engine/modules/ModuleContract.hpp"
+#include "engine/modules/ModuleGraph.hpp"
+
+namespace engine::modules {
+
+struct ModuleLifecycleTiming {
+  std::string id;
+  std::uint32_t wave = 0;
+  double loadMs = 0.0;
+  double startMs = 0.0;
+  double stopMs = 0.0;
+  double unloadMs = 0.0;
+};
+
+// Runs the IModule lifecycle in dependency waves on a worker pool. startup() calls onLoad() then
+// onStart() for every module of a wave concurrently and begins the next wave once all of them
+// returned; shutdown() calls onStop() then onUnload() in reverse wave order. Startup time is
+// therefore bounded by the slowest chain of dependencies rather than the sum of all modules.
+// Lifecycle calls must not dispatch work onto the same pool (WorkerPool::parallelFor() is not
+// reentrant). Use from one thread.
+class ModuleScheduler {
+public:
+  ModuleScheduler(Version supportedApiVersion, core::WorkerPool& workers)
+      : graph_(supportedApiVersion), workers_(workers) {}
+
+  // module must outlive the scheduler. Throws std::runtime_error on a duplicate id or after startup().
+  void add(const ModuleDescriptor& descriptor, IModule& module);
+
+  // Throws std::runtime_error listing the validation errors before any lifecycle call when the
+  // modules do not form a valid graph. When a lifecycle call throws, the modules already loaded or
+  // started are shut down and the first exception is rethrown.
+  void startup();
+  // Stops and unloads what startup() brought up, dependents first. Every wave runs even when a call
+  // throws; the first exception is rethrown afterwards.
+  void shutdown();
+
+  [[nodiscard]] const std::vector<std::vector<ModuleHandle>>& waves() { return graph_.startupWaves(); }
+  // In add() order.
+  [[nodiscard]] std::span<const ModuleLifecycleTiming> timings() const { return timings_; }
+  [[nodiscard]] double startupMs() const { return startupMs_; }
+  [[nodiscard]] double shutdownMs() const { return shutdownMs_; }
+  // Longest dependency chain of onLoad() + onStart() time: what startupMs() approaches with enough workers.
+  [[nodiscard]] double criticalPathMs() const { return criticalPathMs_; }
+
+private:
+  using Clock = std::chrono::steady_clock;
+  static constexpr std::size_t kNoSlot = std::numeric_limits<std::size_t>::max();
+
+  struct Entry {
+    IModule* module = nullptr;
+    bool loaded = false;
+    bool started = false;
+  };
+
+  [[nodiscard]] static double elapsedMs(const Clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+  }
+
+  [[nodiscard]] std::size_t slot(const ModuleHandle handle) const { return handle < slots_.size() ? slots_[handle] : kNoSlot; }
+
+  void startModule(std::size_t index);
+  void stopModule(std::size_t index);
+
+  ModuleGraph graph_;
+  core::WorkerPool& workers_;
+  std::vector<ModuleDescriptor> descriptors_;
+  std::vector<Entry> entries_;
+  std::vector<ModuleLifecycleTiming> timings_;
+  // Entry index per ModuleHandle.
+  std::vector<std::size_t> slots_;
+  double startupMs_ = 0.0;
+  double shutdownMs_ = 0.0;
+  double criticalPathMs_ = 0.0;
+  bool running_ = false;
+};
+
+inline void ModuleScheduler::add(const ModuleDescriptor& descriptor, IModule& module) {
+  if (running_) {
+    throw std::runtime_error("Cannot add module '" + descriptor.id + "' after startup");
+  }
+  if (graph_.find(descriptor.id) != nullptr) {
+    throw std::runtime_error("Duplicate module id detected: " + descriptor.id);
+  }
+
+  const ModuleHandle handle = graph_.upsert(descriptor);
+  if (slots_.size() <= handle) {
+    slots_.resize(static_cast<std::size_t>(handle) + 1, kNoSlot);
+  }
+  slots_[handle] = entries_.size();
+  descriptors_.push_back(descriptor);
+  entries_.push_back(Entry{&module});
+  timings_.push_back(ModuleLifecycleTiming{descriptor.id});
+}
+
+inline void ModuleScheduler::startModule(const std::size_t index) {
+  ENGINE_PROFILE_ZONE("module startup");
+  Entry& entry = entries_[index];
+  ModuleLifecycleTiming& timing = timings_[index];
+
+  Clock::time_point begin = Clock::now();
+  entry.module->onLoad();
+  timing.loadMs = elapsedMs(begin);
+  entry.loaded = true;
+
+  begin = Clock::now();
+  entry.module->onStart();
+  timing.startMs = elapsedMs(begin);
+  entry.started = true;
+}
+
+inline void ModuleScheduler::stopModule(const std::size_t index) {
+  ENGINE_PROFILE_ZONE("module shutdown");
+  Entry& entry = entries_[index];
+  ModuleLifecycleTiming& timing = timings_[index];
+
+  // Flags are cleared first so a throwing call is not repeated by a later shutdown(), and a module
+  // whose onStop() threw is still unloaded. The first error is rethrown after both calls.
+  std::exception_ptr stopError;
+  if (entry.started) {
+    entry.started = false;
+    const Clock::time_point begin = Clock::now();
+    try {
+      entry.module->onStop();
+    } catch (...) {
+      stopError = std::current_exception();
+    }
+    timing.stopMs = elapsedMs(begin);
+  }
+  if (entry.loaded) {
+    entry.loaded = false;
+    const Clock::time_point begin = Clock::now();
+    try {
+      entry.module->onUnload();
+    } catch (...) {
+      if (!stopError) {
+        stopError = std::current_exception();
+      }
+    }
+    timing.unloadMs = elapsedMs(begin);
+  }
+  if (stopError) {
+    std::rethrow_exception(stopError);
+  }
+}
+
+inline void ModuleScheduler::startup() {
+  if (running_) {
+    return;
+  }
+
+  const ValidationResult& validation = graph_.validate();
+  if (!validation.ok) {
+    std::string message = "Module validation failed:";
+    for (const auto& error : validation.errors) {
+      message += "\n  " + error;
+    }
+    throw std::runtime_error(message);
+  }
+
+  running_ = true;
+  const Clock::time_point begin = Clock::now();
+  const auto& waves = graph_.startupWaves();
+  for (std::uint32_t wave = 0; wave < waves.size(); ++wave) {
+    const std::vector<ModuleHandle>& members = waves[wave];
+    for (const ModuleHandle handle : members) {
+      timings_[slot(handle)].wave = wave;
+    }
+
+    try {
+      workers_.parallelFor(static_cast<std::uint32_t>(members.size()),
+                           [&](const std::uint32_t taskIndex, std::uint32_t /*workerIndex*/) { startModule(slot(members[taskIndex])); });
+    } catch (...) {
+      const std::exception_ptr error = std::current_exception();
+      try {
+        shutdown();
+      } catch (...) {
+        // The startup failure is the one worth reporting.
+      }
+      std::rethrow_exception(error);
+    }
+  }
+  startupMs_ = elapsedMs(begin);
+
+  // Waves list every dependency before its dependents.
+  std::vector<double> finishMs(entries_.size(), 0.0);
+  criticalPathMs_ = 0.0;
+  for (const auto& members : waves) {
+    for (const ModuleHandle handle : members) {
+      const std::size_t index = slot(handle);
+      double readyMs = 0.0;
+      for (const auto& dependency : descriptors_[index].dependencies) {
+        if (const auto dependencyHandle = graph_.handle(dependency)) {
+          readyMs = std::max(readyMs, finishMs[slot(*dependencyHandle)]);
+        }
+      }
+      finishMs[index] = readyMs + timings_[index].loadMs + timings_[index].startMs;
+      criticalPathMs_ = std::max(criticalPathMs_, finishMs[index]);
+    }
+  }
+}
+
+inline void ModuleScheduler::shutdown() {
+  if (!running_) {
+    return;
+  }
+
+  const Clock::time_point begin = Clock::now();
+  std::exception_ptr firstError;
+  const auto& waves = graph_.startupWaves();
+  for (auto wave = waves.rbegin(); wave != waves.rend(); ++wave) {
+    const std::vector<ModuleHandle>& members = *wave;
+    try {
+      workers_.parallelFor(static_cast<std::uint32_t>(members.size()),
+                           [&](const std::uint32_t taskIndex, std::uint32_t /*workerIndex*/) { stopModule(slot(members[taskIndex])); });
+    } catch (...) {
+      if (!firstError) {
+        firstError = std::current_exception();
+      }
+    }
+  }
+  shutdownMs_ = elapsedMs(begin);
+  running_ = false;
+
+  if (firstError) {
+    std::rethrow_exception(firstError);
+  }
+}
+
+} // namespace engine::modules
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace engine::platform {
+
+struct FramePacerConfig {
+  // Frames per second to hold; 0 only measures and never waits.
+  double targetHz = 0.0;
+  // Bounds of the adaptive spin window at the end of each wait.
+  std::chrono::nanoseconds minSpin{200'000};
+  std::chrono::nanoseconds maxSpin{2'000'000};
+};
+
+// Measured over the last kFramePacingWindow frame intervals.
+struct FramePacingStats {
+  double targetMs = 0.0;
+  double meanMs = 0.0;
+  // Standard deviation of the interval.
+  double jitterMs = 0.0;
+  // Largest distance of an interval from targetMs (from meanMs when unpaced).
+  double maxDeviationMs = 0.0;
+  // Current spin window; tracks how late the OS wakes sleeping threads.
+  double spinMs = 0.0;
+  // Deadlines that had already passed when the frame asked to wait, over the pacer's lifetime.
+  std::uint64_t missedDeadlines = 0;
+};
+
+inline constexpr std::size_t kFramePacingWindow = 240;
+
+// Holds a target frame rate without burning a core: waitForNextFrame() sleeps while more than the
+// spin window remains before the deadline, then yields in a loop for the rest. The spin window adapts
+// to the measured sleep overshoot, so platforms with coarse timers spin longer and precise ones barely
+// at all. Deadlines advance by whole periods, so one slow frame does not shift the cadence; a frame
+// later than a full period resynchronizes to now. Not thread-safe.
+class FramePacer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit FramePacer(const FramePacerConfig& config = {})
+      : config_(config), spin_(config.minSpin), lastFrame_(Clock::now()), deadline_(lastFrame_) {
+    setTargetHz(config.targetHz);
+  }
+
+  void setTargetHz(const double targetHz) {
+    config_.targetHz = std::max(targetHz, 0.0);
+    period_ = config_.targetHz > 0.0
+                  ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config_.targetHz))
+                  : Clock::duration::zero();
+    deadline_ = Clock::now() + period_;
+  }
+
+  [[nodiscard]] double targetHz() const { return config_.targetHz; }
+
+  // Waits until the next deadline (if a target is set) and returns the seconds since the previous
+  // call returned.
+  double waitForNextFrame() {
+    if (period_ > Clock::duration::zero()) {
+      Clock::time_point now = Clock::now();
+      if (now >= deadline_) {
+        ++missedDeadlines_;
+        if (now - deadline_ > period_) {
+          deadline_ = now;
+        }
+      } else {
+        if (deadline_ - now > spin_) {
+          const Clock::time_point wakeTarget = deadline_ - spin_;
+          std::this_thread::sleep_until(wakeTarget);
+          adaptSpin(Clock::now() - wakeTarget);
+        }
+        while (Clock::now() < deadline_) {
+          std::this_thread::yield();
+        }
+      }
+      deadline_ += period_;
+    }
+
+    const Clock::time_point now = Clock::now();
+    const double intervalSeconds = std::chrono::duration<double>(now - lastFrame_).count();
+    lastFrame_ = now;
+    intervalsMs_[intervalCount_ % intervalsMs_.size()] = intervalSeconds * 1000.0;
+    ++intervalCount_;
+    return intervalSeconds;
+  }
+
+  [[nodiscard]] FramePacingStats stats() const {
+    FramePacingStats stats{};
+    stats.targetMs = config_.targetHz > 0.0 ? 1000.0 / config_.targetHz : 0.0;
+    stats.spinMs = std::chrono::duration<double, std::milli>(spin_).count();
+    stats.missedDeadlines = missedDeadlines_;
+    const std::size_t count = std::min<std::size_t>(intervalCount_, intervalsMs_.size());
+    if (count == 0) {
+      return stats;
+    }
+
+    double sum = 0.0;
+    for (std::size_t index = 0; index < count; ++index) {
+      sum += intervalsMs_[index];
+    }
+    stats.meanMs = sum / static_cast<double>(count);
+    const double reference = stats.targetMs > 0.0 ? stats.targetMs : stats.meanMs;
+    double variance = 0.0;
+    for (std::size_t index = 0; index < count; ++index) {
+      const double fromMean = intervalsMs_[index] - stats.meanMs;
+      variance += fromMean * fromMean;
+      stats.maxDeviationMs = std::max(stats.maxDeviationMs, std::abs(intervalsMs_[index] - reference));
+    }
+    stats.jitterMs = std::sqrt(variance / static_cast<double>(count));
+    return stats;
+  }
+
+private:
+  // Grows to cover the worst recent overshoot at once and shrinks slowly, with a quarter of headroom.
+  void adaptSpin(const Clock::duration overshoot) {
+    const auto wanted = std::chrono::duration_cast<std::chrono::nanoseconds>(overshoot) * 5 / 4;
+    const std::chrono::nanoseconds current = spin_;
+    const std::chrono::nanoseconds next = wanted > current ? wanted : current - (current - wanted) / 16;
+    spin_ = std::clamp(next, config_.minSpin, config_.maxSpin);
+  }
+
+  FramePacerConfig config_;
+  Clock::duration period_{};
+  std::chrono::nanoseconds spin_;
+  Clock::time_point lastFrame_;
+  Clock::time_point deadline_;
+  std::array<double, kFramePacingWindow> intervalsMs_{};
+  std::uint64_t intervalCount_ = 0;
+  std::uint64_t missedDeadlines_ = 0;
+};
+
+} // namespace engine::platform
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <optional>
 
 #include "engine/platform/PlatformTypes.hpp"
@@ -17,7 +19,14 @@ public:
   [[nodiscard]] virtual void* nativeWindowHandle(WindowId windowId) const = 0;
   [[nodiscard]] virtual bool shouldClose(WindowId windowId) const = 0;
 
+  // Polling must run on the thread that created the windows.
   virtual void pollEvents(PlatformEventQueue& eventQueue) = 0;
+  // Lock-free form for handing events to another thread; the caller is the ring's only producer.
+  // Returns the number of events dropped because the ring was full.
+  virtual std::size_t pollEvents(PlatformEventRing& eventRing) = 0;
+  // Called on the polling thread with every native event (an SDL_Event* for SDL) before it is
+  // translated, for libraries such as UI toolkits that consume raw events. Empty clears it.
+  virtual void setNativeEventObserver(std::function<void(const void* nativeEvent)> observer) = 0;
 };
 
 } // namespace engine::platform
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "engine/platform/PlatformTypes.hpp"
+
+namespace engine::platform {
+
+// Input as seen by one frame, built on the consumer side of a PlatformEventRing. beginFrame() drains
+// the ring and derives held state and per-frame edges from the events, so a key tapped and released
+// between two frames still reports pressed() and released() once. All state lives in fixed-size
+// arrays indexed by scan code or button. Use from the consumer thread only.
+class InputFrameState {
+public:
+  void beginFrame(PlatformEventRing& eventRing) {
+    events_.clear();
+    keysPressed_.reset();
+    keysReleased_.reset();
+    buttonsPressed_.reset();
+    buttonsReleased_.reset();
+    pointerDeltaX_ = 0;
+    pointerDeltaY_ = 0;
+    quitRequested_ = false;
+
+    const std::uint64_t now = platformTimestampNs();
+    oldestEventAgeNs_ = 0;
+    PlatformEvent event{};
+    while (eventRing.tryPop(event)) {
+      if (events_.empty() && event.timestampNs != 0 && event.timestampNs < now) {
+        oldestEventAgeNs_ = now - event.timestampNs;
+      }
+      apply(event);
+      events_.push_back(event);
+    }
+  }
+
+  // Events delivered this frame, in order.
+  [[nodiscard]] std::span<const PlatformEvent> events() const { return events_; }
+
+  // Non-zero while held; indexed by scan code, with the layout of SDL_GetKeyboardState().
+  [[nodiscard]] const std::array<std::uint8_t, kMaxScanCodes>& keyboardState() const { return keysHeld_; }
+  [[nodiscard]] bool keyHeld(const std::uint32_t scanCode) const { return scanCode < kMaxScanCodes && keysHeld_[scanCode] != 0; }
+  [[nodiscard]] bool keyPressed(const std::uint32_t scanCode) const { return scanCode < kMaxScanCodes && keysPressed_.test(scanCode); }
+  [[nodiscard]] bool keyReleased(const std::uint32_t scanCode) const {
+    return scanCode < kMaxScanCodes && keysReleased_.test(scanCode);
+  }
+
+  [[nodiscard]] bool buttonHeld(const std::uint8_t button) const { return button < kMaxPointerButtons && buttonsHeld_.test(button); }
+  [[nodiscard]] bool buttonPressed(const std::uint8_t button) const {
+    return button < kMaxPointerButtons && buttonsPressed_.test(button);
+  }
+  [[nodiscard]] bool buttonReleased(const std::uint8_t button) const {
+    return button < kMaxPointerButtons && buttonsReleased_.test(button);
+  }
+
+  // Last known pointer position, and the relative motion summed over this frame.
+  [[nodiscard]] std::int32_t pointerX() const { return pointerX_; }
+  [[nodiscard]] std::int32_t pointerY() const { return pointerY_; }
+  [[nodiscard]] std::int32_t pointerDeltaX() const { return pointerDeltaX_; }
+  [[nodiscard]] std::int32_t pointerDeltaY() const { return pointerDeltaY_; }
+
+  [[nodiscard]] bool quitRequested() const { return quitRequested_; }
+
+  // Time the oldest event of this frame waited between the platform layer and beginFrame(); 0 when
+  // there were no events.
+  [[nodiscard]] std::uint64_t oldestEventAgeNs() const { return oldestEventAgeNs_; }
+
+private:
+  void apply(const PlatformEvent& event) {
+    switch (event.type) {
+    case PlatformEventType::QuitRequested:
+      quitRequested_ = true;
+      break;
+    case PlatformEventType::Keyboard: {
+      const std::uint32_t scanCode = event.keyboard.scanCode;
+      if (scanCode >= kMaxScanCodes || event.keyboard.repeated) {
+        break;
+      }
+      const bool down = event.keyboard.state == KeyState::Pressed;
+      if (down && keysHeld_[scanCode] == 0) {
+        keysPressed_.set(scanCode);
+      } else if (!down && keysHeld_[scanCode] != 0) {
+        keysReleased_.set(scanCode);
+      }
+      keysHeld_[scanCode] = down ? 1 : 0;
+    } break;
+    case PlatformEventType::Pointer: {
+      pointerX_ = event.pointer.x;
+      pointerY_ = event.pointer.y;
+      const std::uint8_t button = event.pointer.button;
+      if (button >= kMaxPointerButtons) {
+        break;
+      }
+      const bool down = event.pointer.state == KeyState::Pressed;
+      if (down && !buttonsHeld_.test(button)) {
+        buttonsPressed_.set(button);
+      } else if (!down && buttonsHeld_.test(button)) {
+        buttonsReleased_.set(button);
+      }
+      buttonsHeld_.set(button, down);
+    } break;
+    case PlatformEventType::PointerMotion:
+      pointerX_ = event.pointer.x;
+      pointerY_ = event.pointer.y;
+      pointerDeltaX_ += event.pointer.deltaX;
+      pointerDeltaY_ += event.pointer.deltaY;
+      break;
+    case PlatformEventType::None:
+    case PlatformEventType::WindowClosed:
+    case PlatformEventType::WindowResized:
+    default:
+      break;
+    }
+  }
+
+  std::vector<PlatformEvent> events_;
+  std::array<std::uint8_t, kMaxScanCodes> keysHeld_{};
+  std::bitset<kMaxScanCodes> keysPressed_;
+  std::bitset<kMaxScanCodes> keysReleased_;
+  std::bitset<kMaxPointerButtons> buttonsHeld_;
+  std::bitset<kMaxPointerButtons> buttonsPressed_;
+  std::bitset<kMaxPointerButtons> buttonsReleased_;
+  std::int32_t pointerX_ = 0;
+  std::int32_t pointerY_ = 0;
+  std::int32_t pointerDeltaX_ = 0;
+  std::int32_t pointerDeltaY_ = 0;
+  std::uint64_t oldestEventAgeNs_ = 0;
+  bool quitRequested_ = false;
+};
+
+} // namespace engine::platform
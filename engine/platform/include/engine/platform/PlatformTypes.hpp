@@ -1,14 +1,27 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 #include <vector>
 
+#include "engine/core/SpscQueue.hpp"
+
 namespace engine::platform {
 
 using WindowId = std::uint64_t;
 using MonitorId = std::uint32_t;
 
+// Bounds of the fixed-size key and pointer button state arrays.
+inline constexpr std::uint32_t kMaxScanCodes = 512;
+inline constexpr std::uint32_t kMaxPointerButtons = 32;
+
+// Steady-clock nanoseconds, the time base of PlatformEvent::timestampNs.
+[[nodiscard]] inline std::uint64_t platformTimestampNs() {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
 struct Extent2D {
   std::uint32_t width = 0;
   std::uint32_t height = 0;
@@ -36,6 +49,8 @@ enum class KeyState {
 
 struct KeyboardEvent {
   std::uint32_t keyCode = 0;
+  // Layout-independent physical key, below kMaxScanCodes.
+  std::uint32_t scanCode = 0;
   KeyState state = KeyState::Released;
   bool repeated = false;
 };
@@ -45,6 +60,9 @@ struct PointerEvent {
   std::int32_t y = 0;
   std::uint8_t button = 0;
   KeyState state = KeyState::Released;
+  // PointerMotion only: relative motion, summed over coalesced events.
+  std::int32_t deltaX = 0;
+  std::int32_t deltaY = 0;
 };
 
 enum class PlatformEventType {
@@ -54,16 +72,23 @@ enum class PlatformEventType {
   WindowResized,
   Keyboard,
   Pointer,
+  // Consecutive motion events for one window are coalesced into one per poll.
+  PointerMotion,
 };
 
 struct PlatformEvent {
   PlatformEventType type = PlatformEventType::None;
   WindowId windowId = 0;
+  // When the OS queued the event, on the platformTimestampNs() clock (millisecond precision with
+  // SDL). Backends without per-event times use the time the event was dequeued.
+  std::uint64_t timestampNs = 0;
   Extent2D resizedExtent{};
   KeyboardEvent keyboard{};
   PointerEvent pointer{};
 };
 
 using PlatformEventQueue = std::vector<PlatformEvent>;
+// Hands events from the thread that polls the windows to the thread that runs the frame.
+using PlatformEventRing = core::SpscQueue<PlatformEvent>;
 
 } // namespace engine::platform
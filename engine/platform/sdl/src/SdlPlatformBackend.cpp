@@ -2,9 +2,15 @@
 
 #include <SDL.h>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 #include "engine/platform/IPlatformBackend.hpp"
 
@@ -100,67 +106,30 @@ public:
   }
 
   void pollEvents(PlatformEventQueue& eventQueue) override {
-    SDL_Event sdlEvent;
-    while (SDL_PollEvent(&sdlEvent) != 0) {
-      PlatformEvent event{};
+    pump([&eventQueue](const PlatformEvent& event) { eventQueue.push_back(event); });
+  }
 
-      switch (sdlEvent.type) {
-      case SDL_QUIT:
-        event.type = PlatformEventType::QuitRequested;
-        break;
-      case SDL_WINDOWEVENT: {
-        event.windowId = findWindow(sdlEvent.window.windowID);
-        if (sdlEvent.window.event == SDL_WINDOWEVENT_CLOSE) {
-          shouldClose_[event.windowId] = true;
-          event.type = PlatformEventType::WindowClosed;
-        } else if (sdlEvent.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
-          event.type = PlatformEventType::WindowResized;
-          event.resizedExtent = Extent2D{static_cast<std::uint32_t>(sdlEvent.window.data1),
-                                         static_cast<std::uint32_t>(sdlEvent.window.data2)};
-        }
-      } break;
-      case SDL_KEYDOWN:
-      case SDL_KEYUP:
-        event.type = PlatformEventType::Keyboard;
-        event.windowId = findWindow(sdlEvent.key.windowID);
-        event.keyboard.keyCode = static_cast<std::uint32_t>(sdlEvent.key.keysym.sym);
-        event.keyboard.state = sdlEvent.key.state == SDL_PRESSED ? KeyState::Pressed : KeyState::Released;
-        event.keyboard.repeated = sdlEvent.key.repeat != 0;
-        keyStates_[event.keyboard.keyCode] = event.keyboard.state;
-        break;
-      case SDL_MOUSEBUTTONDOWN:
-      case SDL_MOUSEBUTTONUP:
-        event.type = PlatformEventType::Pointer;
-        event.windowId = findWindow(sdlEvent.button.windowID);
-        event.pointer.x = sdlEvent.button.x;
-        event.pointer.y = sdlEvent.button.y;
-        event.pointer.button = sdlEvent.button.button;
-        event.pointer.state = sdlEvent.button.state == SDL_PRESSED ? KeyState::Pressed : KeyState::Released;
-        pointerButtons_[event.pointer.button] = event.pointer.state;
-        pointer_ = event.pointer;
-        break;
-      case SDL_MOUSEMOTION:
-        pointer_.x = sdlEvent.motion.x;
-        pointer_.y = sdlEvent.motion.y;
-        break;
-      default:
-        break;
+  std::size_t pollEvents(PlatformEventRing& eventRing) override {
+    std::size_t dropped = 0;
+    pump([&eventRing, &dropped](const PlatformEvent& event) {
+      if (!eventRing.tryPush(event)) {
+        ++dropped;
       }
+    });
+    return dropped;
+  }
 
-      if (event.type != PlatformEventType::None) {
-        eventQueue.push_back(event);
-      }
-    }
+  void setNativeEventObserver(std::function<void(const void* nativeEvent)> observer) override {
+    nativeEventObserver_ = std::move(observer);
   }
 
   [[nodiscard]] KeyState keyState(std::uint32_t keyCode) const override {
-    const auto it = keyStates_.find(keyCode);
-    return it != keyStates_.end() ? it->second : KeyState::Released;
+    const auto scanCode = static_cast<std::uint32_t>(SDL_GetScancodeFromKey(static_cast<SDL_Keycode>(keyCode)));
+    return scanCode < keyStates_.size() ? keyStates_[scanCode] : KeyState::Released;
   }
 
   [[nodiscard]] KeyState pointerButtonState(std::uint8_t button) const override {
-    const auto it = pointerButtons_.find(button);
-    return it != pointerButtons_.end() ? it->second : KeyState::Released;
+    return button < pointerButtons_.size() ? pointerButtons_[button] : KeyState::Released;
   }
 
   [[nodiscard]] PointerEvent pointer() const override { return pointer_; }
@@ -210,6 +179,117 @@ public:
   bool setText(const std::string& value) override { return SDL_SetClipboardText(value.c_str()) == 0; }
 
 private:
+  // Translates every queued SDL event and hands it to emit. Runs of motion events for one window are
+  // merged into a single PointerMotion event carrying the latest position and the summed motion, so
+  // a high-rate mouse cannot flood the queue; any other event flushes the pending motion first to
+  // keep the order; the merged event keeps the time of the first motion. Each event is stamped
+  // with the time SDL queued it (see eventTimestampNs()), so events that waited in the OS queue
+  // report their full age rather than the time of this poll.
+  template <typename Emit>
+  void pump(Emit&& emit) {
+    const Uint32 pollTicks = SDL_GetTicks();
+    const std::uint64_t pollNs = platformTimestampNs();
+    std::optional<PlatformEvent> pendingMotion;
+    const auto flushMotion = [&pendingMotion, &emit] {
+      if (pendingMotion.has_value()) {
+        emit(*pendingMotion);
+        pendingMotion.reset();
+      }
+    };
+
+    SDL_Event sdlEvent;
+    while (SDL_PollEvent(&sdlEvent) != 0) {
+      if (nativeEventObserver_) {
+        nativeEventObserver_(&sdlEvent);
+      }
+
+      const std::uint64_t timestampNs = eventTimestampNs(sdlEvent.common.timestamp, pollTicks, pollNs);
+      PlatformEvent event{};
+      event.timestampNs = timestampNs;
+
+      switch (sdlEvent.type) {
+      case SDL_QUIT:
+        event.type = PlatformEventType::QuitRequested;
+        break;
+      case SDL_WINDOWEVENT: {
+        event.windowId = findWindow(sdlEvent.window.windowID);
+        if (sdlEvent.window.event == SDL_WINDOWEVENT_CLOSE) {
+          shouldClose_[event.windowId] = true;
+          event.type = PlatformEventType::WindowClosed;
+        } else if (sdlEvent.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+          event.type = PlatformEventType::WindowResized;
+          event.resizedExtent = Extent2D{static_cast<std::uint32_t>(sdlEvent.window.data1),
+                                         static_cast<std::uint32_t>(sdlEvent.window.data2)};
+        }
+      } break;
+      case SDL_KEYDOWN:
+      case SDL_KEYUP:
+        event.type = PlatformEventType::Keyboard;
+        event.windowId = findWindow(sdlEvent.key.windowID);
+        event.keyboard.keyCode = static_cast<std::uint32_t>(sdlEvent.key.keysym.sym);
+        event.keyboard.scanCode = static_cast<std::uint32_t>(sdlEvent.key.keysym.scancode);
+        event.keyboard.state = sdlEvent.key.state == SDL_PRESSED ? KeyState::Pressed : KeyState::Released;
+        event.keyboard.repeated = sdlEvent.key.repeat != 0;
+        if (event.keyboard.scanCode < keyStates_.size()) {
+          keyStates_[event.keyboard.scanCode] = event.keyboard.state;
+        }
+        break;
+      case SDL_MOUSEBUTTONDOWN:
+      case SDL_MOUSEBUTTONUP:
+        event.type = PlatformEventType::Pointer;
+        event.windowId = findWindow(sdlEvent.button.windowID);
+        event.pointer.x = sdlEvent.button.x;
+        event.pointer.y = sdlEvent.button.y;
+        event.pointer.button = sdlEvent.button.button;
+        event.pointer.state = sdlEvent.button.state == SDL_PRESSED ? KeyState::Pressed : KeyState::Released;
+        if (event.pointer.button < pointerButtons_.size()) {
+          pointerButtons_[event.pointer.button] = event.pointer.state;
+        }
+        pointer_ = event.pointer;
+        break;
+      case SDL_MOUSEMOTION: {
+        pointer_.x = sdlEvent.motion.x;
+        pointer_.y = sdlEvent.motion.y;
+        const WindowId windowId = findWindow(sdlEvent.motion.windowID);
+        if (pendingMotion.has_value() && pendingMotion->windowId != windowId) {
+          flushMotion();
+        }
+        if (!pendingMotion.has_value()) {
+          pendingMotion = PlatformEvent{};
+          pendingMotion->type = PlatformEventType::PointerMotion;
+          pendingMotion->windowId = windowId;
+          pendingMotion->timestampNs = timestampNs;
+        }
+        pendingMotion->pointer.x = sdlEvent.motion.x;
+        pendingMotion->pointer.y = sdlEvent.motion.y;
+        pendingMotion->pointer.deltaX += sdlEvent.motion.xrel;
+        pendingMotion->pointer.deltaY += sdlEvent.motion.yrel;
+      } break;
+      default:
+        break;
+      }
+
+      if (event.type != PlatformEventType::None) {
+        flushMotion();
+        emit(event);
+      }
+    }
+    flushMotion();
+  }
+
+  // SDL stamps events in SDL_GetTicks() milliseconds; pollTicks and pollNs were read together, so
+  // an event's age in ticks carries over to the steady clock. Events without a stamp, or queued
+  // after the poll started, take the time they are dequeued.
+  [[nodiscard]] static std::uint64_t eventTimestampNs(const Uint32 eventTicks, const Uint32 pollTicks,
+                                                      const std::uint64_t pollNs) {
+    const Uint32 ageMs = pollTicks - eventTicks;
+    if (eventTicks == 0 || static_cast<std::int32_t>(ageMs) < 0) {
+      return platformTimestampNs();
+    }
+    const std::uint64_t ageNs = static_cast<std::uint64_t>(ageMs) * 1'000'000U;
+    return ageNs < pollNs ? pollNs - ageNs : 0;
+  }
+
   [[nodiscard]] WindowId findWindow(std::uint32_t sdlWindowId) const {
     const auto it = sdlWindowToId_.find(sdlWindowId);
     return it != sdlWindowToId_.end() ? it->second : 0;
@@ -220,9 +300,11 @@ private:
   std::unordered_map<std::uint32_t, WindowId> sdlWindowToId_;
   std::unordered_map<WindowId, bool> shouldClose_;
 
-  std::unordered_map<std::uint32_t, KeyState> keyStates_;
-  std::unordered_map<std::uint8_t, KeyState> pointerButtons_;
+  // Indexed by scan code and button; Released is zero, so value-initialization releases everything.
+  std::array<KeyState, kMaxScanCodes> keyStates_{};
+  std::array<KeyState, kMaxPointerButtons> pointerButtons_{};
   PointerEvent pointer_{};
+  std::function<void(const void* nativeEvent)> nativeEventObserver_;
 };
 
 std::unique_ptr<IPlatformBackend> createSdlPlatformBackend() {
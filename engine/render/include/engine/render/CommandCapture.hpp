@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "engine/render/IRenderDevice.hpp"
+
+namespace engine::render {
+
+// Wraps device so that every resource call, and every call on the command contexts it creates, is
+// appended to a binary capture file at path. Create infos are stored with buffer contents, texels and
+// shader byte code; updates, uploads and transient data carry their bytes. Queries (stats, statuses,
+// resources()) are forwarded but not recorded. Transient allocations hand out CPU staging memory that
+// is copied to the device's range, and into the capture, before the next recorded call. The file is
+// complete once the returned device is destroyed. Throws std::runtime_error when path cannot be opened.
+[[nodiscard]] std::unique_ptr<IRenderDevice> createCapturingRenderDevice(std::unique_ptr<IRenderDevice> device,
+                                                                         const std::filesystem::path& path);
+
+struct CommandReplayFrame {
+  // Frame index the application passed to beginFrame().
+  std::uint64_t frameIndex = 0;
+  // CPU time from the end of the previous frame through this frame's endFrame(), so resource calls
+  // between frames are included.
+  double cpuMs = 0.0;
+  std::uint32_t drawCalls = 0;
+  std::uint64_t triangles = 0;
+};
+
+struct CommandReplayResult {
+  // CPU time of the calls before the first beginFrame(), mostly resource creation.
+  double setupMs = 0.0;
+  std::vector<CommandReplayFrame> frames;
+};
+
+// A capture written through createCapturingRenderDevice(). load() reads and decodes the whole file up
+// front, so replay timings exclude I/O and parsing.
+class CommandCapture {
+public:
+  // Throws std::runtime_error when the file cannot be read, is truncated or has a different version.
+  [[nodiscard]] static CommandCapture load(const std::filesystem::path& path);
+
+  CommandCapture(CommandCapture&&) noexcept = default;
+  CommandCapture& operator=(CommandCapture&&) noexcept = default;
+  CommandCapture(const CommandCapture&) = delete;
+  CommandCapture& operator=(const CommandCapture&) = delete;
+  ~CommandCapture() = default;
+
+  [[nodiscard]] std::size_t commandCount() const { return commands_.size(); }
+  [[nodiscard]] std::uint64_t frameCount() const { return frameCount_; }
+
+  // Re-executes the capture on device as fast as it accepts the calls. Captured handles are remapped
+  // to the ones device returns, and each pipeline is polled until it leaves Pending right after it is
+  // created. Resources still alive at the end of the capture are destroyed afterwards. Pass names
+  // point into this capture, so keep it alive as long as the profiler history. Throws
+  // std::runtime_error when a call references a handle the capture never created.
+  [[nodiscard]] CommandReplayResult replay(IRenderDevice& device) const;
+
+private:
+  struct Command {
+    std::uint8_t op = 0;
+    std::uint32_t context = 0;
+    std::array<std::uint64_t, 8> args{};
+    std::string_view text;
+    std::span<const std::byte> payload;
+  };
+
+  CommandCapture() = default;
+
+  // Decoded commands point into data_.
+  std::vector<std::byte> data_;
+  std::vector<Command> commands_;
+  std::uint64_t frameCount_ = 0;
+};
+
+} // namespace engine::render
@@ -2,12 +2,13 @@
 
 #include <string_view>
 
+#include "engine/core/Profiler.hpp"
+#include "engine/render/ICommandContext.hpp"
 #include "engine/render/RenderTypes.hpp"
 
 namespace engine::render {
 
 class IRenderDevice;
-class ICommandContext;
 
 class IFrameGraphHook {
 public:
@@ -19,4 +20,15 @@ public:
   virtual void teardown(IRenderDevice& device) = 0;
 };
 
+// Runs a hook inside a CPU profile zone and a GPU pass scope named after the hook. The zone name is
+// interned because the profiler history can outlive the hook.
+inline void executeFrameGraphHook(IFrameGraphHook& hook,
+                                  ICommandContext& commandContext,
+                                  const FrameGraphFrameInfo& frameInfo) {
+  ENGINE_PROFILE_ZONE(core::Profiler::instance().internName(hook.passName()));
+  commandContext.beginPass(hook.passName());
+  hook.execute(commandContext, frameInfo);
+  commandContext.endPass();
+}
+
 } // namespace engine::render
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace engine::render {
+
+// Handle ids pack the slot index + 1 into the low bits and the slot's generation into the rest,
+// so id 0 is never handed out and stays the invalid handle.
+inline constexpr std::uint32_t kHandleIndexBits = 20;
+inline constexpr std::uint32_t kHandleIndexMask = (1U << kHandleIndexBits) - 1;
+inline constexpr std::uint32_t kMaxHandleGeneration = (1U << (32U - kHandleIndexBits)) - 1;
+
+// Dense storage for resources addressed by generational handle ids. Lookups index the slot and
+// compare its generation, so a stale id is rejected in O(1) instead of aliasing whatever reuses
+// the slot. Freed slots are recycled from a free list; a slot whose generation is exhausted is
+// retired instead. Not thread-safe.
+template <typename T>
+class HandlePool {
+public:
+  // Throws std::runtime_error when every slot is live or retired.
+  [[nodiscard]] std::uint32_t insert(T value) {
+    std::uint32_t index = 0;
+    if (!freeSlots_.empty()) {
+      index = freeSlots_.back();
+      freeSlots_.pop_back();
+    } else {
+      if (slots_.size() >= kHandleIndexMask) {
+        throw std::runtime_error("HandlePool is full (" + std::to_string(kHandleIndexMask) + " slots)");
+      }
+      index = static_cast<std::uint32_t>(slots_.size());
+      slots_.emplace_back();
+    }
+    Slot& slot = slots_[index];
+    slot.value.emplace(std::move(value));
+    ++liveCount_;
+    return packId(index, slot.generation);
+  }
+
+  [[nodiscard]] T* find(const std::uint32_t id) {
+    Slot* slot = liveSlot(id);
+    return slot == nullptr ? nullptr : &*slot->value;
+  }
+
+  [[nodiscard]] const T* find(const std::uint32_t id) const {
+    return const_cast<HandlePool*>(this)->find(id);
+  }
+
+  // False for stale or unknown ids.
+  bool erase(const std::uint32_t id) {
+    Slot* slot = liveSlot(id);
+    if (slot == nullptr) {
+      return false;
+    }
+    slot->value.reset();
+    --liveCount_;
+    if (slot->generation < kMaxHandleGeneration) {
+      ++slot->generation;
+      freeSlots_.push_back((id & kHandleIndexMask) - 1);
+    }
+    return true;
+  }
+
+  [[nodiscard]] std::size_t size() const { return liveCount_; }
+
+  // visit(id, value) for every live entry, in slot order.
+  template <typename Visit>
+  void forEach(Visit&& visit) const {
+    for (std::size_t index = 0; index < slots_.size(); ++index) {
+      if (slots_[index].value.has_value()) {
+        visit(packId(static_cast<std::uint32_t>(index), slots_[index].generation), *slots_[index].value);
+      }
+    }
+  }
+
+private:
+  struct Slot {
+    std::optional<T> value;
+    std::uint32_t generation = 0;
+  };
+
+  [[nodiscard]] static std::uint32_t packId(const std::uint32_t index, const std::uint32_t generation) {
+    return (generation << kHandleIndexBits) | (index + 1);
+  }
+
+  [[nodiscard]] Slot* liveSlot(const std::uint32_t id) {
+    // id 0 wraps to an out-of-range index.
+    const std::uint32_t index = (id & kHandleIndexMask) - 1;
+    if (index >= slots_.size()) {
+      return nullptr;
+    }
+    Slot& slot = slots_[index];
+    if (!slot.value.has_value() || slot.generation != id >> kHandleIndexBits) {
+      return nullptr;
+    }
+    return &slot;
+  }
+
+  std::vector<Slot> slots_;
+  std::vector<std::uint32_t> freeSlots_;
+  std::size_t liveCount_ = 0;
+};
+
+} // namespace engine::render
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
 
 #include "engine/render/RenderTypes.hpp"
 
@@ -13,9 +14,22 @@ public:
   virtual void beginFrame(const FrameGraphFrameInfo& frameInfo) = 0;
   virtual void endFrame() = 0;
 
+  // Named scope around a group of commands (used for GPU timing); scopes may nest. The name must
+  // outlive the frame history of engine::core::Profiler.
+  virtual void beginPass(std::string_view name) = 0;
+  virtual void endPass() = 0;
+
+  // Never waits for a pipeline build: if the pipeline is not Ready when bound, the draws recorded
+  // until the next bind are skipped and counted in RenderFrameStats::drawsSkipped.
   virtual void bindPipeline(PipelineHandle pipeline) = 0;
   virtual void bindVertexBuffer(BufferHandle buffer, std::uint64_t offset = 0) = 0;
   virtual void bindIndexBuffer(BufferHandle buffer, std::uint64_t offset = 0) = 0;
+  // sizeBytes == 0 binds from offset to the end of the buffer.
+  virtual void bindUniformBuffer(std::uint32_t binding,
+                                 BufferHandle buffer,
+                                 std::uint64_t offset = 0,
+                                 std::uint64_t sizeBytes = 0) = 0;
+  // A draw with instanceCount == 0 draws nothing and is not counted in RenderFrameStats.
   virtual void draw(std::uint32_t vertexCount,
                     std::uint32_t instanceCount = 1,
                     std::uint32_t firstVertex = 0,
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <vector>
 
 #include "engine/render/RenderTypes.hpp"
 
@@ -16,15 +20,52 @@ public:
 
   [[nodiscard]] virtual BufferHandle createBuffer(const BufferCreateInfo& createInfo) = 0;
   virtual void destroyBuffer(BufferHandle handle) = 0;
+  // Copies data into the buffer at offset; throws std::runtime_error if the range is out of bounds.
+  // Call between frames: contexts may still read the previous contents until endFrame().
+  virtual void updateBuffer(BufferHandle handle, std::uint64_t offset, std::span<const std::byte> data) = 0;
 
+  // Like updateBuffer(), but never stalls the frame: data is copied to staging memory right away
+  // and transferred to the buffer over the following frames within the device's per-frame upload
+  // budget, in submission order. The range reads undefined until uploadComplete() returns true.
+  // Destroying the buffer cancels its pending transfers. Throws std::runtime_error like updateBuffer().
+  [[nodiscard]] virtual UploadTicket queueBufferUpload(BufferHandle handle, std::uint64_t offset, std::span<const std::byte> data) = 0;
+  // Non-blocking; true once the GPU has finished the transfer.
+  [[nodiscard]] virtual bool uploadComplete(UploadTicket ticket) = 0;
+
+  // Per-frame scratch memory for instance, uniform or debug data, sub-allocated from a device-owned
+  // ring so writing it never waits on the GPU. Write the data before recording the draws that read
+  // it; the range is reused once the GPU has finished the frame, so do not touch it after the
+  // command context's endFrame(). alignment (a power of two) is raised to the uniform-buffer offset
+  // alignment. Throws std::runtime_error when the request does not fit in the ring.
+  [[nodiscard]] virtual TransientAllocation allocateTransient(std::uint64_t sizeBytes, std::uint64_t alignment = 16) = 0;
+
+  // False for block-compressed formats the device cannot sample; createTexture() throws for them.
+  [[nodiscard]] virtual bool supportsTextureFormat(TextureFormat format) const = 0;
   [[nodiscard]] virtual TextureHandle createTexture(const TextureCreateInfo& createInfo) = 0;
   virtual void destroyTexture(TextureHandle handle) = 0;
+  // Replaces one whole mip level (all cube faces or volume slices) with tightly packed texels,
+  // committing its storage if the level was not resident. Throws std::runtime_error on a size
+  // mismatch or an out-of-range level.
+  virtual void updateTexture(TextureHandle handle, std::uint32_t mipLevel, std::span<const std::byte> texels) = 0;
+  // Sampling is clamped to firstResidentMip and coarser. Raising it releases the finer levels;
+  // lowering it commits storage for the newly included levels, so upload them first.
+  virtual void setTextureResidency(TextureHandle handle, std::uint32_t firstResidentMip) = 0;
 
   [[nodiscard]] virtual ShaderHandle createShader(const ShaderCreateInfo& createInfo) = 0;
   virtual void destroyShader(ShaderHandle handle) = 0;
 
+  // Pipelines may finish compiling in the background. Poll pipelineStatus() (or use PipelineWarmup)
+  // until they are Ready before drawing with them; see ICommandContext::bindPipeline().
   [[nodiscard]] virtual PipelineHandle createGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo) = 0;
+  // Advances pending builds. Call on the device thread. Unknown handles are Failed. Non-blocking
+  // where the driver builds in the background; otherwise (OpenGL without
+  // KHR_parallel_shader_compile) the first call finishes the build, so poll while loading.
+  [[nodiscard]] virtual PipelineStatus pipelineStatus(PipelineHandle handle) = 0;
   virtual void destroyPipeline(PipelineHandle handle) = 0;
+
+  // Debug introspection. Both are safe to call from any thread while the device is rendering.
+  [[nodiscard]] virtual std::vector<RenderResourceInfo> resources() const = 0;
+  [[nodiscard]] virtual RenderFrameStats frameStats() const = 0;
 };
 
 } // namespace engine::render
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "engine/render/IRenderDevice.hpp"
+#include "engine/render/RenderTypes.hpp"
+#include "engine/render/TextureStreamer.hpp"
+
+namespace engine::render {
+
+// A memory-mapped KTX2 container. Level views point straight into the mapping, so uploads read
+// the file without an intermediate copy. Supported: 2D, cube and 3D textures with one array
+// layer, no supercompression, and the vkFormats behind TextureFormat (RGBA8, RGBA16F, BC1/3/5/7,
+// ETC2 RGB8/RGBA8). sRGB variants load as their UNORM format with srgb() set.
+class Ktx2File {
+public:
+  // Throws std::runtime_error when the file cannot be mapped or uses an unsupported feature.
+  [[nodiscard]] static Ktx2File open(const std::filesystem::path& path);
+
+  Ktx2File(Ktx2File&& other) noexcept;
+  Ktx2File& operator=(Ktx2File&& other) noexcept;
+  Ktx2File(const Ktx2File&) = delete;
+  Ktx2File& operator=(const Ktx2File&) = delete;
+  ~Ktx2File();
+
+  // debugName is left empty; mipLevels is the level count stored in the file.
+  [[nodiscard]] const TextureCreateInfo& createInfo() const { return createInfo_; }
+  [[nodiscard]] std::uint32_t levelCount() const { return static_cast<std::uint32_t>(levels_.size()); }
+  // Tightly packed data of one level (all faces or slices), as IRenderDevice::updateTexture() takes it.
+  [[nodiscard]] std::span<const std::byte> level(std::uint32_t mipLevel) const;
+  [[nodiscard]] bool srgb() const { return srgb_; }
+
+private:
+  Ktx2File() = default;
+  void release() noexcept;
+
+  const std::byte* mapping_ = nullptr;
+  std::size_t mappingSize_ = 0;
+#if defined(_WIN32)
+  void* fileMapping_ = nullptr;
+#endif
+  TextureCreateInfo createInfo_{};
+  std::vector<std::span<const std::byte>> levels_;
+  bool srgb_ = false;
+};
+
+// Format a device will hold the file's texture in: the stored format when the device supports
+// it, otherwise RGBA8 decoded on the CPU by decodeTextureToRgba8().
+[[nodiscard]] TextureFormat ktx2UploadFormat(const IRenderDevice& device, const Ktx2File& file);
+
+// Level data converted to ktx2UploadFormat().
+[[nodiscard]] std::vector<std::byte> ktx2UploadLevel(const Ktx2File& file, std::uint32_t mipLevel, TextureFormat uploadFormat);
+
+// Creates a fully resident texture and uploads every level.
+[[nodiscard]] TextureHandle createTextureFromKtx2(IRenderDevice& device, const Ktx2File& file, std::string_view debugName);
+
+// Describes the file for TextureStreamer::add(); the loader reads (and decodes, if needed) levels
+// from the shared mapping on the streamer's worker threads.
+[[nodiscard]] StreamedTextureDesc ktx2StreamedTextureDesc(const IRenderDevice& device,
+                                                          std::shared_ptr<const Ktx2File> file,
+                                                          std::string debugName);
+
+} // namespace engine::render
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "engine/render/IRenderDevice.hpp"
+#include "engine/render/RenderTypes.hpp"
+
+namespace engine::render {
+
+struct PipelineWarmupProgress {
+  std::uint32_t total = 0;
+  std::uint32_t ready = 0;
+  std::uint32_t failed = 0;
+
+  [[nodiscard]] bool done() const { return ready + failed == total; }
+  [[nodiscard]] float fraction() const {
+    return total == 0 ? 1.0F : static_cast<float>(ready + failed) / static_cast<float>(total);
+  }
+};
+
+// Creates a known set of pipelines up front so their compiles overlap each other and loading,
+// instead of hitching the first frame that draws with them. Drive poll() once per loading-screen
+// frame, or call wait() to block. The warm-up owns one reference per pipeline: take() hands one to
+// the caller, release() or the destructor destroys the rest. On devices that deduplicate pipelines,
+// later creates of the same pipeline share the warmed one, so release only after they have run.
+// The device must outlive the warm-up.
+class PipelineWarmup {
+public:
+  PipelineWarmup(IRenderDevice& device, const std::span<const GraphicsPipelineCreateInfo> pipelines)
+      : device_(device) {
+    handles_.reserve(pipelines.size());
+    statuses_.reserve(pipelines.size());
+    for (const GraphicsPipelineCreateInfo& createInfo : pipelines) {
+      handles_.push_back(device_.createGraphicsPipeline(createInfo));
+      statuses_.push_back(PipelineStatus::Pending);
+    }
+  }
+
+  ~PipelineWarmup() { release(); }
+
+  PipelineWarmup(const PipelineWarmup&) = delete;
+  PipelineWarmup& operator=(const PipelineWarmup&) = delete;
+
+  // Non-blocking; only pipelines still pending and held are queried.
+  PipelineWarmupProgress poll() {
+    PipelineWarmupProgress progress{};
+    progress.total = static_cast<std::uint32_t>(handles_.size());
+    for (std::size_t index = 0; index < handles_.size(); ++index) {
+      if (statuses_[index] == PipelineStatus::Pending && handles_[index].id != 0) {
+        statuses_[index] = device_.pipelineStatus(handles_[index]);
+      }
+      progress.ready += statuses_[index] == PipelineStatus::Ready ? 1U : 0U;
+      progress.failed += statuses_[index] == PipelineStatus::Failed ? 1U : 0U;
+    }
+    return progress;
+  }
+
+  PipelineWarmupProgress wait(const std::chrono::microseconds pollInterval = std::chrono::microseconds{500}) {
+    PipelineWarmupProgress progress = poll();
+    while (!progress.done()) {
+      std::this_thread::sleep_for(pollInterval);
+      progress = poll();
+    }
+    return progress;
+  }
+
+  // Transfers the pipeline at index to the caller, who then destroys it; its slot reads as an
+  // invalid handle afterwards.
+  [[nodiscard]] PipelineHandle take(const std::size_t index) { return std::exchange(handles_[index], PipelineHandle{}); }
+
+  // Destroys every pipeline still held. Statuses are kept.
+  void release() {
+    for (PipelineHandle& handle : handles_) {
+      if (handle.id != 0) {
+        device_.destroyPipeline(std::exchange(handle, PipelineHandle{}));
+      }
+    }
+  }
+
+  // In creation order, matching the pipelines passed to the constructor.
+  [[nodiscard]] std::span<const PipelineHandle> handles() const { return handles_; }
+  [[nodiscard]] PipelineStatus status(const std::size_t index) const { return statuses_[index]; }
+
+private:
+  IRenderDevice& device_;
+  std::vector<PipelineHandle> handles_;
+  std::vector<PipelineStatus> statuses_;
+};
+
+} // namespace engine::render
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace engine::render {
+
+// Driver-specific linked program blob plus the driver's format tag (GL_PROGRAM_BINARY_FORMAT).
+struct ProgramBinary {
+  std::uint32_t format = 0;
+  std::vector<std::byte> data;
+};
+
+struct ProgramBinaryCacheStats {
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+  // Binaries found on disk but refused by the driver (e.g. after a driver update).
+  std::uint64_t rejected = 0;
+  std::uint64_t writes = 0;
+};
+
+// On-disk cache of linked program binaries, one file per key. Keys hash everything that affects
+// the binary (sources, defines, driver identity), so stale entries are simply never looked up
+// again. Safe to use from several threads; an empty directory disables the cache.
+class ProgramBinaryCache {
+public:
+  ProgramBinaryCache() = default;
+  explicit ProgramBinaryCache(std::filesystem::path directory)
+      : directory_(std::move(directory)) {}
+
+  ProgramBinaryCache(const ProgramBinaryCache&) = delete;
+  ProgramBinaryCache& operator=(const ProgramBinaryCache&) = delete;
+
+  // 64-bit FNV-1a over each part, length-prefixed so ("ab","c") and ("a","bc") differ.
+  [[nodiscard]] static std::uint64_t computeKey(const std::initializer_list<std::string_view> parts) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    const auto mix = [&hash](const unsigned char byte) {
+      hash ^= byte;
+      hash *= 1099511628211ULL;
+    };
+    for (const std::string_view part : parts) {
+      const std::uint64_t length = part.size();
+      for (std::size_t shift = 0; shift < 64; shift += 8) {
+        mix(static_cast<unsigned char>(length >> shift));
+      }
+      for (const char character : part) {
+        mix(static_cast<unsigned char>(character));
+      }
+    }
+    return hash;
+  }
+
+  [[nodiscard]] bool enabled() const { return !directory_.empty(); }
+  [[nodiscard]] const std::filesystem::path& directory() const { return directory_; }
+
+  [[nodiscard]] std::optional<ProgramBinary> load(const std::uint64_t key) const {
+    if (!enabled()) {
+      return std::nullopt;
+    }
+
+    std::ifstream file{pathFor(key), std::ios::binary};
+    if (!file) {
+      return std::nullopt;
+    }
+
+    FileHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != kMagic ||
+        header.version != kVersion || header.key != key || header.sizeBytes > kMaxBinaryBytes) {
+      return std::nullopt;
+    }
+
+    ProgramBinary binary{};
+    binary.format = header.format;
+    binary.data.resize(static_cast<std::size_t>(header.sizeBytes));
+    if (!file.read(reinterpret_cast<char*>(binary.data.data()), static_cast<std::streamsize>(binary.data.size()))) {
+      return std::nullopt;
+    }
+    return binary;
+  }
+
+  // Writes to a temporary file and renames it into place so concurrent readers never see a
+  // partial entry. Failures are ignored: the cache is an optimization only.
+  void store(const std::uint64_t key, const ProgramBinary& binary) {
+    if (!enabled() || binary.data.empty()) {
+      return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    const std::filesystem::path target = pathFor(key);
+    std::filesystem::path temporary = target;
+    temporary += "." + std::to_string(nextTemporaryId_.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+
+    {
+      std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+      const FileHeader header{kMagic, kVersion, binary.format, 0, key, binary.data.size()};
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      file.write(reinterpret_cast<const char*>(binary.data.data()), static_cast<std::streamsize>(binary.data.size()));
+      if (!file) {
+        file.close();
+        std::filesystem::remove(temporary, error);
+        return;
+      }
+    }
+
+    std::filesystem::rename(temporary, target, error);
+    if (error) {
+      std::filesystem::remove(temporary, error);
+      return;
+    }
+    writes_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Drops an entry the driver refused so it is rebuilt on the next store().
+  void reject(const std::uint64_t key) {
+    rejected_.fetch_add(1, std::memory_order_relaxed);
+    std::error_code error;
+    std::filesystem::remove(pathFor(key), error);
+  }
+
+  void recordHit() { hits_.fetch_add(1, std::memory_order_relaxed); }
+  void recordMiss() { misses_.fetch_add(1, std::memory_order_relaxed); }
+
+  [[nodiscard]] ProgramBinaryCacheStats stats() const {
+    return ProgramBinaryCacheStats{hits_.load(std::memory_order_relaxed),
+                                   misses_.load(std::memory_order_relaxed),
+                                   rejected_.load(std::memory_order_relaxed),
+                                   writes_.load(std::memory_order_relaxed)};
+  }
+
+private:
+  static constexpr std::uint32_t kMagic = 0x43425051; // "QPBC"
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::uint64_t kMaxBinaryBytes = std::uint64_t{256} << 20;
+
+  struct FileHeader {
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint32_t format = 0;
+    std::uint32_t reserved = 0;
+    std::uint64_t key = 0;
+    std::uint64_t sizeBytes = 0;
+  };
+
+  [[nodiscard]] std::filesystem::path pathFor(const std::uint64_t key) const {
+    std::array<char, 24> name{};
+    std::snprintf(name.data(), name.size(), "%016llx.bin", static_cast<unsigned long long>(key));
+    return directory_ / name.data();
+  }
+
+  std::filesystem::path directory_;
+  std::atomic<std::uint64_t> hits_{0};
+  std::atomic<std::uint64_t> misses_{0};
+  std::atomic<std::uint64_t> rejected_{0};
+  std::atomic<std::uint64_t> writes_{0};
+  std::atomic<std::uint64_t> nextTemporaryId_{0};
+};
+
+} // namespace engine::render
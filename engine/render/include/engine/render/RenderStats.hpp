@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "engine/render/RenderTypes.hpp"
+
+namespace engine::render {
+
+// Draw counters for one command context. Incremented on the recording thread without
+// synchronization and published to the device once per frame.
+struct FrameDrawCounters {
+  std::uint32_t drawCalls = 0;
+  std::uint64_t triangles = 0;
+  std::uint32_t pipelineBinds = 0;
+  std::uint32_t drawsSkipped = 0;
+  // Backends with a state cache report the GL calls it issued and skipped as redundant.
+  std::uint32_t stateChangesIssued = 0;
+  std::uint32_t stateChangesFiltered = 0;
+
+  // Callers count only draws that render: a draw with instanceCount == 0 draws nothing.
+  void countDraw(const PrimitiveTopology topology, const std::uint32_t vertexCount, const std::uint32_t instanceCount) {
+    ++drawCalls;
+    triangles += primitiveTriangleCount(topology, vertexCount) * instanceCount;
+  }
+
+  [[nodiscard]] static std::uint64_t primitiveTriangleCount(const PrimitiveTopology topology, const std::uint32_t vertexCount) {
+    switch (topology) {
+    case PrimitiveTopology::TriangleStrip:
+      return vertexCount < 3 ? 0 : vertexCount - 2;
+    case PrimitiveTopology::LineList:
+      return 0;
+    case PrimitiveTopology::TriangleList:
+    default:
+      return vertexCount / 3;
+    }
+  }
+};
+
+// Latest published frame statistics of a device. A sequence counter guards the fields, so readers
+// on other threads get a consistent snapshot without ever blocking the publishing thread.
+class RenderStatsCounters {
+public:
+  void publish(const std::uint64_t frameIndex, const FrameDrawCounters& counters, const std::uint32_t pendingDestructions = 0) {
+    std::uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    while ((sequence & 1U) != 0 ||
+           !sequence_.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+      sequence = sequence_.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    frameIndex_.store(frameIndex, std::memory_order_relaxed);
+    drawCalls_.store(counters.drawCalls, std::memory_order_relaxed);
+    triangles_.store(counters.triangles, std::memory_order_relaxed);
+    pipelineBinds_.store(counters.pipelineBinds, std::memory_order_relaxed);
+    drawsSkipped_.store(counters.drawsSkipped, std::memory_order_relaxed);
+    pendingDestructions_.store(pendingDestructions, std::memory_order_relaxed);
+    stateChangesIssued_.store(counters.stateChangesIssued, std::memory_order_relaxed);
+    stateChangesFiltered_.store(counters.stateChangesFiltered, std::memory_order_relaxed);
+
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  [[nodiscard]] RenderFrameStats snapshot() const {
+    RenderFrameStats stats{};
+    while (true) {
+      const std::uint64_t before = sequence_.load(std::memory_order_acquire);
+      if ((before & 1U) != 0) {
+        continue;
+      }
+
+      stats.frameIndex = frameIndex_.load(std::memory_order_relaxed);
+      stats.drawCalls = drawCalls_.load(std::memory_order_relaxed);
+      stats.triangles = triangles_.load(std::memory_order_relaxed);
+      stats.pipelineBinds = pipelineBinds_.load(std::memory_order_relaxed);
+      stats.drawsSkipped = drawsSkipped_.load(std::memory_order_relaxed);
+      stats.pendingDestructions = pendingDestructions_.load(std::memory_order_relaxed);
+      stats.stateChangesIssued = stateChangesIssued_.load(std::memory_order_relaxed);
+      stats.stateChangesFiltered = stateChangesFiltered_.load(std::memory_order_relaxed);
+
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence_.load(std::memory_order_relaxed) == before) {
+        return stats;
+      }
+    }
+  }
+
+private:
+  std::atomic<std::uint64_t> sequence_{0};
+  std::atomic<std::uint64_t> frameIndex_{0};
+  std::atomic<std::uint32_t> drawCalls_{0};
+  std::atomic<std::uint64_t> triangles_{0};
+  std::atomic<std::uint32_t> pipelineBinds_{0};
+  std::atomic<std::uint32_t> drawsSkipped_{0};
+  std::atomic<std::uint32_t> pendingDestructions_{0};
+  std::atomic<std::uint32_t> stateChangesIssued_{0};
+  std::atomic<std::uint32_t> stateChangesFiltered_{0};
+};
+
+} // namespace engine::render
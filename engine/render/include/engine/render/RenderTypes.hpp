@@ -2,6 +2,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
 
 #include "engine/platform/PlatformTypes.hpp"
 
@@ -12,6 +15,8 @@ enum class RenderBackendType {
   OpenGL,
   Vulkan,
   DirectX,
+  Software,
+  Null,
 };
 
 enum class BufferUsage {
@@ -31,8 +36,57 @@ enum class TextureFormat {
   RGBA8,
   RGBA16F,
   Depth24Stencil8,
+  // Block-compressed formats (4x4 texel blocks). Check IRenderDevice::supportsTextureFormat()
+  // and fall back to decodeTextureToRgba8() where the device lacks them.
+  BC1,
+  // BC1 without the punch-through alpha: the fourth color of three-color blocks is opaque black.
+  BC1RGB,
+  BC3,
+  BC5,
+  BC7,
+  ETC2RGB8,
+  ETC2RGBA8,
 };
 
+[[nodiscard]] constexpr bool isBlockCompressed(const TextureFormat format) {
+  switch (format) {
+  case TextureFormat::BC1:
+  case TextureFormat::BC1RGB:
+  case TextureFormat::BC3:
+  case TextureFormat::BC5:
+  case TextureFormat::BC7:
+  case TextureFormat::ETC2RGB8:
+  case TextureFormat::ETC2RGBA8:
+    return true;
+  case TextureFormat::RGBA8:
+  case TextureFormat::RGBA16F:
+  case TextureFormat::Depth24Stencil8:
+  default:
+    return false;
+  }
+}
+
+// Bytes per texel, or per 4x4 block for block-compressed formats.
+[[nodiscard]] constexpr std::size_t textureFormatBlockBytes(const TextureFormat format) {
+  switch (format) {
+  case TextureFormat::RGBA16F:
+    return 8;
+  case TextureFormat::BC1:
+  case TextureFormat::BC1RGB:
+  case TextureFormat::ETC2RGB8:
+    return 8;
+  case TextureFormat::BC3:
+  case TextureFormat::BC5:
+  case TextureFormat::BC7:
+  case TextureFormat::ETC2RGBA8:
+    return 16;
+  case TextureFormat::RGBA8:
+  case TextureFormat::Depth24Stencil8:
+  default:
+    return 4;
+  }
+}
+
 enum class ShaderStage {
   Vertex,
   Fragment,
@@ -61,10 +115,33 @@ struct PipelineHandle {
   std::uint32_t id = 0;
 };
 
+enum class PipelineStatus {
+  Pending,
+  Ready,
+  Failed,
+};
+
 struct BufferCreateInfo {
   std::uint64_t sizeBytes = 0;
   BufferUsage usage = BufferUsage::Vertex;
   bool cpuVisible = false;
+  // Optional; when set, sizeBytes bytes are copied into the buffer at creation.
+  const std::byte* initialData = nullptr;
+  // Copied by the device; shown in debug tooling.
+  std::string_view debugName{};
+};
+
+// Per-frame scratch range returned by IRenderDevice::allocateTransient(). Bind buffer at offset.
+struct TransientAllocation {
+  BufferHandle buffer{};
+  std::uint64_t offset = 0;
+  // Write-only (the memory may be uncached) and valid until the allocating frame ends.
+  std::span<std::byte> data;
+};
+
+// Returned by IRenderDevice::queueBufferUpload(); poll with uploadComplete().
+struct UploadTicket {
+  std::uint64_t id = 0;
 };
 
 struct TextureCreateInfo {
@@ -73,18 +150,104 @@ struct TextureCreateInfo {
   platform::Extent2D extent{};
   std::uint32_t depth = 1;
   std::uint32_t mipLevels = 1;
+  // Levels finer than this start without storage; see IRenderDevice::setTextureResidency().
+  std::uint32_t firstResidentMip = 0;
+  std::string_view debugName{};
 };
 
+// Number of levels in a full mip chain down to 1x1(x1).
+[[nodiscard]] constexpr std::uint32_t fullMipChainLength(const platform::Extent2D extent, const std::uint32_t depth = 1) {
+  std::uint32_t largest = extent.width > extent.height ? extent.width : extent.height;
+  largest = depth > largest ? depth : largest;
+  std::uint32_t levels = 1;
+  while (largest > 1) {
+    largest /= 2;
+    ++levels;
+  }
+  return levels;
+}
+
+[[nodiscard]] constexpr std::uint32_t textureMipCount(const TextureCreateInfo& createInfo) {
+  return createInfo.mipLevels == 0 ? 1 : createInfo.mipLevels;
+}
+
+// Bytes of texel storage for one mip level, including all cube faces or volume slices.
+[[nodiscard]] constexpr std::size_t textureMipByteSize(const TextureCreateInfo& createInfo, const std::uint32_t level) {
+  const std::size_t layers = createInfo.dimension == TextureDimension::TextureCube ? 6 : 1;
+  const std::size_t depth = createInfo.dimension == TextureDimension::Texture3D ? createInfo.depth : 1;
+  const auto levelSize = [level](const std::size_t size) {
+    const std::size_t scaled = size >> level;
+    return scaled == 0 ? std::size_t{1} : scaled;
+  };
+  std::size_t width = levelSize(createInfo.extent.width);
+  std::size_t height = levelSize(createInfo.extent.height);
+  if (isBlockCompressed(createInfo.format)) {
+    width = (width + 3) / 4;
+    height = (height + 3) / 4;
+  }
+  return width * height * levelSize(depth == 0 ? 1 : depth) * layers * textureFormatBlockBytes(createInfo.format);
+}
+
+// Bytes of texel storage for levels firstMip and coarser, used for memory accounting.
+[[nodiscard]] constexpr std::size_t textureByteSize(const TextureCreateInfo& createInfo, const std::uint32_t firstMip = 0) {
+  std::size_t total = 0;
+  for (std::uint32_t level = firstMip; level < textureMipCount(createInfo); ++level) {
+    total += textureMipByteSize(createInfo, level);
+  }
+  return total;
+}
+
 struct ShaderCreateInfo {
   ShaderStage stage = ShaderStage::Vertex;
   const std::byte* byteCode = nullptr;
   std::size_t byteCodeSize = 0;
+  std::string_view debugName{};
 };
 
 struct GraphicsPipelineCreateInfo {
   ShaderHandle vertexShader{};
   ShaderHandle fragmentShader{};
   PrimitiveTopology topology = PrimitiveTopology::TriangleList;
+  std::string_view debugName{};
+};
+
+enum class RenderResourceKind {
+  Buffer,
+  Texture,
+  Shader,
+  Pipeline,
+};
+
+// Snapshot of one live device resource, reported by IRenderDevice::resources().
+struct RenderResourceInfo {
+  RenderResourceKind kind = RenderResourceKind::Buffer;
+  std::uint32_t id = 0;
+  std::string debugName;
+  std::size_t sizeBytes = 0;
+  // Buffers only.
+  BufferUsage usage = BufferUsage::Vertex;
+  // Textures only.
+  TextureFormat format = TextureFormat::RGBA8;
+  platform::Extent2D extent{};
+  std::uint32_t mipLevels = 0;
+  std::uint32_t firstResidentMip = 0;
+  // Shaders only.
+  ShaderStage stage = ShaderStage::Vertex;
+};
+
+// Counters for the most recently completed frame of any command context on a device.
+struct RenderFrameStats {
+  std::uint64_t frameIndex = 0;
+  std::uint32_t drawCalls = 0;
+  std::uint64_t triangles = 0;
+  std::uint32_t pipelineBinds = 0;
+  // Draws dropped because the bound pipeline was not Ready (still compiling, failed or unknown).
+  std::uint32_t drawsSkipped = 0;
+  // Destroyed resources still waiting for the GPU to finish the frames that may use them.
+  std::uint32_t pendingDestructions = 0;
+  // Driver state calls issued and skipped as redundant (OpenGL only).
+  std::uint32_t stateChangesIssued = 0;
+  std::uint32_t stateChangesFiltered = 0;
 };
 
 struct FrameGraphFrameInfo {
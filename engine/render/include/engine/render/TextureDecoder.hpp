@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "engine/platform/PlatformTypes.hpp"
+#include "engine/render/RenderTypes.hpp"
+
+namespace engine::render {
+
+// Decodes one mip level of a block-compressed format to tightly packed RGBA8. blocks holds
+// `layers` images (cube faces or volume slices) of ceil(w/4) x ceil(h/4) blocks each, as laid
+// out by textureMipByteSize(). BC5 decodes to (R, G, 0, 255). Throws std::runtime_error when the
+// format is not block-compressed or blocks is too small.
+[[nodiscard]] std::vector<std::byte> decodeTextureToRgba8(TextureFormat format,
+                                                          platform::Extent2D extent,
+                                                          std::uint32_t layers,
+                                                          std::span<const std::byte> blocks);
+
+} // namespace engine::render
@@ -0,0 +1,431 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "engine/core/MemoryTracker.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/render/IRenderDevice.hpp"
+#include "engine/render/RenderTypes.hpp"
+
+namespace engine::render {
+
+// Produces the tightly packed texels of one mip level (see IRenderDevice::updateTexture). Called
+// on a streamer worker thread, except for the coarse levels loaded by TextureStreamer::add().
+using TextureMipLoader = std::function<std::vector<std::byte>(std::uint32_t mipLevel)>;
+
+struct StreamedTextureDesc {
+  // mipLevels == 0 requests the full chain. firstResidentMip is managed by the streamer.
+  TextureCreateInfo createInfo{};
+  std::string debugName;
+  TextureMipLoader loadMip;
+};
+
+struct TextureStreamerConfig {
+  // Resident mip bytes across all streamed textures. 0 uses the GpuTexture budget configured on
+  // core::MemoryTracker; when that is 0 too, streaming is unbudgeted.
+  std::size_t budgetBytes = 0;
+  // 0 loads mips inline in update(), which is mostly useful for deterministic tests.
+  std::uint32_t workerCount = 2;
+  // Levels no larger than this many texels on their longest side are loaded by add() and are
+  // never evicted, so every texture can always be sampled.
+  std::uint32_t coarseMipTexels = 64;
+  std::uint32_t maxUploadsPerUpdate = 8;
+  std::uint32_t maxLoadsInFlight = 16;
+  // Updates without a request before a texture's demand falls back to its coarse levels.
+  std::uint32_t demandTimeoutUpdates = 60;
+};
+
+struct TextureStreamerStats {
+  std::size_t residentBytes = 0;
+  std::size_t budgetBytes = 0;
+  std::uint32_t textures = 0;
+  std::uint32_t loadsInFlight = 0;
+  std::uint64_t uploads = 0;
+  std::uint64_t evictions = 0;
+  std::uint64_t loadFailures = 0;
+};
+
+struct StreamedTextureId {
+  std::uint32_t id = 0;
+};
+
+// Streams texture mips by screen-space demand under a memory budget. Textures are created with
+// their full mip chain but only the coarse tail resident; finer levels are loaded on worker
+// threads one level at a time, uploaded in update() and released again when the budget is
+// needed for textures that are missing more detail. Everything except the mip loaders runs on
+// the device thread.
+class TextureStreamer {
+public:
+  explicit TextureStreamer(IRenderDevice& device, const TextureStreamerConfig& config = {})
+      : device_(device), config_(config) {
+    for (std::uint32_t workerIndex = 0; workerIndex < config_.workerCount; ++workerIndex) {
+      workers_.emplace_back([this, workerIndex] { workerLoop(workerIndex); });
+    }
+  }
+
+  ~TextureStreamer() {
+    {
+      std::lock_guard lock{queueMutex_};
+      stopping_ = true;
+    }
+    queueReady_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+    for (const auto& [id, texture] : textures_) {
+      device_.destroyTexture(texture.handle);
+    }
+  }
+
+  TextureStreamer(const TextureStreamer&) = delete;
+  TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+  // Creates the device texture and synchronously loads and uploads its coarse levels.
+  [[nodiscard]] StreamedTextureId add(StreamedTextureDesc desc) {
+    ENGINE_PROFILE_ZONE("TextureStreamer::add");
+    StreamedTexture texture{};
+    texture.info = desc.createInfo;
+    const std::uint32_t fullChain = fullMipChainLength(texture.info.extent, texture.info.depth);
+    texture.info.mipLevels = texture.info.mipLevels == 0 ? fullChain : std::min(texture.info.mipLevels, fullChain);
+    texture.info.debugName = desc.debugName;
+    texture.loader = std::make_shared<const TextureMipLoader>(std::move(desc.loadMip));
+
+    texture.coarseMip = texture.info.mipLevels - 1;
+    while (texture.coarseMip > 0 && mipLongestSide(texture.info, texture.coarseMip - 1) <= config_.coarseMipTexels) {
+      --texture.coarseMip;
+    }
+    texture.info.firstResidentMip = texture.coarseMip;
+    texture.residentMip = texture.coarseMip;
+    texture.wantedMip = texture.coarseMip;
+    texture.requestedMip = texture.coarseMip;
+    texture.handle = device_.createTexture(texture.info);
+    texture.info.debugName = {};
+    for (std::uint32_t level = texture.coarseMip; level < texture.info.mipLevels; ++level) {
+      device_.updateTexture(texture.handle, level, (*texture.loader)(level));
+    }
+    residentBytes_ += textureByteSize(texture.info, texture.residentMip);
+
+    const StreamedTextureId id{nextId_++};
+    textures_.emplace(id.id, std::move(texture));
+    return id;
+  }
+
+  void remove(const StreamedTextureId id) {
+    const auto it = textures_.find(id.id);
+    if (it == textures_.end()) {
+      return;
+    }
+
+    {
+      std::lock_guard lock{queueMutex_};
+      const auto queued = std::remove_if(jobs_.begin(), jobs_.end(), [id](const LoadJob& job) { return job.textureId == id.id; });
+      for (auto job = queued; job != jobs_.end(); ++job) {
+        reservedBytes_ -= job->bytes;
+        --loadsInFlight_;
+      }
+      jobs_.erase(queued, jobs_.end());
+    }
+    residentBytes_ -= textureByteSize(it->second.info, it->second.residentMip);
+    device_.destroyTexture(it->second.handle);
+    textures_.erase(it);
+  }
+
+  // Reports that the texture covers about `pixels` screen pixels along its longest axis this
+  // frame. The finest request since the previous update() wins.
+  void requestScreenSize(const StreamedTextureId id, const float pixels) {
+    const auto it = textures_.find(id.id);
+    if (it == textures_.end()) {
+      return;
+    }
+
+    StreamedTexture& texture = it->second;
+    const float longestSide = static_cast<float>(mipLongestSide(texture.info, 0));
+    const float ratio = longestSide / std::max(pixels, 1.0f);
+    const auto mip = ratio <= 1.0f ? 0U : static_cast<std::uint32_t>(std::floor(std::log2(ratio)));
+    texture.requestedMip = std::min({texture.requestedMip, mip, texture.coarseMip});
+    texture.requestedThisUpdate = true;
+  }
+
+  // Uploads finished loads, applies this frame's demand and issues new loads. Call once per
+  // frame on the device thread, outside of any command recording.
+  void update() {
+    ENGINE_PROFILE_ZONE("TextureStreamer::update");
+    ++updateIndex_;
+    uploadCompletedLoads();
+    refreshDemand();
+    scheduleLoads();
+    ENGINE_PROFILE_COUNTER("Texture streaming resident MiB", static_cast<double>(residentBytes_) / (1024.0 * 1024.0));
+  }
+
+  [[nodiscard]] TextureHandle texture(const StreamedTextureId id) const {
+    const auto it = textures_.find(id.id);
+    return it == textures_.end() ? TextureHandle{} : it->second.handle;
+  }
+
+  [[nodiscard]] std::uint32_t residentMip(const StreamedTextureId id) const {
+    const auto it = textures_.find(id.id);
+    return it == textures_.end() ? 0 : it->second.residentMip;
+  }
+
+  [[nodiscard]] std::size_t budgetBytes() const {
+    if (config_.budgetBytes != 0) {
+      return config_.budgetBytes;
+    }
+    return core::MemoryTracker::instance().usage(core::MemoryTag::GpuTexture).budgetBytes;
+  }
+
+  [[nodiscard]] TextureStreamerStats stats() const {
+    TextureStreamerStats stats{};
+    stats.residentBytes = residentBytes_;
+    stats.budgetBytes = budgetBytes();
+    stats.textures = static_cast<std::uint32_t>(textures_.size());
+    stats.loadsInFlight = loadsInFlight_;
+    stats.uploads = uploads_;
+    stats.evictions = evictions_;
+    stats.loadFailures = loadFailures_;
+    return stats;
+  }
+
+private:
+  static constexpr std::uint32_t kNoLoad = std::numeric_limits<std::uint32_t>::max();
+
+  struct StreamedTexture {
+    TextureHandle handle{};
+    // debugName is cleared after creation; the device keeps its own copy.
+    TextureCreateInfo info{};
+    std::shared_ptr<const TextureMipLoader> loader;
+    std::uint32_t coarseMip = 0;
+    std::uint32_t residentMip = 0;
+    std::uint32_t wantedMip = 0;
+    std::uint32_t requestedMip = 0;
+    bool requestedThisUpdate = false;
+    std::uint64_t lastRequestUpdate = 0;
+    std::uint32_t loadingMip = kNoLoad;
+    // Levels finer than this failed to load and are not retried.
+    std::uint32_t finestLoadableMip = 0;
+  };
+
+  struct LoadJob {
+    std::uint32_t textureId = 0;
+    std::uint32_t mipLevel = 0;
+    std::size_t bytes = 0;
+    std::shared_ptr<const TextureMipLoader> loader;
+  };
+
+  struct LoadResult {
+    std::uint32_t textureId = 0;
+    std::uint32_t mipLevel = 0;
+    std::size_t bytes = 0;
+    std::optional<std::vector<std::byte>> texels;
+  };
+
+  [[nodiscard]] static std::uint32_t mipLongestSide(const TextureCreateInfo& info, const std::uint32_t level) {
+    const std::uint32_t depth = info.dimension == TextureDimension::Texture3D ? info.depth : 1U;
+    return std::max({info.extent.width >> level, info.extent.height >> level, depth >> level, 1U});
+  }
+
+  [[nodiscard]] static LoadResult runLoad(const LoadJob& job) {
+    ENGINE_PROFILE_ZONE("TextureStreamer::loadMip");
+    LoadResult result{job.textureId, job.mipLevel, job.bytes, std::nullopt};
+    try {
+      result.texels = (*job.loader)(job.mipLevel);
+    } catch (const std::exception&) {
+      result.texels.reset();
+    }
+    return result;
+  }
+
+  void workerLoop([[maybe_unused]] const std::uint32_t workerIndex) {
+    ENGINE_PROFILE_THREAD_NAME("texture streamer " + std::to_string(workerIndex));
+    while (true) {
+      LoadJob job{};
+      {
+        std::unique_lock lock{queueMutex_};
+        queueReady_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (stopping_) {
+          return;
+        }
+        job = std::move(jobs_.front());
+        jobs_.pop_front();
+      }
+
+      LoadResult result = runLoad(job);
+      std::lock_guard lock{queueMutex_};
+      completed_.push_back(std::move(result));
+    }
+  }
+
+  void uploadCompletedLoads() {
+    {
+      std::lock_guard lock{queueMutex_};
+      for (auto& result : completed_) {
+        pendingUploads_.push_back(std::move(result));
+      }
+      completed_.clear();
+    }
+
+    std::uint32_t uploads = 0;
+    while (!pendingUploads_.empty() && uploads < config_.maxUploadsPerUpdate) {
+      LoadResult result = std::move(pendingUploads_.front());
+      pendingUploads_.pop_front();
+      reservedBytes_ -= result.bytes;
+      --loadsInFlight_;
+
+      const auto it = textures_.find(result.textureId);
+      if (it == textures_.end()) {
+        continue;
+      }
+      StreamedTexture& texture = it->second;
+      texture.loadingMip = kNoLoad;
+      if (!result.texels.has_value() || result.texels->size() != textureMipByteSize(texture.info, result.mipLevel)) {
+        ++loadFailures_;
+        texture.finestLoadableMip = std::max(texture.finestLoadableMip, result.mipLevel + 1);
+        continue;
+      }
+      // Evicted while loading: the level no longer extends the resident range.
+      if (result.mipLevel + 1 != texture.residentMip) {
+        continue;
+      }
+
+      device_.updateTexture(texture.handle, result.mipLevel, *result.texels);
+      device_.setTextureResidency(texture.handle, result.mipLevel);
+      texture.residentMip = result.mipLevel;
+      residentBytes_ += result.bytes;
+      ++uploads_;
+      ++uploads;
+    }
+  }
+
+  void refreshDemand() {
+    for (auto& [id, texture] : textures_) {
+      if (texture.requestedThisUpdate) {
+        texture.wantedMip = texture.requestedMip;
+        texture.lastRequestUpdate = updateIndex_;
+      } else if (updateIndex_ - texture.lastRequestUpdate > config_.demandTimeoutUpdates) {
+        texture.wantedMip = texture.coarseMip;
+      }
+      texture.requestedMip = texture.coarseMip;
+      texture.requestedThisUpdate = false;
+    }
+  }
+
+  // Drops the finest resident level of textures holding more detail than they currently want,
+  // preferring the largest surplus and then the least recently requested, until `bytes` fit.
+  [[nodiscard]] bool makeRoom(const std::size_t bytes, const std::size_t budget) {
+    if (residentBytes_ + reservedBytes_ + bytes <= budget) {
+      return true;
+    }
+
+    std::vector<StreamedTexture*> victims;
+    for (auto& [id, texture] : textures_) {
+      if (texture.residentMip < texture.wantedMip) {
+        victims.push_back(&texture);
+      }
+    }
+    std::sort(victims.begin(), victims.end(), [](const StreamedTexture* left, const StreamedTexture* right) {
+      const std::uint32_t leftSurplus = left->wantedMip - left->residentMip;
+      const std::uint32_t rightSurplus = right->wantedMip - right->residentMip;
+      if (leftSurplus != rightSurplus) {
+        return leftSurplus > rightSurplus;
+      }
+      return left->lastRequestUpdate < right->lastRequestUpdate;
+    });
+
+    for (StreamedTexture* victim : victims) {
+      while (victim->residentMip < victim->wantedMip && residentBytes_ + reservedBytes_ + bytes > budget) {
+        residentBytes_ -= textureMipByteSize(victim->info, victim->residentMip);
+        ++victim->residentMip;
+        device_.setTextureResidency(victim->handle, victim->residentMip);
+        ++evictions_;
+      }
+      if (residentBytes_ + reservedBytes_ + bytes <= budget) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void scheduleLoads() {
+    std::vector<std::pair<std::uint32_t, StreamedTexture*>> candidates;
+    for (auto& [id, texture] : textures_) {
+      if (texture.loadingMip == kNoLoad && texture.residentMip > texture.wantedMip &&
+          texture.residentMip > texture.finestLoadableMip) {
+        candidates.emplace_back(id, &texture);
+      }
+    }
+    // Largest detail deficit first, then the most recently requested.
+    std::sort(candidates.begin(), candidates.end(), [](const auto& left, const auto& right) {
+      const std::uint32_t leftDeficit = left.second->residentMip - left.second->wantedMip;
+      const std::uint32_t rightDeficit = right.second->residentMip - right.second->wantedMip;
+      if (leftDeficit != rightDeficit) {
+        return leftDeficit > rightDeficit;
+      }
+      return left.second->lastRequestUpdate > right.second->lastRequestUpdate;
+    });
+
+    const std::size_t budget = budgetBytes() == 0 ? std::numeric_limits<std::size_t>::max() : budgetBytes();
+    for (const auto& [id, texture] : candidates) {
+      if (loadsInFlight_ >= config_.maxLoadsInFlight) {
+        break;
+      }
+      const std::uint32_t level = texture->residentMip - 1;
+      const std::size_t bytes = textureMipByteSize(texture->info, level);
+      if (!makeRoom(bytes, budget)) {
+        break;
+      }
+
+      texture->loadingMip = level;
+      reservedBytes_ += bytes;
+      ++loadsInFlight_;
+      LoadJob job{id, level, bytes, texture->loader};
+      if (workers_.empty()) {
+        pendingUploads_.push_back(runLoad(job));
+        continue;
+      }
+      {
+        std::lock_guard lock{queueMutex_};
+        jobs_.push_back(std::move(job));
+      }
+      queueReady_.notify_one();
+    }
+  }
+
+  IRenderDevice& device_;
+  TextureStreamerConfig config_;
+  std::unordered_map<std::uint32_t, StreamedTexture> textures_;
+  std::uint32_t nextId_ = 1;
+  std::uint64_t updateIndex_ = 0;
+  std::size_t residentBytes_ = 0;
+  // Bytes of levels being loaded, counted against the budget before they arrive.
+  std::size_t reservedBytes_ = 0;
+  std::uint32_t loadsInFlight_ = 0;
+  std::uint64_t uploads_ = 0;
+  std::uint64_t evictions_ = 0;
+  std::uint64_t loadFailures_ = 0;
+  std::deque<LoadResult> pendingUploads_;
+
+  std::mutex queueMutex_;
+  std::condition_variable queueReady_;
+  std::deque<LoadJob> jobs_;
+  std::vector<LoadResult> completed_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+} // namespace engine::render
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace engine::render {
+
+inline constexpr std::uint64_t kDefaultTransientRingBytes = 8ULL * 1024 * 1024;
+
+// Offset bookkeeping for a ring of per-frame transient allocations (see
+// IRenderDevice::allocateTransient()). Allocations are taken at the head and released a whole
+// frame at a time, oldest first, once the backend knows nothing reads that frame any more.
+// Storage and GPU fencing belong to the backend. Not thread-safe.
+class TransientRingAllocator {
+public:
+  explicit TransientRingAllocator(const std::uint64_t capacity = kDefaultTransientRingBytes)
+      : capacity_(capacity) {
+    if (capacity_ == 0) {
+      throw std::runtime_error("TransientRingAllocator capacity must be non-zero");
+    }
+  }
+
+  // std::nullopt when the ring has no room until older frames are retired. alignment must be a
+  // power of two; skipping the tail end of the ring on wrap-around counts against the frame.
+  [[nodiscard]] std::optional<std::uint64_t> tryAllocate(const std::uint64_t sizeBytes, const std::uint64_t alignment) {
+    assert(std::has_single_bit(alignment));
+    std::uint64_t offset = (head_ + alignment - 1) & ~(alignment - 1);
+    std::uint64_t padding = offset - head_;
+    if (offset + sizeBytes > capacity_) {
+      padding = capacity_ - head_;
+      offset = 0;
+    }
+    if (sizeBytes > capacity_ || padding + sizeBytes > capacity_ - usedBytes_) {
+      return std::nullopt;
+    }
+    head_ = (offset + sizeBytes) % capacity_;
+    usedBytes_ += padding + sizeBytes;
+    frameBytes_ += padding + sizeBytes;
+    return offset;
+  }
+
+  // Closes the current frame; its bytes stay in use until it is retired.
+  void endFrame() {
+    frames_.push_back(frameBytes_);
+    frameBytes_ = 0;
+  }
+
+  void retireOldestFrame() {
+    if (frames_.empty()) {
+      throw std::runtime_error("TransientRingAllocator has no frame to retire");
+    }
+    usedBytes_ -= frames_.front();
+    frames_.pop_front();
+    // An empty ring starts over at offset 0, so the next allocation does not pay wrap-around padding.
+    if (usedBytes_ == 0) {
+      head_ = 0;
+    }
+  }
+
+  [[nodiscard]] std::size_t framesInFlight() const { return frames_.size(); }
+  [[nodiscard]] std::uint64_t capacity() const { return capacity_; }
+  [[nodiscard]] std::uint64_t head() const { return head_; }
+  [[nodiscard]] std::uint64_t usedBytes() const { return usedBytes_; }
+  [[nodiscard]] std::uint64_t frameBytes() const { return frameBytes_; }
+
+  [[nodiscard]] std::string exhaustedMessage(const std::uint64_t sizeBytes) const {
+    return "Transient allocation of " + std::to_string(sizeBytes) + " bytes does not fit in the " + std::to_string(capacity_) +
+           "-byte ring (" + std::to_string(frameBytes_) + " bytes used this frame)";
+  }
+
+private:
+  std::uint64_t capacity_ = 0;
+  std::uint64_t head_ = 0;
+  std::uint64_t usedBytes_ = 0;
+  std::uint64_t frameBytes_ = 0;
+  std::deque<std::uint64_t> frames_;
+};
+
+} // namespace engine::render
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <memory>
+
+namespace engine::render {
+
+class IRenderBackend;
+
+// A backend that validates and counts every call but never touches a GPU. Use it to measure the
+// engine-side CPU cost of a frame (scene update, culling, command recording) in isolation, and
+// to run render code on machines without a display.
+[[nodiscard]] std::unique_ptr<IRenderBackend> createNullRenderBackend();
+
+} // namespace engine::render
@@ -0,0 +1,339 @@
+#include "engine/render/null/NullRenderBackend.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "engine/render/ICommandContext.hpp"
+#include "engine/render/IRenderBackend.hpp"
+#include "engine/render/IRenderDevice.hpp"
+#include "engine/render/RenderStats.hpp"
+#include "engine/render/TransientRingAllocator.hpp"
+
+namespace engine::render {
+namespace {
+
+class NullRenderDevice;
+
+class NullCommandContext final : public ICommandContext {
+public:
+  NullCommandContext(NullRenderDevice& device, RenderStatsCounters& stats, TransientRingAllocator& transientRing)
+      : device_(device), stats_(stats), transientRing_(transientRing) {}
+
+  void beginFrame(const FrameGraphFrameInfo& frameInfo) override {
+    frameIndex_ = frameInfo.frameIndex;
+    counters_ = {};
+  }
+
+  // Nothing reads transient data after the frame, so its ring space is free again immediately.
+  void endFrame() override {
+    transientRing_.endFrame();
+    transientRing_.retireOldestFrame();
+    stats_.publish(frameIndex_, counters_);
+  }
+
+  void beginPass(const std::string_view name) override { (void)name; }
+  void endPass() override {}
+
+  // Defined after NullRenderDevice, which knows the live pipelines.
+  void bindPipeline(PipelineHandle pipeline) override;
+
+  void bindVertexBuffer(const BufferHandle buffer, const std::uint64_t offset) override {
+    (void)buffer;
+    (void)offset;
+  }
+
+  void bindIndexBuffer(const BufferHandle buffer, const std::uint64_t offset) override {
+    (void)buffer;
+    (void)offset;
+  }
+
+  void bindUniformBuffer(const std::uint32_t binding,
+                         const BufferHandle buffer,
+                         const std::uint64_t offset,
+                         const std::uint64_t sizeBytes) override {
+    (void)binding;
+    (void)buffer;
+    (void)offset;
+    (void)sizeBytes;
+  }
+
+  void draw(const std::uint32_t vertexCount,
+            const std::uint32_t instanceCount,
+            const std::uint32_t firstVertex,
+            const std::uint32_t firstInstance) override {
+    (void)firstVertex;
+    (void)firstInstance;
+    if (!pipelineReady_) {
+      ++counters_.drawsSkipped;
+      return;
+    }
+    if (instanceCount == 0) {
+      return;
+    }
+    counters_.countDraw(topology_, vertexCount, instanceCount);
+  }
+
+  void drawIndexed(const std::uint32_t indexCount,
+                   const std::uint32_t instanceCount,
+                   const std::uint32_t firstIndex,
+                   const std::int32_t vertexOffset,
+                   const std::uint32_t firstInstance) override {
+    (void)firstIndex;
+    (void)vertexOffset;
+    (void)firstInstance;
+    if (!pipelineReady_) {
+      ++counters_.drawsSkipped;
+      return;
+    }
+    if (instanceCount == 0) {
+      return;
+    }
+    counters_.countDraw(topology_, indexCount, instanceCount);
+  }
+
+private:
+  NullRenderDevice& device_;
+  RenderStatsCounters& stats_;
+  TransientRingAllocator& transientRing_;
+  std::uint64_t frameIndex_ = 0;
+  FrameDrawCounters counters_{};
+  PrimitiveTopology topology_ = PrimitiveTopology::TriangleList;
+  bool pipelineReady_ = false;
+};
+
+// Resources exist only as bookkeeping records so handles, resources() and updateBuffer() range
+// checks behave like a real device. No memory is charged to the MemoryTracker.
+class NullRenderDevice final : public IRenderDevice {
+public:
+  [[nodiscard]] std::unique_ptr<ICommandContext> createCommandContext() override {
+    return std::make_unique<NullCommandContext>(*this, stats_, transientRing_);
+  }
+
+  [[nodiscard]] BufferHandle createBuffer(const BufferCreateInfo& createInfo) override {
+    RenderResourceInfo info{};
+    info.kind = RenderResourceKind::Buffer;
+    info.debugName = std::string{createInfo.debugName};
+    info.sizeBytes = static_cast<std::size_t>(createInfo.sizeBytes);
+    info.usage = createInfo.usage;
+    return BufferHandle{addRecord(std::move(info))};
+  }
+
+  void destroyBuffer(const BufferHandle handle) override {
+    if (handle.id != transientBuffer_.id) {
+      removeRecord(RenderResourceKind::Buffer, handle.id);
+    }
+  }
+
+  void updateBuffer(const BufferHandle handle, const std::uint64_t offset, const std::span<const std::byte> data) override {
+    std::lock_guard lock{recordsMutex_};
+    const auto it = records_.find(recordKey(RenderResourceKind::Buffer, handle.id));
+    if (it == records_.end()) {
+      throw std::runtime_error("updateBuffer called with an unknown buffer handle");
+    }
+    if (offset + data.size() > it->second.sizeBytes) {
+      throw std::runtime_error("updateBuffer range exceeds buffer '" + it->second.debugName + "'");
+    }
+  }
+
+  // There is no transfer to wait for; uploads complete as soon as they are validated.
+  [[nodiscard]] UploadTicket queueBufferUpload(const BufferHandle handle,
+                                               const std::uint64_t offset,
+                                               const std::span<const std::byte> data) override {
+    updateBuffer(handle, offset, data);
+    return UploadTicket{++lastUploadTicket_};
+  }
+
+  [[nodiscard]] bool uploadComplete(const UploadTicket ticket) override { return ticket.id <= lastUploadTicket_; }
+
+  // Allocations are backed by real memory so callers can write them as on any other device.
+  [[nodiscard]] TransientAllocation allocateTransient(const std::uint64_t sizeBytes, const std::uint64_t alignment) override {
+    if (transientStorage_.empty()) {
+      transientStorage_.resize(static_cast<std::size_t>(transientRing_.capacity()));
+      RenderResourceInfo info{};
+      info.kind = RenderResourceKind::Buffer;
+      info.debugName = "transient ring";
+      info.sizeBytes = transientStorage_.size();
+      info.usage = BufferUsage::Uniform;
+      transientBuffer_ = BufferHandle{addRecord(std::move(info))};
+    }
+    const std::optional<std::uint64_t> offset = transientRing_.tryAllocate(sizeBytes, alignment);
+    if (!offset.has_value()) {
+      throw std::runtime_error(transientRing_.exhaustedMessage(sizeBytes));
+    }
+    return TransientAllocation{transientBuffer_, *offset,
+                               std::span<std::byte>{transientStorage_.data() + *offset, static_cast<std::size_t>(sizeBytes)}};
+  }
+
+  [[nodiscard]] bool supportsTextureFormat(const TextureFormat format) const override {
+    (void)format;
+    return true;
+  }
+
+  [[nodiscard]] TextureHandle createTexture(const TextureCreateInfo& createInfo) override {
+    RenderResourceInfo info{};
+    info.kind = RenderResourceKind::Texture;
+    info.debugName = std::string{createInfo.debugName};
+    info.format = createInfo.format;
+    info.extent = createInfo.extent;
+    info.mipLevels = textureMipCount(createInfo);
+    info.firstResidentMip = std::min(createInfo.firstResidentMip, textureMipCount(createInfo) - 1);
+    info.sizeBytes = textureByteSize(createInfo, info.firstResidentMip);
+
+    TextureCreateInfo layout = createInfo;
+    layout.debugName = {};
+    const std::uint32_t id = addRecord(std::move(info));
+    std::lock_guard lock{recordsMutex_};
+    textureLayouts_.emplace(id, layout);
+    return TextureHandle{id};
+  }
+
+  void destroyTexture(const TextureHandle handle) override {
+    removeRecord(RenderResourceKind::Texture, handle.id);
+    std::lock_guard lock{recordsMutex_};
+    textureLayouts_.erase(handle.id);
+  }
+
+  void updateTexture(const TextureHandle handle, const std::uint32_t mipLevel, const std::span<const std::byte> texels) override {
+    std::lock_guard lock{recordsMutex_};
+    const auto it = textureLayouts_.find(handle.id);
+    if (it == textureLayouts_.end()) {
+      throw std::runtime_error("updateTexture called with an unknown texture handle");
+    }
+    if (mipLevel >= textureMipCount(it->second) || texels.size() != textureMipByteSize(it->second, mipLevel)) {
+      throw std::runtime_error("updateTexture level " + std::to_string(mipLevel) + " does not match texture " +
+                               std::to_string(handle.id));
+    }
+  }
+
+  void setTextureResidency(const TextureHandle handle, const std::uint32_t firstResidentMip) override {
+    std::lock_guard lock{recordsMutex_};
+    const auto layout = textureLayouts_.find(handle.id);
+    const auto record = records_.find(recordKey(RenderResourceKind::Texture, handle.id));
+    if (layout == textureLayouts_.end() || record == records_.end()) {
+      return;
+    }
+    record->second.firstResidentMip = std::min(firstResidentMip, textureMipCount(layout->second) - 1);
+    record->second.sizeBytes = textureByteSize(layout->second, record->second.firstResidentMip);
+  }
+
+  [[nodiscard]] ShaderHandle createShader(const ShaderCreateInfo& createInfo) override {
+    RenderResourceInfo info{};
+    info.kind = RenderResourceKind::Shader;
+    info.debugName = std::string{createInfo.debugName};
+    info.sizeBytes = createInfo.byteCodeSize;
+    info.stage = createInfo.stage;
+    return ShaderHandle{addRecord(std::move(info))};
+  }
+
+  void destroyShader(const ShaderHandle handle) override { removeRecord(RenderResourceKind::Shader, handle.id); }
+
+  [[nodiscard]] PipelineHandle createGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo) override {
+    {
+      std::lock_guard lock{recordsMutex_};
+      if (!records_.contains(recordKey(RenderResourceKind::Shader, createInfo.vertexShader.id)) ||
+          !records_.contains(recordKey(RenderResourceKind::Shader, createInfo.fragmentShader.id))) {
+        throw std::runtime_error("Null pipeline creation requires valid vertex and fragment shaders");
+      }
+    }
+    RenderResourceInfo info{};
+    info.kind = RenderResourceKind::Pipeline;
+    info.debugName = std::string{createInfo.debugName};
+    const std::uint32_t id = addRecord(std::move(info));
+    std::lock_guard lock{recordsMutex_};
+    pipelineTopologies_.emplace(id, createInfo.topology);
+    return PipelineHandle{id};
+  }
+
+  // Topology of a live pipeline (all of them are Ready), or nothing for unknown handles.
+  [[nodiscard]] std::optional<PrimitiveTopology> pipelineTopology(const PipelineHandle handle) const {
+    std::lock_guard lock{recordsMutex_};
+    const auto it = pipelineTopologies_.find(handle.id);
+    if (it == pipelineTopologies_.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  [[nodiscard]] PipelineStatus pipelineStatus(const PipelineHandle handle) override {
+    std::lock_guard lock{recordsMutex_};
+    return records_.contains(recordKey(RenderResourceKind::Pipeline, handle.id)) ? PipelineStatus::Ready : PipelineStatus::Failed;
+  }
+
+  void destroyPipeline(const PipelineHandle handle) override {
+    removeRecord(RenderResourceKind::Pipeline, handle.id);
+    std::lock_guard lock{recordsMutex_};
+    pipelineTopologies_.erase(handle.id);
+  }
+
+  [[nodiscard]] std::vector<RenderResourceInfo> resources() const override {
+    std::lock_guard lock{recordsMutex_};
+    std::vector<RenderResourceInfo> result;
+    result.reserve(records_.size());
+    for (const auto& [key, info] : records_) {
+      result.push_back(info);
+    }
+    return result;
+  }
+
+  [[nodiscard]] RenderFrameStats frameStats() const override { return stats_.snapshot(); }
+
+private:
+  [[nodiscard]] static std::uint64_t recordKey(const RenderResourceKind kind, const std::uint32_t id) {
+    return (static_cast<std::uint64_t>(kind) << 32U) | id;
+  }
+
+  [[nodiscard]] std::uint32_t addRecord(RenderResourceInfo info) {
+    std::lock_guard lock{recordsMutex_};
+    info.id = nextHandle_++;
+    const std::uint32_t id = info.id;
+    records_.emplace(recordKey(info.kind, id), std::move(info));
+    return id;
+  }
+
+  void removeRecord(const RenderResourceKind kind, const std::uint32_t id) {
+    std::lock_guard lock{recordsMutex_};
+    records_.erase(recordKey(kind, id));
+  }
+
+  RenderStatsCounters stats_;
+  mutable std::mutex recordsMutex_;
+  std::uint32_t nextHandle_ = 1;
+  std::unordered_map<std::uint64_t, RenderResourceInfo> records_;
+  std::unordered_map<std::uint32_t, TextureCreateInfo> textureLayouts_;
+  std::unordered_map<std::uint32_t, PrimitiveTopology> pipelineTopologies_;
+  std::uint64_t lastUploadTicket_ = 0;
+  TransientRingAllocator transientRing_;
+  std::vector<std::byte> transientStorage_;
+  BufferHandle transientBuffer_{};
+};
+
+void NullCommandContext::bindPipeline(const PipelineHandle pipeline) {
+  ++counters_.pipelineBinds;
+  const std::optional<PrimitiveTopology> topology = device_.pipelineTopology(pipeline);
+  pipelineReady_ = topology.has_value();
+  if (pipelineReady_) {
+    topology_ = *topology;
+  }
+}
+
+class NullRenderBackend final : public IRenderBackend {
+public:
+  [[nodiscard]] std::string_view name() const override { return "Null"; }
+
+  [[nodiscard]] std::unique_ptr<IRenderDevice> createDevice() override { return std::make_unique<NullRenderDevice>(); }
+};
+
+} // namespace
+
+std::unique_ptr<IRenderBackend> createNullRenderBackend() {
+  return std::make_unique<NullRenderBackend>();
+}
+
+} // namespace engine::render
@@ -1,11 +1,376 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "engine/core/MemoryTracker.hpp"
+#include "engine/render/ProgramBinaryCache.hpp"
+#include "engine/render/RenderTypes.hpp"
+#include "engine/render/TransientRingAllocator.hpp"
 
 namespace engine::render {
 
 class IRenderBackend;
+class IRenderDevice;
+
+inline constexpr std::uint64_t kDefaultUploadStagingBytes = 32ULL * 1024 * 1024;
+inline constexpr std::uint64_t kDefaultUploadBudgetBytes = 4ULL * 1024 * 1024;
+
+struct OpenGlRenderBackendConfig {
+  // Directory for linked program binaries (see ProgramBinaryCache); empty disables the cache.
+  std::string programCacheDirectory;
+  // Capacity of the ring behind IRenderDevice::allocateTransient().
+  std::uint64_t transientRingBytes = kDefaultTransientRingBytes;
+  // Staging memory and per-frame transfer budget of IRenderDevice::queueBufferUpload(); a budget
+  // of 0 transfers everything queued at the next frame.
+  std::uint64_t uploadStagingBytes = kDefaultUploadStagingBytes;
+  std::uint64_t uploadBudgetBytes = kDefaultUploadBudgetBytes;
+  // Use direct state access when the driver has it (see openGlDirectStateAccessSupported()); false
+  // forces the GL 3.3 bind-to-edit path.
+  bool useDirectStateAccess = true;
+};
+
+// Shader and pipeline deduplication counters; a hit returned an existing ref-counted handle.
+struct PipelineDedupStats {
+  std::uint64_t shaderRequests = 0;
+  std::uint64_t shaderHits = 0;
+  std::uint64_t pipelineRequests = 0;
+  std::uint64_t pipelineHits = 0;
+
+  [[nodiscard]] double shaderHitRate() const {
+    return shaderRequests == 0 ? 0.0 : static_cast<double>(shaderHits) / static_cast<double>(shaderRequests);
+  }
+  [[nodiscard]] double pipelineHitRate() const {
+    return pipelineRequests == 0 ? 0.0 : static_cast<double>(pipelineHits) / static_cast<double>(pipelineRequests);
+  }
+};
+
+// The GL helpers below back the OpenGL device and its command contexts, which own one of each (the
+// transient ring behind allocateTransient(), the upload queue behind queueBufferUpload(), and so
+// on). Code that drives GL directly can own its own.
+
+// Ring buffer for per-frame dynamic data. With buffer storage (GL 4.4 or ARB_buffer_storage) the
+// buffer is persistently and coherently mapped, and endFrame() fences each frame so allocate() only
+// waits when the GPU still reads the space it needs. Without it, writes go to a CPU copy that
+// flush() uploads through an unsynchronized map, and wrapping around orphans the buffer. GL objects
+// are created by the first allocate(); every call needs the owning context current.
+class OpenGlTransientRing {
+public:
+  struct Allocation {
+    unsigned int buffer = 0;
+    std::uint64_t offset = 0;
+    std::span<std::byte> data;
+  };
+
+  explicit OpenGlTransientRing(std::uint64_t capacityBytes = kDefaultTransientRingBytes);
+  ~OpenGlTransientRing();
+
+  OpenGlTransientRing(const OpenGlTransientRing&) = delete;
+  OpenGlTransientRing& operator=(const OpenGlTransientRing&) = delete;
+
+  // alignment is raised to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT. Throws std::runtime_error when the
+  // request does not fit even after waiting for every older frame.
+  [[nodiscard]] Allocation allocate(std::uint64_t sizeBytes, std::uint64_t alignment = 16);
+  // Makes written allocations visible to GL; call before the draws that read them. Cheap when
+  // nothing is pending, and a no-op for the persistent mapping.
+  void flush();
+  // Closes the frame: everything allocated since the previous endFrame() is reused only after the
+  // GPU has passed this point.
+  void endFrame();
+
+  [[nodiscard]] bool persistentlyMapped() const { return mapped_ != nullptr; }
+  [[nodiscard]] std::uint64_t capacity() const { return allocator_.capacity(); }
+  // allocate() calls that had to block on a fence.
+  [[nodiscard]] std::uint64_t stalls() const { return stalls_; }
+
+private:
+  void create();
+  bool retireOldestFrame(bool wait);
+
+  TransientRingAllocator allocator_;
+  unsigned int buffer_ = 0;
+  std::uint64_t alignment_ = 0;
+  std::byte* mapped_ = nullptr;
+  // Fallback path only: CPU copy, the range not yet uploaded, where this frame's data starts and
+  // where the latest allocation ends (an allocation below it has wrapped around).
+  std::vector<std::byte> shadow_;
+  std::uint64_t dirtyBegin_ = 0;
+  std::uint64_t dirtyEnd_ = 0;
+  std::uint64_t frameBegin_ = 0;
+  std::uint64_t lastEnd_ = 0;
+  // GLsync per in-flight frame, oldest first (persistent path only).
+  std::deque<void*> frameFences_;
+  std::uint64_t stalls_ = 0;
+  core::TrackedAllocation memory_;
+};
+
+struct UploadQueueStats {
+  std::uint32_t pendingUploads = 0;
+  std::uint64_t pendingBytes = 0;
+  // Bytes transferred by the latest processFrame().
+  std::uint64_t bytesLastFrame = 0;
+  // enqueue() calls that had to wait for staging memory.
+  std::uint64_t stalls = 0;
+  // Uploads larger than the whole staging area, written with glBufferSubData instead.
+  std::uint64_t directUploads = 0;
+};
+
+// Staged buffer uploads. enqueue() copies into a staging buffer, persistently mapped on GL 4.4 or
+// with ARB_buffer_storage; processFrame() issues glCopyBufferSubData transfers up to the per-frame
+// budget, splitting large uploads, and fences them. Staging space is reused in FIFO order once a
+// fence signals. GL objects are created by the first enqueue(); every call needs the owning context
+// current.
+class OpenGlUploadQueue {
+public:
+  explicit OpenGlUploadQueue(std::uint64_t stagingBytes = kDefaultUploadStagingBytes,
+                             std::uint64_t frameBudgetBytes = kDefaultUploadBudgetBytes);
+  ~OpenGlUploadQueue();
+
+  OpenGlUploadQueue(const OpenGlUploadQueue&) = delete;
+  OpenGlUploadQueue& operator=(const OpenGlUploadQueue&) = delete;
+
+  // buffer is a GL buffer name with storage for [offset, offset + data.size()). Immutable storage
+  // needs GL_DYNAMIC_STORAGE_BIT for uploads larger than the staging area, which bypass it.
+  [[nodiscard]] UploadTicket enqueue(unsigned int buffer, std::uint64_t offset, std::span<const std::byte> data);
+  // Call once per frame before drawing.
+  void processFrame();
+  // Non-blocking; polls the transfer fences.
+  [[nodiscard]] bool complete(UploadTicket ticket);
+  // Drops the not yet transferred parts of uploads into buffer, e.g. before deleting it.
+  void cancel(unsigned int buffer);
+
+  [[nodiscard]] UploadQueueStats stats() const;
+
+private:
+  struct PendingUpload {
+    UploadTicket ticket{};
+    unsigned int buffer = 0;
+    std::uint64_t offset = 0;
+    std::uint64_t stagingOffset = 0;
+    std::uint64_t sizeBytes = 0;
+    std::uint64_t transferredBytes = 0;
+  };
+
+  struct TransferBatch {
+    void* fence = nullptr; // GLsync
+    // Uploads whose last bytes are in this batch; their staging is released with it.
+    std::uint32_t finishedUploads = 0;
+    UploadTicket lastFinished{};
+  };
+
+  void create();
+  std::uint64_t issue(std::uint64_t budgetBytes);
+  bool retireOldestBatch(bool wait);
+
+  TransientRingAllocator staging_;
+  std::uint64_t frameBudgetBytes_ = 0;
+  unsigned int stagingBuffer_ = 0;
+  std::byte* mapped_ = nullptr;
+  std::deque<PendingUpload> pending_;
+  std::deque<TransferBatch> inFlight_;
+  std::uint64_t nextTicket_ = 1;
+  std::uint64_t completedThrough_ = 0;
+  std::uint64_t bytesLastFrame_ = 0;
+  std::uint64_t stalls_ = 0;
+  std::uint64_t directUploads_ = 0;
+  bool directStateAccess_ = false;
+  core::TrackedAllocation memory_;
+};
+
+// GL calls a state cache issued to the driver and skipped as redundant since the last takeCounters().
+struct GlStateCacheCounters {
+  std::uint32_t issued = 0;
+  std::uint32_t filtered = 0;
+};
+
+// Shadow copy of the GL binding and fixed-function state the engine sets, so calls that would not
+// change anything are skipped. State starts unknown, and invalidate() returns to that after
+// anything else (e.g. UI rendering) touched GL behind the cache's back. Call the forget*()
+// functions before deleting an object so a recycled name is rebound. Buffer targets other than
+// array, element, uniform and shader-storage pass through uncached; so do texture targets other
+// than 2D, 3D and cube maps.
+class OpenGlStateCache {
+public:
+  static constexpr std::uint32_t kTextureUnits = 32;
+
+  OpenGlStateCache() { invalidate(); }
+
+  void useProgram(unsigned int program);
+  // The element-array binding belongs to the vertex array, so changing it resets that entry.
+  void bindVertexArray(unsigned int vertexArray);
+  void bindBuffer(unsigned int target, unsigned int buffer);
+  // Indexed uniform binding; sizeBytes == 0 binds the whole buffer.
+  void bindUniformBuffer(std::uint32_t binding, unsigned int buffer, std::uint64_t offset, std::uint64_t sizeBytes);
+  void bindTexture(std::uint32_t unit, unsigned int target, unsigned int texture);
+  // Cached for GL_DEPTH_TEST, GL_BLEND and GL_CULL_FACE.
+  void setEnabled(unsigned int capability, bool enabled);
+  void setBlendFunc(unsigned int sourceFactor, unsigned int destinationFactor);
+  void setDepthFunc(unsigned int function);
+  void setViewport(int x, int y, int width, int height);
+
+  void forgetProgram(unsigned int program);
+  void forgetVertexArray(unsigned int vertexArray);
+  void forgetBuffer(unsigned int buffer);
+  void forgetTexture(unsigned int texture);
+  void invalidate();
+
+  [[nodiscard]] GlStateCacheCounters takeCounters();
+
+private:
+  static constexpr unsigned int kUnknown = ~0U;
+  static constexpr std::size_t kBufferTargets = 4;
+  static constexpr std::size_t kTextureTargets = 3;
+  static constexpr std::size_t kCapabilities = 3;
+
+  struct UniformBinding {
+    unsigned int buffer = kUnknown;
+    std::uint64_t offset = 0;
+    std::uint64_t sizeBytes = 0;
+  };
+
+  // True when the call must be issued; counts it either way.
+  [[nodiscard]] bool change(unsigned int& cached, unsigned int value);
+
+  unsigned int program_ = kUnknown;
+  unsigned int vertexArray_ = kUnknown;
+  unsigned int buffers_[kBufferTargets]{};
+  std::vector<UniformBinding> uniformBindings_;
+  unsigned int activeTextureUnit_ = kUnknown;
+  unsigned int textures_[kTextureUnits][kTextureTargets]{};
+  unsigned int capabilities_[kCapabilities]{};
+  unsigned int blendFunc_[2]{};
+  unsigned int depthFunc_ = kUnknown;
+  int viewport_[4]{};
+  bool viewportKnown_ = false;
+  GlStateCacheCounters counters_{};
+};
+
+enum class GlObjectKind : std::uint8_t { Buffer, Texture, Program, VertexArray };
+
+// GL objects destroyed while submitted frames may still read them. Deleting them right away makes
+// the driver synchronize, so each one waits for the fence of the frame it was retired in (the frame
+// being recorded, or the next one between frames) and is deleted by a later endFrame(). Their
+// tracked memory is released with them. A state cache, when given, forgets each name as it is
+// deleted. Every call needs the owning context current.
+class OpenGlDeferredDeletionQueue {
+public:
+  explicit OpenGlDeferredDeletionQueue(OpenGlStateCache* stateCache = nullptr) : stateCache_(stateCache) {}
+  // Deletes everything still pending without waiting.
+  ~OpenGlDeferredDeletionQueue();
+
+  OpenGlDeferredDeletionQueue(const OpenGlDeferredDeletionQueue&) = delete;
+  OpenGlDeferredDeletionQueue& operator=(const OpenGlDeferredDeletionQueue&) = delete;
+
+  void retire(GlObjectKind kind, unsigned int name, core::TrackedAllocation memory = {});
+  // Call once per frame after its commands have been submitted.
+  void endFrame();
+
+  // Objects waiting for their frame's fence.
+  [[nodiscard]] std::uint32_t size() const { return static_cast<std::uint32_t>(pending_.size()); }
+
+private:
+  struct PendingDeletion {
+    GlObjectKind kind = GlObjectKind::Buffer;
+    unsigned int name = 0;
+    std::uint64_t frame = 0;
+    core::TrackedAllocation memory;
+  };
+
+  struct FrameFence {
+    std::uint64_t frame = 0;
+    void* fence = nullptr; // GLsync
+  };
+
+  void deleteObject(const PendingDeletion& object);
+
+  OpenGlStateCache* stateCache_ = nullptr;
+  std::deque<PendingDeletion> pending_;
+  std::deque<FrameFence> fences_;
+  std::uint64_t nextFrame_ = 0;
+  std::uint64_t completedFrames_ = 0;
+};
+
+// GL_TIMESTAMP queries around each frame and the passes in it, reported to core::Profiler as the
+// frame's GPU time and GPU zones. Query sets rotate across kFramesInFlight frames and are only read
+// back once GL reports them available, so profiling never stalls the pipeline; a set that is still
+// in flight when it comes around again is dropped and its frame keeps no GPU time. Pass names are
+// interned. Every call needs the owning context current, and all of them do nothing unless
+// ENGINE_ENABLE_PROFILING is set.
+class OpenGlTimestampProfiler {
+public:
+  OpenGlTimestampProfiler() = default;
+  ~OpenGlTimestampProfiler();
+
+  OpenGlTimestampProfiler(const OpenGlTimestampProfiler&) = delete;
+  OpenGlTimestampProfiler& operator=(const OpenGlTimestampProfiler&) = delete;
+
+  // Opens the frame's "GPU frame" zone for core::Profiler::currentFrameIndex().
+  void beginFrame();
+  // Closes any passes still open and the frame zone.
+  void endFrame();
+  void beginPass(std::string_view name);
+  void endPass();
+
+private:
+  static constexpr std::size_t kFramesInFlight = 3;
+
+  struct PendingZone {
+    std::string_view name;
+    std::uint32_t beginQuery = 0;
+    std::uint32_t endQuery = 0;
+    std::uint32_t depth = 0;
+  };
+
+  struct FrameSlot {
+    std::uint64_t frameIndex = 0;
+    std::int64_t gpuToCpuOffsetNs = 0;
+    std::vector<unsigned int> queries;
+    std::uint32_t usedQueries = 0;
+    std::vector<PendingZone> zones;
+    std::vector<std::size_t> openZones;
+    bool pending = false;
+  };
+
+  [[nodiscard]] static std::uint32_t issue(FrameSlot& slot);
+  static void resolve(FrameSlot& slot);
+
+  std::array<FrameSlot, kFramesInFlight> slots_{};
+  std::size_t current_ = 0;
+  // Last name passed to beginPass() and its interned copy, so a pass run every frame is looked up once.
+  std::string lastPassName_;
+  std::string_view lastInternedName_;
+};
+
+// True when the current context is GL 4.5 or has ARB_direct_state_access, so objects can be created
+// and edited by name (glCreateBuffers, glNamedBufferStorage, glTextureStorage2D, ...) without
+// disturbing bindings. Requires loaded GL entry points.
+[[nodiscard]] bool openGlDirectStateAccessSupported();
+
+[[nodiscard]] std::unique_ptr<IRenderBackend> createOpenGlRenderBackend(const OpenGlRenderBackendConfig& config = {});
+
+// Builds a GL program from GLSL sources for code that drives OpenGL directly. When cache holds a
+// binary the driver accepts, no GLSL is compiled; otherwise the sources are compiled and linked
+// and the result is stored. Requires a current context and returns the GL program name; throws
+// std::runtime_error with the info log when compilation or linking fails.
+[[nodiscard]] unsigned int createOpenGlProgram(std::string_view vertexSource,
+                                               std::string_view fragmentSource,
+                                               ProgramBinaryCache* cache = nullptr);
+
+// Program cache counters of a device created by the OpenGL backend; std::nullopt otherwise.
+[[nodiscard]] std::optional<ProgramBinaryCacheStats> openGlProgramCacheStats(const IRenderDevice& device);
+
+// Deduplication counters of a device created by the OpenGL backend; std::nullopt otherwise.
+[[nodiscard]] std::optional<PipelineDedupStats> openGlPipelineDedupStats(const IRenderDevice& device);
 
-[[nodiscard]] std::unique_ptr<IRenderBackend> createOpenGlRenderBackend();
+// Upload queue counters of a device created by the OpenGL backend; std::nullopt otherwise.
+[[nodiscard]] std::optional<UploadQueueStats> openGlUploadQueueStats(const IRenderDevice& device);
 
 } // namespace engine::render
@@ -8,53 +8,336 @@
 #error "GLAD headers not found. Provide third_party/glad or a glad package."
 #endif
 
+// The loader must be generated with EXT_texture_compression_s3tc, ARB_texture_compression_bptc and
+// ARB_ES3_compatibility: supportsFormat() reads their GLAD_GL_* flags and toGlInternalFormat() uses
+// their enums.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "engine/core/MemoryTracker.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/render/HandlePool.hpp"
 #include "engine/render/ICommandContext.hpp"
 #include "engine/render/IRenderBackend.hpp"
 #include "engine/render/IRenderDevice.hpp"
+#include "engine/render/RenderStats.hpp"
 
 namespace engine::render {
 namespace {
 
+[[nodiscard]] std::string shaderInfoLog(const GLuint shader) {
+  GLint logLength = 0;
+  glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+  std::string log(static_cast<std::size_t>(std::max(logLength, 0)), '\0');
+  if (logLength > 0) {
+    glGetShaderInfoLog(shader, logLength, nullptr, log.data());
+  }
+  return log;
+}
+
+[[nodiscard]] std::string programInfoLog(const GLuint program) {
+  GLint logLength = 0;
+  glGetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength);
+  std::string log(static_cast<std::size_t>(std::max(logLength, 0)), '\0');
+  if (logLength > 0) {
+    glGetProgramInfoLog(program, logLength, nullptr, log.data());
+  }
+  return log;
+}
+
+// Issues a compile without querying its status, so drivers with parallel shader compilation
+// can run it in the background; errors surface when the program link is checked.
+[[nodiscard]] GLuint issueShaderCompile(const GLenum stage, const std::string_view source) {
+  ENGINE_PROFILE_ZONE("OpenGL::compileShader");
+  const GLuint shader = glCreateShader(stage);
+  const auto* sourcePointer = reinterpret_cast<const GLchar*>(source.data());
+  const auto length = static_cast<GLint>(source.size());
+  glShaderSource(shader, 1, &sourcePointer, &length);
+  glCompileShader(shader);
+  return shader;
+}
+
+// Vendor, renderer and version: a binary is only valid for the exact driver that produced it.
+[[nodiscard]] std::string glDriverIdentity() {
+  const auto readString = [](const GLenum name) {
+    const auto* value = reinterpret_cast<const char*>(glGetString(name));
+    return std::string{value != nullptr ? value : ""};
+  };
+  return readString(GL_VENDOR) + "|" + readString(GL_RENDERER) + "|" + readString(GL_VERSION);
+}
+
+[[nodiscard]] bool glProgramBinariesSupported() {
+  GLint formatCount = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+  return formatCount > 0;
+}
+
+// Turns on KHR/ARB_parallel_shader_compile when available. Returns whether compile and link
+// completion can be polled without blocking.
+[[nodiscard]] bool enableParallelShaderCompile() {
+  if (GLAD_GL_KHR_parallel_shader_compile) {
+    glMaxShaderCompilerThreadsKHR(0xFFFFFFFFU);
+    return true;
+  }
+  if (GLAD_GL_ARB_parallel_shader_compile) {
+    glMaxShaderCompilerThreadsARB(0xFFFFFFFFU);
+    return true;
+  }
+  return false;
+}
+
+// Immutable, persistently mappable buffers (glBufferStorage) are core since GL 4.4.
+[[nodiscard]] bool bufferStorageSupported() {
+  return GLAD_GL_VERSION_4_4 != 0 || GLAD_GL_ARB_buffer_storage != 0;
+}
+
+// Polls (or, with wait, blocks on) a fence. GL_WAIT_FAILED, e.g. after a lost context, counts as
+// signaled rather than waiting forever.
+[[nodiscard]] bool fenceSignaled(const GLsync fence, const bool wait) {
+  GLenum result = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, 0);
+  while (wait && result == GL_TIMEOUT_EXPIRED) {
+    result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+  }
+  return result != GL_TIMEOUT_EXPIRED;
+}
+
+// Shader objects for one link; owned shaders are deleted once the program has linked.
+struct ProgramShaders {
+  GLuint vertex = 0;
+  GLuint fragment = 0;
+  bool owned = false;
+};
+
+// A program that may still be compiling and linking on the driver's threads.
+struct ProgramBuild {
+  GLuint program = 0;
+  ProgramShaders shaders{};
+  std::uint64_t cacheKey = 0;
+  // Linked from source with the retrievable hint; the binary is stored once the link succeeds.
+  bool storeBinary = false;
+  bool loadedFromCache = false;
+};
+
+// Starts building a program. Cache hits are complete on return. On a miss, compileShaders()
+// issues the shader compiles and the link is started without waiting for either.
+template <typename CompileShaders>
+[[nodiscard]] ProgramBuild beginProgramBuild(ProgramBinaryCache* cache,
+                                             const std::uint64_t key,
+                                             CompileShaders&& compileShaders) {
+  ENGINE_PROFILE_ZONE("OpenGL::beginProgram");
+  ProgramBuild build{};
+  build.cacheKey = key;
+  const bool useCache = cache != nullptr && cache->enabled() && glProgramBinariesSupported();
+  if (useCache) {
+    if (const std::optional<ProgramBinary> binary = cache->load(key); binary.has_value()) {
+      const GLuint program = glCreateProgram();
+      glProgramBinary(program, static_cast<GLenum>(binary->format), binary->data.data(), static_cast<GLsizei>(binary->data.size()));
+      GLint linked = GL_FALSE;
+      glGetProgramiv(program, GL_LINK_STATUS, &linked);
+      if (linked == GL_TRUE) {
+        cache->recordHit();
+        build.program = program;
+        build.loadedFromCache = true;
+        return build;
+      }
+      glDeleteProgram(program);
+      cache->reject(key);
+    }
+    cache->recordMiss();
+  }
+
+  build.shaders = compileShaders();
+  build.program = glCreateProgram();
+  build.storeBinary = useCache;
+  if (useCache) {
+    glProgramParameteri(build.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+  glAttachShader(build.program, build.shaders.vertex);
+  glAttachShader(build.program, build.shaders.fragment);
+  glLinkProgram(build.program);
+  return build;
+}
+
+// True once finishProgramBuild() will not block. Without parallel compilation GL cannot be
+// polled, so the build counts as complete and finishing it waits for the driver.
+[[nodiscard]] bool programBuildComplete(const ProgramBuild& build, const bool parallelCompile) {
+  if (build.loadedFromCache || !parallelCompile) {
+    return true;
+  }
+  GLint complete = GL_FALSE;
+  glGetProgramiv(build.program, GL_COMPLETION_STATUS_KHR, &complete);
+  return complete == GL_TRUE;
+}
+
+// Checks the link result, releases the build's shaders and stores the binary on success. Returns
+// an empty string on success; otherwise deletes the program and returns the compile/link log.
+[[nodiscard]] std::string finishProgramBuild(ProgramBuild& build, ProgramBinaryCache* cache) {
+  ENGINE_PROFILE_ZONE("OpenGL::finishProgram");
+  if (build.loadedFromCache) {
+    return {};
+  }
+
+  GLint linked = GL_FALSE;
+  glGetProgramiv(build.program, GL_LINK_STATUS, &linked);
+  std::string error;
+  if (linked != GL_TRUE) {
+    for (const GLuint shader : {build.shaders.vertex, build.shaders.fragment}) {
+      GLint compiled = GL_FALSE;
+      glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+      if (compiled != GL_TRUE) {
+        error += "compile: " + shaderInfoLog(shader) + "\n";
+      }
+    }
+    error += "link: " + programInfoLog(build.program);
+  }
+
+  glDetachShader(build.program, build.shaders.vertex);
+  glDetachShader(build.program, build.shaders.fragment);
+  if (build.shaders.owned) {
+    glDeleteShader(build.shaders.vertex);
+    glDeleteShader(build.shaders.fragment);
+  }
+  build.shaders = {};
+
+  if (!error.empty()) {
+    glDeleteProgram(build.program);
+    build.program = 0;
+    return error;
+  }
+
+  if (build.storeBinary && cache != nullptr) {
+    GLint binaryLength = 0;
+    glGetProgramiv(build.program, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+    if (binaryLength > 0) {
+      ProgramBinary binary{};
+      binary.data.resize(static_cast<std::size_t>(binaryLength));
+      GLenum format = 0;
+      glGetProgramBinary(build.program, binaryLength, nullptr, &format, binary.data.data());
+      binary.format = static_cast<std::uint32_t>(format);
+      cache->store(build.cacheKey, binary);
+    }
+  }
+  return {};
+}
+
+
+// Program and primitive mode a command context binds for a pipeline; program 0 until it is Ready.
+struct BoundPipeline {
+  GLuint program = 0;
+  GLenum mode = GL_TRIANGLES;
+  PrimitiveTopology topology = PrimitiveTopology::TriangleList;
+};
+
+class OpenGlRenderDevice;
+
 class OpenGlCommandContext final : public ICommandContext {
 public:
+  OpenGlCommandContext(OpenGlRenderDevice& device,
+                       RenderStatsCounters& stats,
+                       OpenGlTransientRing& transientRing,
+                       OpenGlUploadQueue& uploadQueue,
+                       OpenGlDeferredDeletionQueue& deletionQueue,
+                       OpenGlStateCache& stateCache)
+      : device_(device),
+        stats_(stats),
+        transientRing_(transientRing),
+        uploadQueue_(uploadQueue),
+        deletionQueue_(deletionQueue),
+        stateCache_(stateCache) {}
+
+  ~OpenGlCommandContext() override {
+    if (vertexArray_ != 0) {
+      stateCache_.forgetVertexArray(vertexArray_);
+      glDeleteVertexArrays(1, &vertexArray_);
+    }
+  }
+
+  OpenGlCommandContext(const OpenGlCommandContext&) = delete;
+  OpenGlCommandContext& operator=(const OpenGlCommandContext&) = delete;
+
   void beginFrame(const FrameGraphFrameInfo& frameInfo) override {
     currentExtent_ = frameInfo.renderExtent;
-    glViewport(0, 0, static_cast<GLint>(currentExtent_.width), static_cast<GLint>(currentExtent_.height));
+    frameIndex_ = frameInfo.frameIndex;
+    counters_ = {};
+    // Whatever ran since the last frame (UI rendering, other contexts) may have changed GL state.
+    stateCache_.invalidate();
+    (void)stateCache_.takeCounters();
+    uploadQueue_.processFrame();
+    // Core profiles cannot draw without a vertex array; buffers bound by this context live in it.
+    if (vertexArray_ == 0) {
+      glGenVertexArrays(1, &vertexArray_);
+    }
+    stateCache_.bindVertexArray(vertexArray_);
+    stateCache_.setViewport(0, 0, static_cast<GLint>(currentExtent_.width), static_cast<GLint>(currentExtent_.height));
+    gpuProfiler_.beginFrame();
   }
 
-  void endFrame() override { glFlush(); }
+  void endFrame() override {
+    gpuProfiler_.endFrame();
+    transientRing_.endFrame();
+    deletionQueue_.endFrame();
+    glFlush();
 
-  void bindPipeline(const PipelineHandle pipeline) override { activePipeline_ = pipeline; }
-  void bindVertexBuffer(const BufferHandle buffer, const std::uint64_t offset) override {
-    (void)offset;
-    glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(buffer.id));
+    const GlStateCacheCounters stateChanges = stateCache_.takeCounters();
+    counters_.stateChangesIssued = stateChanges.issued;
+    counters_.stateChangesFiltered = stateChanges.filtered;
+    stats_.publish(frameIndex_, counters_, deletionQueue_.size());
+    ENGINE_PROFILE_COUNTER("draw calls", counters_.drawCalls);
+    ENGINE_PROFILE_COUNTER("triangles", counters_.triangles);
+    ENGINE_PROFILE_COUNTER("pipeline binds", counters_.pipelineBinds);
+    ENGINE_PROFILE_COUNTER("draws skipped", counters_.drawsSkipped);
+    ENGINE_PROFILE_COUNTER("GL state changes", stateChanges.issued);
+    ENGINE_PROFILE_COUNTER("GL state changes filtered", stateChanges.filtered);
+    ENGINE_PROFILE_COUNTER("pending destructions", deletionQueue_.size());
   }
 
-  void bindIndexBuffer(const BufferHandle buffer, const std::uint64_t offset) override {
-    (void)offset;
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLuint>(buffer.id));
-  }
+  void beginPass(const std::string_view name) override { gpuProfiler_.beginPass(name); }
+  void endPass() override { gpuProfiler_.endPass(); }
+
+  // Defined after OpenGlRenderDevice, which resolves handles to GL names.
+  void bindPipeline(PipelineHandle pipeline) override;
+  void bindVertexBuffer(BufferHandle buffer, std::uint64_t offset) override;
+  void bindIndexBuffer(BufferHandle buffer, std::uint64_t offset) override;
+  void bindUniformBuffer(std::uint32_t binding, BufferHandle buffer, std::uint64_t offset, std::uint64_t sizeBytes) override;
 
   void draw(const std::uint32_t vertexCount,
             const std::uint32_t instanceCount,
             const std::uint32_t firstVertex,
             const std::uint32_t firstInstance) override {
-    (void)activePipeline_;
     (void)firstInstance;
+    if (!pipelineReady_) {
+      ++counters_.drawsSkipped;
+      return;
+    }
+    if (instanceCount == 0) {
+      return;
+    }
+    counters_.countDraw(topology_, vertexCount, instanceCount);
+    transientRing_.flush();
     if (instanceCount <= 1) {
-      glDrawArrays(GL_TRIANGLES, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount));
+      glDrawArrays(primitiveMode_, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount));
       return;
     }
 
-    glDrawArraysInstanced(GL_TRIANGLES,
+    glDrawArraysInstanced(primitiveMode_,
                           static_cast<GLint>(firstVertex),
                           static_cast<GLsizei>(vertexCount),
                           static_cast<GLsizei>(instanceCount));
@@ -67,13 +350,22 @@ public:
                    const std::uint32_t firstInstance) override {
     (void)vertexOffset;
     (void)firstInstance;
+    if (!pipelineReady_) {
+      ++counters_.drawsSkipped;
+      return;
+    }
+    if (instanceCount == 0) {
+      return;
+    }
+    counters_.countDraw(topology_, indexCount, instanceCount);
+    transientRing_.flush();
     const auto* offsetPointer = reinterpret_cast<const void*>(static_cast<std::uintptr_t>(firstIndex * sizeof(std::uint32_t)));
     if (instanceCount <= 1) {
-      glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, offsetPointer);
+      glDrawElements(primitiveMode_, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, offsetPointer);
       return;
     }
 
-    glDrawElementsInstanced(GL_TRIANGLES,
+    glDrawElementsInstanced(primitiveMode_,
                             static_cast<GLsizei>(indexCount),
                             GL_UNSIGNED_INT,
                             offsetPointer,
@@ -81,130 +373,505 @@ public:
   }
 
 private:
+  OpenGlRenderDevice& device_;
+  RenderStatsCounters& stats_;
+  OpenGlTransientRing& transientRing_;
+  OpenGlUploadQueue& uploadQueue_;
+  OpenGlDeferredDeletionQueue& deletionQueue_;
+  OpenGlStateCache& stateCache_;
+  FrameDrawCounters counters_{};
+  std::uint64_t frameIndex_ = 0;
   platform::Extent2D currentExtent_{};
-  PipelineHandle activePipeline_{};
+  GLuint vertexArray_ = 0;
+  GLenum primitiveMode_ = GL_TRIANGLES;
+  PrimitiveTopology topology_ = PrimitiveTopology::TriangleList;
+  bool pipelineReady_ = false;
+  OpenGlTimestampProfiler gpuProfiler_;
 };
 
 class OpenGlRenderDevice final : public IRenderDevice {
 public:
+  explicit OpenGlRenderDevice(const OpenGlRenderBackendConfig& config)
+      : programCache_(config.programCacheDirectory),
+        directStateAccess_(config.useDirectStateAccess && openGlDirectStateAccessSupported()),
+        transientRing_(config.transientRingBytes),
+        uploadQueue_(config.uploadStagingBytes, config.uploadBudgetBytes),
+        deletionQueue_(&stateCache_) {}
+
   [[nodiscard]] std::unique_ptr<ICommandContext> createCommandContext() override {
-    return std::make_unique<OpenGlCommandContext>();
+    return std::make_unique<OpenGlCommandContext>(*this, stats_, transientRing_, uploadQueue_, deletionQueue_, stateCache_);
   }
 
   [[nodiscard]] BufferHandle createBuffer(const BufferCreateInfo& createInfo) override {
+    core::TrackedAllocation memory{core::MemoryTag::GpuBuffer, static_cast<std::size_t>(createInfo.sizeBytes)};
+
     GLuint id = 0;
-    glGenBuffers(1, &id);
-    glBindBuffer(toGlBufferTarget(createInfo.usage), id);
-    glBufferData(toGlBufferTarget(createInfo.usage),
-                 static_cast<GLsizeiptr>(createInfo.sizeBytes),
-                 nullptr,
-                 createInfo.cpuVisible ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
-
-    BufferHandle handle{nextBufferHandle_++};
-    liveBuffers_.insert(handle.id);
-    glBufferLookup_[handle.id] = id;
-    return handle;
+    if (directStateAccess_) {
+      // Immutable storage lets the driver pick the placement up front; dynamic storage keeps
+      // updateBuffer() legal. Zero-sized storage is an error, so empty buffers get one byte.
+      glCreateBuffers(1, &id);
+      const GLbitfield flags = GL_DYNAMIC_STORAGE_BIT | (createInfo.cpuVisible ? GL_CLIENT_STORAGE_BIT : 0U);
+      glNamedBufferStorage(id,
+                           std::max<GLsizeiptr>(static_cast<GLsizeiptr>(createInfo.sizeBytes), 1),
+                           createInfo.sizeBytes == 0 ? nullptr : createInfo.initialData,
+                           flags);
+    } else {
+      glGenBuffers(1, &id);
+      stateCache_.bindBuffer(toGlBufferTarget(createInfo.usage), id);
+      glBufferData(toGlBufferTarget(createInfo.usage),
+                   static_cast<GLsizeiptr>(createInfo.sizeBytes),
+                   createInfo.initialData,
+                   createInfo.cpuVisible ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    }
+
+    BufferRecord buffer{};
+    buffer.id = id;
+    buffer.resource.info.kind = RenderResourceKind::Buffer;
+    buffer.resource.info.debugName = std::string{createInfo.debugName};
+    buffer.resource.info.sizeBytes = memory.bytes();
+    buffer.resource.info.usage = createInfo.usage;
+    buffer.resource.memory = std::move(memory);
+    return BufferHandle{addRecord(buffers_, std::move(buffer))};
   }
 
   void destroyBuffer(const BufferHandle handle) override {
-    const auto it = glBufferLookup_.find(handle.id);
-    if (it == glBufferLookup_.end()) {
+    const BufferRecord* buffer = buffers_.find(handle.id);
+    if (buffer == nullptr || handle.id == transientBuffer_.id) {
       return;
     }
 
-    const GLuint id = it->second;
-    glDeleteBuffers(1, &id);
-    glBufferLookup_.erase(it);
-    liveBuffers_.erase(handle.id);
+    uploadQueue_.cancel(buffer->id);
+    deletionQueue_.retire(GlObjectKind::Buffer, buffer->id, removeRecord(buffers_, handle.id));
+  }
+
+  void updateBuffer(const BufferHandle handle, const std::uint64_t offset, const std::span<const std::byte> data) override {
+    const GLuint id = writableBuffer("updateBuffer", handle, offset, data.size());
+    if (data.empty()) {
+      return;
+    }
+    if (directStateAccess_) {
+      glNamedBufferSubData(id, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(data.size()), data.data());
+      return;
+    }
+
+    // GL_COPY_WRITE_BUFFER leaves the usage-specific binding points untouched.
+    glBindBuffer(GL_COPY_WRITE_BUFFER, id);
+    glBufferSubData(GL_COPY_WRITE_BUFFER,
+                    static_cast<GLintptr>(offset),
+                    static_cast<GLsizeiptr>(data.size()),
+                    data.data());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  }
+
+  [[nodiscard]] UploadTicket queueBufferUpload(const BufferHandle handle,
+                                               const std::uint64_t offset,
+                                               const std::span<const std::byte> data) override {
+    const GLuint id = writableBuffer("queueBufferUpload", handle, offset, data.size());
+    return uploadQueue_.enqueue(id, offset, data);
   }
 
+  [[nodiscard]] bool uploadComplete(const UploadTicket ticket) override { return uploadQueue_.complete(ticket); }
+
+  [[nodiscard]] TransientAllocation allocateTransient(const std::uint64_t sizeBytes, const std::uint64_t alignment) override {
+    const OpenGlTransientRing::Allocation allocation = transientRing_.allocate(sizeBytes, alignment);
+    if (transientBuffer_.id == 0) {
+      // The ring charges its own memory to the tracker.
+      BufferRecord buffer{};
+      buffer.id = allocation.buffer;
+      buffer.resource.info.kind = RenderResourceKind::Buffer;
+      buffer.resource.info.debugName = transientRing_.persistentlyMapped() ? "transient ring (persistent)" : "transient ring";
+      buffer.resource.info.sizeBytes = static_cast<std::size_t>(transientRing_.capacity());
+      buffer.resource.info.usage = BufferUsage::Uniform;
+      transientBuffer_ = BufferHandle{addRecord(buffers_, std::move(buffer))};
+    }
+    return TransientAllocation{transientBuffer_, allocation.offset, allocation.data};
+  }
+
+  // Textures that start with finer levels non-resident use mutable per-level storage rather than
+  // glTexStorage, so those levels can be given zero size and actually release their memory. With
+  // direct state access, fully resident textures get immutable storage instead; residency changes
+  // on them only clamp sampling.
   [[nodiscard]] TextureHandle createTexture(const TextureCreateInfo& createInfo) override {
-    GLuint id = 0;
-    glGenTextures(1, &id);
-    glBindTexture(GL_TEXTURE_2D, id);
-    glTexImage2D(GL_TEXTURE_2D,
-                 0,
-                 toGlInternalFormat(createInfo.format),
-                 static_cast<GLsizei>(createInfo.extent.width),
-                 static_cast<GLsizei>(createInfo.extent.height),
-                 0,
-                 toGlFormat(createInfo.format),
-                 toGlType(createInfo.format),
-                 nullptr);
-
-    TextureHandle handle{nextTextureHandle_++};
-    liveTextures_.insert(handle.id);
-    glTextureLookup_[handle.id] = id;
-    return handle;
+    if (!supportsFormat(createInfo.format)) {
+      throw std::runtime_error("OpenGL driver does not support the format of texture '" + std::string{createInfo.debugName} + "'");
+    }
+    TextureRecord texture{};
+    texture.info = createInfo;
+    texture.info.mipLevels = std::min(textureMipCount(createInfo), fullMipChainLength(createInfo.extent, textureDepth(createInfo)));
+    texture.info.firstResidentMip = std::min(createInfo.firstResidentMip, texture.info.mipLevels - 1);
+    texture.info.debugName = {};
+    core::TrackedAllocation memory{core::MemoryTag::GpuTexture, textureByteSize(texture.info, texture.info.firstResidentMip)};
+
+    const GLenum target = toGlTextureTarget(createInfo.dimension);
+    if (directStateAccess_) {
+      glCreateTextures(target, 1, &texture.id);
+      glTextureParameteri(texture.id, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(texture.info.mipLevels - 1));
+      glTextureParameteri(texture.id, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(texture.info.firstResidentMip));
+      texture.immutable = texture.info.firstResidentMip == 0;
+    } else {
+      glGenTextures(1, &texture.id);
+      stateCache_.bindTexture(0, target, texture.id);
+      glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(texture.info.mipLevels - 1));
+      glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(texture.info.firstResidentMip));
+    }
+    if (texture.immutable) {
+      allocateImmutableStorage(texture);
+    } else {
+      stateCache_.bindTexture(0, target, texture.id);
+      for (std::uint32_t level = texture.info.firstResidentMip; level < texture.info.mipLevels; ++level) {
+        specifyTextureLevel(texture, level, nullptr);
+      }
+    }
+
+    RenderResourceInfo& info = texture.resource.info;
+    info.kind = RenderResourceKind::Texture;
+    info.debugName = std::string{createInfo.debugName};
+    info.sizeBytes = memory.bytes();
+    info.format = createInfo.format;
+    info.extent = createInfo.extent;
+    info.mipLevels = texture.info.mipLevels;
+    info.firstResidentMip = texture.info.firstResidentMip;
+    texture.resource.memory = std::move(memory);
+    return TextureHandle{addRecord(textures_, std::move(texture))};
   }
 
   void destroyTexture(const TextureHandle handle) override {
-    const auto it = glTextureLookup_.find(handle.id);
-    if (it == glTextureLookup_.end()) {
+    const TextureRecord* texture = textures_.find(handle.id);
+    if (texture == nullptr) {
+      return;
+    }
+
+    deletionQueue_.retire(GlObjectKind::Texture, texture->id, removeRecord(textures_, handle.id));
+  }
+
+  [[nodiscard]] bool supportsTextureFormat(const TextureFormat format) const override { return supportsFormat(format); }
+
+  void updateTexture(const TextureHandle handle, const std::uint32_t mipLevel, const std::span<const std::byte> texels) override {
+    ENGINE_PROFILE_ZONE("OpenGL::updateTexture");
+    TextureRecord* found = textures_.find(handle.id);
+    if (found == nullptr) {
+      throw std::runtime_error("updateTexture called with an unknown texture handle");
+    }
+    TextureRecord& texture = *found;
+    if (mipLevel >= texture.info.mipLevels || texels.size() != textureMipByteSize(texture.info, mipLevel)) {
+      throw std::runtime_error("updateTexture level " + std::to_string(mipLevel) + " does not match texture " +
+                               std::to_string(handle.id));
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (texture.immutable) {
+      uploadImmutableLevel(texture, mipLevel, texels.data());
+    } else {
+      stateCache_.bindTexture(0, toGlTextureTarget(texture.info.dimension), texture.id);
+      specifyTextureLevel(texture, mipLevel, texels.data());
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  }
+
+  void setTextureResidency(const TextureHandle handle, const std::uint32_t firstResidentMip) override {
+    TextureRecord* found = textures_.find(handle.id);
+    if (found == nullptr) {
+      return;
+    }
+    TextureRecord& texture = *found;
+    const std::uint32_t first = std::min(firstResidentMip, texture.info.mipLevels - 1);
+    if (first == texture.info.firstResidentMip) {
+      return;
+    }
+    if (texture.immutable) {
+      // Immutable storage cannot shrink: sampling is clamped and the memory stays charged.
+      glTextureParameteri(texture.id, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(first));
+      texture.info.firstResidentMip = first;
+      std::lock_guard lock{recordsMutex_};
+      texture.resource.info.firstResidentMip = first;
       return;
     }
 
-    const GLuint id = it->second;
-    glDeleteTextures(1, &id);
-    glTextureLookup_.erase(it);
-    liveTextures_.erase(handle.id);
+    const GLenum target = toGlTextureTarget(texture.info.dimension);
+    stateCache_.bindTexture(0, target, texture.id);
+    // Clamp sampling before releasing levels so the texture never samples a zero-sized level.
+    if (first > texture.info.firstResidentMip) {
+      glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(first));
+      for (std::uint32_t level = texture.info.firstResidentMip; level < first; ++level) {
+        releaseTextureLevel(texture, level);
+      }
+    } else {
+      // Levels already uploaded through updateTexture() keep their contents.
+      for (std::uint32_t level = first; level < texture.info.firstResidentMip; ++level) {
+        if (!texture.committedLevels.test(level)) {
+          specifyTextureLevel(texture, level, nullptr);
+        }
+      }
+      glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, static_cast<GLint>(first));
+    }
+    texture.info.firstResidentMip = first;
+
+    std::lock_guard lock{recordsMutex_};
+    ResourceRecord& record = texture.resource;
+    record.memory = {};
+    record.memory = core::TrackedAllocation{core::MemoryTag::GpuTexture, textureByteSize(texture.info, first)};
+    record.info.sizeBytes = record.memory.bytes();
+    record.info.firstResidentMip = first;
   }
 
+  // GLSL is kept and compiled on first use by a pipeline that misses the program cache.
+  // Identical stage + source returns the existing handle with its reference count raised; each
+  // create must be paired with a destroy.
   [[nodiscard]] ShaderHandle createShader(const ShaderCreateInfo& createInfo) override {
-    const GLenum glStage = toGlShaderStage(createInfo.stage);
-    const GLuint shader = glCreateShader(glStage);
-    const auto* source = reinterpret_cast<const GLchar*>(createInfo.byteCode);
-    const GLint length = static_cast<GLint>(createInfo.byteCodeSize);
-    glShaderSource(shader, 1, &source, &length);
-    glCompileShader(shader);
-
-    ShaderHandle handle{nextShaderHandle_++};
-    liveShaders_.insert(handle.id);
-    glShaderLookup_[handle.id] = shader;
+    ShaderRecord shader{};
+    shader.stage = toGlShaderStage(createInfo.stage);
+    shader.source.assign(reinterpret_cast<const char*>(createInfo.byteCode), createInfo.byteCodeSize);
+    const std::string stageTag = std::to_string(shader.stage);
+    shader.dedupKey = ProgramBinaryCache::computeKey({stageTag, shader.source});
+
+    shaderRequests_.fetch_add(1, std::memory_order_relaxed);
+    if (const auto existing = shaderDedup_.find(shader.dedupKey); existing != shaderDedup_.end()) {
+      ShaderRecord& record = *shaders_.find(existing->second);
+      if (record.stage == shader.stage && record.source == shader.source) {
+        ++record.refCount;
+        shaderHits_.fetch_add(1, std::memory_order_relaxed);
+        return ShaderHandle{existing->second};
+      }
+    }
+
+    shader.resource.info.kind = RenderResourceKind::Shader;
+    shader.resource.info.debugName = std::string{createInfo.debugName};
+    shader.resource.info.sizeBytes = createInfo.byteCodeSize;
+    shader.resource.info.stage = createInfo.stage;
+    const std::uint64_t dedupKey = shader.dedupKey;
+    const ShaderHandle handle{addRecord(shaders_, std::move(shader))};
+    shaderDedup_.try_emplace(dedupKey, handle.id);
     return handle;
   }
 
   void destroyShader(const ShaderHandle handle) override {
-    const auto it = glShaderLookup_.find(handle.id);
-    if (it == glShaderLookup_.end()) {
+    ShaderRecord* shader = shaders_.find(handle.id);
+    if (shader == nullptr || --shader->refCount > 0) {
       return;
     }
 
-    glDeleteShader(it->second);
-    glShaderLookup_.erase(it);
-    liveShaders_.erase(handle.id);
+    if (const auto dedup = shaderDedup_.find(shader->dedupKey); dedup != shaderDedup_.end() && dedup->second == handle.id) {
+      shaderDedup_.erase(dedup);
+    }
+    if (shader->shader != 0) {
+      glDeleteShader(shader->shader);
+    }
+    (void)removeRecord(shaders_, handle.id);
   }
 
+  // Returns immediately; compile and link run on the driver's threads and finish in pipelineStatus().
+  // Shaders are deduplicated, so equal shader handles plus topology mean an equal pipeline: such
+  // requests share one ref-counted handle and the first request's debug name.
   [[nodiscard]] PipelineHandle createGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo) override {
-    const auto vertexIt = glShaderLookup_.find(createInfo.vertexShader.id);
-    const auto fragmentIt = glShaderLookup_.find(createInfo.fragmentShader.id);
-    if (vertexIt == glShaderLookup_.end() || fragmentIt == glShaderLookup_.end()) {
+    ShaderRecord* vertexShader = shaders_.find(createInfo.vertexShader.id);
+    ShaderRecord* fragmentShader = shaders_.find(createInfo.fragmentShader.id);
+    if (vertexShader == nullptr || fragmentShader == nullptr) {
       throw std::runtime_error("OpenGL pipeline creation requires valid vertex and fragment shaders");
     }
 
-    const GLuint program = glCreateProgram();
-    glAttachShader(program, vertexIt->second);
-    glAttachShader(program, fragmentIt->second);
-    glLinkProgram(program);
+    const PipelineKey pipelineKey{createInfo.vertexShader.id, createInfo.fragmentShader.id, createInfo.topology};
+    pipelineRequests_.fetch_add(1, std::memory_order_relaxed);
+    if (const auto existing = pipelineDedup_.find(pipelineKey); existing != pipelineDedup_.end()) {
+      ++pipelines_.find(existing->second)->refCount;
+      pipelineHits_.fetch_add(1, std::memory_order_relaxed);
+      return PipelineHandle{existing->second};
+    }
+
+    if (driverIdentity_.empty()) {
+      driverIdentity_ = glDriverIdentity();
+      parallelCompile_ = enableParallelShaderCompile();
+    }
+    ShaderRecord& vertex = *vertexShader;
+    ShaderRecord& fragment = *fragmentShader;
+    const std::uint64_t key = ProgramBinaryCache::computeKey({vertex.source, fragment.source, driverIdentity_});
+    PipelineRecord record{};
+    record.key = pipelineKey;
+    record.debugName = std::string{createInfo.debugName};
+    record.build = beginProgramBuild(&programCache_, key, [&vertex, &fragment] {
+      for (ShaderRecord* shader : {&vertex, &fragment}) {
+        if (shader->shader == 0) {
+          shader->shader = issueShaderCompile(shader->stage, shader->source);
+        }
+      }
+      return ProgramShaders{vertex.shader, fragment.shader, false};
+    });
 
-    PipelineHandle handle{nextPipelineHandle_++};
-    livePipelines_.insert(handle.id);
-    glPipelineLookup_[handle.id] = program;
+    record.resource.info.kind = RenderResourceKind::Pipeline;
+    record.resource.info.debugName = record.debugName;
+    const PipelineHandle handle{addRecord(pipelines_, std::move(record))};
+    pipelineDedup_.emplace(pipelineKey, handle.id);
     return handle;
   }
 
+  [[nodiscard]] PipelineStatus pipelineStatus(const PipelineHandle handle) override {
+    PipelineRecord* found = pipelines_.find(handle.id);
+    if (found == nullptr) {
+      return PipelineStatus::Failed;
+    }
+
+    PipelineRecord& record = *found;
+    if (record.status == PipelineStatus::Pending && programBuildComplete(record.build, parallelCompile_)) {
+      const std::string error = finishProgramBuild(record.build, &programCache_);
+      if (error.empty()) {
+        record.status = PipelineStatus::Ready;
+      } else {
+        std::cerr << "OpenGL pipeline '" << record.debugName << "' failed to build:\n" << error << '\n';
+        record.status = PipelineStatus::Failed;
+      }
+    }
+    return record.status;
+  }
+
   void destroyPipeline(const PipelineHandle handle) override {
-    const auto it = glPipelineLookup_.find(handle.id);
-    if (it == glPipelineLookup_.end()) {
+    PipelineRecord* pipeline = pipelines_.find(handle.id);
+    if (pipeline == nullptr || --pipeline->refCount > 0) {
       return;
     }
 
-    glDeleteProgram(it->second);
-    glPipelineLookup_.erase(it);
-    livePipelines_.erase(handle.id);
+    pipelineDedup_.erase(pipeline->key);
+    // Deleting a program that is still linking is fine; GL defers the free until the link ends.
+    deletionQueue_.retire(GlObjectKind::Program, pipeline->build.program, removeRecord(pipelines_, handle.id));
+  }
+
+  [[nodiscard]] std::vector<RenderResourceInfo> resources() const override {
+    std::lock_guard lock{recordsMutex_};
+    std::vector<RenderResourceInfo> result;
+    result.reserve(buffers_.size() + textures_.size() + shaders_.size() + pipelines_.size());
+    const auto collect = [&result](std::uint32_t, const auto& record) { result.push_back(record.resource.info); };
+    buffers_.forEach(collect);
+    textures_.forEach(collect);
+    shaders_.forEach(collect);
+    pipelines_.forEach(collect);
+    return result;
+  }
+
+  [[nodiscard]] RenderFrameStats frameStats() const override { return stats_.snapshot(); }
+
+  // Unknown or stale handles resolve to buffer 0.
+  [[nodiscard]] GLuint glBufferName(const BufferHandle handle) const {
+    const BufferRecord* buffer = buffers_.find(handle.id);
+    return buffer == nullptr ? 0 : buffer->id;
+  }
+
+  // Using a program that is still compiling or linking blocks in the driver, so only Ready
+  // pipelines resolve to their program. A pending build is advanced here only when that can be
+  // polled without blocking; otherwise finishing it is left to pipelineStatus().
+  [[nodiscard]] BoundPipeline pipelineForBinding(const PipelineHandle handle) {
+    const PipelineRecord* pipeline = pipelines_.find(handle.id);
+    if (pipeline == nullptr) {
+      return BoundPipeline{};
+    }
+    if (pipeline->status == PipelineStatus::Pending && (parallelCompile_ || pipeline->build.loadedFromCache)) {
+      (void)pipelineStatus(handle);
+    }
+    if (pipeline->status != PipelineStatus::Ready) {
+      return BoundPipeline{};
+    }
+    return BoundPipeline{pipeline->build.program, toGlPrimitiveMode(pipeline->key.topology), pipeline->key.topology};
+  }
+
+  [[nodiscard]] ProgramBinaryCacheStats programCacheStats() const { return programCache_.stats(); }
+  [[nodiscard]] UploadQueueStats uploadQueueStats() const { return uploadQueue_.stats(); }
+
+  [[nodiscard]] PipelineDedupStats pipelineDedupStats() const {
+    return PipelineDedupStats{shaderRequests_.load(std::memory_order_relaxed),
+                              shaderHits_.load(std::memory_order_relaxed),
+                              pipelineRequests_.load(std::memory_order_relaxed),
+                              pipelineHits_.load(std::memory_order_relaxed)};
   }
 
 private:
+  // Debug info and tracked memory of a live resource, stored inline in its pool slot.
+  struct ResourceRecord {
+    RenderResourceInfo info;
+    core::TrackedAllocation memory;
+  };
+
+  struct BufferRecord {
+    GLuint id = 0;
+    ResourceRecord resource;
+  };
+
+  struct ShaderRecord {
+    GLenum stage = GL_VERTEX_SHADER;
+    std::string source;
+    // 0 until a pipeline using this shader has to be compiled from source.
+    GLuint shader = 0;
+    std::uint64_t dedupKey = 0;
+    std::uint32_t refCount = 1;
+    ResourceRecord resource;
+  };
+
+  // Shader handles stand in for shader contents because shaders are deduplicated first.
+  struct PipelineKey {
+    std::uint32_t vertexShader = 0;
+    std::uint32_t fragmentShader = 0;
+    PrimitiveTopology topology = PrimitiveTopology::TriangleList;
+
+    [[nodiscard]] bool operator==(const PipelineKey&) const = default;
+  };
+
+  struct PipelineKeyHash {
+    [[nodiscard]] std::size_t operator()(const PipelineKey& key) const {
+      const std::uint64_t shaders = (static_cast<std::uint64_t>(key.vertexShader) << 32U) | key.fragmentShader;
+      return std::hash<std::uint64_t>{}(shaders * 31U + static_cast<std::uint64_t>(key.topology));
+    }
+  };
+
+  struct PipelineRecord {
+    PipelineKey key{};
+    std::uint32_t refCount = 1;
+    ProgramBuild build{};
+    PipelineStatus status = PipelineStatus::Pending;
+    std::string debugName;
+    ResourceRecord resource;
+  };
+
+  struct TextureRecord {
+    GLuint id = 0;
+    // debugName is not kept; mipLevels is clamped to the full chain.
+    TextureCreateInfo info{};
+    // Levels with storage; finer non-resident levels are zero-sized.
+    std::bitset<32> committedLevels;
+    // glTextureStorage*: every level is allocated once and updated in place.
+    bool immutable = false;
+    ResourceRecord resource;
+  };
+
+  // Pools only change under recordsMutex_, so resources() can walk them from other threads while
+  // the device thread looks records up without locking.
+  template <typename Record>
+  [[nodiscard]] std::uint32_t addRecord(HandlePool<Record>& pool, Record record) {
+    std::lock_guard lock{recordsMutex_};
+    const std::uint32_t id = pool.insert(std::move(record));
+    pool.find(id)->resource.info.id = id;
+    return id;
+  }
+
+  // Returns the record's memory so callers can keep it tracked until the GL object is freed.
+  template <typename Record>
+  [[nodiscard]] core::TrackedAllocation removeRecord(HandlePool<Record>& pool, const std::uint32_t id) {
+    std::lock_guard lock{recordsMutex_};
+    core::TrackedAllocation memory = std::move(pool.find(id)->resource.memory);
+    pool.erase(id);
+    return memory;
+  }
+
+  // GL name of a buffer that caller may write [offset, offset + sizeBytes) of.
+  [[nodiscard]] GLuint writableBuffer(const char* caller, const BufferHandle handle, const std::uint64_t offset, const std::uint64_t sizeBytes) const {
+    const BufferRecord* buffer = buffers_.find(handle.id);
+    if (buffer == nullptr) {
+      throw std::runtime_error(std::string{caller} + " called with an unknown buffer handle");
+    }
+    if (handle.id == transientBuffer_.id) {
+      throw std::runtime_error(std::string{caller} + " cannot target the transient ring; write its allocations directly");
+    }
+    if (offset + sizeBytes > buffer->resource.info.sizeBytes) {
+      throw std::runtime_error(std::string{caller} + " range exceeds buffer '" + buffer->resource.info.debugName + "'");
+    }
+    return buffer->id;
+  }
+
   [[nodiscard]] static GLenum toGlBufferTarget(const BufferUsage usage) {
     switch (usage) {
     case BufferUsage::Vertex:
@@ -220,6 +887,18 @@ private:
     }
   }
 
+  [[nodiscard]] static GLenum toGlPrimitiveMode(const PrimitiveTopology topology) {
+    switch (topology) {
+    case PrimitiveTopology::TriangleStrip:
+      return GL_TRIANGLE_STRIP;
+    case PrimitiveTopology::LineList:
+      return GL_LINES;
+    case PrimitiveTopology::TriangleList:
+    default:
+      return GL_TRIANGLES;
+    }
+  }
+
   [[nodiscard]] static GLenum toGlShaderStage(const ShaderStage stage) {
     switch (stage) {
     case ShaderStage::Vertex:
@@ -233,6 +912,164 @@ private:
     }
   }
 
+  [[nodiscard]] static GLenum toGlTextureTarget(const TextureDimension dimension) {
+    switch (dimension) {
+    case TextureDimension::Texture3D:
+      return GL_TEXTURE_3D;
+    case TextureDimension::TextureCube:
+      return GL_TEXTURE_CUBE_MAP;
+    case TextureDimension::Texture2D:
+    default:
+      return GL_TEXTURE_2D;
+    }
+  }
+
+  [[nodiscard]] static std::uint32_t textureDepth(const TextureCreateInfo& createInfo) {
+    return createInfo.dimension == TextureDimension::Texture3D ? std::max(1U, createInfo.depth) : 1U;
+  }
+
+  // (Re)specifies one level at its full size on the currently bound texture; texels may be null.
+  static void specifyTextureLevel(TextureRecord& texture, const std::uint32_t level, const std::byte* texels) {
+    const TextureCreateInfo& info = texture.info;
+    const auto levelSize = [level](const std::uint32_t size) { return static_cast<GLsizei>(std::max(1U, size >> level)); };
+    const std::size_t imageBytes = textureMipByteSize(info, level);
+    switch (info.dimension) {
+    case TextureDimension::Texture3D:
+      defineTextureImage(GL_TEXTURE_3D, info.format, level, levelSize(info.extent.width), levelSize(info.extent.height),
+                         levelSize(textureDepth(info)), imageBytes, texels);
+      break;
+    case TextureDimension::TextureCube: {
+      const std::size_t faceBytes = imageBytes / 6;
+      for (GLenum face = 0; face < 6; ++face) {
+        defineTextureImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, info.format, level, levelSize(info.extent.width),
+                           levelSize(info.extent.height), 1, faceBytes, texels == nullptr ? nullptr : texels + face * faceBytes);
+      }
+      break;
+    }
+    case TextureDimension::Texture2D:
+    default:
+      defineTextureImage(GL_TEXTURE_2D, info.format, level, levelSize(info.extent.width), levelSize(info.extent.height), 1,
+                         imageBytes, texels);
+      break;
+    }
+    texture.committedLevels.set(level);
+  }
+
+  // Direct state access only.
+  static void allocateImmutableStorage(TextureRecord& texture) {
+    const TextureCreateInfo& info = texture.info;
+    const auto levels = static_cast<GLsizei>(info.mipLevels);
+    const auto internalFormat = static_cast<GLenum>(toGlInternalFormat(info.format));
+    const auto width = static_cast<GLsizei>(info.extent.width);
+    const auto height = static_cast<GLsizei>(info.extent.height);
+    if (info.dimension == TextureDimension::Texture3D) {
+      glTextureStorage3D(texture.id, levels, internalFormat, width, height, static_cast<GLsizei>(textureDepth(info)));
+    } else {
+      // Cube maps take 2D storage; their faces are addressed as layers when uploading.
+      glTextureStorage2D(texture.id, levels, internalFormat, width, height);
+    }
+    for (std::uint32_t level = 0; level < info.mipLevels; ++level) {
+      texture.committedLevels.set(level);
+    }
+  }
+
+  static void uploadImmutableLevel(const TextureRecord& texture, const std::uint32_t level, const std::byte* texels) {
+    const TextureCreateInfo& info = texture.info;
+    const auto glLevel = static_cast<GLint>(level);
+    const auto width = static_cast<GLsizei>(std::max(1U, info.extent.width >> level));
+    const auto height = static_cast<GLsizei>(std::max(1U, info.extent.height >> level));
+    const auto imageBytes = static_cast<GLsizei>(textureMipByteSize(info, level));
+    GLsizei layers = 1;
+    if (info.dimension == TextureDimension::Texture3D) {
+      layers = static_cast<GLsizei>(std::max(1U, textureDepth(info) >> level));
+    } else if (info.dimension == TextureDimension::TextureCube) {
+      layers = 6;
+    }
+
+    if (isBlockCompressed(info.format)) {
+      const auto internalFormat = static_cast<GLenum>(toGlInternalFormat(info.format));
+      if (info.dimension == TextureDimension::Texture2D) {
+        glCompressedTextureSubImage2D(texture.id, glLevel, 0, 0, width, height, internalFormat, imageBytes, texels);
+      } else {
+        glCompressedTextureSubImage3D(texture.id, glLevel, 0, 0, 0, width, height, layers, internalFormat, imageBytes, texels);
+      }
+      return;
+    }
+    if (info.dimension == TextureDimension::Texture2D) {
+      glTextureSubImage2D(texture.id, glLevel, 0, 0, width, height, toGlFormat(info.format), toGlType(info.format), texels);
+    } else {
+      glTextureSubImage3D(texture.id, glLevel, 0, 0, 0, width, height, layers, toGlFormat(info.format), toGlType(info.format), texels);
+    }
+  }
+
+  // Zero-sized level images hold no storage; the level is outside the sampled range.
+  static void releaseTextureLevel(TextureRecord& texture, const std::uint32_t level) {
+    const TextureCreateInfo& info = texture.info;
+    switch (info.dimension) {
+    case TextureDimension::Texture3D:
+      defineTextureImage(GL_TEXTURE_3D, info.format, level, 0, 0, 0, 0, nullptr);
+      break;
+    case TextureDimension::TextureCube:
+      for (GLenum face = 0; face < 6; ++face) {
+        defineTextureImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, info.format, level, 0, 0, 1, 0, nullptr);
+      }
+      break;
+    case TextureDimension::Texture2D:
+    default:
+      defineTextureImage(GL_TEXTURE_2D, info.format, level, 0, 0, 1, 0, nullptr);
+      break;
+    }
+    texture.committedLevels.reset(level);
+  }
+
+  // Block-compressed levels go through glCompressedTexImage*, which takes the encoded blocks as-is.
+  static void defineTextureImage(const GLenum target,
+                                 const TextureFormat format,
+                                 const std::uint32_t level,
+                                 const GLsizei width,
+                                 const GLsizei height,
+                                 const GLsizei depth,
+                                 const std::size_t imageBytes,
+                                 const std::byte* texels) {
+    const auto glLevel = static_cast<GLint>(level);
+    const GLint internalFormat = toGlInternalFormat(format);
+    if (isBlockCompressed(format)) {
+      const auto size = static_cast<GLsizei>(imageBytes);
+      if (target == GL_TEXTURE_3D) {
+        glCompressedTexImage3D(target, glLevel, static_cast<GLenum>(internalFormat), width, height, depth, 0, size, texels);
+      } else {
+        glCompressedTexImage2D(target, glLevel, static_cast<GLenum>(internalFormat), width, height, 0, size, texels);
+      }
+      return;
+    }
+
+    if (target == GL_TEXTURE_3D) {
+      glTexImage3D(target, glLevel, internalFormat, width, height, depth, 0, toGlFormat(format), toGlType(format), texels);
+    } else {
+      glTexImage2D(target, glLevel, internalFormat, width, height, 0, toGlFormat(format), toGlType(format), texels);
+    }
+  }
+
+  [[nodiscard]] static bool supportsFormat(const TextureFormat format) {
+    switch (format) {
+    case TextureFormat::BC1:
+    case TextureFormat::BC1RGB:
+    case TextureFormat::BC3:
+      return GLAD_GL_EXT_texture_compression_s3tc != 0;
+    case TextureFormat::BC7:
+      return GLAD_GL_VERSION_4_2 != 0 || GLAD_GL_ARB_texture_compression_bptc != 0;
+    case TextureFormat::ETC2RGB8:
+    case TextureFormat::ETC2RGBA8:
+      return GLAD_GL_VERSION_4_3 != 0 || GLAD_GL_ARB_ES3_compatibility != 0;
+    case TextureFormat::BC5:
+    case TextureFormat::RGBA8:
+    case TextureFormat::RGBA16F:
+    case TextureFormat::Depth24Stencil8:
+    default:
+      return true;
+    }
+  }
+
   [[nodiscard]] static GLint toGlInternalFormat(const TextureFormat format) {
     switch (format) {
     case TextureFormat::RGBA8:
@@ -241,6 +1078,20 @@ private:
       return GL_RGBA16F;
     case TextureFormat::Depth24Stencil8:
       return GL_DEPTH24_STENCIL8;
+    case TextureFormat::BC1:
+      return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+    case TextureFormat::BC1RGB:
+      return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case TextureFormat::BC3:
+      return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case TextureFormat::BC5:
+      return GL_COMPRESSED_RG_RGTC2;
+    case TextureFormat::BC7:
+      return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    case TextureFormat::ETC2RGB8:
+      return GL_COMPRESSED_RGB8_ETC2;
+    case TextureFormat::ETC2RGBA8:
+      return GL_COMPRESSED_RGBA8_ETC2_EAC;
     default:
       return GL_RGBA8;
     }
@@ -269,35 +1120,848 @@ private:
     }
   }
 
-  std::uint32_t nextBufferHandle_ = 1;
-  std::uint32_t nextTextureHandle_ = 1;
-  std::uint32_t nextShaderHandle_ = 1;
-  std::uint32_t nextPipelineHandle_ = 1;
-
-  std::unordered_set<std::uint32_t> liveBuffers_;
-  std::unordered_set<std::uint32_t> liveTextures_;
-  std::unordered_set<std::uint32_t> liveShaders_;
-  std::unordered_set<std::uint32_t> livePipelines_;
+  HandlePool<BufferRecord> buffers_;
+  HandlePool<TextureRecord> textures_;
+  HandlePool<ShaderRecord> shaders_;
+  HandlePool<PipelineRecord> pipelines_;
+  std::unordered_map<std::uint64_t, std::uint32_t> shaderDedup_;
+  std::unordered_map<PipelineKey, std::uint32_t, PipelineKeyHash> pipelineDedup_;
+  std::atomic<std::uint64_t> shaderRequests_{0};
+  std::atomic<std::uint64_t> shaderHits_{0};
+  std::atomic<std::uint64_t> pipelineRequests_{0};
+  std::atomic<std::uint64_t> pipelineHits_{0};
 
-  std::unordered_map<std::uint32_t, GLuint> glBufferLookup_;
-  std::unordered_map<std::uint32_t, GLuint> glTextureLookup_;
-  std::unordered_map<std::uint32_t, GLuint> glShaderLookup_;
-  std::unordered_map<std::uint32_t, GLuint> glPipelineLookup_;
+  // Declared before the queues that bind and delete through it.
+  OpenGlStateCache stateCache_;
+  mutable std::mutex recordsMutex_;
+  RenderStatsCounters stats_;
+  ProgramBinaryCache programCache_;
+  std::string driverIdentity_;
+  bool parallelCompile_ = false;
+  const bool directStateAccess_;
+  OpenGlTransientRing transientRing_;
+  BufferHandle transientBuffer_{};
+  OpenGlUploadQueue uploadQueue_;
+  OpenGlDeferredDeletionQueue deletionQueue_;
 };
 
+void OpenGlCommandContext::bindPipeline(const PipelineHandle pipeline) {
+  const BoundPipeline bound = device_.pipelineForBinding(pipeline);
+  ++counters_.pipelineBinds;
+  pipelineReady_ = bound.program != 0;
+  if (!pipelineReady_) {
+    return;
+  }
+  stateCache_.useProgram(bound.program);
+  primitiveMode_ = bound.mode;
+  topology_ = bound.topology;
+}
+
+void OpenGlCommandContext::bindVertexBuffer(const BufferHandle buffer, const std::uint64_t offset) {
+  (void)offset;
+  stateCache_.bindBuffer(GL_ARRAY_BUFFER, device_.glBufferName(buffer));
+}
+
+void OpenGlCommandContext::bindIndexBuffer(const BufferHandle buffer, const std::uint64_t offset) {
+  (void)offset;
+  stateCache_.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, device_.glBufferName(buffer));
+}
+
+void OpenGlCommandContext::bindUniformBuffer(const std::uint32_t binding,
+                                             const BufferHandle buffer,
+                                             const std::uint64_t offset,
+                                             const std::uint64_t sizeBytes) {
+  stateCache_.bindUniformBuffer(binding, device_.glBufferName(buffer), offset, sizeBytes);
+}
+
 class OpenGlRenderBackend final : public IRenderBackend {
 public:
+  explicit OpenGlRenderBackend(OpenGlRenderBackendConfig config)
+      : config_(std::move(config)) {}
+
   [[nodiscard]] std::string_view name() const override { return "OpenGL"; }
 
   [[nodiscard]] std::unique_ptr<IRenderDevice> createDevice() override {
-    return std::make_unique<OpenGlRenderDevice>();
+    return std::make_unique<OpenGlRenderDevice>(config_);
   }
+
+private:
+  OpenGlRenderBackendConfig config_;
 };
 
 } // namespace
 
-std::unique_ptr<IRenderBackend> createOpenGlRenderBackend() {
-  return std::make_unique<OpenGlRenderBackend>();
+bool openGlDirectStateAccessSupported() {
+  return GLAD_GL_VERSION_4_5 != 0 || GLAD_GL_ARB_direct_state_access != 0;
+}
+
+std::unique_ptr<IRenderBackend> createOpenGlRenderBackend(const OpenGlRenderBackendConfig& config) {
+  return std::make_unique<OpenGlRenderBackend>(config);
+}
+
+unsigned int createOpenGlProgram(const std::string_view vertexSource,
+                                 const std::string_view fragmentSource,
+                                 ProgramBinaryCache* cache) {
+  const std::uint64_t key = cache != nullptr ? ProgramBinaryCache::computeKey({vertexSource, fragmentSource, glDriverIdentity()}) : 0;
+  ProgramBuild build = beginProgramBuild(cache, key, [vertexSource, fragmentSource] {
+    return ProgramShaders{issueShaderCompile(GL_VERTEX_SHADER, vertexSource),
+                          issueShaderCompile(GL_FRAGMENT_SHADER, fragmentSource),
+                          true};
+  });
+  if (const std::string error = finishProgramBuild(build, cache); !error.empty()) {
+    throw std::runtime_error("OpenGL program build failed:\n" + error);
+  }
+  return build.program;
+}
+
+OpenGlTransientRing::OpenGlTransientRing(const std::uint64_t capacityBytes)
+    : allocator_(capacityBytes) {}
+
+OpenGlTransientRing::~OpenGlTransientRing() {
+  if (buffer_ == 0) {
+    return;
+  }
+  for (void* fence : frameFences_) {
+    glDeleteSync(static_cast<GLsync>(fence));
+  }
+  if (mapped_ != nullptr) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  }
+  glDeleteBuffers(1, &buffer_);
+}
+
+void OpenGlTransientRing::create() {
+  GLint uniformAlignment = 0;
+  glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+  alignment_ = static_cast<std::uint64_t>(std::max(uniformAlignment, 1));
+
+  const auto size = static_cast<GLsizeiptr>(allocator_.capacity());
+  glGenBuffers(1, &buffer_);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+  if (bufferStorageSupported()) {
+    constexpr GLbitfield kFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, kFlags);
+    mapped_ = static_cast<std::byte*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, kFlags));
+    if (mapped_ == nullptr) {
+      // Immutable storage cannot be respecified, so start over with a mutable buffer.
+      glDeleteBuffers(1, &buffer_);
+      glGenBuffers(1, &buffer_);
+      glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+    }
+  }
+  if (mapped_ == nullptr) {
+    glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    shadow_.resize(static_cast<std::size_t>(size));
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  memory_ = core::TrackedAllocation{core::MemoryTag::GpuBuffer, static_cast<std::size_t>(size)};
+}
+
+OpenGlTransientRing::Allocation OpenGlTransientRing::allocate(const std::uint64_t sizeBytes, const std::uint64_t alignment) {
+  if (buffer_ == 0) {
+    create();
+  }
+  const std::uint64_t effectiveAlignment = std::max(alignment, alignment_);
+
+  if (mapped_ != nullptr) {
+    bool stalled = false;
+    while (true) {
+      if (const std::optional<std::uint64_t> offset = allocator_.tryAllocate(sizeBytes, effectiveAlignment)) {
+        return Allocation{buffer_, *offset, std::span<std::byte>{mapped_ + *offset, static_cast<std::size_t>(sizeBytes)}};
+      }
+      if (frameFences_.empty()) {
+        throw std::runtime_error(allocator_.exhaustedMessage(sizeBytes));
+      }
+      if (!stalled) {
+        ENGINE_PROFILE_ZONE("OpenGlTransientRing::stall");
+        stalled = true;
+        ++stalls_;
+      }
+      retireOldestFrame(true);
+    }
+  }
+
+  const std::optional<std::uint64_t> offset = allocator_.tryAllocate(sizeBytes, effectiveAlignment);
+  if (!offset.has_value()) {
+    throw std::runtime_error(allocator_.exhaustedMessage(sizeBytes));
+  }
+  if (*offset < lastEnd_) {
+    // Wrapped: orphan the storage instead of waiting for the GPU, then re-upload what this frame
+    // wrote before the wrap, since draws recorded after this point may still read it.
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(allocator_.capacity()), nullptr, GL_STREAM_DRAW);
+    if (lastEnd_ > frameBegin_) {
+      glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(frameBegin_), static_cast<GLsizeiptr>(lastEnd_ - frameBegin_),
+                      shadow_.data() + frameBegin_);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    dirtyBegin_ = *offset;
+    dirtyEnd_ = *offset;
+  }
+  if (dirtyEnd_ == dirtyBegin_) {
+    dirtyBegin_ = *offset;
+  }
+  dirtyEnd_ = *offset + sizeBytes;
+  lastEnd_ = dirtyEnd_;
+  return Allocation{buffer_, *offset, std::span<std::byte>{shadow_.data() + *offset, static_cast<std::size_t>(sizeBytes)}};
+}
+
+void OpenGlTransientRing::flush() {
+  if (mapped_ != nullptr || dirtyEnd_ == dirtyBegin_) {
+    return;
+  }
+  // Only never-used ranges of the current storage are written, so there is nothing to wait for.
+  const auto length = static_cast<GLsizeiptr>(dirtyEnd_ - dirtyBegin_);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, buffer_);
+  bool uploaded = false;
+  if (void* target = glMapBufferRange(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(dirtyBegin_), length,
+                                      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+      target != nullptr) {
+    std::memcpy(target, shadow_.data() + dirtyBegin_, static_cast<std::size_t>(length));
+    uploaded = glUnmapBuffer(GL_COPY_WRITE_BUFFER) == GL_TRUE;
+  }
+  if (!uploaded) {
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(dirtyBegin_), length, shadow_.data() + dirtyBegin_);
+  }
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  dirtyBegin_ = dirtyEnd_;
+}
+
+void OpenGlTransientRing::endFrame() {
+  if (buffer_ == 0) {
+    return;
+  }
+  allocator_.endFrame();
+  if (mapped_ == nullptr) {
+    // Orphaning keeps in-flight data alive in the driver, so the space is free right away.
+    allocator_.retireOldestFrame();
+    frameBegin_ = lastEnd_;
+    return;
+  }
+  frameFences_.push_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+  while (!frameFences_.empty() && retireOldestFrame(false)) {
+  }
+}
+
+bool OpenGlTransientRing::retireOldestFrame(const bool wait) {
+  auto* fence = static_cast<GLsync>(frameFences_.front());
+  if (!fenceSignaled(fence, wait)) {
+    return false;
+  }
+  glDeleteSync(fence);
+  frameFences_.pop_front();
+  allocator_.retireOldestFrame();
+  return true;
+}
+
+OpenGlUploadQueue::OpenGlUploadQueue(const std::uint64_t stagingBytes, const std::uint64_t frameBudgetBytes)
+    : staging_(stagingBytes), frameBudgetBytes_(frameBudgetBytes) {}
+
+OpenGlUploadQueue::~OpenGlUploadQueue() {
+  if (stagingBuffer_ == 0) {
+    return;
+  }
+  for (const TransferBatch& batch : inFlight_) {
+    glDeleteSync(static_cast<GLsync>(batch.fence));
+  }
+  if (mapped_ != nullptr) {
+    glBindBuffer(GL_COPY_READ_BUFFER, stagingBuffer_);
+    glUnmapBuffer(GL_COPY_READ_BUFFER);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  }
+  glDeleteBuffers(1, &stagingBuffer_);
+}
+
+void OpenGlUploadQueue::create() {
+  directStateAccess_ = openGlDirectStateAccessSupported();
+  const auto size = static_cast<GLsizeiptr>(staging_.capacity());
+  glGenBuffers(1, &stagingBuffer_);
+  glBindBuffer(GL_COPY_READ_BUFFER, stagingBuffer_);
+  if (bufferStorageSupported()) {
+    constexpr GLbitfield kFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_COPY_READ_BUFFER, size, nullptr, kFlags);
+    mapped_ = static_cast<std::byte*>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, size, kFlags));
+    if (mapped_ == nullptr) {
+      glDeleteBuffers(1, &stagingBuffer_);
+      glGenBuffers(1, &stagingBuffer_);
+      glBindBuffer(GL_COPY_READ_BUFFER, stagingBuffer_);
+    }
+  }
+  if (mapped_ == nullptr) {
+    glBufferData(GL_COPY_READ_BUFFER, size, nullptr, GL_STREAM_COPY);
+  }
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  memory_ = core::TrackedAllocation{core::MemoryTag::GpuBuffer, static_cast<std::size_t>(size)};
+}
+
+UploadTicket OpenGlUploadQueue::enqueue(const unsigned int buffer, const std::uint64_t offset, const std::span<const std::byte> data) {
+  ENGINE_PROFILE_ZONE("OpenGlUploadQueue::enqueue");
+  if (stagingBuffer_ == 0) {
+    create();
+  }
+  const UploadTicket ticket{nextTicket_++};
+
+  std::optional<std::uint64_t> stagingOffset = staging_.tryAllocate(data.size(), 16);
+  bool stalled = false;
+  while (!stagingOffset.has_value()) {
+    if (inFlight_.empty() && pending_.empty()) {
+      // Larger than the whole staging area: fall back to a direct (possibly synchronizing) write.
+      if (directStateAccess_) {
+        glNamedBufferSubData(buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(data.size()), data.data());
+      } else {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(data.size()), data.data());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+      }
+      ++directUploads_;
+      completedThrough_ = ticket.id;
+      return ticket;
+    }
+    if (!stalled) {
+      ENGINE_PROFILE_ZONE("OpenGlUploadQueue::stall");
+      stalled = true;
+      ++stalls_;
+    }
+    if (inFlight_.empty()) {
+      // Staging is full of transfers not issued yet: issue the oldest one over budget.
+      const PendingUpload& oldest = pending_.front();
+      (void)issue(oldest.sizeBytes - oldest.transferredBytes);
+    } else {
+      retireOldestBatch(true);
+    }
+    stagingOffset = staging_.tryAllocate(data.size(), 16);
+  }
+  // One allocator frame per upload, released when its last chunk's fence signals.
+  staging_.endFrame();
+
+  if (!data.empty()) {
+    if (mapped_ != nullptr) {
+      std::memcpy(mapped_ + *stagingOffset, data.data(), data.size());
+    } else {
+      // The range is only reused after its fence signaled, so the map needs no synchronization.
+      glBindBuffer(GL_COPY_READ_BUFFER, stagingBuffer_);
+      bool written = false;
+      if (void* target = glMapBufferRange(GL_COPY_READ_BUFFER, static_cast<GLintptr>(*stagingOffset),
+                                          static_cast<GLsizeiptr>(data.size()),
+                                          GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+          target != nullptr) {
+        std::memcpy(target, data.data(), data.size());
+        written = glUnmapBuffer(GL_COPY_READ_BUFFER) == GL_TRUE;
+      }
+      if (!written) {
+        glBufferSubData(GL_COPY_READ_BUFFER, static_cast<GLintptr>(*stagingOffset), static_cast<GLsizeiptr>(data.size()), data.data());
+      }
+      glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+  }
+  pending_.push_back(PendingUpload{ticket, buffer, offset, *stagingOffset, data.size(), 0});
+  return ticket;
+}
+
+void OpenGlUploadQueue::processFrame() {
+  ENGINE_PROFILE_ZONE("OpenGlUploadQueue::processFrame");
+  while (!inFlight_.empty() && retireOldestBatch(false)) {
+  }
+  bytesLastFrame_ = pending_.empty() ? 0 : issue(frameBudgetBytes_ == 0 ? std::numeric_limits<std::uint64_t>::max() : frameBudgetBytes_);
+  ENGINE_PROFILE_COUNTER("staged upload bytes", bytesLastFrame_);
+}
+
+// Copies up to budgetBytes of pending uploads, in order, and fences them as one batch.
+std::uint64_t OpenGlUploadQueue::issue(const std::uint64_t budgetBytes) {
+  TransferBatch batch{};
+  std::uint64_t issued = 0;
+  if (!directStateAccess_) {
+    glBindBuffer(GL_COPY_READ_BUFFER, stagingBuffer_);
+  }
+  while (!pending_.empty() && (issued < budgetBytes || pending_.front().transferredBytes == pending_.front().sizeBytes)) {
+    PendingUpload& upload = pending_.front();
+    const std::uint64_t chunk = std::min(upload.sizeBytes - upload.transferredBytes, budgetBytes - issued);
+    if (chunk > 0) {
+      const auto source = static_cast<GLintptr>(upload.stagingOffset + upload.transferredBytes);
+      const auto destination = static_cast<GLintptr>(upload.offset + upload.transferredBytes);
+      if (directStateAccess_) {
+        glCopyNamedBufferSubData(stagingBuffer_, upload.buffer, source, destination, static_cast<GLsizeiptr>(chunk));
+      } else {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, upload.buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, source, destination, static_cast<GLsizeiptr>(chunk));
+      }
+      upload.transferredBytes += chunk;
+      issued += chunk;
+    }
+    if (upload.transferredBytes == upload.sizeBytes) {
+      ++batch.finishedUploads;
+      batch.lastFinished = upload.ticket;
+      pending_.pop_front();
+    }
+  }
+  if (!directStateAccess_) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+  }
+  batch.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  inFlight_.push_back(batch);
+  return issued;
+}
+
+bool OpenGlUploadQueue::retireOldestBatch(const bool wait) {
+  const TransferBatch& batch = inFlight_.front();
+  if (!fenceSignaled(static_cast<GLsync>(batch.fence), wait)) {
+    return false;
+  }
+  glDeleteSync(static_cast<GLsync>(batch.fence));
+  for (std::uint32_t index = 0; index < batch.finishedUploads; ++index) {
+    staging_.retireOldestFrame();
+  }
+  if (batch.finishedUploads > 0) {
+    completedThrough_ = batch.lastFinished.id;
+  }
+  inFlight_.pop_front();
+  return true;
+}
+
+bool OpenGlUploadQueue::complete(const UploadTicket ticket) {
+  if (ticket.id <= completedThrough_) {
+    return true;
+  }
+  while (!inFlight_.empty() && retireOldestBatch(false)) {
+  }
+  return ticket.id <= completedThrough_;
+}
+
+void OpenGlUploadQueue::cancel(const unsigned int buffer) {
+  for (PendingUpload& upload : pending_) {
+    if (upload.buffer == buffer) {
+      upload.sizeBytes = upload.transferredBytes;
+    }
+  }
+}
+
+UploadQueueStats OpenGlUploadQueue::stats() const {
+  UploadQueueStats stats{};
+  stats.pendingUploads = static_cast<std::uint32_t>(pending_.size());
+  for (const PendingUpload& upload : pending_) {
+    stats.pendingBytes += upload.sizeBytes - upload.transferredBytes;
+  }
+  stats.bytesLastFrame = bytesLastFrame_;
+  stats.stalls = stalls_;
+  stats.directUploads = directUploads_;
+  return stats;
+}
+
+namespace {
+
+constexpr std::size_t kUncachedState = ~std::size_t{0};
+
+[[nodiscard]] std::size_t bufferTargetSlot(const GLenum target) {
+  switch (target) {
+  case GL_ARRAY_BUFFER:
+    return 0;
+  case GL_ELEMENT_ARRAY_BUFFER:
+    return 1;
+  case GL_UNIFORM_BUFFER:
+    return 2;
+  case GL_SHADER_STORAGE_BUFFER:
+    return 3;
+  default:
+    return kUncachedState;
+  }
+}
+
+[[nodiscard]] std::size_t textureTargetSlot(const GLenum target) {
+  switch (target) {
+  case GL_TEXTURE_2D:
+    return 0;
+  case GL_TEXTURE_3D:
+    return 1;
+  case GL_TEXTURE_CUBE_MAP:
+    return 2;
+  default:
+    return kUncachedState;
+  }
+}
+
+[[nodiscard]] std::size_t capabilitySlot(const GLenum capability) {
+  switch (capability) {
+  case GL_DEPTH_TEST:
+    return 0;
+  case GL_BLEND:
+    return 1;
+  case GL_CULL_FACE:
+    return 2;
+  default:
+    return kUncachedState;
+  }
+}
+
+} // namespace
+
+bool OpenGlStateCache::change(unsigned int& cached, const unsigned int value) {
+  if (cached == value) {
+    ++counters_.filtered;
+    return false;
+  }
+  cached = value;
+  ++counters_.issued;
+  return true;
+}
+
+void OpenGlStateCache::useProgram(const unsigned int program) {
+  if (change(program_, program)) {
+    glUseProgram(program);
+  }
+}
+
+void OpenGlStateCache::bindVertexArray(const unsigned int vertexArray) {
+  if (change(vertexArray_, vertexArray)) {
+    glBindVertexArray(vertexArray);
+    buffers_[bufferTargetSlot(GL_ELEMENT_ARRAY_BUFFER)] = kUnknown;
+  }
+}
+
+void OpenGlStateCache::bindBuffer(const unsigned int target, const unsigned int buffer) {
+  const std::size_t slot = bufferTargetSlot(target);
+  if (slot == kUncachedState) {
+    ++counters_.issued;
+    glBindBuffer(target, buffer);
+  } else if (change(buffers_[slot], buffer)) {
+    glBindBuffer(target, buffer);
+  }
+}
+
+void OpenGlStateCache::bindUniformBuffer(const std::uint32_t binding,
+                                         const unsigned int buffer,
+                                         const std::uint64_t offset,
+                                         const std::uint64_t sizeBytes) {
+  if (binding >= uniformBindings_.size()) {
+    uniformBindings_.resize(binding + 1);
+  }
+  UniformBinding& cached = uniformBindings_[binding];
+  if (cached.buffer == buffer && cached.offset == offset && cached.sizeBytes == sizeBytes) {
+    ++counters_.filtered;
+    return;
+  }
+  cached = UniformBinding{buffer, offset, sizeBytes};
+  ++counters_.issued;
+  if (offset == 0 && sizeBytes == 0) {
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+  } else {
+    glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(sizeBytes));
+  }
+  // Indexed binds also replace the generic binding point.
+  buffers_[bufferTargetSlot(GL_UNIFORM_BUFFER)] = buffer;
+}
+
+void OpenGlStateCache::bindTexture(const std::uint32_t unit, const unsigned int target, const unsigned int texture) {
+  const std::size_t slot = textureTargetSlot(target);
+  const bool cacheable = unit < kTextureUnits && slot != kUncachedState;
+  if (cacheable && textures_[unit][slot] == texture) {
+    ++counters_.filtered;
+    return;
+  }
+  if (change(activeTextureUnit_, unit)) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+  }
+  ++counters_.issued;
+  glBindTexture(target, texture);
+  if (cacheable) {
+    textures_[unit][slot] = texture;
+  }
+}
+
+void OpenGlStateCache::setEnabled(const unsigned int capability, const bool enabled) {
+  const std::size_t slot = capabilitySlot(capability);
+  if (slot == kUncachedState) {
+    ++counters_.issued;
+  } else if (!change(capabilities_[slot], enabled ? 1U : 0U)) {
+    return;
+  }
+  if (enabled) {
+    glEnable(capability);
+  } else {
+    glDisable(capability);
+  }
+}
+
+void OpenGlStateCache::setBlendFunc(const unsigned int sourceFactor, const unsigned int destinationFactor) {
+  if (blendFunc_[0] == sourceFactor && blendFunc_[1] == destinationFactor) {
+    ++counters_.filtered;
+    return;
+  }
+  blendFunc_[0] = sourceFactor;
+  blendFunc_[1] = destinationFactor;
+  ++counters_.issued;
+  glBlendFunc(sourceFactor, destinationFactor);
+}
+
+void OpenGlStateCache::setDepthFunc(const unsigned int function) {
+  if (change(depthFunc_, function)) {
+    glDepthFunc(function);
+  }
+}
+
+void OpenGlStateCache::setViewport(const int x, const int y, const int width, const int height) {
+  if (viewportKnown_ && viewport_[0] == x && viewport_[1] == y && viewport_[2] == width && viewport_[3] == height) {
+    ++counters_.filtered;
+    return;
+  }
+  viewport_[0] = x;
+  viewport_[1] = y;
+  viewport_[2] = width;
+  viewport_[3] = height;
+  viewportKnown_ = true;
+  ++counters_.issued;
+  glViewport(x, y, width, height);
+}
+
+void OpenGlStateCache::forgetProgram(const unsigned int program) {
+  if (program_ == program) {
+    program_ = kUnknown;
+  }
+}
+
+void OpenGlStateCache::forgetVertexArray(const unsigned int vertexArray) {
+  if (vertexArray_ == vertexArray) {
+    vertexArray_ = kUnknown;
+    buffers_[bufferTargetSlot(GL_ELEMENT_ARRAY_BUFFER)] = kUnknown;
+  }
+}
+
+void OpenGlStateCache::forgetBuffer(const unsigned int buffer) {
+  for (unsigned int& bound : buffers_) {
+    if (bound == buffer) {
+      bound = kUnknown;
+    }
+  }
+  for (UniformBinding& binding : uniformBindings_) {
+    if (binding.buffer == buffer) {
+      binding.buffer = kUnknown;
+    }
+  }
+}
+
+void OpenGlStateCache::forgetTexture(const unsigned int texture) {
+  for (auto& unit : textures_) {
+    for (unsigned int& bound : unit) {
+      if (bound == texture) {
+        bound = kUnknown;
+      }
+    }
+  }
+}
+
+void OpenGlStateCache::invalidate() {
+  program_ = kUnknown;
+  vertexArray_ = kUnknown;
+  std::fill(std::begin(buffers_), std::end(buffers_), kUnknown);
+  uniformBindings_.clear();
+  activeTextureUnit_ = kUnknown;
+  for (auto& unit : textures_) {
+    std::fill(std::begin(unit), std::end(unit), kUnknown);
+  }
+  std::fill(std::begin(capabilities_), std::end(capabilities_), kUnknown);
+  std::fill(std::begin(blendFunc_), std::end(blendFunc_), kUnknown);
+  depthFunc_ = kUnknown;
+  viewportKnown_ = false;
+}
+
+GlStateCacheCounters OpenGlStateCache::takeCounters() {
+  const GlStateCacheCounters counters = counters_;
+  counters_ = {};
+  return counters;
+}
+
+OpenGlDeferredDeletionQueue::~OpenGlDeferredDeletionQueue() {
+  for (const FrameFence& frame : fences_) {
+    glDeleteSync(static_cast<GLsync>(frame.fence));
+  }
+  for (const PendingDeletion& object : pending_) {
+    deleteObject(object);
+  }
+}
+
+void OpenGlDeferredDeletionQueue::retire(const GlObjectKind kind, const unsigned int name, core::TrackedAllocation memory) {
+  pending_.push_back(PendingDeletion{kind, name, nextFrame_, std::move(memory)});
+}
+
+void OpenGlDeferredDeletionQueue::endFrame() {
+  ENGINE_PROFILE_ZONE("OpenGlDeferredDeletionQueue::endFrame");
+  // Frames that retired nothing need no fence; a later fence covers their commands too.
+  if (!pending_.empty() && pending_.back().frame == nextFrame_) {
+    fences_.push_back(FrameFence{nextFrame_, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)});
+  }
+  ++nextFrame_;
+
+  while (!fences_.empty() && fenceSignaled(static_cast<GLsync>(fences_.front().fence), false)) {
+    completedFrames_ = fences_.front().frame + 1;
+    glDeleteSync(static_cast<GLsync>(fences_.front().fence));
+    fences_.pop_front();
+  }
+  while (!pending_.empty() && pending_.front().frame < completedFrames_) {
+    deleteObject(pending_.front());
+    pending_.pop_front();
+  }
+}
+
+void OpenGlDeferredDeletionQueue::deleteObject(const PendingDeletion& object) {
+  switch (object.kind) {
+    case GlObjectKind::Buffer:
+      if (stateCache_ != nullptr) {
+        stateCache_->forgetBuffer(object.name);
+      }
+      glDeleteBuffers(1, &object.name);
+      break;
+    case GlObjectKind::Texture:
+      if (stateCache_ != nullptr) {
+        stateCache_->forgetTexture(object.name);
+      }
+      glDeleteTextures(1, &object.name);
+      break;
+    case GlObjectKind::Program:
+      if (stateCache_ != nullptr) {
+        stateCache_->forgetProgram(object.name);
+      }
+      glDeleteProgram(object.name);
+      break;
+    case GlObjectKind::VertexArray:
+      if (stateCache_ != nullptr) {
+        stateCache_->forgetVertexArray(object.name);
+      }
+      glDeleteVertexArrays(1, &object.name);
+      break;
+  }
+}
+
+OpenGlTimestampProfiler::~OpenGlTimestampProfiler() {
+  for (auto& slot : slots_) {
+    if (!slot.queries.empty()) {
+      glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+    }
+  }
+}
+
+void OpenGlTimestampProfiler::beginFrame() {
+#if ENGINE_ENABLE_PROFILING
+  current_ = (current_ + 1) % kFramesInFlight;
+  FrameSlot& slot = slots_[current_];
+  if (slot.pending) {
+    resolve(slot);
+  }
+
+  slot.frameIndex = core::Profiler::instance().currentFrameIndex();
+  slot.usedQueries = 0;
+  slot.zones.clear();
+  slot.openZones.clear();
+
+  GLint64 gpuNow = 0;
+  glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+  slot.gpuToCpuOffsetNs = static_cast<std::int64_t>(core::Profiler::nowNs()) - static_cast<std::int64_t>(gpuNow);
+
+  beginPass("GPU frame");
+#endif
+}
+
+void OpenGlTimestampProfiler::endFrame() {
+#if ENGINE_ENABLE_PROFILING
+  FrameSlot& slot = slots_[current_];
+  while (!slot.openZones.empty()) {
+    endPass();
+  }
+  slot.pending = true;
+#endif
+}
+
+void OpenGlTimestampProfiler::beginPass(const std::string_view name) {
+#if ENGINE_ENABLE_PROFILING
+  // Zones are reported frames later, when the caller's name may be gone.
+  if (lastInternedName_.empty() || name != lastPassName_) {
+    lastPassName_ = std::string{name};
+    lastInternedName_ = core::Profiler::instance().internName(name);
+  }
+  FrameSlot& slot = slots_[current_];
+  slot.openZones.push_back(slot.zones.size());
+  slot.zones.push_back(PendingZone{lastInternedName_, issue(slot), 0, static_cast<std::uint32_t>(slot.openZones.size() - 1)});
+#else
+  (void)name;
+#endif
+}
+
+void OpenGlTimestampProfiler::endPass() {
+#if ENGINE_ENABLE_PROFILING
+  FrameSlot& slot = slots_[current_];
+  if (slot.openZones.empty()) {
+    return;
+  }
+  slot.zones[slot.openZones.back()].endQuery = issue(slot);
+  slot.openZones.pop_back();
+#endif
+}
+
+std::uint32_t OpenGlTimestampProfiler::issue(FrameSlot& slot) {
+  if (slot.usedQueries == slot.queries.size()) {
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    slot.queries.push_back(query);
+  }
+  glQueryCounter(slot.queries[slot.usedQueries], GL_TIMESTAMP);
+  return slot.usedQueries++;
+}
+
+void OpenGlTimestampProfiler::resolve(FrameSlot& slot) {
+  slot.pending = false;
+  if (slot.usedQueries == 0) {
+    return;
+  }
+
+  GLuint available = GL_FALSE;
+  glGetQueryObjectuiv(slot.queries[slot.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+  if (available != GL_TRUE) {
+    return;
+  }
+
+  std::vector<GLuint64> timestamps(slot.usedQueries);
+  for (std::uint32_t index = 0; index < slot.usedQueries; ++index) {
+    glGetQueryObjectui64v(slot.queries[index], GL_QUERY_RESULT, &timestamps[index]);
+  }
+
+  const auto toCpuNs = [&slot](const GLuint64 gpuNs) {
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(gpuNs) + slot.gpuToCpuOffsetNs);
+  };
+
+  std::vector<core::GpuZoneRecord> zones;
+  zones.reserve(slot.zones.size());
+  for (const auto& zone : slot.zones) {
+    zones.push_back(core::GpuZoneRecord{zone.name, toCpuNs(timestamps[zone.beginQuery]), toCpuNs(timestamps[zone.endQuery]), zone.depth});
+  }
+
+  // zones.front() is the frame zone opened by beginFrame().
+  const double gpuFrameMs = static_cast<double>(zones.front().endNs - zones.front().startNs) / 1.0e6;
+  core::Profiler::instance().recordGpuFrame(slot.frameIndex, gpuFrameMs, std::move(zones));
+}
+
+std::optional<ProgramBinaryCacheStats> openGlProgramCacheStats(const IRenderDevice& device) {
+  const auto* openGlDevice = dynamic_cast<const OpenGlRenderDevice*>(&device);
+  if (openGlDevice == nullptr) {
+    return std::nullopt;
+  }
+  return openGlDevice->programCacheStats();
+}
+
+std::optional<PipelineDedupStats> openGlPipelineDedupStats(const IRenderDevice& device) {
+  const auto* openGlDevice = dynamic_cast<const OpenGlRenderDevice*>(&device);
+  if (openGlDevice == nullptr) {
+    return std::nullopt;
+  }
+  return openGlDevice->pipelineDedupStats();
+}
+
+std::optional<UploadQueueStats> openGlUploadQueueStats(const IRenderDevice& device) {
+  const auto* openGlDevice = dynamic_cast<const OpenGlRenderDevice*>(&device);
+  if (openGlDevice == nullptr) {
+    return std::nullopt;
+  }
+  return openGlDevice->uploadQueueStats();
 }
 
 } // namespace engine::render
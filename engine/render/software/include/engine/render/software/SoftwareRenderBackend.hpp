@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+
+#include "engine/platform/PlatformTypes.hpp"
+
+namespace engine::render {
+
+class ICommandContext;
+class IRenderBackend;
+
+struct SoftwareRenderBackendConfig {
+  // 0 selects std::thread::hardware_concurrency().
+  std::uint32_t workerCount = 0;
+  // Screen tile edge in pixels; rounded up to a multiple of 4 for the 4-wide pixel loop.
+  std::uint32_t tileSize = 64;
+  float clearColor[4]{0.0f, 0.0f, 0.0f, 1.0f};
+};
+
+// Vertex buffers are read with the sample mesh layout: position[3], normal[3], uv[2] as floats.
+inline constexpr std::size_t kSoftwareVertexStride = 8 * sizeof(float);
+
+// Uniform buffer bindings read by the built-in Blinn-Phong pipeline. Both blocks are laid out
+// std140-compatible so the same buffers can feed the GLSL version of the shader.
+inline constexpr std::uint32_t kSoftwareFrameConstantsBinding = 0;
+inline constexpr std::uint32_t kSoftwareDrawConstantsBinding = 1;
+
+struct SoftwareFrameConstants {
+  float view[16]{1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  float projection[16]{1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  float cameraPosition[4]{0.0f, 0.0f, 5.0f, 1.0f};
+  float lightPosition[4]{2.5f, 4.0f, 2.5f, 1.0f};
+  float lightColor[4]{1.0f, 1.0f, 1.0f, 1.0f};
+  float ambientIntensity = 0.18f;
+  float padding[3]{};
+};
+
+struct SoftwareDrawConstants {
+  float model[16]{1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+  float baseColor[4]{1.0f, 1.0f, 1.0f, 1.0f};
+  float metallic = 0.0f;
+  float roughness = 0.7f;
+  float ambientOcclusion = 1.0f;
+  float highlight = 0.0f;
+  float selected = 0.0f;
+  float padding[3]{};
+};
+
+struct SoftwareFramebufferView {
+  platform::Extent2D extent{};
+  // Pixels per row in colorRgba8; at least extent.width.
+  std::uint32_t rowPitch = 0;
+  // Top row first, one RGBA8 pixel per element with red in the lowest byte.
+  std::span<const std::uint32_t> colorRgba8;
+};
+
+struct SoftwareFrameStats {
+  std::uint64_t trianglesSubmitted = 0;
+  std::uint64_t trianglesRasterized = 0;
+  std::uint64_t binEntries = 0;
+  std::uint32_t workerCount = 0;
+  double geometryMs = 0.0;
+  double rasterMs = 0.0;
+};
+
+[[nodiscard]] std::unique_ptr<IRenderBackend> createSoftwareRenderBackend(const SoftwareRenderBackendConfig& config = {});
+
+// Both return std::nullopt when the context was not created by a software render device.
+[[nodiscard]] std::optional<SoftwareFramebufferView> softwareColorTarget(const ICommandContext& commandContext);
+[[nodiscard]] std::optional<SoftwareFrameStats> softwareFrameStats(const ICommandContext& commandContext);
+
+} // namespace engine::render
@@ -0,0 +1,1268 @@
+#include "engine/render/software/SoftwareRenderBackend.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE_SOFTWARE_RASTER_SSE2 1
+#else
+#define ENGINE_SOFTWARE_RASTER_SSE2 0
+#endif
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "engine/core/MemoryTracker.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/core/WorkerPool.hpp"
+#include "engine/render/ICommandContext.hpp"
+#include "engine/render/IRenderBackend.hpp"
+#include "engine/render/IRenderDevice.hpp"
+#include "engine/render/RenderStats.hpp"
+#include "engine/render/TransientRingAllocator.hpp"
+
+namespace engine::render {
+namespace {
+
+constexpr std::uint32_t kMaxUniformBindings = 4;
+constexpr std::uint32_t kChunksPerWorker = 4;
+constexpr std::uint32_t kMinTrianglesPerChunk = 256;
+constexpr float kMinTriangleArea = 1.0e-6f;
+constexpr float kMinClipW = 1.0e-6f;
+// Coverage uses vertex positions snapped to 1/kSubpixelSteps of a pixel.
+constexpr double kSubpixelSteps = 16.0;
+
+struct Vec3 {
+  float x = 0.0f;
+  float y = 0.0f;
+  float z = 0.0f;
+};
+
+struct Vec4 {
+  float x = 0.0f;
+  float y = 0.0f;
+  float z = 0.0f;
+  float w = 0.0f;
+};
+
+[[nodiscard]] Vec3 operator+(const Vec3& a, const Vec3& b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+[[nodiscard]] Vec3 operator-(const Vec3& a, const Vec3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+[[nodiscard]] Vec3 operator*(const Vec3& a, const float scalar) { return {a.x * scalar, a.y * scalar, a.z * scalar}; }
+[[nodiscard]] float dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+[[nodiscard]] Vec3 normalize(const Vec3& v) {
+  const float len = std::sqrt(dot(v, v));
+  if (len <= 0.0001f) {
+    return {0.0f, 0.0f, 1.0f};
+  }
+  return v * (1.0f / len);
+}
+
+[[nodiscard]] Vec3 mix(const Vec3& a, const Vec3& b, const float t) { return a + (b - a) * t; }
+
+[[nodiscard]] Vec4 lerp(const Vec4& a, const Vec4& b, const float t) {
+  return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t};
+}
+
+// Matrices are column-major, matching the GL path.
+[[nodiscard]] Vec4 transform(const float (&m)[16], const float x, const float y, const float z, const float w) {
+  return {m[0] * x + m[4] * y + m[8] * z + m[12] * w,
+          m[1] * x + m[5] * y + m[9] * z + m[13] * w,
+          m[2] * x + m[6] * y + m[10] * z + m[14] * w,
+          m[3] * x + m[7] * y + m[11] * z + m[15] * w};
+}
+
+void multiply(const float (&left)[16], const float (&right)[16], float (&out)[16]) {
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      float sum = 0.0f;
+      for (int k = 0; k < 4; ++k) {
+        sum += left[k * 4 + row] * right[col * 4 + k];
+      }
+      out[col * 4 + row] = sum;
+    }
+  }
+}
+
+// Equivalent of GLSL mat3(transpose(inverse(model))), stored column-major.
+void normalMatrix(const float (&m)[16], float (&out)[9]) {
+  const float a = m[0], b = m[4], c = m[8];
+  const float d = m[1], e = m[5], f = m[9];
+  const float g = m[2], h = m[6], i = m[10];
+
+  const float coA = e * i - f * h;
+  const float coB = -(d * i - f * g);
+  const float coC = d * h - e * g;
+  const float det = a * coA + b * coB + c * coC;
+  const float invDet = std::abs(det) > 1.0e-12f ? 1.0f / det : 0.0f;
+
+  // inverse = adjugate / det; transpose(inverse) = cofactor matrix / det.
+  const float cofactor[9] = {coA, coB, coC,
+                             -(b * i - c * h), a * i - c * g, -(a * h - b * g),
+                             b * f - c * e, -(a * f - c * d), a * e - b * d};
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 3; ++col) {
+      out[col * 3 + row] = cofactor[row * 3 + col] * invDet;
+    }
+  }
+}
+
+#if ENGINE_SOFTWARE_RASTER_SSE2
+
+struct Float4 {
+  __m128 value;
+
+  [[nodiscard]] static Float4 broadcast(const float scalar) { return {_mm_set1_ps(scalar)}; }
+  [[nodiscard]] static Float4 ramp(const float base) { return {_mm_setr_ps(base, base + 1.0f, base + 2.0f, base + 3.0f)}; }
+  [[nodiscard]] static Float4 load(const float* source) { return {_mm_loadu_ps(source)}; }
+  void store(float* destination) const { _mm_storeu_ps(destination, value); }
+};
+
+[[nodiscard]] Float4 operator+(const Float4 a, const Float4 b) { return {_mm_add_ps(a.value, b.value)}; }
+[[nodiscard]] Float4 operator-(const Float4 a, const Float4 b) { return {_mm_sub_ps(a.value, b.value)}; }
+[[nodiscard]] Float4 operator*(const Float4 a, const Float4 b) { return {_mm_mul_ps(a.value, b.value)}; }
+[[nodiscard]] int lessMask(const Float4 a, const Float4 b) { return _mm_movemask_ps(_mm_cmplt_ps(a.value, b.value)); }
+
+// Four doubles as two SSE2 pairs, for the integer-valued coverage edge functions.
+struct Double4 {
+  __m128d low;
+  __m128d high;
+
+  [[nodiscard]] static Double4 broadcast(const double scalar) { return {_mm_set1_pd(scalar), _mm_set1_pd(scalar)}; }
+  // base + lane * step.
+  [[nodiscard]] static Double4 ramp(const double base, const double step) {
+    return {_mm_setr_pd(base, base + step), _mm_setr_pd(base + 2.0 * step, base + 3.0 * step)};
+  }
+  [[nodiscard]] static Double4 load(const double* source) { return {_mm_loadu_pd(source), _mm_loadu_pd(source + 2)}; }
+  void store(double* destination) const {
+    _mm_storeu_pd(destination, low);
+    _mm_storeu_pd(destination + 2, high);
+  }
+};
+
+[[nodiscard]] Double4 operator+(const Double4 a, const Double4 b) { return {_mm_add_pd(a.low, b.low), _mm_add_pd(a.high, b.high)}; }
+[[nodiscard]] Double4 operator-(const Double4 a, const Double4 b) { return {_mm_sub_pd(a.low, b.low), _mm_sub_pd(a.high, b.high)}; }
+[[nodiscard]] Double4 operator*(const Double4 a, const Double4 b) { return {_mm_mul_pd(a.low, b.low), _mm_mul_pd(a.high, b.high)}; }
+// Bit n is set when lane n of every argument is >= 0.
+[[nodiscard]] int nonNegativeMask(const Double4 a, const Double4 b, const Double4 c) {
+  const __m128d zero = _mm_setzero_pd();
+  const __m128d low = _mm_and_pd(_mm_and_pd(_mm_cmpge_pd(a.low, zero), _mm_cmpge_pd(b.low, zero)), _mm_cmpge_pd(c.low, zero));
+  const __m128d high = _mm_and_pd(_mm_and_pd(_mm_cmpge_pd(a.high, zero), _mm_cmpge_pd(b.high, zero)), _mm_cmpge_pd(c.high, zero));
+  return _mm_movemask_pd(low) | (_mm_movemask_pd(high) << 2);
+}
+
+#else
+
+struct Float4 {
+  std::array<float, 4> value{};
+
+  [[nodiscard]] static Float4 broadcast(const float scalar) { return {{scalar, scalar, scalar, scalar}}; }
+  [[nodiscard]] static Float4 ramp(const float base) { return {{base, base + 1.0f, base + 2.0f, base + 3.0f}}; }
+  [[nodiscard]] static Float4 load(const float* source) { return {{source[0], source[1], source[2], source[3]}}; }
+  void store(float* destination) const { std::memcpy(destination, value.data(), sizeof(value)); }
+};
+
+[[nodiscard]] Float4 operator+(const Float4 a, const Float4 b) {
+  return {{a.value[0] + b.value[0], a.value[1] + b.value[1], a.value[2] + b.value[2], a.value[3] + b.value[3]}};
+}
+[[nodiscard]] Float4 operator-(const Float4 a, const Float4 b) {
+  return {{a.value[0] - b.value[0], a.value[1] - b.value[1], a.value[2] - b.value[2], a.value[3] - b.value[3]}};
+}
+[[nodiscard]] Float4 operator*(const Float4 a, const Float4 b) {
+  return {{a.value[0] * b.value[0], a.value[1] * b.value[1], a.value[2] * b.value[2], a.value[3] * b.value[3]}};
+}
+[[nodiscard]] int lessMask(const Float4 a, const Float4 b) {
+  int mask = 0;
+  for (int lane = 0; lane < 4; ++lane) {
+    const auto index = static_cast<std::size_t>(lane);
+    mask |= a.value[index] < b.value[index] ? (1 << lane) : 0;
+  }
+  return mask;
+}
+
+struct Double4 {
+  std::array<double, 4> value{};
+
+  [[nodiscard]] static Double4 broadcast(const double scalar) { return {{scalar, scalar, scalar, scalar}}; }
+  [[nodiscard]] static Double4 ramp(const double base, const double step) {
+    return {{base, base + step, base + 2.0 * step, base + 3.0 * step}};
+  }
+  [[nodiscard]] static Double4 load(const double* source) { return {{source[0], source[1], source[2], source[3]}}; }
+  void store(double* destination) const { std::memcpy(destination, value.data(), sizeof(value)); }
+};
+
+[[nodiscard]] Double4 operator+(const Double4 a, const Double4 b) {
+  return {{a.value[0] + b.value[0], a.value[1] + b.value[1], a.value[2] + b.value[2], a.value[3] + b.value[3]}};
+}
+[[nodiscard]] Double4 operator-(const Double4 a, const Double4 b) {
+  return {{a.value[0] - b.value[0], a.value[1] - b.value[1], a.value[2] - b.value[2], a.value[3] - b.value[3]}};
+}
+[[nodiscard]] Double4 operator*(const Double4 a, const Double4 b) {
+  return {{a.value[0] * b.value[0], a.value[1] * b.value[1], a.value[2] * b.value[2], a.value[3] * b.value[3]}};
+}
+[[nodiscard]] int nonNegativeMask(const Double4 a, const Double4 b, const Double4 c) {
+  int mask = 0;
+  for (int lane = 0; lane < 4; ++lane) {
+    const auto index = static_cast<std::size_t>(lane);
+    mask |= a.value[index] >= 0.0 && b.value[index] >= 0.0 && c.value[index] >= 0.0 ? (1 << lane) : 0;
+  }
+  return mask;
+}
+
+#endif
+
+[[nodiscard]] std::uint32_t packRgba8(const Vec3& color, const float alpha) {
+  const auto channel = [](const float value) {
+    return static_cast<std::uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+  };
+  return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) | (channel(alpha) << 24);
+}
+
+struct ClipVertex {
+  Vec4 clip{};
+  Vec3 world{};
+  Vec3 normal{};
+};
+
+[[nodiscard]] ClipVertex lerp(const ClipVertex& a, const ClipVertex& b, const float t) {
+  return {lerp(a.clip, b.clip, t), mix(a.world, b.world, t), mix(a.normal, b.normal, t)};
+}
+
+// Screen-space triangle ready for rasterization. Barycentric weights of vertices 0..2 are the
+// plane equations edge[k][0] * x + edge[k][1] * y + edge[k][2]; per-vertex attributes are
+// pre-divided by clip w for perspective-correct interpolation.
+//
+// Coverage is decided separately by coverage[k], the same edge functions unnormalized over
+// subpixel coordinates. Those values are integers, exact in double precision within about a
+// million pixels of the viewport, so a pixel center on an edge shared by two triangles is
+// classified consistently and the top-left rule (folded into coverage[k][2]) gives it to exactly
+// one of them.
+struct SetupTriangle {
+  std::int32_t minX = 0;
+  std::int32_t minY = 0;
+  std::int32_t maxX = 0;
+  std::int32_t maxY = 0;
+  float edge[3][3]{};
+  double coverage[3][3]{};
+  float depth[3]{};
+  float invW[3]{};
+  Vec3 worldOverW[3]{};
+  Vec3 normalOverW[3]{};
+  std::uint32_t drawIndex = 0;
+};
+
+struct SoftwareBuffer;
+
+// Holds the buffers it reads, so destroying or updating them before endFrame() cannot change or
+// free the data a recorded draw rasterizes.
+struct DrawRecord {
+  std::shared_ptr<const SoftwareBuffer> vertexBuffer;
+  std::shared_ptr<const SoftwareBuffer> indexBuffer;
+  const std::byte* vertexData = nullptr;
+  std::size_t vertexCount = 0;
+  const std::uint32_t* indices = nullptr;
+  std::size_t indexCount = 0;
+  std::uint32_t firstElement = 0;
+  std::int32_t vertexOffset = 0;
+  std::uint32_t triangleCount = 0;
+  std::uint32_t frameConstantsIndex = 0;
+  SoftwareDrawConstants constants{};
+  float modelViewProjection[16]{};
+  float normalMatrix[9]{};
+};
+
+struct GeometryChunk {
+  std::vector<SetupTriangle> triangles;
+  std::vector<std::vector<std::uint32_t>> bins;
+  std::uint64_t trianglesSubmitted = 0;
+  std::uint64_t binEntries = 0;
+};
+
+struct SoftwareBuffer {
+  BufferCreateInfo info{};
+  std::string debugName;
+  std::vector<std::byte> storage;
+  core::TrackedAllocation memory;
+};
+
+struct SoftwareTexture {
+  TextureCreateInfo info{};
+  std::string debugName;
+  std::vector<std::byte> storage;
+  core::TrackedAllocation memory;
+};
+
+struct SoftwareShader {
+  ShaderStage stage = ShaderStage::Vertex;
+  std::size_t byteCodeSize = 0;
+  std::string debugName;
+};
+
+struct SoftwarePipeline {
+  GraphicsPipelineCreateInfo info{};
+  std::string debugName;
+};
+
+class SoftwareCommandContext;
+
+class SoftwareRenderDevice final : public IRenderDevice {
+public:
+  explicit SoftwareRenderDevice(const SoftwareRenderBackendConfig& config)
+      : config_(config), workers_(config.workerCount) {
+    config_.tileSize = std::max(4U, (config_.tileSize + 3U) & ~3U);
+  }
+
+  [[nodiscard]] std::unique_ptr<ICommandContext> createCommandContext() override;
+
+  [[nodiscard]] BufferHandle createBuffer(const BufferCreateInfo& createInfo) override {
+    SoftwareBuffer buffer{};
+    buffer.info = createInfo;
+    buffer.debugName = std::string{createInfo.debugName};
+    buffer.memory = core::TrackedAllocation{core::MemoryTag::GpuBuffer, static_cast<std::size_t>(createInfo.sizeBytes)};
+    buffer.storage.resize(static_cast<std::size_t>(createInfo.sizeBytes));
+    if (createInfo.initialData != nullptr) {
+      std::memcpy(buffer.storage.data(), createInfo.initialData, buffer.storage.size());
+    }
+
+    std::lock_guard lock{resourceMutex_};
+    BufferHandle handle{nextBufferHandle_++};
+    buffers_.emplace(handle.id, std::make_shared<SoftwareBuffer>(std::move(buffer)));
+    return handle;
+  }
+
+  void destroyBuffer(const BufferHandle handle) override {
+    if (handle.id == transientBuffer_.id) {
+      return;
+    }
+    std::lock_guard lock{resourceMutex_};
+    buffers_.erase(handle.id);
+  }
+
+  // Draws copy their uniform blocks when recorded and hold the vertex and index buffers they read
+  // until endFrame(). Updating a buffer that a recorded draw still holds writes a copy, so the draw
+  // sees the contents it was recorded with, as on the GPU backends. Must not race endFrame().
+  void updateBuffer(const BufferHandle handle, const std::uint64_t offset, const std::span<const std::byte> data) override {
+    const auto it = buffers_.find(handle.id);
+    if (it == buffers_.end()) {
+      throw std::runtime_error("updateBuffer called with an unknown buffer handle");
+    }
+    if (offset + data.size() > it->second->storage.size()) {
+      throw std::runtime_error("updateBuffer range exceeds buffer '" + it->second->debugName + "'");
+    }
+    if (data.empty()) {
+      return;
+    }
+    // The transient ring never rewrites data a pending frame reads.
+    if (it->second.use_count() > 1 && handle.id != transientBuffer_.id) {
+      const SoftwareBuffer& recorded = *it->second;
+      auto copy = std::make_shared<SoftwareBuffer>();
+      copy->info = recorded.info;
+      copy->debugName = recorded.debugName;
+      copy->memory = core::TrackedAllocation{core::MemoryTag::GpuBuffer, recorded.storage.size()};
+      copy->storage = recorded.storage;
+      std::lock_guard lock{resourceMutex_};
+      it->second = std::move(copy);
+    }
+    std::memcpy(it->second->storage.data() + offset, data.data(), data.size());
+  }
+
+  // Buffers are plain memory, so the copy happens immediately; like updateBuffer(), call it
+  // between frames.
+  [[nodiscard]] UploadTicket queueBufferUpload(const BufferHandle handle,
+                                               const std::uint64_t offset,
+                                               const std::span<const std::byte> data) override {
+    updateBuffer(handle, offset, data);
+    return UploadTicket{++lastUploadTicket_};
+  }
+
+  [[nodiscard]] bool uploadComplete(const UploadTicket ticket) override { return ticket.id <= lastUploadTicket_; }
+
+  // The ring is an ordinary buffer, so draws read transient data like any other buffer in endFrame().
+  [[nodiscard]] TransientAllocation allocateTransient(const std::uint64_t sizeBytes, const std::uint64_t alignment) override {
+    if (transientStorage_ == nullptr) {
+      BufferCreateInfo createInfo{};
+      createInfo.sizeBytes = transientRing_.capacity();
+      createInfo.usage = BufferUsage::Uniform;
+      createInfo.cpuVisible = true;
+      createInfo.debugName = "transient ring";
+      transientBuffer_ = createBuffer(createInfo);
+      transientStorage_ = buffers_.at(transientBuffer_.id)->storage.data();
+    }
+    const std::optional<std::uint64_t> offset = transientRing_.tryAllocate(sizeBytes, alignment);
+    if (!offset.has_value()) {
+      throw std::runtime_error(transientRing_.exhaustedMessage(sizeBytes));
+    }
+    return TransientAllocation{transientBuffer_, *offset,
+                               std::span<std::byte>{transientStorage_ + *offset, static_cast<std::size_t>(sizeBytes)}};
+  }
+
+  // Called once a frame has been rasterized; nothing reads its transient data any more.
+  void retireTransientFrame() {
+    transientRing_.endFrame();
+    transientRing_.retireOldestFrame();
+  }
+
+  // Software textures are plain texel storage; decode compressed data with decodeTextureToRgba8() first.
+  [[nodiscard]] bool supportsTextureFormat(const TextureFormat format) const override { return !isBlockCompressed(format); }
+
+  [[nodiscard]] TextureHandle createTexture(const TextureCreateInfo& createInfo) override {
+    if (!supportsTextureFormat(createInfo.format)) {
+      throw std::runtime_error("Software textures cannot use block-compressed formats");
+    }
+    SoftwareTexture texture{};
+    texture.info = createInfo;
+    texture.info.firstResidentMip = std::min(createInfo.firstResidentMip, textureMipCount(createInfo) - 1);
+    texture.debugName = std::string{createInfo.debugName};
+    texture.memory = core::TrackedAllocation{core::MemoryTag::GpuTexture, textureByteSize(createInfo)};
+    texture.storage.resize(texture.memory.bytes());
+
+    std::lock_guard lock{resourceMutex_};
+    TextureHandle handle{nextTextureHandle_++};
+    textures_.emplace(handle.id, std::move(texture));
+    return handle;
+  }
+
+  void destroyTexture(const TextureHandle handle) override {
+    std::lock_guard lock{resourceMutex_};
+    textures_.erase(handle.id);
+  }
+
+  // Mip levels are stored finest first in one allocation.
+  void updateTexture(const TextureHandle handle, const std::uint32_t mipLevel, const std::span<const std::byte> texels) override {
+    std::lock_guard lock{resourceMutex_};
+    const auto it = textures_.find(handle.id);
+    if (it == textures_.end()) {
+      throw std::runtime_error("updateTexture called with an unknown texture handle");
+    }
+    const TextureCreateInfo& info = it->second.info;
+    if (mipLevel >= textureMipCount(info) || texels.size() != textureMipByteSize(info, mipLevel)) {
+      throw std::runtime_error("updateTexture level " + std::to_string(mipLevel) + " does not match texture '" +
+                               it->second.debugName + "'");
+    }
+    const std::size_t offset = textureByteSize(info) - textureByteSize(info, mipLevel);
+    std::memcpy(it->second.storage.data() + offset, texels.data(), texels.size());
+  }
+
+  // The software device keeps the full chain in memory and only records the residency.
+  void setTextureResidency(const TextureHandle handle, const std::uint32_t firstResidentMip) override {
+    std::lock_guard lock{resourceMutex_};
+    if (const auto it = textures_.find(handle.id); it != textures_.end()) {
+      it->second.info.firstResidentMip = std::min(firstResidentMip, textureMipCount(it->second.info) - 1);
+    }
+  }
+
+  [[nodiscard]] ShaderHandle createShader(const ShaderCreateInfo& createInfo) override {
+    // Shader byte code targets the GPU backends; the software pipeline runs its built-in
+    // Blinn-Phong shading and only tracks the stage for pipeline validation.
+    std::lock_guard lock{resourceMutex_};
+    ShaderHandle handle{nextShaderHandle_++};
+    shaders_.emplace(handle.id, SoftwareShader{createInfo.stage, createInfo.byteCodeSize, std::string{createInfo.debugName}});
+    return handle;
+  }
+
+  void destroyShader(const ShaderHandle handle) override {
+    std::lock_guard lock{resourceMutex_};
+    shaders_.erase(handle.id);
+  }
+
+  [[nodiscard]] PipelineHandle createGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo) override {
+    const auto vertexIt = shaders_.find(createInfo.vertexShader.id);
+    const auto fragmentIt = shaders_.find(createInfo.fragmentShader.id);
+    if (vertexIt == shaders_.end() || fragmentIt == shaders_.end()) {
+      throw std::runtime_error("Software pipeline creation requires valid vertex and fragment shaders");
+    }
+    if (createInfo.topology != PrimitiveTopology::TriangleList) {
+      throw std::runtime_error("Software pipeline only supports triangle lists");
+    }
+
+    std::lock_guard lock{resourceMutex_};
+    PipelineHandle handle{nextPipelineHandle_++};
+    pipelines_.emplace(handle.id, SoftwarePipeline{createInfo, std::string{createInfo.debugName}});
+    return handle;
+  }
+
+  [[nodiscard]] PipelineStatus pipelineStatus(const PipelineHandle handle) override {
+    std::lock_guard lock{resourceMutex_};
+    return pipelines_.contains(handle.id) ? PipelineStatus::Ready : PipelineStatus::Failed;
+  }
+
+  void destroyPipeline(const PipelineHandle handle) override {
+    std::lock_guard lock{resourceMutex_};
+    pipelines_.erase(handle.id);
+  }
+
+  [[nodiscard]] std::vector<RenderResourceInfo> resources() const override {
+    std::lock_guard lock{resourceMutex_};
+    std::vector<RenderResourceInfo> result;
+    result.reserve(buffers_.size() + textures_.size() + shaders_.size() + pipelines_.size());
+    for (const auto& [id, buffer] : buffers_) {
+      RenderResourceInfo info{};
+      info.kind = RenderResourceKind::Buffer;
+      info.id = id;
+      info.debugName = buffer->debugName;
+      info.sizeBytes = buffer->storage.size();
+      info.usage = buffer->info.usage;
+      result.push_back(std::move(info));
+    }
+    for (const auto& [id, texture] : textures_) {
+      RenderResourceInfo info{};
+      info.kind = RenderResourceKind::Texture;
+      info.id = id;
+      info.debugName = texture.debugName;
+      info.sizeBytes = texture.storage.size();
+      info.format = texture.info.format;
+      info.extent = texture.info.extent;
+      info.mipLevels = textureMipCount(texture.info);
+      info.firstResidentMip = texture.info.firstResidentMip;
+      result.push_back(std::move(info));
+    }
+    for (const auto& [id, shader] : shaders_) {
+      RenderResourceInfo info{};
+      info.kind = RenderResourceKind::Shader;
+      info.id = id;
+      info.debugName = shader.debugName;
+      info.sizeBytes = shader.byteCodeSize;
+      info.stage = shader.stage;
+      result.push_back(std::move(info));
+    }
+    for (const auto& [id, pipeline] : pipelines_) {
+      RenderResourceInfo info{};
+      info.kind = RenderResourceKind::Pipeline;
+      info.id = id;
+      info.debugName = pipeline.debugName;
+      result.push_back(std::move(info));
+    }
+    return result;
+  }
+
+  [[nodiscard]] RenderFrameStats frameStats() const override { return stats_.snapshot(); }
+  [[nodiscard]] RenderStatsCounters& stats() { return stats_; }
+
+  [[nodiscard]] const SoftwareBuffer* findBuffer(const BufferHandle handle) const {
+    const auto it = buffers_.find(handle.id);
+    return it != buffers_.end() ? it->second.get() : nullptr;
+  }
+
+  [[nodiscard]] std::shared_ptr<const SoftwareBuffer> shareBuffer(const BufferHandle handle) const {
+    const auto it = buffers_.find(handle.id);
+    return it != buffers_.end() ? it->second : nullptr;
+  }
+
+  [[nodiscard]] bool hasPipeline(const PipelineHandle handle) const { return pipelines_.contains(handle.id); }
+
+  [[nodiscard]] const SoftwareRenderBackendConfig& config() const { return config_; }
+  [[nodiscard]] core::WorkerPool& workers() { return workers_; }
+
+private:
+  SoftwareRenderBackendConfig config_{};
+  core::WorkerPool workers_;
+  RenderStatsCounters stats_;
+
+  // Resources are only created, destroyed and looked up on the recording thread; the mutex keeps
+  // resources() safe to call from tooling threads.
+  mutable std::mutex resourceMutex_;
+
+  std::uint32_t nextBufferHandle_ = 1;
+  std::uint32_t nextTextureHandle_ = 1;
+  std::uint32_t nextShaderHandle_ = 1;
+  std::uint32_t nextPipelineHandle_ = 1;
+
+  // Shared with the draws recorded against them until endFrame().
+  std::unordered_map<std::uint32_t, std::shared_ptr<SoftwareBuffer>> buffers_;
+  std::unordered_map<std::uint32_t, SoftwareTexture> textures_;
+  std::unordered_map<std::uint32_t, SoftwareShader> shaders_;
+  std::unordered_map<std::uint32_t, SoftwarePipeline> pipelines_;
+
+  std::uint64_t lastUploadTicket_ = 0;
+  TransientRingAllocator transientRing_;
+  BufferHandle transientBuffer_{};
+  std::byte* transientStorage_ = nullptr;
+};
+
+// Draws are recorded between beginFrame() and endFrame(). endFrame() runs two parallel phases on
+// the device worker pool: geometry (vertex transform, near clipping, triangle setup and binning
+// into per-chunk tile lists) and raster (each tile clears, then rasterizes and shades its bins in
+// submission order). Chunks are contiguous triangle ranges, so walking them in order per tile
+// preserves draw order without locks.
+class SoftwareCommandContext final : public ICommandContext {
+public:
+  explicit SoftwareCommandContext(SoftwareRenderDevice& device)
+      : device_(device) {}
+
+  void beginFrame(const FrameGraphFrameInfo& frameInfo) override {
+    resizeTargets(frameInfo.renderExtent);
+    draws_.clear();
+    frameConstants_.clear();
+    totalTriangles_ = 0;
+    frameIndex_ = frameInfo.frameIndex;
+    counters_ = {};
+    stats_ = SoftwareFrameStats{};
+    stats_.workerCount = device_.workers().workerCount();
+  }
+
+  void endFrame() override {
+    ENGINE_PROFILE_ZONE("SoftwareCommandContext::endFrame");
+    const auto geometryStart = std::chrono::steady_clock::now();
+    runGeometryPhase();
+    const auto rasterStart = std::chrono::steady_clock::now();
+    runRasterPhase();
+    const auto rasterEnd = std::chrono::steady_clock::now();
+
+    stats_.geometryMs = std::chrono::duration<double, std::milli>(rasterStart - geometryStart).count();
+    stats_.rasterMs = std::chrono::duration<double, std::milli>(rasterEnd - rasterStart).count();
+    device_.retireTransientFrame();
+    // Releases the buffers the draws held.
+    draws_.clear();
+
+    device_.stats().publish(frameIndex_, counters_);
+    ENGINE_PROFILE_COUNTER("draw calls", counters_.drawCalls);
+    ENGINE_PROFILE_COUNTER("triangles", counters_.triangles);
+  }
+
+  // Commands execute in endFrame(), so there is no per-pass work to scope here.
+  void beginPass(const std::string_view name) override { (void)name; }
+  void endPass() override {}
+
+  void bindPipeline(const PipelineHandle pipeline) override {
+    activePipeline_ = pipeline;
+    ++counters_.pipelineBinds;
+  }
+
+  void bindVertexBuffer(const BufferHandle buffer, const std::uint64_t offset) override {
+    vertexBuffer_ = buffer;
+    vertexBufferOffset_ = offset;
+  }
+
+  void bindIndexBuffer(const BufferHandle buffer, const std::uint64_t offset) override {
+    indexBuffer_ = buffer;
+    indexBufferOffset_ = offset;
+  }
+
+  void bindUniformBuffer(const std::uint32_t binding,
+                         const BufferHandle buffer,
+                         const std::uint64_t offset,
+                         const std::uint64_t sizeBytes) override {
+    (void)sizeBytes;
+    if (binding >= kMaxUniformBindings) {
+      return;
+    }
+    uniformBindings_[binding] = UniformBinding{buffer, offset};
+  }
+
+  void draw(const std::uint32_t vertexCount,
+            const std::uint32_t instanceCount,
+            const std::uint32_t firstVertex,
+            const std::uint32_t firstInstance) override {
+    (void)firstInstance;
+    // Software pipelines are Ready from creation; only unknown or destroyed ones are skipped.
+    if (!device_.hasPipeline(activePipeline_)) {
+      ++counters_.drawsSkipped;
+      return;
+    }
+    if (instanceCount == 0) {
+      return;
+    }
+    counters_.countDraw(PrimitiveTopology::TriangleList, vertexCount, instanceCount);
+    recordDraw(nullptr, nullptr, 0, firstVertex, 0, vertexCount / 3);
+  }
+
+  // Instances carry no per-instance attributes in this API and therefore rasterize identically;
+  // only the first one is drawn, though frame stats count every instance.
+  void drawIndexed(const std::uint32_t indexCount,
+                   const std::uint32_t instanceCount,
+                   const std::uint32_t firstIndex,
+                   const std::int32_t vertexOffset,
+                   const std::uint32_t firstInstance) override {
+    (void)firstInstance;
+    if (!device_.hasPipeline(activePipeline_)) {
+      ++counters_.drawsSkipped;
+      return;
+    }
+    if (instanceCount == 0) {
+      return;
+    }
+    counters_.countDraw(PrimitiveTopology::TriangleList, indexCount, instanceCount);
+
+    std::shared_ptr<const SoftwareBuffer> indexBuffer = device_.shareBuffer(indexBuffer_);
+    if (indexBuffer == nullptr || indexBufferOffset_ >= indexBuffer->storage.size()) {
+      return;
+    }
+
+    const auto* indices = reinterpret_cast<const std::uint32_t*>(indexBuffer->storage.data() + indexBufferOffset_);
+    const std::size_t available = (indexBuffer->storage.size() - indexBufferOffset_) / sizeof(std::uint32_t);
+    if (static_cast<std::size_t>(firstIndex) + indexCount > available) {
+      return;
+    }
+
+    recordDraw(std::move(indexBuffer), indices, available, firstIndex, vertexOffset, indexCount / 3);
+  }
+
+  [[nodiscard]] SoftwareFramebufferView colorTarget() const {
+    return SoftwareFramebufferView{extent_, rowPitch_, std::span<const std::uint32_t>(color_)};
+  }
+
+  [[nodiscard]] const SoftwareFrameStats& frameStats() const { return stats_; }
+
+private:
+  struct UniformBinding {
+    BufferHandle buffer{};
+    std::uint64_t offset = 0;
+  };
+
+  template <typename T>
+  [[nodiscard]] bool readUniform(const std::uint32_t binding, T& out) const {
+    const UniformBinding& slot = uniformBindings_[binding];
+    const SoftwareBuffer* buffer = device_.findBuffer(slot.buffer);
+    if (buffer == nullptr || slot.offset + sizeof(T) > buffer->storage.size()) {
+      return false;
+    }
+    std::memcpy(&out, buffer->storage.data() + slot.offset, sizeof(T));
+    return true;
+  }
+
+  void resizeTargets(const platform::Extent2D extent) {
+    extent_ = extent;
+    rowPitch_ = (extent.width + 3U) & ~3U;
+    const std::size_t pixelCount = static_cast<std::size_t>(rowPitch_) * extent.height;
+    color_.resize(pixelCount);
+    depth_.resize(pixelCount);
+
+    const std::uint32_t tileSize = device_.config().tileSize;
+    tilesX_ = (extent.width + tileSize - 1) / tileSize;
+    tilesY_ = (extent.height + tileSize - 1) / tileSize;
+  }
+
+  void recordDraw(std::shared_ptr<const SoftwareBuffer> indexBuffer,
+                  const std::uint32_t* indices,
+                  const std::size_t indexCount,
+                  const std::uint32_t firstElement,
+                  const std::int32_t vertexOffset,
+                  const std::uint32_t triangleCount) {
+    if (triangleCount == 0) {
+      return;
+    }
+
+    std::shared_ptr<const SoftwareBuffer> vertexBuffer = device_.shareBuffer(vertexBuffer_);
+    if (vertexBuffer == nullptr || vertexBufferOffset_ >= vertexBuffer->storage.size()) {
+      return;
+    }
+
+    SoftwareFrameConstants frameConstants{};
+    (void)readUniform(kSoftwareFrameConstantsBinding, frameConstants);
+    if (frameConstants_.empty() || std::memcmp(&frameConstants_.back(), &frameConstants, sizeof(frameConstants)) != 0) {
+      frameConstants_.push_back(frameConstants);
+    }
+
+    DrawRecord record{};
+    record.vertexData = vertexBuffer->storage.data() + vertexBufferOffset_;
+    record.vertexCount = (vertexBuffer->storage.size() - vertexBufferOffset_) / kSoftwareVertexStride;
+    record.vertexBuffer = std::move(vertexBuffer);
+    record.indexBuffer = std::move(indexBuffer);
+    record.indices = indices;
+    record.indexCount = indexCount;
+    record.firstElement = firstElement;
+    record.vertexOffset = vertexOffset;
+    record.triangleCount = triangleCount;
+    record.frameConstantsIndex = static_cast<std::uint32_t>(frameConstants_.size() - 1);
+    (void)readUniform(kSoftwareDrawConstantsBinding, record.constants);
+
+    const SoftwareFrameConstants& frame = frameConstants_.back();
+    float viewProjection[16]{};
+    multiply(frame.projection, frame.view, viewProjection);
+    multiply(viewProjection, record.constants.model, record.modelViewProjection);
+    normalMatrix(record.constants.model, record.normalMatrix);
+
+    draws_.push_back(std::move(record));
+    totalTriangles_ += triangleCount;
+  }
+
+  [[nodiscard]] ClipVertex fetchVertex(const DrawRecord& draw, const std::uint64_t element, bool& valid) const {
+    std::int64_t vertexIndex = static_cast<std::int64_t>(element);
+    if (draw.indices != nullptr) {
+      vertexIndex = static_cast<std::int64_t>(draw.indices[element]) + draw.vertexOffset;
+    }
+    if (vertexIndex < 0 || static_cast<std::size_t>(vertexIndex) >= draw.vertexCount) {
+      valid = false;
+      return {};
+    }
+
+    float attributes[8]{};
+    std::memcpy(attributes, draw.vertexData + static_cast<std::size_t>(vertexIndex) * kSoftwareVertexStride, sizeof(attributes));
+
+    const float(&model)[16] = draw.constants.model;
+    const Vec4 world = transform(model, attributes[0], attributes[1], attributes[2], 1.0f);
+    const float(&n)[9] = draw.normalMatrix;
+
+    ClipVertex out{};
+    out.clip = transform(draw.modelViewProjection, attributes[0], attributes[1], attributes[2], 1.0f);
+    out.world = {world.x, world.y, world.z};
+    out.normal = {n[0] * attributes[3] + n[3] * attributes[4] + n[6] * attributes[5],
+                  n[1] * attributes[3] + n[4] * attributes[4] + n[7] * attributes[5],
+                  n[2] * attributes[3] + n[5] * attributes[4] + n[8] * attributes[5]};
+    return out;
+  }
+
+  void setupTriangle(const ClipVertex (&vertices)[3], const std::uint32_t drawIndex, GeometryChunk& chunk) const {
+    const float width = static_cast<float>(extent_.width);
+    const float height = static_cast<float>(extent_.height);
+
+    float screenX[3]{};
+    float screenY[3]{};
+    double subpixelX[3]{};
+    double subpixelY[3]{};
+    SetupTriangle triangle{};
+    triangle.drawIndex = drawIndex;
+    for (int k = 0; k < 3; ++k) {
+      const Vec4& clip = vertices[k].clip;
+      const float invW = 1.0f / clip.w;
+      subpixelX[k] = std::round(static_cast<double>((clip.x * invW * 0.5f + 0.5f) * width) * kSubpixelSteps);
+      subpixelY[k] = std::round(static_cast<double>((0.5f - clip.y * invW * 0.5f) * height) * kSubpixelSteps);
+      screenX[k] = static_cast<float>(subpixelX[k] / kSubpixelSteps);
+      screenY[k] = static_cast<float>(subpixelY[k] / kSubpixelSteps);
+      triangle.depth[k] = clip.z * invW * 0.5f + 0.5f;
+      triangle.invW[k] = invW;
+      triangle.worldOverW[k] = vertices[k].world * invW;
+      triangle.normalOverW[k] = vertices[k].normal * invW;
+    }
+
+    const float area = (screenX[1] - screenX[0]) * (screenY[2] - screenY[0]) -
+                       (screenY[1] - screenY[0]) * (screenX[2] - screenX[0]);
+    const double subpixelArea = (subpixelX[1] - subpixelX[0]) * (subpixelY[2] - subpixelY[0]) -
+                                (subpixelY[1] - subpixelY[0]) * (subpixelX[2] - subpixelX[0]);
+    if (!std::isfinite(area) || std::abs(area) < kMinTriangleArea || subpixelArea == 0.0) {
+      return;
+    }
+
+    // The three edges are set up side by side: lane k holds the edge from vertex (k + 1) % 3 to
+    // (k + 2) % 3, opposite vertex k; lane 3 is padding. Weight of vertex k is that edge function
+    // divided by the signed area, which makes the inside positive for either winding.
+    const float edgeStartX[4] = {screenX[1], screenX[2], screenX[0], 0.0f};
+    const float edgeStartY[4] = {screenY[1], screenY[2], screenY[0], 0.0f};
+    const float edgeEndX[4] = {screenX[2], screenX[0], screenX[1], 0.0f};
+    const float edgeEndY[4] = {screenY[2], screenY[0], screenY[1], 0.0f};
+    const Float4 startX = Float4::load(edgeStartX);
+    const Float4 startY = Float4::load(edgeStartY);
+    const Float4 dx = Float4::load(edgeEndX) - startX;
+    const Float4 dy = Float4::load(edgeEndY) - startY;
+    const Float4 invArea = Float4::broadcast(1.0f / area);
+    float planeX[4];
+    float planeY[4];
+    float planeC[4];
+    ((Float4::broadcast(0.0f) - dy) * invArea).store(planeX);
+    (dx * invArea).store(planeY);
+    ((dy * startX - dx * startY) * invArea).store(planeC);
+
+    // The same edges over subpixel coordinates, oriented so the inside is positive.
+    const double subpixelStartX[4] = {subpixelX[1], subpixelX[2], subpixelX[0], 0.0};
+    const double subpixelStartY[4] = {subpixelY[1], subpixelY[2], subpixelY[0], 0.0};
+    const double subpixelEndX[4] = {subpixelX[2], subpixelX[0], subpixelX[1], 0.0};
+    const double subpixelEndY[4] = {subpixelY[2], subpixelY[0], subpixelY[1], 0.0};
+    const Double4 sign = Double4::broadcast(subpixelArea > 0.0 ? 1.0 : -1.0);
+    const Double4 subpixelStartX4 = Double4::load(subpixelStartX);
+    const Double4 subpixelStartY4 = Double4::load(subpixelStartY);
+    const Double4 subpixelDx = Double4::load(subpixelEndX) - subpixelStartX4;
+    const Double4 subpixelDy = Double4::load(subpixelEndY) - subpixelStartY4;
+    double coverageX[4];
+    double coverageY[4];
+    double coverageC[4];
+    ((subpixelStartY4 - Double4::load(subpixelEndY)) * sign).store(coverageX);
+    (subpixelDx * sign).store(coverageY);
+    ((subpixelDy * subpixelStartX4 - subpixelDx * subpixelStartY4) * sign).store(coverageC);
+
+    for (int k = 0; k < 3; ++k) {
+      triangle.edge[k][0] = planeX[k];
+      triangle.edge[k][1] = planeY[k];
+      triangle.edge[k][2] = planeC[k];
+
+      // An edge is top-left when the inside lies to its right (the function grows with x) or
+      // directly below a horizontal edge; pixel centers exactly on other edges are left out by
+      // lowering the integer-valued constant by one.
+      const bool topLeft = coverageX[k] > 0.0 || (coverageX[k] == 0.0 && coverageY[k] > 0.0);
+      triangle.coverage[k][0] = coverageX[k];
+      triangle.coverage[k][1] = coverageY[k];
+      triangle.coverage[k][2] = coverageC[k] - (topLeft ? 0.0 : 1.0);
+    }
+
+    const float minX = std::min({screenX[0], screenX[1], screenX[2]});
+    const float maxX = std::max({screenX[0], screenX[1], screenX[2]});
+    const float minY = std::min({screenY[0], screenY[1], screenY[2]});
+    const float maxY = std::max({screenY[0], screenY[1], screenY[2]});
+    triangle.minX = static_cast<std::int32_t>(std::clamp(std::floor(minX), 0.0f, width - 1.0f));
+    triangle.maxX = static_cast<std::int32_t>(std::clamp(std::floor(maxX), 0.0f, width - 1.0f));
+    triangle.minY = static_cast<std::int32_t>(std::clamp(std::floor(minY), 0.0f, height - 1.0f));
+    triangle.maxY = static_cast<std::int32_t>(std::clamp(std::floor(maxY), 0.0f, height - 1.0f));
+    if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) {
+      return;
+    }
+
+    const auto triangleIndex = static_cast<std::uint32_t>(chunk.triangles.size());
+    chunk.triangles.push_back(triangle);
+
+    const auto tileSize = static_cast<std::int32_t>(device_.config().tileSize);
+    for (std::int32_t tileY = triangle.minY / tileSize; tileY <= triangle.maxY / tileSize; ++tileY) {
+      for (std::int32_t tileX = triangle.minX / tileSize; tileX <= triangle.maxX / tileSize; ++tileX) {
+        chunk.bins[static_cast<std::size_t>(tileY) * tilesX_ + static_cast<std::size_t>(tileX)].push_back(triangleIndex);
+        ++chunk.binEntries;
+      }
+    }
+  }
+
+  void clipAndSetup(const ClipVertex (&vertices)[3], const std::uint32_t drawIndex, GeometryChunk& chunk) const {
+    const auto outside = [&](auto&& predicate) {
+      return predicate(vertices[0].clip) && predicate(vertices[1].clip) && predicate(vertices[2].clip);
+    };
+    if (outside([](const Vec4& c) { return c.x < -c.w; }) || outside([](const Vec4& c) { return c.x > c.w; }) ||
+        outside([](const Vec4& c) { return c.y < -c.w; }) || outside([](const Vec4& c) { return c.y > c.w; }) ||
+        outside([](const Vec4& c) { return c.z < -c.w; }) || outside([](const Vec4& c) { return c.z > c.w; })) {
+      return;
+    }
+
+    const auto nearDistance = [](const ClipVertex& v) { return v.clip.z + v.clip.w; };
+    if (nearDistance(vertices[0]) >= 0.0f && nearDistance(vertices[1]) >= 0.0f && nearDistance(vertices[2]) >= 0.0f &&
+        vertices[0].clip.w > kMinClipW && vertices[1].clip.w > kMinClipW && vertices[2].clip.w > kMinClipW) {
+      setupTriangle(vertices, drawIndex, chunk);
+      return;
+    }
+
+    // Sutherland-Hodgman against the near plane (z >= -w); a triangle yields at most a quad.
+    ClipVertex polygon[4]{};
+    int count = 0;
+    for (int k = 0; k < 3; ++k) {
+      const ClipVertex& current = vertices[k];
+      const ClipVertex& next = vertices[(k + 1) % 3];
+      const float dCurrent = nearDistance(current);
+      const float dNext = nearDistance(next);
+      if (dCurrent >= 0.0f) {
+        polygon[count++] = current;
+      }
+      if ((dCurrent >= 0.0f) != (dNext >= 0.0f)) {
+        polygon[count++] = lerp(current, next, dCurrent / (dCurrent - dNext));
+      }
+    }
+
+    for (int k = 1; k + 1 < count; ++k) {
+      const ClipVertex fan[3] = {polygon[0], polygon[k], polygon[k + 1]};
+      if (fan[0].clip.w > kMinClipW && fan[1].clip.w > kMinClipW && fan[2].clip.w > kMinClipW) {
+        setupTriangle(fan, drawIndex, chunk);
+      }
+    }
+  }
+
+  void runGeometryPhase() {
+    auto& workers = device_.workers();
+    const std::size_t tileCount = static_cast<std::size_t>(tilesX_) * tilesY_;
+    const std::uint64_t maxChunks = std::max<std::uint64_t>(1, totalTriangles_ / kMinTrianglesPerChunk);
+    const auto chunkCount = static_cast<std::uint32_t>(
+        std::min<std::uint64_t>(static_cast<std::uint64_t>(workers.workerCount()) * kChunksPerWorker, maxChunks));
+
+    if (chunks_.size() < chunkCount) {
+      chunks_.resize(chunkCount);
+    }
+    for (std::uint32_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex) {
+      GeometryChunk& chunk = chunks_[chunkIndex];
+      chunk.triangles.clear();
+      chunk.bins.resize(tileCount);
+      for (auto& bin : chunk.bins) {
+        bin.clear();
+      }
+      chunk.trianglesSubmitted = 0;
+      chunk.binEntries = 0;
+    }
+    activeChunks_ = chunkCount;
+
+    if (totalTriangles_ == 0 || tileCount == 0) {
+      return;
+    }
+
+    drawTriangleStart_.resize(draws_.size() + 1);
+    drawTriangleStart_[0] = 0;
+    for (std::size_t drawIndex = 0; drawIndex < draws_.size(); ++drawIndex) {
+      drawTriangleStart_[drawIndex + 1] = drawTriangleStart_[drawIndex] + draws_[drawIndex].triangleCount;
+    }
+
+    workers.parallelFor(chunkCount, [&](const std::uint32_t chunkIndex, const std::uint32_t) {
+      ENGINE_PROFILE_ZONE("Software geometry chunk");
+      GeometryChunk& chunk = chunks_[chunkIndex];
+      const std::uint64_t begin = totalTriangles_ * chunkIndex / chunkCount;
+      const std::uint64_t end = totalTriangles_ * (chunkIndex + 1) / chunkCount;
+
+      auto drawIt = std::upper_bound(drawTriangleStart_.begin(), drawTriangleStart_.end(), begin) - 1;
+      for (std::uint64_t globalTriangle = begin; globalTriangle < end; ++globalTriangle) {
+        while (globalTriangle >= *(drawIt + 1)) {
+          ++drawIt;
+        }
+
+        const auto drawIndex = static_cast<std::uint32_t>(drawIt - drawTriangleStart_.begin());
+        const DrawRecord& draw = draws_[drawIndex];
+        const std::uint64_t firstElement = draw.firstElement + (globalTriangle - *drawIt) * 3;
+
+        bool valid = true;
+        const ClipVertex vertices[3] = {fetchVertex(draw, firstElement, valid),
+                                        fetchVertex(draw, firstElement + 1, valid),
+                                        fetchVertex(draw, firstElement + 2, valid)};
+        ++chunk.trianglesSubmitted;
+        if (valid) {
+          clipAndSetup(vertices, drawIndex, chunk);
+        }
+      }
+    });
+
+    for (std::uint32_t chunkIndex = 0; chunkIndex < chunkCount; ++chunkIndex) {
+      stats_.trianglesSubmitted += chunks_[chunkIndex].trianglesSubmitted;
+      stats_.trianglesRasterized += chunks_[chunkIndex].triangles.size();
+      stats_.binEntries += chunks_[chunkIndex].binEntries;
+    }
+  }
+
+  void runRasterPhase() {
+    const std::uint32_t tileCount = tilesX_ * tilesY_;
+    if (tileCount == 0) {
+      return;
+    }
+
+    device_.workers().parallelFor(tileCount, [&](const std::uint32_t tileIndex, const std::uint32_t) {
+      ENGINE_PROFILE_ZONE("Software raster tile");
+      const auto tileSize = static_cast<std::int32_t>(device_.config().tileSize);
+      const std::int32_t tileX0 = static_cast<std::int32_t>(tileIndex % tilesX_) * tileSize;
+      const std::int32_t tileY0 = static_cast<std::int32_t>(tileIndex / tilesX_) * tileSize;
+      const std::int32_t tileX1 = std::min(tileX0 + tileSize, static_cast<std::int32_t>(extent_.width)) - 1;
+      const std::int32_t tileY1 = std::min(tileY0 + tileSize, static_cast<std::int32_t>(extent_.height)) - 1;
+
+      clearTile(tileX0, tileY0, tileX1, tileY1);
+      for (std::uint32_t chunkIndex = 0; chunkIndex < activeChunks_; ++chunkIndex) {
+        const GeometryChunk& chunk = chunks_[chunkIndex];
+        for (const std::uint32_t triangleIndex : chunk.bins[tileIndex]) {
+          rasterizeTriangle(chunk.triangles[triangleIndex], tileX0, tileY0, tileX1, tileY1);
+        }
+      }
+    });
+  }
+
+  void clearTile(const std::int32_t x0, const std::int32_t y0, const std::int32_t x1, const std::int32_t y1) {
+    const float(&clear)[4] = device_.config().clearColor;
+    const std::uint32_t clearColor = packRgba8({clear[0], clear[1], clear[2]}, clear[3]);
+    for (std::int32_t y = y0; y <= y1; ++y) {
+      const std::size_t row = static_cast<std::size_t>(y) * rowPitch_;
+      std::fill(color_.begin() + static_cast<std::ptrdiff_t>(row + static_cast<std::size_t>(x0)),
+                color_.begin() + static_cast<std::ptrdiff_t>(row + static_cast<std::size_t>(x1) + 1),
+                clearColor);
+      std::fill(depth_.begin() + static_cast<std::ptrdiff_t>(row + static_cast<std::size_t>(x0)),
+                depth_.begin() + static_cast<std::ptrdiff_t>(row + static_cast<std::size_t>(x1) + 1),
+                1.0f);
+    }
+  }
+
+  void rasterizeTriangle(const SetupTriangle& triangle,
+                         const std::int32_t tileX0,
+                         const std::int32_t tileY0,
+                         const std::int32_t tileX1,
+                         const std::int32_t tileY1) {
+    const std::int32_t minX = std::max(triangle.minX, tileX0);
+    const std::int32_t maxX = std::min(triangle.maxX, tileX1);
+    const std::int32_t minY = std::max(triangle.minY, tileY0);
+    const std::int32_t maxY = std::min(triangle.maxY, tileY1);
+    if (minX > maxX || minY > maxY) {
+      return;
+    }
+
+    const Float4 e1x = Float4::broadcast(triangle.edge[1][0]);
+    const Float4 e2x = Float4::broadcast(triangle.edge[2][0]);
+    const float dz1 = triangle.depth[1] - triangle.depth[0];
+    const float dz2 = triangle.depth[2] - triangle.depth[0];
+
+    // Coverage edge functions at the first pixel center of the first row, stepped by whole pixels
+    // from there. Every value and step is an integer, so the sums stay exact and match a direct
+    // evaluation at each pixel.
+    const std::int32_t alignedMinX = minX & ~3;
+    const double firstCenterX = (static_cast<double>(alignedMinX) + 0.5) * kSubpixelSteps;
+    const double firstCenterY = (static_cast<double>(minY) + 0.5) * kSubpixelSteps;
+    double coverageRow[3]{};
+    Double4 coverageBlockStep[3]{};
+    for (int k = 0; k < 3; ++k) {
+      coverageRow[k] = triangle.coverage[k][0] * firstCenterX + triangle.coverage[k][1] * firstCenterY + triangle.coverage[k][2];
+      coverageBlockStep[k] = Double4::broadcast(triangle.coverage[k][0] * kSubpixelSteps * 4.0);
+    }
+
+    // Lanes of the first and last blocks of a row that fall outside [minX, maxX].
+    const int firstBlockMask = 0xF & (0xF << (minX - alignedMinX));
+    const int lastBlockMask = 0xF >> (3 - ((maxX - alignedMinX) & 3));
+    const std::int32_t lastBlockX = alignedMinX + ((maxX - alignedMinX) & ~3);
+
+    for (std::int32_t y = minY; y <= maxY; ++y) {
+      const float py = static_cast<float>(y) + 0.5f;
+      const Float4 e1Row = Float4::broadcast(triangle.edge[1][1] * py + triangle.edge[1][2]);
+      const Float4 e2Row = Float4::broadcast(triangle.edge[2][1] * py + triangle.edge[2][2]);
+      float* depthRow = depth_.data() + static_cast<std::size_t>(y) * rowPitch_;
+      std::uint32_t* colorRow = color_.data() + static_cast<std::size_t>(y) * rowPitch_;
+
+      Double4 coverage0 = Double4::ramp(coverageRow[0], triangle.coverage[0][0] * kSubpixelSteps);
+      Double4 coverage1 = Double4::ramp(coverageRow[1], triangle.coverage[1][0] * kSubpixelSteps);
+      Double4 coverage2 = Double4::ramp(coverageRow[2], triangle.coverage[2][0] * kSubpixelSteps);
+      for (int k = 0; k < 3; ++k) {
+        coverageRow[k] += triangle.coverage[k][1] * kSubpixelSteps;
+      }
+
+      for (std::int32_t x = alignedMinX; x <= maxX; x += 4) {
+        int mask = nonNegativeMask(coverage0, coverage1, coverage2);
+        coverage0 = coverage0 + coverageBlockStep[0];
+        coverage1 = coverage1 + coverageBlockStep[1];
+        coverage2 = coverage2 + coverageBlockStep[2];
+        if (x == alignedMinX) {
+          mask &= firstBlockMask;
+        }
+        if (x == lastBlockX) {
+          mask &= lastBlockMask;
+        }
+        if (mask == 0) {
+          continue;
+        }
+
+        const Float4 px = Float4::ramp(static_cast<float>(x) + 0.5f);
+        const Float4 w1 = e1x * px + e1Row;
+        const Float4 w2 = e2x * px + e2Row;
+
+        const Float4 depth = Float4::broadcast(triangle.depth[0]) + w1 * Float4::broadcast(dz1) + w2 * Float4::broadcast(dz2);
+        mask &= lessMask(depth, Float4::load(depthRow + x));
+        if (mask == 0) {
+          continue;
+        }
+
+        float depthLanes[4];
+        float w1Lanes[4];
+        float w2Lanes[4];
+        depth.store(depthLanes);
+        w1.store(w1Lanes);
+        w2.store(w2Lanes);
+        for (int lane = 0; lane < 4; ++lane) {
+          if ((mask & (1 << lane)) == 0) {
+            continue;
+          }
+          const auto index = static_cast<std::size_t>(x + lane);
+          depthRow[index] = depthLanes[lane];
+          colorRow[index] = shade(triangle, w1Lanes[lane], w2Lanes[lane]);
+        }
+      }
+    }
+  }
+
+  // C++ port of the sample's Blinn-Phong fragment shader.
+  [[nodiscard]] std::uint32_t shade(const SetupTriangle& triangle, const float b1, const float b2) const {
+    const float b0 = 1.0f - b1 - b2;
+    const float invW = triangle.invW[0] * b0 + triangle.invW[1] * b1 + triangle.invW[2] * b2;
+    const float w = 1.0f / invW;
+    const Vec3 worldPos = (triangle.worldOverW[0] * b0 + triangle.worldOverW[1] * b1 + triangle.worldOverW[2] * b2) * w;
+    const Vec3 normal = (triangle.normalOverW[0] * b0 + triangle.normalOverW[1] * b1 + triangle.normalOverW[2] * b2) * w;
+
+    const DrawRecord& draw = draws_[triangle.drawIndex];
+    const SoftwareFrameConstants& frame = frameConstants_[draw.frameConstantsIndex];
+    const SoftwareDrawConstants& material = draw.constants;
+
+    const Vec3 baseColor{material.baseColor[0], material.baseColor[1], material.baseColor[2]};
+    const Vec3 lightColor{frame.lightColor[0], frame.lightColor[1], frame.lightColor[2]};
+    const Vec3 lightPos{frame.lightPosition[0], frame.lightPosition[1], frame.lightPosition[2]};
+    const Vec3 cameraPos{frame.cameraPosition[0], frame.cameraPosition[1], frame.cameraPosition[2]};
+
+    const Vec3 norm = normalize(normal);
+    const Vec3 lightDir = normalize(lightPos - worldPos);
+    const float diff = std::max(dot(norm, lightDir), 0.0f);
+
+    const Vec3 viewDir = normalize(cameraPos - worldPos);
+    const Vec3 halfDir = normalize(lightDir + viewDir);
+    const float smoothness = 1.0f - std::clamp(material.roughness, 0.04f, 1.0f);
+    const float specPower = 8.0f + (128.0f - 8.0f) * smoothness;
+    const float spec = std::pow(std::max(dot(norm, halfDir), 0.0f), specPower);
+
+    const float metallic = std::clamp(material.metallic, 0.0f, 1.0f);
+    const Vec3 f0 = mix({0.04f, 0.04f, 0.04f}, baseColor, metallic);
+    const Vec3 ambient = lightColor * (frame.ambientIntensity * material.ambientOcclusion);
+    const Vec3 diffuse = lightColor * (diff * (1.0f - metallic));
+    const Vec3 specular{spec * f0.x * lightColor.x, spec * f0.y * lightColor.y, spec * f0.z * lightColor.z};
+
+    const Vec3 light = ambient + diffuse + specular;
+    const Vec3 lit{light.x * baseColor.x, light.y * baseColor.y, light.z * baseColor.z};
+    const Vec3 hoveredTint = mix(lit, {1.0f, 0.82f, 0.05f}, material.highlight * 0.55f);
+    const Vec3 selectedTint = mix(hoveredTint, {1.0f, 0.25f, 1.0f}, material.selected * 0.82f);
+    return packRgba8(selectedTint, 1.0f);
+  }
+
+  SoftwareRenderDevice& device_;
+
+  PipelineHandle activePipeline_{};
+  BufferHandle vertexBuffer_{};
+  std::uint64_t vertexBufferOffset_ = 0;
+  BufferHandle indexBuffer_{};
+  std::uint64_t indexBufferOffset_ = 0;
+  std::array<UniformBinding, kMaxUniformBindings> uniformBindings_{};
+
+  platform::Extent2D extent_{};
+  std::uint32_t rowPitch_ = 0;
+  std::uint32_t tilesX_ = 0;
+  std::uint32_t tilesY_ = 0;
+  std::vector<std::uint32_t> color_;
+  std::vector<float> depth_;
+
+  std::vector<DrawRecord> draws_;
+  std::vector<SoftwareFrameConstants> frameConstants_;
+  std::vector<std::uint64_t> drawTriangleStart_;
+  std::uint64_t totalTriangles_ = 0;
+  std::vector<GeometryChunk> chunks_;
+  std::uint32_t activeChunks_ = 0;
+
+  SoftwareFrameStats stats_{};
+  FrameDrawCounters counters_{};
+  std::uint64_t frameIndex_ = 0;
+};
+
+std::unique_ptr<ICommandContext> SoftwareRenderDevice::createCommandContext() {
+  return std::make_unique<SoftwareCommandContext>(*this);
+}
+
+class SoftwareRenderBackend final : public IRenderBackend {
+public:
+  explicit SoftwareRenderBackend(const SoftwareRenderBackendConfig& config)
+      : config_(config) {}
+
+  [[nodiscard]] std::string_view name() const override { return "Software"; }
+
+  [[nodiscard]] std::unique_ptr<IRenderDevice> createDevice() override {
+    return std::make_unique<SoftwareRenderDevice>(config_);
+  }
+
+private:
+  SoftwareRenderBackendConfig config_{};
+};
+
+} // namespace
+
+std::unique_ptr<IRenderBackend> createSoftwareRenderBackend(const SoftwareRenderBackendConfig& config) {
+  return std::make_unique<SoftwareRenderBackend>(config);
+}
+
+std::optional<SoftwareFramebufferView> softwareColorTarget(const ICommandContext& commandContext) {
+  const auto* context = dynamic_cast<const SoftwareCommandContext*>(&commandContext);
+  if (context == nullptr) {
+    return std::nullopt;
+  }
+  return context->colorTarget();
+}
+
+std::optional<SoftwareFrameStats> softwareFrameStats(const ICommandContext& commandContext) {
+  const auto* context = dynamic_cast<const SoftwareCommandContext*>(&commandContext);
+  if (context == nullptr) {
+    return std::nullopt;
+  }
+  return context->frameStats();
+}
+
+} // namespace engine::render
@@ -0,0 +1,770 @@
+#include "engine/render/CommandCapture.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "engine/core/Profiler.hpp"
+#include "engine/render/ICommandContext.hpp"
+
+namespace engine::render {
+namespace {
+
+constexpr std::array<char, 8> kCaptureMagic{'E', 'N', 'G', 'C', 'A', 'P', 'T', '\0'};
+constexpr std::uint64_t kCaptureVersion = 2;
+constexpr std::size_t kWriterFlushBytes = std::size_t{1} << 20U;
+
+// Records are an opcode byte, the context id (0 for device calls), then the op's integer arguments as
+// LEB128 varints, an optional length-prefixed text and an optional length-prefixed payload.
+enum class Op : std::uint8_t {
+  CreateBuffer,
+  DestroyBuffer,
+  UpdateBuffer,
+  QueueBufferUpload,
+  Transient,
+  CreateTexture,
+  DestroyTexture,
+  UpdateTexture,
+  SetTextureResidency,
+  CreateShader,
+  DestroyShader,
+  CreatePipeline,
+  DestroyPipeline,
+  CreateContext,
+  DestroyContext,
+  BeginFrame,
+  EndFrame,
+  BeginPass,
+  EndPass,
+  BindPipeline,
+  BindVertexBuffer,
+  BindIndexBuffer,
+  BindUniformBuffer,
+  Draw,
+  DrawIndexed,
+  Count,
+};
+
+struct OpLayout {
+  std::uint8_t intArgs;
+  bool text;
+  bool payload;
+};
+
+constexpr std::array<OpLayout, static_cast<std::size_t>(Op::Count)> kOpLayouts{{
+    {4, true, true},   // CreateBuffer: id, size, usage, cpuVisible; name; initial data
+    {1, false, false}, // DestroyBuffer: id
+    {2, false, true},  // UpdateBuffer: id, offset; data
+    {2, false, true},  // QueueBufferUpload: id, offset; data
+    {4, false, true},  // Transient: size, alignment, buffer, offset; data
+    {8, true, false},  // CreateTexture: id, dimension, format, width, height, depth, mips, first resident mip; name
+    {1, false, false}, // DestroyTexture: id
+    {2, false, true},  // UpdateTexture: id, level; texels
+    {2, false, false}, // SetTextureResidency: id, first resident mip
+    {2, true, true},   // CreateShader: id, stage; name; byte code
+    {1, false, false}, // DestroyShader: id
+    {4, true, false},  // CreatePipeline: id, vertex shader, fragment shader, topology; name
+    {1, false, false}, // DestroyPipeline: id
+    {0, false, false}, // CreateContext
+    {0, false, false}, // DestroyContext
+    {3, false, false}, // BeginFrame: frame index, width, height
+    {0, false, false}, // EndFrame
+    {0, true, false},  // BeginPass; name
+    {0, false, false}, // EndPass
+    {1, false, false}, // BindPipeline: id
+    {2, false, false}, // BindVertexBuffer: id, offset
+    {2, false, false}, // BindIndexBuffer: id, offset
+    {4, false, false}, // BindUniformBuffer: binding, id, offset, size
+    {4, false, false}, // Draw: vertex count, instance count, first vertex, first instance
+    {5, false, false}, // DrawIndexed: index count, instance count, first index, vertex offset, first instance
+}};
+
+[[nodiscard]] std::span<const std::byte> asBytes(const void* data, const std::size_t size) {
+  return {static_cast<const std::byte*>(data), data == nullptr ? 0 : size};
+}
+
+class CaptureWriter {
+public:
+  explicit CaptureWriter(const std::filesystem::path& path) : file_(path, std::ios::binary | std::ios::trunc) {
+    if (!file_) {
+      throw std::runtime_error("Failed to open command capture '" + path.string() + "' for writing");
+    }
+    file_.write(kCaptureMagic.data(), static_cast<std::streamsize>(kCaptureMagic.size()));
+    writeVarint(kCaptureVersion);
+  }
+
+  CaptureWriter(const CaptureWriter&) = delete;
+  CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+  ~CaptureWriter() {
+    flushTransients();
+    flushFile();
+  }
+
+  // Guards the record stream and the device calls whose order it must preserve.
+  [[nodiscard]] std::unique_lock<std::mutex> lock() { return std::unique_lock{mutex_}; }
+
+  // Callers hold lock(). Pending transient data is written first, so replay sees it before any call
+  // that may read it.
+  void record(const Op op,
+              const std::uint32_t context,
+              const std::initializer_list<std::uint64_t> args,
+              const std::string_view text = {},
+              const std::span<const std::byte> payload = {}) {
+    flushTransients();
+    append(op, context, args, text, payload);
+  }
+
+  // Callers hold lock().
+  [[nodiscard]] TransientAllocation stageTransient(const TransientAllocation& allocation, const std::uint64_t alignment) {
+    PendingTransient& pending = pendingTransients_.emplace_back();
+    pending.target = allocation;
+    pending.alignment = alignment;
+    pending.staging.assign(allocation.data.size(), std::byte{0});
+    return {allocation.buffer, allocation.offset, pending.staging};
+  }
+
+  [[nodiscard]] std::uint32_t nextContextId() { return ++contextCount_; }
+
+private:
+  struct PendingTransient {
+    TransientAllocation target{};
+    std::uint64_t alignment = 0;
+    std::vector<std::byte> staging;
+  };
+
+  void flushTransients() {
+    for (PendingTransient& pending : pendingTransients_) {
+      if (!pending.staging.empty()) {
+        std::memcpy(pending.target.data.data(), pending.staging.data(), pending.staging.size());
+      }
+      append(Op::Transient,
+             0,
+             {pending.staging.size(), pending.alignment, pending.target.buffer.id, pending.target.offset},
+             {},
+             pending.staging);
+    }
+    pendingTransients_.clear();
+  }
+
+  void append(const Op op,
+              const std::uint32_t context,
+              const std::initializer_list<std::uint64_t> args,
+              const std::string_view text,
+              const std::span<const std::byte> payload) {
+    buffer_.push_back(static_cast<std::byte>(op));
+    writeVarint(context);
+    for (const std::uint64_t arg : args) {
+      writeVarint(arg);
+    }
+    const OpLayout& layout = kOpLayouts[static_cast<std::size_t>(op)];
+    if (layout.text) {
+      writeVarint(text.size());
+      const auto* textBytes = reinterpret_cast<const std::byte*>(text.data());
+      buffer_.insert(buffer_.end(), textBytes, textBytes + text.size());
+    }
+    if (layout.payload) {
+      writeVarint(payload.size());
+      buffer_.insert(buffer_.end(), payload.begin(), payload.end());
+    }
+    if (buffer_.size() >= kWriterFlushBytes) {
+      flushFile();
+    }
+  }
+
+  void writeVarint(std::uint64_t value) {
+    while (value >= 0x80U) {
+      buffer_.push_back(static_cast<std::byte>((value & 0x7FU) | 0x80U));
+      value >>= 7U;
+    }
+    buffer_.push_back(static_cast<std::byte>(value));
+  }
+
+  void flushFile() {
+    file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+
+  std::mutex mutex_;
+  std::ofstream file_;
+  std::vector<std::byte> buffer_;
+  std::vector<PendingTransient> pendingTransients_;
+  std::uint32_t contextCount_ = 0;
+};
+
+class CapturingCommandContext final : public ICommandContext {
+public:
+  CapturingCommandContext(std::unique_ptr<ICommandContext> inner, std::shared_ptr<CaptureWriter> writer, const std::uint32_t id)
+      : inner_(std::move(inner)), writer_(std::move(writer)), id_(id) {}
+
+  ~CapturingCommandContext() override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::DestroyContext, id_, {});
+  }
+
+  void beginFrame(const FrameGraphFrameInfo& frameInfo) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::BeginFrame, id_, {frameInfo.frameIndex, frameInfo.renderExtent.width, frameInfo.renderExtent.height});
+    inner_->beginFrame(frameInfo);
+  }
+
+  void endFrame() override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::EndFrame, id_, {});
+    inner_->endFrame();
+  }
+
+  void beginPass(const std::string_view name) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::BeginPass, id_, {}, name);
+    inner_->beginPass(name);
+  }
+
+  void endPass() override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::EndPass, id_, {});
+    inner_->endPass();
+  }
+
+  void bindPipeline(const PipelineHandle pipeline) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::BindPipeline, id_, {pipeline.id});
+    inner_->bindPipeline(pipeline);
+  }
+
+  void bindVertexBuffer(const BufferHandle buffer, const std::uint64_t offset) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::BindVertexBuffer, id_, {buffer.id, offset});
+    inner_->bindVertexBuffer(buffer, offset);
+  }
+
+  void bindIndexBuffer(const BufferHandle buffer, const std::uint64_t offset) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::BindIndexBuffer, id_, {buffer.id, offset});
+    inner_->bindIndexBuffer(buffer, offset);
+  }
+
+  void bindUniformBuffer(const std::uint32_t binding,
+                         const BufferHandle buffer,
+                         const std::uint64_t offset,
+                         const std::uint64_t sizeBytes) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::BindUniformBuffer, id_, {binding, buffer.id, offset, sizeBytes});
+    inner_->bindUniformBuffer(binding, buffer, offset, sizeBytes);
+  }
+
+  void draw(const std::uint32_t vertexCount,
+            const std::uint32_t instanceCount,
+            const std::uint32_t firstVertex,
+            const std::uint32_t firstInstance) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::Draw, id_, {vertexCount, instanceCount, firstVertex, firstInstance});
+    inner_->draw(vertexCount, instanceCount, firstVertex, firstInstance);
+  }
+
+  void drawIndexed(const std::uint32_t indexCount,
+                   const std::uint32_t instanceCount,
+                   const std::uint32_t firstIndex,
+                   const std::int32_t vertexOffset,
+                   const std::uint32_t firstInstance) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::DrawIndexed,
+                    id_,
+                    {indexCount, instanceCount, firstIndex, static_cast<std::uint32_t>(vertexOffset), firstInstance});
+    inner_->drawIndexed(indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+  }
+
+private:
+  std::unique_ptr<ICommandContext> inner_;
+  std::shared_ptr<CaptureWriter> writer_;
+  std::uint32_t id_ = 0;
+};
+
+class CapturingRenderDevice final : public IRenderDevice {
+public:
+  CapturingRenderDevice(std::unique_ptr<IRenderDevice> inner, const std::filesystem::path& path)
+      : inner_(std::move(inner)), writer_(std::make_shared<CaptureWriter>(path)) {}
+
+  std::unique_ptr<ICommandContext> createCommandContext() override {
+    const auto lock = writer_->lock();
+    const std::uint32_t id = writer_->nextContextId();
+    auto context = std::make_unique<CapturingCommandContext>(inner_->createCommandContext(), writer_, id);
+    writer_->record(Op::CreateContext, id, {});
+    return context;
+  }
+
+  BufferHandle createBuffer(const BufferCreateInfo& createInfo) override {
+    const auto lock = writer_->lock();
+    const BufferHandle handle = inner_->createBuffer(createInfo);
+    writer_->record(Op::CreateBuffer,
+                    0,
+                    {handle.id, createInfo.sizeBytes, static_cast<std::uint64_t>(createInfo.usage), createInfo.cpuVisible ? 1U : 0U},
+                    createInfo.debugName,
+                    asBytes(createInfo.initialData, createInfo.sizeBytes));
+    return handle;
+  }
+
+  void destroyBuffer(const BufferHandle handle) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::DestroyBuffer, 0, {handle.id});
+    inner_->destroyBuffer(handle);
+  }
+
+  void updateBuffer(const BufferHandle handle, const std::uint64_t offset, const std::span<const std::byte> data) override {
+    const auto lock = writer_->lock();
+    inner_->updateBuffer(handle, offset, data);
+    writer_->record(Op::UpdateBuffer, 0, {handle.id, offset}, {}, data);
+  }
+
+  UploadTicket queueBufferUpload(const BufferHandle handle, const std::uint64_t offset, const std::span<const std::byte> data) override {
+    const auto lock = writer_->lock();
+    const UploadTicket ticket = inner_->queueBufferUpload(handle, offset, data);
+    writer_->record(Op::QueueBufferUpload, 0, {handle.id, offset}, {}, data);
+    return ticket;
+  }
+
+  bool uploadComplete(const UploadTicket ticket) override { return inner_->uploadComplete(ticket); }
+
+  TransientAllocation allocateTransient(const std::uint64_t sizeBytes, const std::uint64_t alignment) override {
+    const auto lock = writer_->lock();
+    return writer_->stageTransient(inner_->allocateTransient(sizeBytes, alignment), alignment);
+  }
+
+  bool supportsTextureFormat(const TextureFormat format) const override { return inner_->supportsTextureFormat(format); }
+
+  TextureHandle createTexture(const TextureCreateInfo& createInfo) override {
+    const auto lock = writer_->lock();
+    const TextureHandle handle = inner_->createTexture(createInfo);
+    writer_->record(Op::CreateTexture,
+                    0,
+                    {handle.id,
+                     static_cast<std::uint64_t>(createInfo.dimension),
+                     static_cast<std::uint64_t>(createInfo.format),
+                     createInfo.extent.width,
+                     createInfo.extent.height,
+                     createInfo.depth,
+                     createInfo.mipLevels,
+                     createInfo.firstResidentMip},
+                    createInfo.debugName);
+    return handle;
+  }
+
+  void destroyTexture(const TextureHandle handle) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::DestroyTexture, 0, {handle.id});
+    inner_->destroyTexture(handle);
+  }
+
+  void updateTexture(const TextureHandle handle, const std::uint32_t mipLevel, const std::span<const std::byte> texels) override {
+    const auto lock = writer_->lock();
+    inner_->updateTexture(handle, mipLevel, texels);
+    writer_->record(Op::UpdateTexture, 0, {handle.id, mipLevel}, {}, texels);
+  }
+
+  void setTextureResidency(const TextureHandle handle, const std::uint32_t firstResidentMip) override {
+    const auto lock = writer_->lock();
+    inner_->setTextureResidency(handle, firstResidentMip);
+    writer_->record(Op::SetTextureResidency, 0, {handle.id, firstResidentMip});
+  }
+
+  ShaderHandle createShader(const ShaderCreateInfo& createInfo) override {
+    const auto lock = writer_->lock();
+    const ShaderHandle handle = inner_->createShader(createInfo);
+    writer_->record(Op::CreateShader,
+                    0,
+                    {handle.id, static_cast<std::uint64_t>(createInfo.stage)},
+                    createInfo.debugName,
+                    asBytes(createInfo.byteCode, createInfo.byteCodeSize));
+    return handle;
+  }
+
+  void destroyShader(const ShaderHandle handle) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::DestroyShader, 0, {handle.id});
+    inner_->destroyShader(handle);
+  }
+
+  PipelineHandle createGraphicsPipeline(const GraphicsPipelineCreateInfo& createInfo) override {
+    const auto lock = writer_->lock();
+    const PipelineHandle handle = inner_->createGraphicsPipeline(createInfo);
+    writer_->record(Op::CreatePipeline,
+                    0,
+                    {handle.id, createInfo.vertexShader.id, createInfo.fragmentShader.id, static_cast<std::uint64_t>(createInfo.topology)},
+                    createInfo.debugName);
+    return handle;
+  }
+
+  PipelineStatus pipelineStatus(const PipelineHandle handle) override { return inner_->pipelineStatus(handle); }
+
+  void destroyPipeline(const PipelineHandle handle) override {
+    const auto lock = writer_->lock();
+    writer_->record(Op::DestroyPipeline, 0, {handle.id});
+    inner_->destroyPipeline(handle);
+  }
+
+  std::vector<RenderResourceInfo> resources() const override { return inner_->resources(); }
+  RenderFrameStats frameStats() const override { return inner_->frameStats(); }
+
+private:
+  std::unique_ptr<IRenderDevice> inner_;
+  std::shared_ptr<CaptureWriter> writer_;
+};
+
+class CaptureReader {
+public:
+  CaptureReader(const std::span<const std::byte> data, const std::filesystem::path& path) : data_(data), path_(path) {}
+
+  [[nodiscard]] bool done() const { return offset_ == data_.size(); }
+
+  [[nodiscard]] std::uint8_t byte() {
+    require(1);
+    return std::to_integer<std::uint8_t>(data_[offset_++]);
+  }
+
+  [[nodiscard]] std::uint64_t varint() {
+    std::uint64_t value = 0;
+    for (std::uint32_t shift = 0; shift < 64; shift += 7) {
+      const std::uint8_t next = byte();
+      value |= static_cast<std::uint64_t>(next & 0x7FU) << shift;
+      if ((next & 0x80U) == 0) {
+        return value;
+      }
+    }
+    fail("malformed integer");
+  }
+
+  [[nodiscard]] std::span<const std::byte> bytes() {
+    const std::uint64_t size = varint();
+    require(size);
+    const std::span<const std::byte> result = data_.subspan(offset_, static_cast<std::size_t>(size));
+    offset_ += static_cast<std::size_t>(size);
+    return result;
+  }
+
+  [[noreturn]] void fail(const std::string& reason) const {
+    throw std::runtime_error("Command capture '" + path_.string() + "': " + reason + " at byte " + std::to_string(offset_));
+  }
+
+private:
+  void require(const std::uint64_t size) const {
+    if (size > data_.size() - offset_) {
+      fail("truncated record");
+    }
+  }
+
+  std::span<const std::byte> data_;
+  std::size_t offset_ = 0;
+  const std::filesystem::path& path_;
+};
+
+// A transient range of the current frame: where the capture saw it and where replay put it.
+struct ReplayTransient {
+  std::uint64_t capturedOffset = 0;
+  std::uint64_t size = 0;
+  BufferHandle buffer{};
+  std::uint64_t offset = 0;
+};
+
+// Devices that deduplicate creates hand the same handle out more than once, so a captured id maps
+// to a stack of replay handles: creates push, destroys pop, and uses read the newest.
+template <typename Handle>
+using ReplayHandles = std::unordered_map<std::uint64_t, std::vector<Handle>>;
+
+template <typename Handle>
+[[nodiscard]] Handle mappedHandle(const ReplayHandles<Handle>& handles, const std::uint64_t capturedId, const char* kind) {
+  if (capturedId == 0) {
+    return Handle{};
+  }
+  const auto found = handles.find(capturedId);
+  if (found == handles.end() || found->second.empty()) {
+    throw std::runtime_error(std::string{"Command capture references unknown "} + kind + " " + std::to_string(capturedId));
+  }
+  return found->second.back();
+}
+
+template <typename Handle>
+[[nodiscard]] Handle takeHandle(ReplayHandles<Handle>& handles, const std::uint64_t capturedId, const char* kind) {
+  const Handle handle = mappedHandle(handles, capturedId, kind);
+  if (capturedId != 0) {
+    handles[capturedId].pop_back();
+  }
+  return handle;
+}
+
+template <typename Handle, typename Destroy>
+void destroyAll(const ReplayHandles<Handle>& handles, Destroy&& destroy) {
+  for (const auto& [capturedId, stack] : handles) {
+    for (auto handle = stack.rbegin(); handle != stack.rend(); ++handle) {
+      destroy(*handle);
+    }
+  }
+}
+
+} // namespace
+
+std::unique_ptr<IRenderDevice> createCapturingRenderDevice(std::unique_ptr<IRenderDevice> device, const std::filesystem::path& path) {
+  if (device == nullptr) {
+    throw std::runtime_error("createCapturingRenderDevice requires a device");
+  }
+  return std::make_unique<CapturingRenderDevice>(std::move(device), path);
+}
+
+CommandCapture CommandCapture::load(const std::filesystem::path& path) {
+  ENGINE_PROFILE_ZONE("CommandCapture::load");
+  std::ifstream file{path, std::ios::binary};
+  if (!file) {
+    throw std::runtime_error("Failed to open command capture '" + path.string() + "'");
+  }
+  CommandCapture capture;
+  file.seekg(0, std::ios::end);
+  capture.data_.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0, std::ios::beg);
+  file.read(reinterpret_cast<char*>(capture.data_.data()), static_cast<std::streamsize>(capture.data_.size()));
+  if (!file) {
+    throw std::runtime_error("Failed to read command capture '" + path.string() + "'");
+  }
+
+  const std::span<const std::byte> data{capture.data_};
+  if (data.size() < kCaptureMagic.size() || std::memcmp(data.data(), kCaptureMagic.data(), kCaptureMagic.size()) != 0) {
+    throw std::runtime_error("'" + path.string() + "' is not a command capture");
+  }
+  CaptureReader reader{data.subspan(kCaptureMagic.size()), path};
+  if (const std::uint64_t version = reader.varint(); version != kCaptureVersion) {
+    reader.fail("unsupported version " + std::to_string(version));
+  }
+
+  while (!reader.done()) {
+    Command command{};
+    command.op = reader.byte();
+    if (command.op >= static_cast<std::uint8_t>(Op::Count)) {
+      reader.fail("unknown opcode " + std::to_string(command.op));
+    }
+    command.context = static_cast<std::uint32_t>(reader.varint());
+    const OpLayout& layout = kOpLayouts[command.op];
+    for (std::uint8_t arg = 0; arg < layout.intArgs; ++arg) {
+      command.args[arg] = reader.varint();
+    }
+    if (layout.text) {
+      const std::span<const std::byte> text = reader.bytes();
+      command.text = {reinterpret_cast<const char*>(text.data()), text.size()};
+    }
+    if (layout.payload) {
+      command.payload = reader.bytes();
+    }
+    // Replay copies the payload into a range allocated from these arguments.
+    if (static_cast<Op>(command.op) == Op::Transient) {
+      if (command.payload.size() != command.args[0]) {
+        reader.fail("transient payload of " + std::to_string(command.payload.size()) + " bytes for a " +
+                    std::to_string(command.args[0]) + "-byte range");
+      }
+      if (!std::has_single_bit(command.args[1])) {
+        reader.fail("transient alignment " + std::to_string(command.args[1]) + " is not a power of two");
+      }
+    }
+    if (static_cast<Op>(command.op) == Op::EndFrame) {
+      ++capture.frameCount_;
+    }
+    capture.commands_.push_back(command);
+  }
+  return capture;
+}
+
+CommandReplayResult CommandCapture::replay(IRenderDevice& device) const {
+  ENGINE_PROFILE_ZONE("CommandCapture::replay");
+  ReplayHandles<BufferHandle> buffers;
+  ReplayHandles<TextureHandle> textures;
+  ReplayHandles<ShaderHandle> shaders;
+  ReplayHandles<PipelineHandle> pipelines;
+  std::unordered_map<std::uint32_t, std::unique_ptr<ICommandContext>> contexts;
+  // Keyed by the captured ring buffer id; cleared when a frame ends, as the ranges expire then.
+  std::unordered_map<std::uint64_t, std::vector<ReplayTransient>> transients;
+  std::unordered_map<std::uint32_t, std::uint64_t> frameIndices;
+
+  // Transient ranges were never created through createBuffer(), so binds to them are resolved by
+  // the captured offset instead of the handle alone.
+  const auto bufferBinding = [&](const std::uint64_t capturedId, const std::uint64_t offset) -> std::pair<BufferHandle, std::uint64_t> {
+    if (const auto found = transients.find(capturedId); found != transients.end()) {
+      for (const ReplayTransient& range : found->second) {
+        if (offset >= range.capturedOffset && offset - range.capturedOffset < std::max<std::uint64_t>(range.size, 1)) {
+          return {range.buffer, range.offset + (offset - range.capturedOffset)};
+        }
+      }
+    }
+    return {mappedHandle(buffers, capturedId, "buffer"), offset};
+  };
+  const auto context = [&contexts](const Command& command) -> ICommandContext& {
+    const auto found = contexts.find(command.context);
+    if (found == contexts.end()) {
+      throw std::runtime_error("Command capture references unknown command context " + std::to_string(command.context));
+    }
+    return *found->second;
+  };
+  const auto u32 = [](const std::uint64_t value) { return static_cast<std::uint32_t>(value); };
+
+  using Clock = std::chrono::steady_clock;
+  CommandReplayResult result{};
+  result.frames.reserve(static_cast<std::size_t>(frameCount_));
+  Clock::time_point frameStart = Clock::now();
+  bool inSetup = true;
+
+  for (const Command& command : commands_) {
+    const auto& args = command.args;
+    switch (static_cast<Op>(command.op)) {
+    case Op::CreateBuffer: {
+      BufferCreateInfo createInfo{};
+      createInfo.sizeBytes = args[1];
+      createInfo.usage = static_cast<BufferUsage>(args[2]);
+      createInfo.cpuVisible = args[3] != 0;
+      createInfo.initialData = command.payload.empty() ? nullptr : command.payload.data();
+      createInfo.debugName = command.text;
+      buffers[args[0]].push_back(device.createBuffer(createInfo));
+      break;
+    }
+    case Op::DestroyBuffer:
+      device.destroyBuffer(takeHandle(buffers, args[0], "buffer"));
+      break;
+    case Op::UpdateBuffer:
+      device.updateBuffer(mappedHandle(buffers, args[0], "buffer"), args[1], command.payload);
+      break;
+    case Op::QueueBufferUpload:
+      (void)device.queueBufferUpload(mappedHandle(buffers, args[0], "buffer"), args[1], command.payload);
+      break;
+    case Op::Transient: {
+      const TransientAllocation allocation = device.allocateTransient(args[0], args[1]);
+      if (allocation.data.size() < command.payload.size()) {
+        throw std::runtime_error("Command capture replay: device returned a " + std::to_string(allocation.data.size()) +
+                                 "-byte transient range for " + std::to_string(command.payload.size()) + " bytes");
+      }
+      std::copy(command.payload.begin(), command.payload.end(), allocation.data.begin());
+      transients[args[2]].push_back({args[3], args[0], allocation.buffer, allocation.offset});
+      break;
+    }
+    case Op::CreateTexture: {
+      TextureCreateInfo createInfo{};
+      createInfo.dimension = static_cast<TextureDimension>(args[1]);
+      createInfo.format = static_cast<TextureFormat>(args[2]);
+      createInfo.extent = {u32(args[3]), u32(args[4])};
+      createInfo.depth = u32(args[5]);
+      createInfo.mipLevels = u32(args[6]);
+      createInfo.firstResidentMip = u32(args[7]);
+      createInfo.debugName = command.text;
+      textures[args[0]].push_back(device.createTexture(createInfo));
+      break;
+    }
+    case Op::DestroyTexture:
+      device.destroyTexture(takeHandle(textures, args[0], "texture"));
+      break;
+    case Op::UpdateTexture:
+      device.updateTexture(mappedHandle(textures, args[0], "texture"), u32(args[1]), command.payload);
+      break;
+    case Op::SetTextureResidency:
+      device.setTextureResidency(mappedHandle(textures, args[0], "texture"), u32(args[1]));
+      break;
+    case Op::CreateShader: {
+      ShaderCreateInfo createInfo{};
+      createInfo.stage = static_cast<ShaderStage>(args[1]);
+      createInfo.byteCode = command.payload.empty() ? nullptr : command.payload.data();
+      createInfo.byteCodeSize = command.payload.size();
+      createInfo.debugName = command.text;
+      shaders[args[0]].push_back(device.createShader(createInfo));
+      break;
+    }
+    case Op::DestroyShader:
+      device.destroyShader(takeHandle(shaders, args[0], "shader"));
+      break;
+    case Op::CreatePipeline: {
+      GraphicsPipelineCreateInfo createInfo{};
+      createInfo.vertexShader = mappedHandle(shaders, args[1], "shader");
+      createInfo.fragmentShader = mappedHandle(shaders, args[2], "shader");
+      createInfo.topology = static_cast<PrimitiveTopology>(args[3]);
+      createInfo.debugName = command.text;
+      const PipelineHandle pipeline = device.createGraphicsPipeline(createInfo);
+      while (device.pipelineStatus(pipeline) == PipelineStatus::Pending) {
+      }
+      pipelines[args[0]].push_back(pipeline);
+      break;
+    }
+    case Op::DestroyPipeline:
+      device.destroyPipeline(takeHandle(pipelines, args[0], "pipeline"));
+      break;
+    case Op::CreateContext:
+      contexts[command.context] = device.createCommandContext();
+      break;
+    case Op::DestroyContext:
+      contexts.erase(command.context);
+      break;
+    case Op::BeginFrame:
+      if (inSetup) {
+        const Clock::time_point now = Clock::now();
+        result.setupMs = std::chrono::duration<double, std::milli>(now - frameStart).count();
+        frameStart = now;
+        inSetup = false;
+      }
+      frameIndices[command.context] = args[0];
+      context(command).beginFrame({args[0], {u32(args[1]), u32(args[2])}});
+      break;
+    case Op::EndFrame: {
+      context(command).endFrame();
+      const Clock::time_point now = Clock::now();
+      const RenderFrameStats stats = device.frameStats();
+      result.frames.push_back({frameIndices[command.context],
+                               std::chrono::duration<double, std::milli>(now - frameStart).count(),
+                               stats.drawCalls,
+                               stats.triangles});
+      transients.clear();
+      frameStart = Clock::now();
+      break;
+    }
+    case Op::BeginPass:
+      context(command).beginPass(command.text);
+      break;
+    case Op::EndPass:
+      context(command).endPass();
+      break;
+    case Op::BindPipeline:
+      context(command).bindPipeline(mappedHandle(pipelines, args[0], "pipeline"));
+      break;
+    case Op::BindVertexBuffer: {
+      const auto [buffer, offset] = bufferBinding(args[0], args[1]);
+      context(command).bindVertexBuffer(buffer, offset);
+      break;
+    }
+    case Op::BindIndexBuffer: {
+      const auto [buffer, offset] = bufferBinding(args[0], args[1]);
+      context(command).bindIndexBuffer(buffer, offset);
+      break;
+    }
+    case Op::BindUniformBuffer: {
+      const auto [buffer, offset] = bufferBinding(args[1], args[2]);
+      context(command).bindUniformBuffer(u32(args[0]), buffer, offset, args[3]);
+      break;
+    }
+    case Op::Draw:
+      context(command).draw(u32(args[0]), u32(args[1]), u32(args[2]), u32(args[3]));
+      break;
+    case Op::DrawIndexed:
+      context(command).drawIndexed(u32(args[0]), u32(args[1]), u32(args[2]), static_cast<std::int32_t>(u32(args[3])), u32(args[4]));
+      break;
+    case Op::Count:
+      break;
+    }
+  }
+
+  contexts.clear();
+  destroyAll(pipelines, [&device](const PipelineHandle handle) { device.destroyPipeline(handle); });
+  destroyAll(shaders, [&device](const ShaderHandle handle) { device.destroyShader(handle); });
+  destroyAll(textures, [&device](const TextureHandle handle) { device.destroyTexture(handle); });
+  destroyAll(buffers, [&device](const BufferHandle handle) { device.destroyBuffer(handle); });
+  return result;
+}
+
+} // namespace engine::render
@@ -0,0 +1,302 @@
+#include "engine/render/Ktx2Loader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "engine/core/Profiler.hpp"
+#include "engine/render/TextureDecoder.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine::render {
+namespace {
+
+constexpr std::array<unsigned char, 12> kKtx2Identifier{0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+// Identifier, nine uint32 header fields and the DFD/KVD/SGD index.
+constexpr std::size_t kKtx2LevelIndexOffset = 80;
+constexpr std::size_t kKtx2LevelIndexEntrySize = 24;
+
+struct VkFormatMapping {
+  std::uint32_t vkFormat;
+  TextureFormat format;
+  bool srgb;
+};
+
+constexpr std::array<VkFormatMapping, 16> kVkFormats{{
+    {37, TextureFormat::RGBA8, false},      // VK_FORMAT_R8G8B8A8_UNORM
+    {43, TextureFormat::RGBA8, true},       // VK_FORMAT_R8G8B8A8_SRGB
+    {97, TextureFormat::RGBA16F, false},    // VK_FORMAT_R16G16B16A16_SFLOAT
+    {131, TextureFormat::BC1RGB, false},    // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+    {132, TextureFormat::BC1RGB, true},     // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+    {133, TextureFormat::BC1, false},       // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+    {134, TextureFormat::BC1, true},        // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+    {137, TextureFormat::BC3, false},       // VK_FORMAT_BC3_UNORM_BLOCK
+    {138, TextureFormat::BC3, true},        // VK_FORMAT_BC3_SRGB_BLOCK
+    {141, TextureFormat::BC5, false},       // VK_FORMAT_BC5_UNORM_BLOCK
+    {145, TextureFormat::BC7, false},       // VK_FORMAT_BC7_UNORM_BLOCK
+    {146, TextureFormat::BC7, true},        // VK_FORMAT_BC7_SRGB_BLOCK
+    {147, TextureFormat::ETC2RGB8, false},  // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+    {148, TextureFormat::ETC2RGB8, true},   // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+    {151, TextureFormat::ETC2RGBA8, false}, // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+    {152, TextureFormat::ETC2RGBA8, true},  // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+}};
+
+template <typename T>
+[[nodiscard]] T readLittleEndian(const std::byte* data) {
+  T value = 0;
+  for (std::size_t index = sizeof(T); index-- > 0;) {
+    value = static_cast<T>((value << 8U) | std::to_integer<T>(data[index]));
+  }
+  return value;
+}
+
+[[noreturn]] void throwKtx2Error(const std::filesystem::path& path, const std::string& reason) {
+  throw std::runtime_error("KTX2 file '" + path.string() + "': " + reason);
+}
+
+// Slices (3D) or faces (cube) stored per level, for the CPU decoder.
+[[nodiscard]] std::uint32_t levelLayers(const TextureCreateInfo& createInfo, const std::uint32_t mipLevel) {
+  if (createInfo.dimension == TextureDimension::TextureCube) {
+    return 6;
+  }
+  if (createInfo.dimension == TextureDimension::Texture3D) {
+    return std::max<std::uint32_t>(1, createInfo.depth >> mipLevel);
+  }
+  return 1;
+}
+
+} // namespace
+
+Ktx2File Ktx2File::open(const std::filesystem::path& path) {
+  ENGINE_PROFILE_ZONE("Ktx2File::open");
+  Ktx2File file;
+
+#if defined(_WIN32)
+  const HANDLE handle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    throwKtx2Error(path, "cannot open file");
+  }
+  LARGE_INTEGER size{};
+  if (GetFileSizeEx(handle, &size) == FALSE || size.QuadPart == 0) {
+    CloseHandle(handle);
+    throwKtx2Error(path, "cannot read file size");
+  }
+  const HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(handle);
+  if (mapping == nullptr) {
+    throwKtx2Error(path, "cannot map file");
+  }
+  const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view == nullptr) {
+    CloseHandle(mapping);
+    throwKtx2Error(path, "cannot map file");
+  }
+  file.fileMapping_ = mapping;
+  file.mapping_ = static_cast<const std::byte*>(view);
+  file.mappingSize_ = static_cast<std::size_t>(size.QuadPart);
+#else
+  const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (descriptor < 0) {
+    throwKtx2Error(path, "cannot open file");
+  }
+  struct stat status {};
+  if (::fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+    ::close(descriptor);
+    throwKtx2Error(path, "cannot read file size");
+  }
+  void* view = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+  ::close(descriptor);
+  if (view == MAP_FAILED) {
+    throwKtx2Error(path, "cannot map file");
+  }
+  file.mapping_ = static_cast<const std::byte*>(view);
+  file.mappingSize_ = static_cast<std::size_t>(status.st_size);
+#endif
+
+  const std::byte* data = file.mapping_;
+  if (file.mappingSize_ < kKtx2LevelIndexOffset ||
+      std::memcmp(data, kKtx2Identifier.data(), kKtx2Identifier.size()) != 0) {
+    throwKtx2Error(path, "not a KTX2 file");
+  }
+
+  const auto header = [data](const std::size_t field) { return readLittleEndian<std::uint32_t>(data + 12 + field * 4); };
+  const std::uint32_t vkFormat = header(0);
+  const std::uint32_t pixelWidth = header(2);
+  const std::uint32_t pixelHeight = header(3);
+  const std::uint32_t pixelDepth = header(4);
+  const std::uint32_t layerCount = header(5);
+  const std::uint32_t faceCount = header(6);
+  const std::uint32_t levelCount = std::max<std::uint32_t>(1, header(7));
+  const std::uint32_t supercompression = header(8);
+
+  const auto mapping = std::find_if(kVkFormats.begin(), kVkFormats.end(),
+                                    [vkFormat](const VkFormatMapping& entry) { return entry.vkFormat == vkFormat; });
+  if (mapping == kVkFormats.end()) {
+    throwKtx2Error(path, "unsupported vkFormat " + std::to_string(vkFormat));
+  }
+  if (supercompression != 0) {
+    throwKtx2Error(path, "supercompression scheme " + std::to_string(supercompression) + " is not supported");
+  }
+  if (layerCount > 1) {
+    throwKtx2Error(path, "array textures are not supported");
+  }
+  if (faceCount != 1 && faceCount != 6) {
+    throwKtx2Error(path, "invalid face count " + std::to_string(faceCount));
+  }
+  if (pixelWidth == 0 || (faceCount == 6 && (pixelDepth != 0 || pixelWidth != pixelHeight))) {
+    throwKtx2Error(path, "invalid dimensions");
+  }
+
+  TextureCreateInfo& createInfo = file.createInfo_;
+  createInfo.format = mapping->format;
+  createInfo.extent = {pixelWidth, std::max<std::uint32_t>(1, pixelHeight)};
+  createInfo.depth = std::max<std::uint32_t>(1, pixelDepth);
+  createInfo.dimension = faceCount == 6   ? TextureDimension::TextureCube
+                         : pixelDepth > 0 ? TextureDimension::Texture3D
+                                          : TextureDimension::Texture2D;
+  createInfo.mipLevels = levelCount;
+  file.srgb_ = mapping->srgb;
+  if (levelCount > fullMipChainLength(createInfo.extent, createInfo.depth)) {
+    throwKtx2Error(path, "more levels than the mip chain allows");
+  }
+  if (file.mappingSize_ < kKtx2LevelIndexOffset + levelCount * kKtx2LevelIndexEntrySize) {
+    throwKtx2Error(path, "truncated level index");
+  }
+
+  file.levels_.reserve(levelCount);
+  for (std::uint32_t level = 0; level < levelCount; ++level) {
+    const std::byte* entry = data + kKtx2LevelIndexOffset + level * kKtx2LevelIndexEntrySize;
+    const auto byteOffset = readLittleEndian<std::uint64_t>(entry);
+    const auto byteLength = readLittleEndian<std::uint64_t>(entry + 8);
+    if (byteLength != textureMipByteSize(createInfo, level)) {
+      throwKtx2Error(path, "level " + std::to_string(level) + " has " + std::to_string(byteLength) + " bytes, expected " +
+                               std::to_string(textureMipByteSize(createInfo, level)));
+    }
+    if (byteOffset > file.mappingSize_ || byteLength > file.mappingSize_ - byteOffset) {
+      throwKtx2Error(path, "level " + std::to_string(level) + " lies outside the file");
+    }
+    file.levels_.emplace_back(data + byteOffset, static_cast<std::size_t>(byteLength));
+  }
+  return file;
+}
+
+Ktx2File::Ktx2File(Ktx2File&& other) noexcept
+    : mapping_(std::exchange(other.mapping_, nullptr)),
+      mappingSize_(std::exchange(other.mappingSize_, 0)),
+#if defined(_WIN32)
+      fileMapping_(std::exchange(other.fileMapping_, nullptr)),
+#endif
+      createInfo_(other.createInfo_),
+      levels_(std::move(other.levels_)),
+      srgb_(other.srgb_) {
+}
+
+Ktx2File& Ktx2File::operator=(Ktx2File&& other) noexcept {
+  if (this != &other) {
+    release();
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mappingSize_ = std::exchange(other.mappingSize_, 0);
+#if defined(_WIN32)
+    fileMapping_ = std::exchange(other.fileMapping_, nullptr);
+#endif
+    createInfo_ = other.createInfo_;
+    levels_ = std::move(other.levels_);
+    srgb_ = other.srgb_;
+  }
+  return *this;
+}
+
+Ktx2File::~Ktx2File() {
+  release();
+}
+
+void Ktx2File::release() noexcept {
+  if (mapping_ == nullptr) {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(mapping_);
+  CloseHandle(fileMapping_);
+  fileMapping_ = nullptr;
+#else
+  ::munmap(const_cast<std::byte*>(mapping_), mappingSize_);
+#endif
+  mapping_ = nullptr;
+  mappingSize_ = 0;
+  levels_.clear();
+}
+
+std::span<const std::byte> Ktx2File::level(const std::uint32_t mipLevel) const {
+  if (mipLevel >= levels_.size()) {
+    throw std::runtime_error("KTX2 level " + std::to_string(mipLevel) + " is out of range");
+  }
+  return levels_[mipLevel];
+}
+
+TextureFormat ktx2UploadFormat(const IRenderDevice& device, const Ktx2File& file) {
+  const TextureFormat format = file.createInfo().format;
+  return device.supportsTextureFormat(format) ? format : TextureFormat::RGBA8;
+}
+
+std::vector<std::byte> ktx2UploadLevel(const Ktx2File& file, const std::uint32_t mipLevel, const TextureFormat uploadFormat) {
+  const std::span<const std::byte> stored = file.level(mipLevel);
+  const TextureCreateInfo& createInfo = file.createInfo();
+  if (uploadFormat == createInfo.format) {
+    return {stored.begin(), stored.end()};
+  }
+  if (uploadFormat != TextureFormat::RGBA8 || !isBlockCompressed(createInfo.format)) {
+    throw std::runtime_error("KTX2 data can only be converted from a block-compressed format to RGBA8");
+  }
+  const platform::Extent2D extent{std::max<std::uint32_t>(1, createInfo.extent.width >> mipLevel),
+                                  std::max<std::uint32_t>(1, createInfo.extent.height >> mipLevel)};
+  return decodeTextureToRgba8(createInfo.format, extent, levelLayers(createInfo, mipLevel), stored);
+}
+
+TextureHandle createTextureFromKtx2(IRenderDevice& device, const Ktx2File& file, const std::string_view debugName) {
+  ENGINE_PROFILE_ZONE("Ktx2::createTexture");
+  TextureCreateInfo createInfo = file.createInfo();
+  createInfo.format = ktx2UploadFormat(device, file);
+  createInfo.firstResidentMip = 0;
+  createInfo.debugName = debugName;
+  const TextureHandle texture = device.createTexture(createInfo);
+  try {
+    for (std::uint32_t level = 0; level < file.levelCount(); ++level) {
+      if (createInfo.format == file.createInfo().format) {
+        // Upload straight from the mapping.
+        device.updateTexture(texture, level, file.level(level));
+      } else {
+        device.updateTexture(texture, level, ktx2UploadLevel(file, level, createInfo.format));
+      }
+    }
+  } catch (...) {
+    device.destroyTexture(texture);
+    throw;
+  }
+  return texture;
+}
+
+StreamedTextureDesc ktx2StreamedTextureDesc(const IRenderDevice& device, std::shared_ptr<const Ktx2File> file, std::string debugName) {
+  StreamedTextureDesc desc;
+  desc.createInfo = file->createInfo();
+  desc.createInfo.format = ktx2UploadFormat(device, *file);
+  desc.debugName = std::move(debugName);
+  desc.loadMip = [file = std::move(file), format = desc.createInfo.format](const std::uint32_t mipLevel) {
+    return ktx2UploadLevel(*file, mipLevel, format);
+  };
+  return desc;
+}
+
+} // namespace engine::render
@@ -6,6 +6,8 @@
 #include <string>
 
 #include "engine/render/IRenderBackend.hpp"
+#include "engine/render/null/NullRenderBackend.hpp"
+#include "engine/render/software/SoftwareRenderBackend.hpp"
 
 #if ENGINE_RENDER_HAS_OPENGL
 #include "engine/render/opengl/OpenGlRenderBackend.hpp"
@@ -39,6 +41,12 @@ std::optional<RenderBackendType> parseRenderBackendType(const std::string_view v
   if (normalized == "directx" || normalized == "d3d") {
     return RenderBackendType::DirectX;
   }
+  if (normalized == "software" || normalized == "cpu") {
+    return RenderBackendType::Software;
+  }
+  if (normalized == "null" || normalized == "none") {
+    return RenderBackendType::Null;
+  }
   return std::nullopt;
 }
 
@@ -80,6 +88,10 @@ std::unique_ptr<IRenderBackend> createRenderBackend(RenderBackendType type) {
     throw std::runtime_error("Vulkan backend requested but not yet implemented");
   case RenderBackendType::DirectX:
     throw std::runtime_error("DirectX backend requested but not yet implemented");
+  case RenderBackendType::Software:
+    return createSoftwareRenderBackend();
+  case RenderBackendType::Null:
+    return createNullRenderBackend();
   case RenderBackendType::Auto:
   default:
     throw std::runtime_error("Unknown render backend requested");
@@ -0,0 +1,611 @@
+#include "engine/render/TextureDecoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "engine/core/Profiler.hpp"
+
+namespace engine::render {
+namespace {
+
+// One decoded 4x4 block, row-major RGBA8.
+using BlockTexels = std::array<std::uint8_t, 64>;
+
+[[nodiscard]] std::uint8_t clampByte(const int value) {
+  return static_cast<std::uint8_t>(std::clamp(value, 0, 255));
+}
+
+[[nodiscard]] std::uint64_t loadLittleEndian64(const std::byte* data) {
+  std::uint64_t value = 0;
+  for (int index = 7; index >= 0; --index) {
+    value = (value << 8U) | std::to_integer<std::uint64_t>(data[index]);
+  }
+  return value;
+}
+
+[[nodiscard]] std::uint64_t loadBigEndian64(const std::byte* data) {
+  std::uint64_t value = 0;
+  for (int index = 0; index < 8; ++index) {
+    value = (value << 8U) | std::to_integer<std::uint64_t>(data[index]);
+  }
+  return value;
+}
+
+// --- BC1 / BC3 / BC5 ----------------------------------------------------------------------------
+
+void decodeBc1Colors(const std::byte* block, BlockTexels& texels, const bool alwaysFourColors) {
+  const auto color0 = static_cast<std::uint16_t>(std::to_integer<unsigned>(block[0]) | (std::to_integer<unsigned>(block[1]) << 8U));
+  const auto color1 = static_cast<std::uint16_t>(std::to_integer<unsigned>(block[2]) | (std::to_integer<unsigned>(block[3]) << 8U));
+  const auto expand565 = [](const std::uint16_t color) {
+    const unsigned red = (color >> 11U) & 31U;
+    const unsigned green = (color >> 5U) & 63U;
+    const unsigned blue = color & 31U;
+    return std::array<int, 4>{static_cast<int>((red << 3U) | (red >> 2U)), static_cast<int>((green << 2U) | (green >> 4U)),
+                              static_cast<int>((blue << 3U) | (blue >> 2U)), 255};
+  };
+
+  std::array<std::array<int, 4>, 4> palette{expand565(color0), expand565(color1), {}, {}};
+  for (std::size_t channel = 0; channel < 3; ++channel) {
+    if (alwaysFourColors || color0 > color1) {
+      palette[2][channel] = (2 * palette[0][channel] + palette[1][channel]) / 3;
+      palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel]) / 3;
+    } else {
+      palette[2][channel] = (palette[0][channel] + palette[1][channel]) / 2;
+      palette[3][channel] = 0;
+    }
+  }
+  palette[2][3] = 255;
+  palette[3][3] = alwaysFourColors || color0 > color1 ? 255 : 0;
+
+  std::uint32_t indices = 0;
+  for (int index = 7; index >= 4; --index) {
+    indices = (indices << 8U) | std::to_integer<std::uint32_t>(block[index]);
+  }
+  for (std::size_t texel = 0; texel < 16; ++texel) {
+    const auto& color = palette[(indices >> (2 * texel)) & 3U];
+    for (std::size_t channel = 0; channel < 4; ++channel) {
+      texels[texel * 4 + channel] = static_cast<std::uint8_t>(color[channel]);
+    }
+  }
+}
+
+// BC4-style single channel block, shared by BC3 alpha and both BC5 channels.
+void decodeBc4Channel(const std::byte* block, BlockTexels& texels, const std::size_t channel) {
+  const int value0 = std::to_integer<int>(block[0]);
+  const int value1 = std::to_integer<int>(block[1]);
+  std::array<int, 8> palette{value0, value1};
+  if (value0 > value1) {
+    for (int step = 1; step < 7; ++step) {
+      palette[static_cast<std::size_t>(step + 1)] = ((7 - step) * value0 + step * value1) / 7;
+    }
+  } else {
+    for (int step = 1; step < 5; ++step) {
+      palette[static_cast<std::size_t>(step + 1)] = ((5 - step) * value0 + step * value1) / 5;
+    }
+    palette[6] = 0;
+    palette[7] = 255;
+  }
+
+  std::uint64_t indices = 0;
+  for (int index = 7; index >= 2; --index) {
+    indices = (indices << 8U) | std::to_integer<std::uint64_t>(block[index]);
+  }
+  for (std::size_t texel = 0; texel < 16; ++texel) {
+    texels[texel * 4 + channel] = static_cast<std::uint8_t>(palette[(indices >> (3 * texel)) & 7U]);
+  }
+}
+
+void decodeBc1Block(const std::byte* block, BlockTexels& texels) {
+  decodeBc1Colors(block, texels, false);
+}
+
+void decodeBc1RgbBlock(const std::byte* block, BlockTexels& texels) {
+  decodeBc1Colors(block, texels, false);
+  for (std::size_t texel = 0; texel < 16; ++texel) {
+    texels[texel * 4 + 3] = 255;
+  }
+}
+
+void decodeBc3Block(const std::byte* block, BlockTexels& texels) {
+  decodeBc1Colors(block + 8, texels, true);
+  decodeBc4Channel(block, texels, 3);
+}
+
+void decodeBc5Block(const std::byte* block, BlockTexels& texels) {
+  decodeBc4Channel(block, texels, 0);
+  decodeBc4Channel(block + 8, texels, 1);
+  for (std::size_t texel = 0; texel < 16; ++texel) {
+    texels[texel * 4 + 2] = 0;
+    texels[texel * 4 + 3] = 255;
+  }
+}
+
+// --- BC7 ----------------------------------------------------------------------------------------
+
+struct Bc7Mode {
+  std::uint8_t subsets;
+  std::uint8_t partitionBits;
+  std::uint8_t rotationBits;
+  std::uint8_t indexSelectionBits;
+  std::uint8_t colorBits;
+  std::uint8_t alphaBits;
+  std::uint8_t endpointPBits;
+  std::uint8_t sharedPBits;
+  std::uint8_t indexBits;
+  std::uint8_t secondaryIndexBits;
+};
+
+constexpr std::array<Bc7Mode, 8> kBc7Modes{{
+    {3, 4, 0, 0, 4, 0, 1, 0, 3, 0},
+    {2, 6, 0, 0, 6, 0, 0, 1, 3, 0},
+    {3, 6, 0, 0, 5, 0, 0, 0, 2, 0},
+    {2, 6, 0, 0, 7, 0, 1, 0, 2, 0},
+    {1, 0, 2, 1, 5, 6, 0, 0, 2, 3},
+    {1, 0, 2, 0, 7, 8, 0, 0, 2, 2},
+    {1, 0, 0, 0, 7, 7, 1, 0, 4, 0},
+    {2, 6, 0, 0, 5, 5, 1, 0, 2, 0},
+}};
+
+// Bit t set: texel t belongs to subset 1.
+constexpr std::array<std::uint16_t, 64> kBc7Partitions2{
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80, 0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8,
+    0xFF00, 0xFFF0, 0xF000, 0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE, 0x088C, 0x3110,
+    0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C, 0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696,
+    0xA55A, 0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660, 0x0272, 0x04E4, 0x4E40, 0x2720,
+    0xC936, 0x936C, 0x39C6, 0x639C, 0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+// Two bits per texel (texel 0 in the low bits): subset index 0-2.
+constexpr std::array<std::uint32_t, 64> kBc7Partitions3{
+    0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+    0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+    0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+    0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+    0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+    0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+    0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+    0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+};
+
+// Anchor texels (stored with one index bit less) of the second and third subsets.
+constexpr std::array<std::uint8_t, 64> kBc7Anchors2{
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 2,  8, 2,  2,  8,
+    8,  15, 2,  8,  2,  2,  8,  8,  2,  2,  15, 15, 6,  8,  2,  8,  15, 15, 2, 8,  2,  2,
+    2,  15, 15, 6,  6,  2,  6,  8,  15, 15, 2,  2,  15, 15, 15, 15, 15, 2,  2, 15,
+};
+
+constexpr std::array<std::uint8_t, 64> kBc7Anchors3Second{
+    3, 3,  15, 15, 8, 3,  15, 15, 8,  8,  6,  6,  6, 5,  3,  3,  3,  3,  8,  15, 3,  3,
+    6, 10, 5,  8,  8, 6,  8,  5,  15, 15, 8,  15, 3, 5,  6,  10, 8,  15, 15, 3,  15, 5,
+    15, 15, 15, 15, 3, 15, 5,  5,  5,  8,  5,  10, 5, 10, 8,  13, 15, 12, 3,  3,
+};
+
+constexpr std::array<std::uint8_t, 64> kBc7Anchors3Third{
+    15, 8,  8,  3,  15, 15, 3,  8,  15, 15, 15, 15, 15, 15, 15, 8,  15, 8,  15, 3,  15, 8,
+    15, 8,  3,  15, 6,  10, 15, 15, 10, 8,  15, 3,  15, 10, 10, 8,  9,  10, 6,  15, 8,  15,
+    3,  6,  6,  8,  15, 3,  15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 3,  15, 15, 8,
+};
+
+constexpr std::array<int, 4> kBc7Weights2{0, 21, 43, 64};
+constexpr std::array<int, 8> kBc7Weights3{0, 9, 18, 27, 37, 46, 55, 64};
+constexpr std::array<int, 16> kBc7Weights4{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+class Bc7BitReader {
+public:
+  explicit Bc7BitReader(const std::byte* block)
+      : low_(loadLittleEndian64(block)), high_(loadLittleEndian64(block + 8)) {}
+
+  [[nodiscard]] unsigned read(const unsigned count) {
+    unsigned value = 0;
+    for (unsigned bit = 0; bit < count; ++bit, ++position_) {
+      const std::uint64_t word = position_ < 64 ? low_ >> position_ : high_ >> (position_ - 64);
+      value |= static_cast<unsigned>(word & 1U) << bit;
+    }
+    return value;
+  }
+
+private:
+  std::uint64_t low_ = 0;
+  std::uint64_t high_ = 0;
+  unsigned position_ = 0;
+};
+
+[[nodiscard]] int bc7Interpolate(const int endpoint0, const int endpoint1, const unsigned index, const unsigned indexBits) {
+  int weight = 0;
+  if (indexBits == 2) {
+    weight = kBc7Weights2[index];
+  } else if (indexBits == 3) {
+    weight = kBc7Weights3[index];
+  } else {
+    weight = kBc7Weights4[index];
+  }
+  return ((64 - weight) * endpoint0 + weight * endpoint1 + 32) >> 6;
+}
+
+void decodeBc7Block(const std::byte* block, BlockTexels& texels) {
+  Bc7BitReader bits{block};
+  unsigned modeIndex = 0;
+  while (modeIndex < 8 && bits.read(1) == 0) {
+    ++modeIndex;
+  }
+  if (modeIndex == 8) {
+    // Reserved mode: decoders output transparent black.
+    texels.fill(0);
+    return;
+  }
+
+  const Bc7Mode& mode = kBc7Modes[modeIndex];
+  const unsigned partition = bits.read(mode.partitionBits);
+  const unsigned rotation = bits.read(mode.rotationBits);
+  const unsigned indexSelection = bits.read(mode.indexSelectionBits);
+
+  // endpoints[subset * 2 + endpoint][channel]
+  std::array<std::array<int, 4>, 6> endpoints{};
+  const unsigned endpointCount = mode.subsets * 2U;
+  for (std::size_t channel = 0; channel < 3; ++channel) {
+    for (unsigned endpoint = 0; endpoint < endpointCount; ++endpoint) {
+      endpoints[endpoint][channel] = static_cast<int>(bits.read(mode.colorBits));
+    }
+  }
+  for (unsigned endpoint = 0; endpoint < endpointCount; ++endpoint) {
+    endpoints[endpoint][3] = static_cast<int>(bits.read(mode.alphaBits));
+  }
+
+  const std::size_t pbitChannels = mode.alphaBits > 0 ? 4 : 3;
+  if (mode.endpointPBits != 0) {
+    for (unsigned endpoint = 0; endpoint < endpointCount; ++endpoint) {
+      const auto pbit = static_cast<int>(bits.read(1));
+      for (std::size_t channel = 0; channel < pbitChannels; ++channel) {
+        endpoints[endpoint][channel] = (endpoints[endpoint][channel] << 1) | pbit;
+      }
+    }
+  }
+  if (mode.sharedPBits != 0) {
+    for (unsigned subset = 0; subset < mode.subsets; ++subset) {
+      const auto pbit = static_cast<int>(bits.read(1));
+      for (unsigned endpoint = subset * 2; endpoint < subset * 2 + 2; ++endpoint) {
+        for (std::size_t channel = 0; channel < pbitChannels; ++channel) {
+          endpoints[endpoint][channel] = (endpoints[endpoint][channel] << 1) | pbit;
+        }
+      }
+    }
+  }
+
+  const unsigned pbit = mode.endpointPBits != 0 || mode.sharedPBits != 0 ? 1 : 0;
+  const unsigned colorPrecision = mode.colorBits + pbit;
+  const unsigned alphaPrecision = mode.alphaBits == 0 ? 0 : mode.alphaBits + pbit;
+  const auto expand = [](const int value, const unsigned precision) {
+    return (value << (8 - precision)) | (value >> (2 * precision - 8));
+  };
+  for (unsigned endpoint = 0; endpoint < endpointCount; ++endpoint) {
+    for (std::size_t channel = 0; channel < 3; ++channel) {
+      endpoints[endpoint][channel] = expand(endpoints[endpoint][channel], colorPrecision);
+    }
+    endpoints[endpoint][3] = alphaPrecision == 0 ? 255 : expand(endpoints[endpoint][3], alphaPrecision);
+  }
+
+  const auto subsetOf = [&mode, partition](const unsigned texel) -> unsigned {
+    if (mode.subsets == 2) {
+      return (kBc7Partitions2[partition] >> texel) & 1U;
+    }
+    if (mode.subsets == 3) {
+      return (kBc7Partitions3[partition] >> (2 * texel)) & 3U;
+    }
+    return 0;
+  };
+  const auto isAnchor = [&mode, partition](const unsigned texel) {
+    if (texel == 0) {
+      return true;
+    }
+    if (mode.subsets == 2) {
+      return texel == kBc7Anchors2[partition];
+    }
+    if (mode.subsets == 3) {
+      return texel == kBc7Anchors3Second[partition] || texel == kBc7Anchors3Third[partition];
+    }
+    return false;
+  };
+
+  std::array<unsigned, 16> primary{};
+  std::array<unsigned, 16> secondary{};
+  for (unsigned texel = 0; texel < 16; ++texel) {
+    primary[texel] = bits.read(mode.indexBits - (isAnchor(texel) ? 1U : 0U));
+  }
+  if (mode.secondaryIndexBits != 0) {
+    for (unsigned texel = 0; texel < 16; ++texel) {
+      secondary[texel] = bits.read(mode.secondaryIndexBits - (texel == 0 ? 1U : 0U));
+    }
+  }
+
+  for (unsigned texel = 0; texel < 16; ++texel) {
+    const unsigned subset = subsetOf(texel);
+    const std::array<int, 4>& endpoint0 = endpoints[subset * 2];
+    const std::array<int, 4>& endpoint1 = endpoints[subset * 2 + 1];
+
+    unsigned colorIndex = primary[texel];
+    unsigned colorBits = mode.indexBits;
+    unsigned alphaIndex = primary[texel];
+    unsigned alphaBits = mode.indexBits;
+    if (mode.secondaryIndexBits != 0) {
+      alphaIndex = secondary[texel];
+      alphaBits = mode.secondaryIndexBits;
+      if (indexSelection != 0) {
+        std::swap(colorIndex, alphaIndex);
+        std::swap(colorBits, alphaBits);
+      }
+    }
+
+    std::array<int, 4> color{};
+    for (std::size_t channel = 0; channel < 3; ++channel) {
+      color[channel] = bc7Interpolate(endpoint0[channel], endpoint1[channel], colorIndex, colorBits);
+    }
+    color[3] = bc7Interpolate(endpoint0[3], endpoint1[3], alphaIndex, alphaBits);
+    if (rotation != 0) {
+      std::swap(color[3], color[rotation - 1]);
+    }
+    for (std::size_t channel = 0; channel < 4; ++channel) {
+      texels[texel * 4 + channel] = static_cast<std::uint8_t>(color[channel]);
+    }
+  }
+}
+
+// --- ETC2 / EAC ---------------------------------------------------------------------------------
+
+constexpr std::array<std::array<int, 4>, 8> kEtcModifiers{{
+    {2, 8, -2, -8},
+    {5, 17, -5, -17},
+    {9, 29, -9, -29},
+    {13, 42, -13, -42},
+    {18, 60, -18, -60},
+    {24, 80, -24, -80},
+    {33, 106, -33, -106},
+    {47, 183, -47, -183},
+}};
+
+constexpr std::array<int, 8> kEtcDistances{3, 6, 11, 16, 23, 32, 41, 64};
+
+constexpr std::array<std::array<int, 8>, 16> kEacModifiers{{
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8},
+}};
+
+// ETC texel t = x * 4 + y (column-major); the 2-bit index is split across the low two words.
+[[nodiscard]] unsigned etcTexelIndex(const std::uint64_t bits, const unsigned x, const unsigned y) {
+  const unsigned texel = x * 4 + y;
+  return static_cast<unsigned>((((bits >> (16 + texel)) & 1U) << 1U) | ((bits >> texel) & 1U));
+}
+
+void writeTexel(BlockTexels& texels, const unsigned x, const unsigned y, const std::array<int, 3>& color) {
+  const std::size_t offset = (static_cast<std::size_t>(y) * 4 + x) * 4;
+  texels[offset] = clampByte(color[0]);
+  texels[offset + 1] = clampByte(color[1]);
+  texels[offset + 2] = clampByte(color[2]);
+  texels[offset + 3] = 255;
+}
+
+void decodeEtcPaintModes(const std::uint64_t bits, BlockTexels& texels, const bool hMode) {
+  const auto high = static_cast<std::uint32_t>(bits >> 32U);
+  std::array<int, 3> color0{};
+  std::array<int, 3> color1{};
+  unsigned distanceIndex = 0;
+  if (!hMode) {
+    color0 = {static_cast<int>((((high >> 27U) & 3U) << 2U) | ((high >> 24U) & 3U)), static_cast<int>((high >> 20U) & 15U),
+              static_cast<int>((high >> 16U) & 15U)};
+    color1 = {static_cast<int>((high >> 12U) & 15U), static_cast<int>((high >> 8U) & 15U), static_cast<int>((high >> 4U) & 15U)};
+    distanceIndex = (((high >> 2U) & 3U) << 1U) | (high & 1U);
+  } else {
+    color0 = {static_cast<int>((high >> 27U) & 15U), static_cast<int>((((high >> 24U) & 7U) << 1U) | ((high >> 20U) & 1U)),
+              static_cast<int>((((high >> 19U) & 1U) << 3U) | ((high >> 15U) & 7U))};
+    color1 = {static_cast<int>((high >> 11U) & 15U), static_cast<int>((high >> 7U) & 15U), static_cast<int>((high >> 3U) & 15U)};
+    const int packed0 = (color0[0] << 8) | (color0[1] << 4) | color0[2];
+    const int packed1 = (color1[0] << 8) | (color1[1] << 4) | color1[2];
+    distanceIndex = (high & 4U) | ((high << 1U) & 2U) | (packed0 >= packed1 ? 1U : 0U);
+  }
+  for (std::size_t channel = 0; channel < 3; ++channel) {
+    color0[channel] = color0[channel] * 17;
+    color1[channel] = color1[channel] * 17;
+  }
+
+  const int distance = kEtcDistances[distanceIndex];
+  std::array<std::array<int, 3>, 4> paint{};
+  for (std::size_t channel = 0; channel < 3; ++channel) {
+    if (!hMode) {
+      paint[0][channel] = color0[channel];
+      paint[1][channel] = color1[channel] + distance;
+      paint[2][channel] = color1[channel];
+      paint[3][channel] = color1[channel] - distance;
+    } else {
+      paint[0][channel] = color0[channel] + distance;
+      paint[1][channel] = color0[channel] - distance;
+      paint[2][channel] = color1[channel] + distance;
+      paint[3][channel] = color1[channel] - distance;
+    }
+  }
+  for (unsigned y = 0; y < 4; ++y) {
+    for (unsigned x = 0; x < 4; ++x) {
+      writeTexel(texels, x, y, paint[etcTexelIndex(bits, x, y)]);
+    }
+  }
+}
+
+void decodeEtcPlanarMode(const std::uint64_t bits, BlockTexels& texels) {
+  const auto high = static_cast<std::uint32_t>(bits >> 32U);
+  const auto low = static_cast<std::uint32_t>(bits);
+  const auto expand6 = [](const unsigned value) { return static_cast<int>((value << 2U) | (value >> 4U)); };
+  const auto expand7 = [](const unsigned value) { return static_cast<int>((value << 1U) | (value >> 6U)); };
+  const std::array<int, 3> origin{expand6((high >> 25U) & 63U), expand7((((high >> 24U) & 1U) << 6U) | ((high >> 17U) & 63U)),
+                                  expand6((((high >> 16U) & 1U) << 5U) | (((high >> 11U) & 3U) << 3U) | ((high >> 7U) & 7U))};
+  const std::array<int, 3> horizontal{expand6((((high >> 2U) & 31U) << 1U) | (high & 1U)), expand7((low >> 25U) & 127U),
+                                      expand6((low >> 19U) & 63U)};
+  const std::array<int, 3> vertical{expand6((low >> 13U) & 63U), expand7((low >> 6U) & 127U), expand6(low & 63U)};
+  for (unsigned y = 0; y < 4; ++y) {
+    for (unsigned x = 0; x < 4; ++x) {
+      std::array<int, 3> color{};
+      for (std::size_t channel = 0; channel < 3; ++channel) {
+        color[channel] = (static_cast<int>(x) * (horizontal[channel] - origin[channel]) +
+                          static_cast<int>(y) * (vertical[channel] - origin[channel]) + 4 * origin[channel] + 2) >>
+                         2;
+      }
+      writeTexel(texels, x, y, color);
+    }
+  }
+}
+
+void decodeEtc2RgbBlock(const std::byte* block, BlockTexels& texels) {
+  const std::uint64_t bits = loadBigEndian64(block);
+  const bool differential = ((bits >> 33U) & 1U) != 0;
+  const bool flipped = ((bits >> 32U) & 1U) != 0;
+
+  std::array<std::array<int, 3>, 2> bases{};
+  if (differential) {
+    std::array<int, 3> base{};
+    std::array<int, 3> second{};
+    for (std::size_t channel = 0; channel < 3; ++channel) {
+      const unsigned shift = 59U - static_cast<unsigned>(channel) * 8U;
+      base[channel] = static_cast<int>((bits >> shift) & 31U);
+      int delta = static_cast<int>((bits >> (shift - 3U)) & 7U);
+      delta = delta >= 4 ? delta - 8 : delta;
+      second[channel] = base[channel] + delta;
+    }
+    // An out-of-range second colour selects the ETC2 modes (checked in R, G, B order).
+    if (second[0] < 0 || second[0] > 31) {
+      decodeEtcPaintModes(bits, texels, false);
+      return;
+    }
+    if (second[1] < 0 || second[1] > 31) {
+      decodeEtcPaintModes(bits, texels, true);
+      return;
+    }
+    if (second[2] < 0 || second[2] > 31) {
+      decodeEtcPlanarMode(bits, texels);
+      return;
+    }
+    for (std::size_t channel = 0; channel < 3; ++channel) {
+      bases[0][channel] = (base[channel] << 3) | (base[channel] >> 2);
+      bases[1][channel] = (second[channel] << 3) | (second[channel] >> 2);
+    }
+  } else {
+    for (std::size_t channel = 0; channel < 3; ++channel) {
+      const unsigned shift = 60U - static_cast<unsigned>(channel) * 8U;
+      bases[0][channel] = static_cast<int>((bits >> shift) & 15U) * 17;
+      bases[1][channel] = static_cast<int>((bits >> (shift - 4U)) & 15U) * 17;
+    }
+  }
+
+  const std::array<unsigned, 2> tables{static_cast<unsigned>((bits >> 37U) & 7U), static_cast<unsigned>((bits >> 34U) & 7U)};
+  for (unsigned y = 0; y < 4; ++y) {
+    for (unsigned x = 0; x < 4; ++x) {
+      const std::size_t subblock = flipped ? (y < 2 ? 0 : 1) : (x < 2 ? 0 : 1);
+      const int modifier = kEtcModifiers[tables[subblock]][etcTexelIndex(bits, x, y)];
+      writeTexel(texels, x, y, {bases[subblock][0] + modifier, bases[subblock][1] + modifier, bases[subblock][2] + modifier});
+    }
+  }
+}
+
+void decodeEacAlpha(const std::byte* block, BlockTexels& texels) {
+  const std::uint64_t bits = loadBigEndian64(block);
+  const auto base = static_cast<int>(bits >> 56U);
+  const auto multiplier = static_cast<int>((bits >> 52U) & 15U);
+  const std::array<int, 8>& modifiers = kEacModifiers[(bits >> 48U) & 15U];
+  for (unsigned x = 0; x < 4; ++x) {
+    for (unsigned y = 0; y < 4; ++y) {
+      const unsigned texel = x * 4 + y;
+      const int modifier = modifiers[(bits >> (45U - 3U * texel)) & 7U];
+      texels[(static_cast<std::size_t>(y) * 4 + x) * 4 + 3] = clampByte(base + modifier * multiplier);
+    }
+  }
+}
+
+void decodeEtc2RgbaBlock(const std::byte* block, BlockTexels& texels) {
+  decodeEtc2RgbBlock(block + 8, texels);
+  decodeEacAlpha(block, texels);
+}
+
+using BlockDecoder = void (*)(const std::byte*, BlockTexels&);
+
+[[nodiscard]] BlockDecoder blockDecoderFor(const TextureFormat format) {
+  switch (format) {
+  case TextureFormat::BC1:
+    return decodeBc1Block;
+  case TextureFormat::BC1RGB:
+    return decodeBc1RgbBlock;
+  case TextureFormat::BC3:
+    return decodeBc3Block;
+  case TextureFormat::BC5:
+    return decodeBc5Block;
+  case TextureFormat::BC7:
+    return decodeBc7Block;
+  case TextureFormat::ETC2RGB8:
+    return decodeEtc2RgbBlock;
+  case TextureFormat::ETC2RGBA8:
+    return decodeEtc2RgbaBlock;
+  case TextureFormat::RGBA8:
+  case TextureFormat::RGBA16F:
+  case TextureFormat::Depth24Stencil8:
+  default:
+    return nullptr;
+  }
+}
+
+} // namespace
+
+std::vector<std::byte> decodeTextureToRgba8(const TextureFormat format,
+                                            const platform::Extent2D extent,
+                                            const std::uint32_t layers,
+                                            const std::span<const std::byte> blocks) {
+  ENGINE_PROFILE_ZONE("Texture::decodeToRgba8");
+  const BlockDecoder decoder = blockDecoderFor(format);
+  if (decoder == nullptr) {
+    throw std::runtime_error("decodeTextureToRgba8 requires a block-compressed format");
+  }
+
+  const std::size_t blockBytes = textureFormatBlockBytes(format);
+  const std::size_t blocksWide = (static_cast<std::size_t>(extent.width) + 3) / 4;
+  const std::size_t blocksHigh = (static_cast<std::size_t>(extent.height) + 3) / 4;
+  const std::size_t layerBlockBytes = blocksWide * blocksHigh * blockBytes;
+  if (blocks.size() < layerBlockBytes * layers) {
+    throw std::runtime_error("Compressed texture data is smaller than its extent requires (" + std::to_string(blocks.size()) +
+                             " < " + std::to_string(layerBlockBytes * layers) + " bytes)");
+  }
+
+  const std::size_t rowBytes = static_cast<std::size_t>(extent.width) * 4;
+  const std::size_t layerBytes = rowBytes * extent.height;
+  std::vector<std::byte> rgba(layerBytes * layers);
+  BlockTexels texels{};
+  for (std::uint32_t layer = 0; layer < layers; ++layer) {
+    const std::byte* source = blocks.data() + layer * layerBlockBytes;
+    std::byte* target = rgba.data() + layer * layerBytes;
+    for (std::size_t blockY = 0; blockY < blocksHigh; ++blockY) {
+      for (std::size_t blockX = 0; blockX < blocksWide; ++blockX, source += blockBytes) {
+        decoder(source, texels);
+        // Edge blocks of non-multiple-of-4 extents are clipped.
+        const std::size_t copyWidth = std::min<std::size_t>(4, extent.width - blockX * 4);
+        const std::size_t copyHeight = std::min<std::size_t>(4, extent.height - blockY * 4);
+        for (std::size_t row = 0; row < copyHeight; ++row) {
+          std::memcpy(target + (blockY * 4 + row) * rowBytes + blockX * 16, texels.data() + row * 16, copyWidth * 4);
+        }
+      }
+    }
+  }
+  return rgba;
+}
+
+} // namespace engine::render
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FrameStatistics.hpp"
+#include "SampleArguments.hpp"
+#include "engine/render/CommandCapture.hpp"
+#include "engine/render/IRenderBackend.hpp"
+#include "engine/render/IRenderDevice.hpp"
+#include "engine/render/RenderBackendFactory.hpp"
+
+namespace {
+
+struct ReplayOptions {
+  std::string capturePath;
+  std::string reportPath;
+  std::uint32_t repeat = 1;
+  engine::render::RenderBackendType backend = engine::render::RenderBackendType::Null;
+};
+
+using sample::common::computePercentiles;
+using sample::common::Percentiles;
+
+[[nodiscard]] ReplayOptions parseReplayOptions(const int argc, char** argv) {
+  ReplayOptions options{};
+  std::vector<std::string_view> arguments;
+  for (int index = 1; index < argc; ++index) {
+    const std::string_view argument{argv[index]};
+    arguments.push_back(argument);
+    if (argument.starts_with("--report=")) {
+      options.reportPath = std::string{argument.substr(9)};
+    } else if (argument.starts_with("--repeat=")) {
+      options.repeat = sample::common::parseNumericArgument<std::uint32_t>(argument, "--repeat=", 1);
+    } else if (!argument.starts_with("--") && options.capturePath.empty()) {
+      options.capturePath = std::string{argument};
+    } else if (!argument.starts_with("--render-backend=")) {
+      throw std::runtime_error("Unknown argument '" + std::string{argument} + "'");
+    }
+  }
+  if (options.capturePath.empty()) {
+    throw std::runtime_error("Usage: engine_sample_capture_replay <capture file> [--render-backend=null|software] [--repeat=<n>] "
+                             "[--report=<file.json>]");
+  }
+  options.backend = engine::render::selectRenderBackendType(std::nullopt, arguments, engine::render::RenderBackendType::Null);
+  return options;
+}
+
+void writeReportJson(std::ostream& output,
+                     const ReplayOptions& options,
+                     const std::string_view backendName,
+                     const std::vector<engine::render::CommandReplayResult>& runs) {
+  output << std::fixed << std::setprecision(4);
+  output << "{\n  \"capture\": \"" << options.capturePath << "\",\n  \"backend\": \"" << backendName << "\",\n  \"runs\": [\n";
+  for (std::size_t run = 0; run < runs.size(); ++run) {
+    std::vector<double> frameMs;
+    for (const auto& frame : runs[run].frames) {
+      frameMs.push_back(frame.cpuMs);
+    }
+    const Percentiles stats = computePercentiles(frameMs);
+    output << "    {\"setupMs\": " << runs[run].setupMs << ", \"frame\": {\"mean\": " << stats.mean << ", \"p50\": " << stats.p50
+           << ", \"p95\": " << stats.p95 << ", \"p99\": " << stats.p99 << ", \"max\": " << stats.max << "},\n     \"frames\": [";
+    for (std::size_t index = 0; index < runs[run].frames.size(); ++index) {
+      const auto& frame = runs[run].frames[index];
+      output << (index == 0 ? "" : ", ") << "{\"index\": " << frame.frameIndex << ", \"cpuMs\": " << frame.cpuMs
+             << ", \"drawCalls\": " << frame.drawCalls << ", \"triangles\": " << frame.triangles << '}';
+    }
+    output << "]}" << (run + 1 == runs.size() ? "\n" : ",\n");
+  }
+  output << "  ]\n}\n";
+}
+
+int runReplay(const ReplayOptions& options) {
+  using engine::render::RenderBackendType;
+  if (options.backend != RenderBackendType::Null && options.backend != RenderBackendType::Software) {
+    throw std::runtime_error("The replayer runs headless; use --render-backend=null or --render-backend=software");
+  }
+
+  const engine::render::CommandCapture capture = engine::render::CommandCapture::load(options.capturePath);
+  auto backend = engine::render::createRenderBackend(options.backend);
+  std::cout << "Replaying '" << options.capturePath << "' (" << capture.commandCount() << " commands, " << capture.frameCount()
+            << " frames) on " << backend->name() << ", " << options.repeat << " run(s)\n";
+
+  // Each run gets a fresh device so runs do not share warm caches or leftover resources.
+  std::vector<engine::render::CommandReplayResult> runs;
+  for (std::uint32_t run = 0; run < options.repeat; ++run) {
+    auto device = backend->createDevice();
+    runs.push_back(capture.replay(*device));
+  }
+
+  std::cout << std::fixed << std::setprecision(3) << std::left << std::setw(6) << "run" << std::right << std::setw(10) << "setup"
+            << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p95" << std::setw(10) << "p99"
+            << std::setw(10) << "max" << "  (ms)\n";
+  for (std::size_t run = 0; run < runs.size(); ++run) {
+    std::vector<double> frameMs;
+    for (const auto& frame : runs[run].frames) {
+      frameMs.push_back(frame.cpuMs);
+    }
+    const Percentiles stats = computePercentiles(frameMs);
+    std::cout << std::left << std::setw(6) << run << std::right << std::setw(10) << runs[run].setupMs << std::setw(10) << stats.mean
+              << std::setw(10) << stats.p50 << std::setw(10) << stats.p95 << std::setw(10) << stats.p99 << std::setw(10)
+              << stats.max << '\n';
+  }
+
+  if (!options.reportPath.empty()) {
+    std::ofstream report{options.reportPath, std::ios::binary | std::ios::trunc};
+    writeReportJson(report, options, backend->name(), runs);
+    if (!report) {
+      std::cerr << "Failed to write report to '" << options.reportPath << "'\n";
+      return 1;
+    }
+    std::cout << "Wrote report to '" << options.reportPath << "'\n";
+  }
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  try {
+    return runReplay(parseReplayOptions(argc, argv));
+  } catch (const std::exception& exception) {
+    std::cerr << "Capture replay failed: " << exception.what() << '\n';
+    return 1;
+  }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace sample::common {
+
+struct Percentiles {
+  double mean = 0.0;
+  double p50 = 0.0;
+  double p95 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+// Nearest-rank percentiles of per-frame timings; all zero for an empty set.
+[[nodiscard]] inline Percentiles computePercentiles(std::vector<double> values) {
+  Percentiles result{};
+  if (values.empty()) {
+    return result;
+  }
+
+  std::sort(values.begin(), values.end());
+  const auto rank = [&values](const double fraction) {
+    const auto index = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(values.size())));
+    return values[std::clamp<std::size_t>(index, 1, values.size()) - 1];
+  };
+
+  double sum = 0.0;
+  for (const double value : values) {
+    sum += value;
+  }
+  result.mean = sum / static_cast<double>(values.size());
+  result.p50 = rank(0.50);
+  result.p95 = rank(0.95);
+  result.p99 = rank(0.99);
+  result.max = values.back();
+  return result;
+}
+
+} // namespace sample::common
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace sample::common {
+
+// Parses the value of a "--flag=<value>" argument. The whole value must be a number within
+// [minimum, maximum]; anything else throws std::runtime_error naming the flag.
+template <typename T>
+[[nodiscard]] T parseNumericArgument(const std::string_view argument,
+                                     const std::string_view prefix,
+                                     const T minimum,
+                                     const T maximum = std::numeric_limits<T>::max()) {
+  static_assert(std::is_arithmetic_v<T>);
+  const std::string_view text = argument.substr(prefix.size());
+  T value{};
+  const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  // from_chars accepts "nan" and "inf" for floating-point types; neither compares inside the range.
+  if (text.empty() || error != std::errc{} || end != text.data() + text.size() || !(value >= minimum) ||
+      !(value <= maximum)) {
+    const std::string_view flag = prefix.ends_with('=') ? prefix.substr(0, prefix.size() - 1) : prefix;
+    std::ostringstream message;
+    message << flag << " expects " << (std::is_integral_v<T> ? "an integer" : "a number");
+    if (maximum == std::numeric_limits<T>::max()) {
+      message << " >= " << +minimum;
+    } else {
+      message << " in [" << +minimum << ", " << +maximum << "]";
+    }
+    message << ", got '" << text << "'";
+    throw std::runtime_error(message.str());
+  }
+  return value;
+}
+
+} // namespace sample::common
@@ -73,9 +73,11 @@ void CameraController::handleMouseMotion(const SDL_MouseMotionEvent& motion, con
   updateForward();
 }
 
-void CameraController::setMouseLookActive(const bool active) {
+void CameraController::setMouseLookActive(const bool active, const bool captureCursor) {
   mouseLookActive_ = active;
-  SDL_SetRelativeMouseMode(active ? SDL_TRUE : SDL_FALSE);
+  if (captureCursor) {
+    SDL_SetRelativeMouseMode(active ? SDL_TRUE : SDL_FALSE);
+  }
 }
 
 const rendering::CameraState& CameraController::camera() const {
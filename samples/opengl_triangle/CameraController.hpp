@@ -10,7 +10,8 @@ class CameraController {
 public:
   void updateFromInput(float deltaSeconds, const Uint8* keyboardState, bool allowMouseLook);
   void handleMouseMotion(const SDL_MouseMotionEvent& motion, bool allowMouseLook);
-  void setMouseLookActive(bool active);
+  // captureCursor switches SDL relative mouse mode along with mouse look.
+  void setMouseLookActive(bool active, bool captureCursor = true);
 
   [[nodiscard]] const rendering::CameraState& camera() const;
 
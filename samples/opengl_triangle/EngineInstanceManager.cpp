@@ -43,6 +43,20 @@ namespace {
   };
 }
 
+[[nodiscard]] std::size_t moduleStateBytes(const std::vector<EngineInstanceManager::ModuleRuntimeState>& modules) {
+  std::size_t bytes = modules.capacity() * sizeof(EngineInstanceManager::ModuleRuntimeState);
+  for (const auto& module : modules) {
+    bytes += module.descriptor.id.capacity() + module.descriptor.category.capacity();
+    for (const auto& dependency : module.descriptor.dependencies) {
+      bytes += sizeof(dependency) + dependency.capacity();
+    }
+    for (const auto& conflict : module.descriptor.conflicts) {
+      bytes += sizeof(conflict) + conflict.capacity();
+    }
+  }
+  return bytes;
+}
+
 [[nodiscard]] std::array<float, 3> profileTint(const std::string& profile) {
   if (profile == "Editor") {
     return {0.45f, 0.62f, 0.30f};
@@ -92,6 +106,11 @@ std::uint32_t EngineInstanceManager::createInstanceWithMesh(std::string name,
       .running = true};
   runtime.meshId = meshId;
   runtime.modules = defaultModules(apiVersion_);
+  runtime.moduleMemory = engine::core::TrackedAllocation{engine::core::MemoryTag::Module, moduleStateBytes(runtime.modules)};
+  runtime.moduleGraph = engine::modules::ModuleGraph{apiVersion_};
+  for (const auto& module : runtime.modules) {
+    runtime.moduleGraph.upsert(module.descriptor);
+  }
 
   instances_.push_back(std::move(runtime));
   return meshId;
@@ -7,7 +7,9 @@
 
 #include "MeshRenderEngine.hpp"
 #include "ObjLoader.hpp"
+#include "engine/core/MemoryTracker.hpp"
 #include "engine/modules/ModuleContract.hpp"
+#include "engine/modules/ModuleGraph.hpp"
 
 namespace sample::app {
 
@@ -31,6 +33,9 @@ public:
     EngineInstanceSummary summary;
     std::uint32_t meshId = 0;
     std::vector<ModuleRuntimeState> modules;
+    // Mirrors the descriptors in modules; upsert() a descriptor after editing it.
+    engine::modules::ModuleGraph moduleGraph{engine::modules::Version{}};
+    engine::core::TrackedAllocation moduleMemory;
   };
 
   EngineInstanceManager(rendering::MeshRenderEngine& renderer,
@@ -0,0 +1,181 @@
+#include "FlyThroughBenchmark.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "FrameStatistics.hpp"
+
+namespace sample::app {
+namespace {
+
+constexpr const char* kRecordingHeader = "quma-input-recording 1";
+constexpr std::array<SDL_Scancode, 4> kMovementKeys{SDL_SCANCODE_W, SDL_SCANCODE_A, SDL_SCANCODE_S, SDL_SCANCODE_D};
+
+using common::computePercentiles;
+using common::Percentiles;
+
+[[noreturn]] void throwRecordingError(const std::filesystem::path& path, const std::size_t line, const std::string& reason) {
+  throw std::runtime_error("Input recording '" + path.string() + "' line " + std::to_string(line) + ": " + reason);
+}
+
+} // namespace
+
+InputRecorder::InputRecorder(const std::filesystem::path& path) : file_(path, std::ios::trunc) {
+  if (!file_) {
+    throw std::runtime_error("Failed to open input recording '" + path.string() + "' for writing");
+  }
+  file_ << kRecordingHeader << '\n' << std::setprecision(std::numeric_limits<float>::max_digits10);
+}
+
+void InputRecorder::mouseLook(const bool active) {
+  file_ << "look " << (active ? 1 : 0) << '\n';
+}
+
+void InputRecorder::mouseMotion(const SDL_MouseMotionEvent& motion, const bool allowMouseLook) {
+  file_ << "motion " << motion.xrel << ' ' << motion.yrel << ' ' << (allowMouseLook ? 1 : 0) << '\n';
+}
+
+void InputRecorder::endFrame(const float deltaSeconds,
+                             const Uint8* keyboardState,
+                             const bool allowKeyboard,
+                             const rendering::CameraState& camera) {
+  unsigned movementKeys = 0;
+  for (std::size_t key = 0; key < kMovementKeys.size(); ++key) {
+    if (keyboardState[kMovementKeys[key]] != 0) {
+      movementKeys |= 1U << key;
+    }
+  }
+  file_ << "frame " << deltaSeconds << ' ' << movementKeys << ' ' << (allowKeyboard ? 1 : 0);
+  for (const float value : camera.position) {
+    file_ << ' ' << value;
+  }
+  for (const float value : camera.forward) {
+    file_ << ' ' << value;
+  }
+  file_ << '\n';
+  ++frames_;
+}
+
+std::vector<RecordedInputFrame> loadInputRecording(const std::filesystem::path& path) {
+  std::ifstream file{path};
+  if (!file) {
+    throw std::runtime_error("Failed to open input recording '" + path.string() + "'");
+  }
+
+  std::string line;
+  if (!std::getline(file, line) || line != kRecordingHeader) {
+    throwRecordingError(path, 1, std::string{"expected header '"} + kRecordingHeader + "'");
+  }
+
+  std::vector<RecordedInputFrame> frames;
+  RecordedInputFrame pending{};
+  std::size_t lineNumber = 1;
+  while (std::getline(file, line)) {
+    ++lineNumber;
+    if (line.empty()) {
+      continue;
+    }
+    std::istringstream fields{line};
+    std::string kind;
+    fields >> kind;
+    int enabled = 0;
+    if (kind == "look") {
+      fields >> enabled;
+      pending.events.push_back({RecordedInputEvent::Kind::MouseLook, enabled != 0, 0, 0});
+    } else if (kind == "motion") {
+      RecordedInputEvent event{};
+      fields >> event.xrel >> event.yrel >> enabled;
+      event.enabled = enabled != 0;
+      pending.events.push_back(event);
+    } else if (kind == "frame") {
+      unsigned movementKeys = 0;
+      fields >> pending.deltaSeconds >> movementKeys >> enabled;
+      pending.movementKeys = static_cast<std::uint8_t>(movementKeys);
+      pending.allowKeyboard = enabled != 0;
+      for (float& value : pending.position) {
+        fields >> value;
+      }
+      for (float& value : pending.forward) {
+        fields >> value;
+      }
+      if (fields) {
+        frames.push_back(std::move(pending));
+        pending = {};
+      }
+    } else {
+      throwRecordingError(path, lineNumber, "unknown record '" + kind + "'");
+    }
+    if (!fields) {
+      throwRecordingError(path, lineNumber, "malformed '" + kind + "' record");
+    }
+  }
+  return frames;
+}
+
+float playInputFrame(CameraController& controller, const RecordedInputFrame& frame) {
+  for (const RecordedInputEvent& event : frame.events) {
+    if (event.kind == RecordedInputEvent::Kind::MouseLook) {
+      controller.setMouseLookActive(event.enabled, false);
+    } else {
+      SDL_MouseMotionEvent motion{};
+      motion.type = SDL_MOUSEMOTION;
+      motion.xrel = event.xrel;
+      motion.yrel = event.yrel;
+      controller.handleMouseMotion(motion, event.enabled);
+    }
+  }
+
+  std::array<Uint8, SDL_NUM_SCANCODES> keyboardState{};
+  for (std::size_t key = 0; key < kMovementKeys.size(); ++key) {
+    keyboardState[kMovementKeys[key]] = (frame.movementKeys >> key) & 1U;
+  }
+  controller.updateFromInput(frame.deltaSeconds, keyboardState.data(), frame.allowKeyboard);
+
+  const rendering::CameraState& camera = controller.camera();
+  const float dx = camera.position[0] - frame.position[0];
+  const float dy = camera.position[1] - frame.position[1];
+  const float dz = camera.position[2] - frame.position[2];
+  return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+void writeBenchmarkReport(const std::filesystem::path& reportPath,
+                          const std::filesystem::path& recordingPath,
+                          const std::vector<BenchmarkFrameSample>& samples,
+                          const float maxCameraDrift) {
+  std::vector<double> frameMs;
+  double drawCalls = 0.0;
+  double triangles = 0.0;
+  for (const BenchmarkFrameSample& sample : samples) {
+    frameMs.push_back(sample.frameMs);
+    drawCalls += sample.drawCalls;
+    triangles += static_cast<double>(sample.triangles);
+  }
+  const double count = samples.empty() ? 1.0 : static_cast<double>(samples.size());
+  const Percentiles stats = computePercentiles(frameMs);
+
+  std::ofstream output{reportPath, std::ios::binary | std::ios::trunc};
+  output << std::fixed << std::setprecision(4);
+  output << "{\n  \"recording\": \"" << recordingPath.generic_string() << "\",\n  \"frames\": " << samples.size()
+         << ",\n  \"maxCameraDrift\": " << maxCameraDrift << ",\n  \"frameMs\": {\"mean\": " << stats.mean << ", \"p50\": " << stats.p50
+         << ", \"p95\": " << stats.p95 << ", \"p99\": " << stats.p99 << ", \"max\": " << stats.max
+         << "},\n  \"averageDrawCalls\": " << drawCalls / count << ",\n  \"averageTriangles\": " << triangles / count
+         << ",\n  \"samples\": [";
+  for (std::size_t index = 0; index < samples.size(); ++index) {
+    output << (index == 0 ? "\n    " : ",\n    ") << "{\"frameMs\": " << samples[index].frameMs
+           << ", \"drawCalls\": " << samples[index].drawCalls << ", \"triangles\": " << samples[index].triangles << '}';
+  }
+  output << "\n  ]\n}\n";
+  if (!output) {
+    throw std::runtime_error("Failed to write benchmark report '" + reportPath.string() + "'");
+  }
+}
+
+} // namespace sample::app
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <SDL.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "CameraController.hpp"
+#include "SceneMath.hpp"
+
+namespace sample::app {
+
+// Camera input seen during one frame, in the order CameraController received it.
+struct RecordedInputEvent {
+  enum class Kind : std::uint8_t {
+    MouseLook,
+    MouseMotion,
+  };
+
+  Kind kind = Kind::MouseMotion;
+  // MouseLook: new state. MouseMotion: allowMouseLook passed to handleMouseMotion().
+  bool enabled = false;
+  int xrel = 0;
+  int yrel = 0;
+};
+
+struct RecordedInputFrame {
+  float deltaSeconds = 0.0f;
+  std::vector<RecordedInputEvent> events;
+  // Bit per movement key (W, A, S, D) held when updateFromInput() ran.
+  std::uint8_t movementKeys = 0;
+  bool allowKeyboard = false;
+  // Camera after the frame's input; playback compares against it to detect drift.
+  float position[3]{};
+  float forward[3]{};
+};
+
+// Writes the camera input of every frame to a text file, one line per event and per frame. Floats are
+// written with enough digits to round-trip, so playback reproduces the recorded path exactly.
+class InputRecorder {
+public:
+  // Throws std::runtime_error when path cannot be opened.
+  explicit InputRecorder(const std::filesystem::path& path);
+
+  void mouseLook(bool active);
+  void mouseMotion(const SDL_MouseMotionEvent& motion, bool allowMouseLook);
+  void endFrame(float deltaSeconds, const Uint8* keyboardState, bool allowKeyboard, const rendering::CameraState& camera);
+
+  [[nodiscard]] std::uint32_t frames() const { return frames_; }
+
+private:
+  std::ofstream file_;
+  std::uint32_t frames_ = 0;
+};
+
+// Throws std::runtime_error when the file cannot be read or is malformed.
+[[nodiscard]] std::vector<RecordedInputFrame> loadInputRecording(const std::filesystem::path& path);
+
+// Feeds one recorded frame through controller the way the live loop does, with the recorded delta time
+// instead of the wall clock. Mouse look does not capture the cursor. Returns the distance between the
+// resulting and the recorded camera position.
+float playInputFrame(CameraController& controller, const RecordedInputFrame& frame);
+
+struct BenchmarkFrameSample {
+  double frameMs = 0.0;
+  std::uint32_t drawCalls = 0;
+  std::uint64_t triangles = 0;
+};
+
+// Writes frame-time percentiles, draw call and triangle averages and every sample as JSON.
+void writeBenchmarkReport(const std::filesystem::path& reportPath,
+                          const std::filesystem::path& recordingPath,
+                          const std::vector<BenchmarkFrameSample>& samples,
+                          float maxCameraDrift);
+
+} // namespace sample::app
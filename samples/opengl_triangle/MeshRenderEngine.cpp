@@ -14,227 +14,19 @@
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <limits>
+#include <span>
 #include <stdexcept>
-#include <string>
+#include <utility>
+
+#include "engine/core/MemoryTracker.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/render/opengl/OpenGlRenderBackend.hpp"
 
 namespace sample::rendering {
 namespace {
 
-struct Vec3 {
-  float x = 0.0f;
-  float y = 0.0f;
-  float z = 0.0f;
-};
-
-struct Mat4 {
-  std::array<float, 16> value{};
-};
-
-[[nodiscard]] Vec3 operator+(const Vec3& a, const Vec3& b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
-[[nodiscard]] Vec3 operator-(const Vec3& a, const Vec3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
-[[nodiscard]] Vec3 operator*(const Vec3& a, const float scalar) { return {a.x * scalar, a.y * scalar, a.z * scalar}; }
-
-[[nodiscard]] float dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
-
-[[nodiscard]] Vec3 cross(const Vec3& a, const Vec3& b) {
-  return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
-}
-
-[[nodiscard]] float length(const Vec3& v) { return std::sqrt(dot(v, v)); }
-
-[[nodiscard]] Vec3 normalize(const Vec3& v) {
-  const float len = length(v);
-  if (len <= 0.0001f) {
-    return {0.0f, 0.0f, -1.0f};
-  }
-  return v * (1.0f / len);
-}
-
-[[nodiscard]] Mat4 identity() {
-  Mat4 matrix{};
-  matrix.value = {1.0f, 0.0f, 0.0f, 0.0f,
-                  0.0f, 1.0f, 0.0f, 0.0f,
-                  0.0f, 0.0f, 1.0f, 0.0f,
-                  0.0f, 0.0f, 0.0f, 1.0f};
-  return matrix;
-}
-
-[[nodiscard]] Mat4 multiply(const Mat4& left, const Mat4& right) {
-  Mat4 out{};
-  for (int row = 0; row < 4; ++row) {
-    for (int col = 0; col < 4; ++col) {
-      float sum = 0.0f;
-      for (int k = 0; k < 4; ++k) {
-        sum += left.value[k * 4 + row] * right.value[col * 4 + k];
-      }
-      out.value[col * 4 + row] = sum;
-    }
-  }
-  return out;
-}
-
-[[nodiscard]] Mat4 perspective(const float fovRadians, const float aspectRatio, const float nearPlane, const float farPlane) {
-  Mat4 matrix{};
-  const float tanHalf = std::tan(fovRadians * 0.5f);
-  matrix.value = {1.0f / (aspectRatio * tanHalf), 0.0f, 0.0f, 0.0f,
-                  0.0f, 1.0f / tanHalf, 0.0f, 0.0f,
-                  0.0f, 0.0f, -(farPlane + nearPlane) / (farPlane - nearPlane), -1.0f,
-                  0.0f, 0.0f, -(2.0f * farPlane * nearPlane) / (farPlane - nearPlane), 0.0f};
-  return matrix;
-}
-
-[[nodiscard]] Mat4 lookAt(const Vec3& eye, const Vec3& center, const Vec3& upHint) {
-  const Vec3 forward = normalize(center - eye);
-  const Vec3 right = normalize(cross(forward, upHint));
-  const Vec3 up = cross(right, forward);
-
-  Mat4 matrix = identity();
-  matrix.value[0] = right.x;
-  matrix.value[1] = up.x;
-  matrix.value[2] = -forward.x;
-  matrix.value[4] = right.y;
-  matrix.value[5] = up.y;
-  matrix.value[6] = -forward.y;
-  matrix.value[8] = right.z;
-  matrix.value[9] = up.z;
-  matrix.value[10] = -forward.z;
-  matrix.value[12] = -dot(right, eye);
-  matrix.value[13] = -dot(up, eye);
-  matrix.value[14] = dot(forward, eye);
-  return matrix;
-}
-
-[[nodiscard]] Mat4 translate(const float x, const float y, const float z) {
-  Mat4 matrix = identity();
-  matrix.value[12] = x;
-  matrix.value[13] = y;
-  matrix.value[14] = z;
-  return matrix;
-}
-
-[[nodiscard]] Mat4 rotateY(const float radians) {
-  Mat4 matrix = identity();
-  const float c = std::cos(radians);
-  const float s = std::sin(radians);
-  matrix.value[0] = c;
-  matrix.value[2] = -s;
-  matrix.value[8] = s;
-  matrix.value[10] = c;
-  return matrix;
-}
-
-[[nodiscard]] Mat4 scaleUniform(const float scale) {
-  Mat4 matrix = identity();
-  matrix.value[0] = scale;
-  matrix.value[5] = scale;
-  matrix.value[10] = scale;
-  return matrix;
-}
-
-[[nodiscard]] unsigned int compileShader(const unsigned int type, const char* source) {
-  const unsigned int shader = glCreateShader(type);
-  glShaderSource(shader, 1, &source, nullptr);
-  glCompileShader(shader);
-
-  int success = GL_FALSE;
-  glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-  if (success != GL_TRUE) {
-    int logLength = 0;
-    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
-    std::string log(static_cast<std::size_t>(logLength), '\0');
-    glGetShaderInfoLog(shader, logLength, nullptr, log.data());
-    glDeleteShader(shader);
-    throw std::runtime_error("Shader compilation failed: " + log);
-  }
-
-  return shader;
-}
-
-[[nodiscard]] unsigned int createProgram(const char* vertexSource, const char* fragmentSource) {
-  const unsigned int vertex = compileShader(GL_VERTEX_SHADER, vertexSource);
-  const unsigned int fragment = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
-
-  const unsigned int program = glCreateProgram();
-  glAttachShader(program, vertex);
-  glAttachShader(program, fragment);
-  glLinkProgram(program);
-
-  int success = GL_FALSE;
-  glGetProgramiv(program, GL_LINK_STATUS, &success);
-  glDeleteShader(vertex);
-  glDeleteShader(fragment);
-
-  if (success != GL_TRUE) {
-    int logLength = 0;
-    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &logLength);
-    std::string log(static_cast<std::size_t>(logLength), '\0');
-    glGetProgramInfoLog(program, logLength, nullptr, log.data());
-    glDeleteProgram(program);
-    throw std::runtime_error("Program link failed: " + log);
-  }
-
-  return program;
-}
-
-[[nodiscard]] bool rayIntersectsAabb(const Vec3& rayOrigin,
-                                     const Vec3& rayDirection,
-                                     const Vec3& minBounds,
-                                     const Vec3& maxBounds,
-                                     float& outDistance) {
-  float tMin = 0.0f;
-  float tMax = std::numeric_limits<float>::max();
-
-  auto axisCheck = [&](const float origin, const float direction, const float minVal, const float maxVal) {
-    if (std::abs(direction) < 0.0001f) {
-      return origin >= minVal && origin <= maxVal;
-    }
-
-    float invD = 1.0f / direction;
-    float t0 = (minVal - origin) * invD;
-    float t1 = (maxVal - origin) * invD;
-    if (t0 > t1) {
-      std::swap(t0, t1);
-    }
-    tMin = std::max(tMin, t0);
-    tMax = std::min(tMax, t1);
-    return tMax >= tMin;
-  };
-
-  if (!axisCheck(rayOrigin.x, rayDirection.x, minBounds.x, maxBounds.x)) {
-    return false;
-  }
-  if (!axisCheck(rayOrigin.y, rayDirection.y, minBounds.y, maxBounds.y)) {
-    return false;
-  }
-  if (!axisCheck(rayOrigin.z, rayDirection.z, minBounds.z, maxBounds.z)) {
-    return false;
-  }
-
-  outDistance = tMin;
-  return true;
-}
-
-[[nodiscard]] Vec3 createRayDirectionFromScreen(const int mouseX,
-                                                const int mouseY,
-                                                const int width,
-                                                const int height,
-                                                const CameraState& camera) {
-  const float xNdc = (2.0f * static_cast<float>(mouseX) / static_cast<float>(width)) - 1.0f;
-  const float yNdc = 1.0f - (2.0f * static_cast<float>(mouseY) / static_cast<float>(height));
-
-  const float tanHalf = std::tan(camera.fovDegrees * 0.0174532925f * 0.5f);
-  const float aspect = static_cast<float>(width) / static_cast<float>(height);
-  Vec3 dirCamera{xNdc * aspect * tanHalf, yNdc * tanHalf, -1.0f};
-
-  const Vec3 forward = normalize({camera.forward[0], camera.forward[1], camera.forward[2]});
-  const Vec3 up = normalize({camera.up[0], camera.up[1], camera.up[2]});
-  const Vec3 right = normalize(cross(forward, up));
-
-  Vec3 worldDir = normalize((right * dirCamera.x) + (up * dirCamera.y) + (forward * -dirCamera.z));
-  return worldDir;
-}
-
 constexpr const char* kVertexShader = R"(
 #version 330 core
 layout(location = 0) in vec3 aPosition;
@@ -332,49 +124,52 @@ struct MeshRenderEngine::GpuMesh {
   unsigned int vbo = 0;
   unsigned int ebo = 0;
   std::uint32_t indexCount = 0;
+  // Drawn once the staged index upload (queued after the vertices) has reached the GPU.
+  engine::render::UploadTicket upload{};
   Vec3 localBoundsMin{};
   Vec3 localBoundsMax{};
   Vec3 position{};
   float rotationYRadians = 0.0f;
   float scale = 1.0f;
+  engine::core::TrackedAllocation cpuMemory;
 };
 
-MeshRenderEngine::MeshRenderEngine(SDL_Window* window)
+namespace {
+
+void deleteMeshObjects(const unsigned int vao, const unsigned int vbo, const unsigned int ebo) {
+  if (ebo != 0) {
+    glDeleteBuffers(1, &ebo);
+  }
+  if (vbo != 0) {
+    glDeleteBuffers(1, &vbo);
+  }
+  if (vao != 0) {
+    glDeleteVertexArrays(1, &vao);
+  }
+}
+
+} // namespace
+
+MeshRenderEngine::MeshRenderEngine(SDL_Window* window, engine::render::ProgramBinaryCache* programCache)
     : window_(window) {
   if (window_ == nullptr) {
     throw std::runtime_error("MeshRenderEngine requires a valid SDL window");
   }
 
-  program_ = createProgram(kVertexShader, kFragmentShader);
-  gizmoProgram_ = createProgram(kGizmoVertexShader, kGizmoFragmentShader);
+  program_ = engine::render::createOpenGlProgram(kVertexShader, kFragmentShader, programCache);
+  gizmoProgram_ = engine::render::createOpenGlProgram(kGizmoVertexShader, kGizmoFragmentShader, programCache);
   glGenVertexArrays(1, &gizmoVao_);
-  glGenBuffers(1, &gizmoVbo_);
   glBindVertexArray(gizmoVao_);
-  glBindBuffer(GL_ARRAY_BUFFER, gizmoVbo_);
-  glBufferData(GL_ARRAY_BUFFER, 6 * 6 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<void*>(0));
   glEnableVertexAttribArray(0);
-  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
   glEnableVertexAttribArray(1);
   glEnable(GL_DEPTH_TEST);
 }
 
 MeshRenderEngine::~MeshRenderEngine() {
-  for (auto& mesh : meshes_) {
-    if (mesh.ebo != 0) {
-      glDeleteBuffers(1, &mesh.ebo);
-    }
-    if (mesh.vbo != 0) {
-      glDeleteBuffers(1, &mesh.vbo);
-    }
-    if (mesh.vao != 0) {
-      glDeleteVertexArrays(1, &mesh.vao);
-    }
+  for (const auto& mesh : meshes_) {
+    deleteMeshObjects(mesh.vao, mesh.vbo, mesh.ebo);
   }
 
-  if (gizmoVbo_ != 0) {
-    glDeleteBuffers(1, &gizmoVbo_);
-  }
   if (gizmoVao_ != 0) {
     glDeleteVertexArrays(1, &gizmoVao_);
   }
@@ -394,6 +189,9 @@ std::uint32_t MeshRenderEngine::addMeshInstance(const MeshInstanceCreateInfo& cr
   gpuMesh.rotationYRadians = createInfo.rotationYRadians;
   gpuMesh.scale = createInfo.scale;
   gpuMesh.indexCount = static_cast<std::uint32_t>(gpuMesh.mesh.indices.size());
+  gpuMesh.cpuMemory = engine::core::TrackedAllocation{
+      engine::core::MemoryTag::MeshCpu,
+      gpuMesh.mesh.vertices.size() * sizeof(Vertex) + gpuMesh.mesh.indices.size() * sizeof(std::uint32_t)};
 
   if (gpuMesh.mesh.vertices.empty() || gpuMesh.mesh.indices.empty()) {
     throw std::runtime_error("Cannot add empty mesh instance");
@@ -411,35 +209,76 @@ std::uint32_t MeshRenderEngine::addMeshInstance(const MeshInstanceCreateInfo& cr
     gpuMesh.localBoundsMax.z = std::max(gpuMesh.localBoundsMax.z, vertex.position[2]);
   }
 
-  glGenVertexArrays(1, &gpuMesh.vao);
-  glGenBuffers(1, &gpuMesh.vbo);
-  glGenBuffers(1, &gpuMesh.ebo);
-
-  glBindVertexArray(gpuMesh.vao);
-  glBindBuffer(GL_ARRAY_BUFFER, gpuMesh.vbo);
-  glBufferData(GL_ARRAY_BUFFER,
-               static_cast<GLsizeiptr>(gpuMesh.mesh.vertices.size() * sizeof(Vertex)),
-               gpuMesh.mesh.vertices.data(),
-               GL_STATIC_DRAW);
+  const auto vertexBytes = static_cast<GLsizeiptr>(gpuMesh.mesh.vertices.size() * sizeof(Vertex));
+  const auto indexBytes = static_cast<GLsizeiptr>(gpuMesh.mesh.indices.size() * sizeof(std::uint32_t));
+  if (engine::render::openGlDirectStateAccessSupported()) {
+    // Named objects are set up without touching the current bindings.
+    glCreateVertexArrays(1, &gpuMesh.vao);
+    glCreateBuffers(1, &gpuMesh.vbo);
+    glCreateBuffers(1, &gpuMesh.ebo);
+    glNamedBufferStorage(gpuMesh.vbo, vertexBytes, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glNamedBufferStorage(gpuMesh.ebo, indexBytes, nullptr, GL_DYNAMIC_STORAGE_BIT);
+
+    glVertexArrayVertexBuffer(gpuMesh.vao, 0, gpuMesh.vbo, 0, sizeof(Vertex));
+    glVertexArrayElementBuffer(gpuMesh.vao, gpuMesh.ebo);
+    const std::array<std::pair<GLint, GLuint>, 3> attributes{{{3, static_cast<GLuint>(offsetof(Vertex, position))},
+                                                              {3, static_cast<GLuint>(offsetof(Vertex, normal))},
+                                                              {2, static_cast<GLuint>(offsetof(Vertex, uv))}}};
+    for (GLuint location = 0; location < attributes.size(); ++location) {
+      glEnableVertexArrayAttrib(gpuMesh.vao, location);
+      glVertexArrayAttribFormat(gpuMesh.vao, location, attributes[location].first, GL_FLOAT, GL_FALSE, attributes[location].second);
+      glVertexArrayAttribBinding(gpuMesh.vao, location, 0);
+    }
+  } else {
+    glGenVertexArrays(1, &gpuMesh.vao);
+    glGenBuffers(1, &gpuMesh.vbo);
+    glGenBuffers(1, &gpuMesh.ebo);
+
+    glBindVertexArray(gpuMesh.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, gpuMesh.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertexBytes, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuMesh.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, nullptr, GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, position)));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, uv)));
+    glEnableVertexAttribArray(2);
+  }
 
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpuMesh.ebo);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-               static_cast<GLsizeiptr>(gpuMesh.mesh.indices.size() * sizeof(std::uint32_t)),
-               gpuMesh.mesh.indices.data(),
-               GL_STATIC_DRAW);
-
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, position)));
-  glEnableVertexAttribArray(0);
-  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
-  glEnableVertexAttribArray(1);
-  glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, uv)));
-  glEnableVertexAttribArray(2);
+  // Large meshes would otherwise stall the frame that adds them; the queue spreads the copy out
+  // and uploads complete in order, so the index ticket covers both buffers.
+  (void)uploads_.enqueue(gpuMesh.vbo, 0, std::as_bytes(std::span{gpuMesh.mesh.vertices}));
+  gpuMesh.upload = uploads_.enqueue(gpuMesh.ebo, 0, std::as_bytes(std::span{gpuMesh.mesh.indices}));
 
   const std::uint32_t newId = gpuMesh.id;
   meshes_.push_back(std::move(gpuMesh));
   return newId;
 }
 
+void MeshRenderEngine::removeMeshInstance(const std::uint32_t meshId) {
+  auto it = std::find_if(meshes_.begin(), meshes_.end(), [meshId](const GpuMesh& mesh) { return mesh.id == meshId; });
+  if (it == meshes_.end()) {
+    return;
+  }
+  uploads_.cancel(it->vbo);
+  uploads_.cancel(it->ebo);
+  if (hoveredMeshId_ == meshId) {
+    hoveredMeshId_.reset();
+  }
+  if (selectedMeshId_ == meshId) {
+    selectedMeshId_.reset();
+  }
+  // Frames already submitted may still draw it; endFrame() deletes it once they have finished.
+  using engine::render::GlObjectKind;
+  deletionQueue_.retire(GlObjectKind::VertexArray, it->vao);
+  deletionQueue_.retire(GlObjectKind::Buffer, it->vbo);
+  deletionQueue_.retire(GlObjectKind::Buffer, it->ebo);
+  meshes_.erase(it);
+}
+
 void MeshRenderEngine::updateMeshMaterial(const std::uint32_t meshId, const PbrMaterial& material) {
   auto it = std::find_if(meshes_.begin(), meshes_.end(), [meshId](const GpuMesh& mesh) { return mesh.id == meshId; });
   if (it != meshes_.end()) {
@@ -457,23 +296,9 @@ std::optional<std::uint32_t> MeshRenderEngine::pickMeshFromScreen(const int mous
 
   const Vec3 origin{camera.position[0], camera.position[1], camera.position[2]};
   const Vec3 direction = createRayDirectionFromScreen(mouseX, mouseY, width, height, camera);
-
-  std::optional<std::uint32_t> bestMesh;
-  float bestDistance = std::numeric_limits<float>::max();
-  for (const auto& mesh : meshes_) {
-    const Vec3 minBounds = (mesh.localBoundsMin * mesh.scale) + mesh.position;
-    const Vec3 maxBounds = (mesh.localBoundsMax * mesh.scale) + mesh.position;
-    float distance = 0.0f;
-    if (!rayIntersectsAabb(origin, direction, minBounds, maxBounds, distance)) {
-      continue;
-    }
-    if (distance < bestDistance) {
-      bestDistance = distance;
-      bestMesh = mesh.id;
-    }
-  }
-
-  return bestMesh;
+  return pickClosest(origin, direction, meshes_, [](const GpuMesh& mesh) {
+    return PickBounds{mesh.id, (mesh.localBoundsMin * mesh.scale) + mesh.position, (mesh.localBoundsMax * mesh.scale) + mesh.position};
+  });
 }
 
 std::optional<std::uint32_t> MeshRenderEngine::findLookedAtMesh(const CameraState& camera) const {
@@ -517,16 +342,20 @@ void MeshRenderEngine::setMeshTransform(const std::uint32_t meshId, const MeshTr
   it->scale = transform.scale;
 }
 
-void MeshRenderEngine::resize(const int drawableWidth, const int drawableHeight) const {
+void MeshRenderEngine::resize(const int drawableWidth, const int drawableHeight) {
   glViewport(0, 0, drawableWidth, drawableHeight);
 }
 
-void MeshRenderEngine::beginFrame(const float clearR, const float clearG, const float clearB) const {
+void MeshRenderEngine::beginFrame(const float clearR, const float clearG, const float clearB) {
+  gpuTimer_.beginFrame();
+  uploads_.processFrame();
   glClearColor(clearR, clearG, clearB, 1.0f);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-void MeshRenderEngine::renderScene(const CameraState& camera, const SceneLighting& lighting) const {
+void MeshRenderEngine::renderScene(const CameraState& camera, const SceneLighting& lighting) {
+  ENGINE_PROFILE_ZONE("MeshRenderEngine::renderScene");
+  gpuTimer_.beginPass("scene");
   int drawableWidth = 1;
   int drawableHeight = 1;
   SDL_GL_GetDrawableSize(window_, &drawableWidth, &drawableHeight);
@@ -546,7 +375,13 @@ void MeshRenderEngine::renderScene(const CameraState& camera, const SceneLightin
   glUniform3f(glGetUniformLocation(program_, "uCameraPos"), camera.position[0], camera.position[1], camera.position[2]);
   glUniform1f(glGetUniformLocation(program_, "uAmbient"), lighting.ambientIntensity);
 
+  std::uint32_t drawCalls = 0;
+  std::uint64_t triangles = 0;
+  std::size_t gizmoBytes = 0;
   for (const auto& mesh : meshes_) {
+    if (!uploads_.complete(mesh.upload)) {
+      continue;
+    }
     const Mat4 model = multiply(translate(mesh.position.x, mesh.position.y, mesh.position.z),
                                 multiply(rotateY(mesh.rotationYRadians), scaleUniform(mesh.scale)));
 
@@ -563,6 +398,8 @@ void MeshRenderEngine::renderScene(const CameraState& camera, const SceneLightin
 
     glBindVertexArray(mesh.vao);
     glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh.indexCount), GL_UNSIGNED_INT, nullptr);
+    ++drawCalls;
+    triangles += mesh.indexCount / 3;
   }
 
   if (selectedMeshId_.has_value()) {
@@ -584,16 +421,42 @@ void MeshRenderEngine::renderScene(const CameraState& camera, const SceneLightin
       glUseProgram(gizmoProgram_);
       glUniformMatrix4fv(glGetUniformLocation(gizmoProgram_, "uView"), 1, GL_FALSE, view.value.data());
       glUniformMatrix4fv(glGetUniformLocation(gizmoProgram_, "uProjection"), 1, GL_FALSE, projection.value.data());
+      const engine::render::OpenGlTransientRing::Allocation allocation = gizmoRing_.allocate(sizeof(gizmoVertices));
+      std::memcpy(allocation.data.data(), gizmoVertices, sizeof(gizmoVertices));
+      gizmoRing_.flush();
+      // Each frame's vertices land at a different ring offset, so re-point the attributes.
       glBindVertexArray(gizmoVao_);
-      glBindBuffer(GL_ARRAY_BUFFER, gizmoVbo_);
-      glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(gizmoVertices), gizmoVertices);
+      glBindBuffer(GL_ARRAY_BUFFER, allocation.buffer);
+      glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<void*>(allocation.offset));
+      glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float),
+                            reinterpret_cast<void*>(allocation.offset + 3 * sizeof(float)));
       glLineWidth(3.0f);
       glDrawArrays(GL_LINES, 0, 6);
+      ++drawCalls;
+      gizmoBytes += sizeof(gizmoVertices);
     }
   }
+
+  gpuTimer_.endPass();
+
+  lastFrameStats_.drawCalls = drawCalls;
+  lastFrameStats_.triangles = triangles;
+  ENGINE_PROFILE_COUNTER("draw calls", drawCalls);
+  ENGINE_PROFILE_COUNTER("triangles", totalTriangles());
+  ENGINE_PROFILE_COUNTER("gizmo bytes", gizmoBytes);
+}
+
+void MeshRenderEngine::endFrame() {
+  ENGINE_PROFILE_ZONE("MeshRenderEngine::endFrame");
+  gizmoRing_.endFrame();
+  deletionQueue_.endFrame();
+  gpuTimer_.endFrame();
+  lastFrameStats_.pendingDestructions = deletionQueue_.size();
+  ENGINE_PROFILE_COUNTER("pending destructions", lastFrameStats_.pendingDestructions);
 }
 
-void MeshRenderEngine::endFrame() const {
+void MeshRenderEngine::present() {
+  ENGINE_PROFILE_ZONE("MeshRenderEngine::present");
   SDL_GL_SwapWindow(window_);
 }
 
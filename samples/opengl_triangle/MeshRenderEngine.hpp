@@ -7,6 +7,9 @@
 #include <vector>
 
 #include "ObjLoader.hpp"
+#include "SceneMath.hpp"
+#include "engine/render/ProgramBinaryCache.hpp"
+#include "engine/render/opengl/OpenGlRenderBackend.hpp"
 
 namespace sample::rendering {
 
@@ -16,15 +19,6 @@ struct SceneLighting {
   float ambientIntensity = 0.18f;
 };
 
-struct CameraState {
-  float position[3]{0.0f, 0.0f, 5.0f};
-  float forward[3]{0.0f, 0.0f, -1.0f};
-  float up[3]{0.0f, 1.0f, 0.0f};
-  float fovDegrees = 60.0f;
-  float nearPlane = 0.1f;
-  float farPlane = 150.0f;
-};
-
 class MeshRenderEngine {
 public:
   struct MeshInstanceCreateInfo {
@@ -34,19 +28,29 @@ public:
     float scale = 1.0f;
   };
 
+  struct FrameDrawStats {
+    std::uint32_t drawCalls = 0;
+    std::uint64_t triangles = 0;
+    // Removed meshes whose GL objects wait for the GPU, as of the last endFrame().
+    std::uint32_t pendingDestructions = 0;
+  };
+
   struct MeshTransform {
     float position[3]{0.0f, 0.0f, 0.0f};
     float rotationYRadians = 0.0f;
     float scale = 1.0f;
   };
 
-  explicit MeshRenderEngine(SDL_Window* window);
+  // programCache (optional) must outlive the constructor call only.
+  explicit MeshRenderEngine(SDL_Window* window, engine::render::ProgramBinaryCache* programCache = nullptr);
   ~MeshRenderEngine();
 
   MeshRenderEngine(const MeshRenderEngine&) = delete;
   MeshRenderEngine& operator=(const MeshRenderEngine&) = delete;
 
   [[nodiscard]] std::uint32_t addMeshInstance(const MeshInstanceCreateInfo& createInfo);
+  // The mesh stops drawing at once; its GL objects are freed once the GPU has finished with them.
+  void removeMeshInstance(std::uint32_t meshId);
   void updateMeshMaterial(std::uint32_t meshId, const PbrMaterial& material);
 
   [[nodiscard]] std::optional<std::uint32_t> pickMeshFromScreen(int mouseX, int mouseY, const CameraState& camera) const;
@@ -58,12 +62,16 @@ public:
   [[nodiscard]] std::optional<MeshTransform> meshTransform(std::uint32_t meshId) const;
   void setMeshTransform(std::uint32_t meshId, const MeshTransform& transform);
 
-  void resize(int drawableWidth, int drawableHeight) const;
-  void beginFrame(float clearR, float clearG, float clearB) const;
-  void renderScene(const CameraState& camera, const SceneLighting& lighting) const;
-  void endFrame() const;
+  void resize(int drawableWidth, int drawableHeight);
+  void beginFrame(float clearR, float clearG, float clearB);
+  void renderScene(const CameraState& camera, const SceneLighting& lighting);
+  void endFrame();
+  // Swaps the window; kept apart from endFrame() so callers can release shared state before blocking on vsync.
+  void present();
 
   [[nodiscard]] std::uint32_t totalTriangles() const;
+  // Draws issued by the last renderScene() call.
+  [[nodiscard]] FrameDrawStats lastFrameStats() const { return lastFrameStats_; }
 
 private:
   struct GpuMesh;
@@ -72,11 +80,18 @@ private:
   unsigned int program_ = 0;
   unsigned int gizmoProgram_ = 0;
   unsigned int gizmoVao_ = 0;
-  unsigned int gizmoVbo_ = 0;
+  // Gizmo vertices change every frame; the ring avoids re-uploading into a buffer the GPU may still read.
+  engine::render::OpenGlTransientRing gizmoRing_{64 * 1024};
+  engine::render::OpenGlUploadQueue uploads_;
+  // Removed meshes' GL objects, deleted once the frames that may still draw them have finished.
+  engine::render::OpenGlDeferredDeletionQueue deletionQueue_;
+  // Reports the frame's GPU time and a "scene" pass to core::Profiler when profiling is enabled.
+  engine::render::OpenGlTimestampProfiler gpuTimer_;
   std::vector<GpuMesh> meshes_;
   std::optional<std::uint32_t> hoveredMeshId_;
   std::optional<std::uint32_t> selectedMeshId_;
   std::uint32_t nextMeshId_ = 1;
+  FrameDrawStats lastFrameStats_{};
 };
 
 } // namespace sample::rendering
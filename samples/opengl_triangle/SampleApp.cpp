@@ -17,25 +17,46 @@
 #include <imgui.h>
 
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <exception>
+#include <functional>
 #include <iostream>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "CameraController.hpp"
 #include "EngineInstanceManager.hpp"
+#include "FlyThroughBenchmark.hpp"
 #include "MeshRenderEngine.hpp"
 #include "PrimitiveMeshFactory.hpp"
+#include "SampleArguments.hpp"
 #include "SampleAssets.hpp"
+#include "engine/core/ChromeTrace.hpp"
+#include "engine/core/MemoryTracker.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/core/WorkerPool.hpp"
+#include "engine/devtools/imgui_tools/RuntimeMetricsService.hpp"
 #include "engine/modules/IModule.hpp"
 #include "engine/modules/ModuleContract.hpp"
 #include "engine/modules/ModuleManager.hpp"
+#include "engine/modules/ModuleScheduler.hpp"
+#include "engine/platform/FramePacer.hpp"
 #include "engine/platform/IPlatformBackend.hpp"
 #include "engine/platform/IWindowSystem.hpp"
+#include "engine/platform/InputFrameState.hpp"
 #include "engine/platform/PlatformBackendFactory.hpp"
+#include "engine/render/ProgramBinaryCache.hpp"
 
 namespace sample::app {
 namespace {
@@ -49,6 +70,131 @@ public:
 };
 
 constexpr engine::modules::Version kEngineApiVersion{0, 1, 0};
+constexpr std::uint32_t kDefaultTraceFrames = 120;
+// The manager window is tooling; it does not need the scene's refresh rate.
+constexpr double kManagerFrameHz = 60.0;
+// How often the main thread pumps events between manager frames.
+constexpr std::chrono::milliseconds kEventPollInterval{1};
+
+enum class VsyncMode { Off, On, Adaptive };
+
+struct SampleOptions {
+  std::string tracePath;
+  std::uint32_t traceFrames = kDefaultTraceFrames;
+  bool failOnMemoryBudget = false;
+  // Linked program binaries are cached here across runs; empty disables the cache.
+  std::string shaderCacheDirectory = "shader_cache";
+  std::string recordInputPath;
+  std::string benchmarkPath;
+  std::string benchmarkReportPath = "benchmark.json";
+  std::uint32_t benchmarkWarmupFrames = 10;
+  // Swap interval of both windows; benchmarks always run with vsync off.
+  VsyncMode vsync = VsyncMode::On;
+  // Frame rate held by the scene thread's frame pacer; 0 leaves pacing to
+  // vsync.
+  double targetFps = 0.0;
+};
+
+void configureMemoryBudgets(const SampleOptions &options) {
+  constexpr std::size_t kMiB = std::size_t{1} << 20;
+  auto &tracker = engine::core::MemoryTracker::instance();
+  tracker.setBudget(engine::core::MemoryTag::MeshCpu, 512 * kMiB);
+  tracker.setBudget(engine::core::MemoryTag::GpuBuffer, 1024 * kMiB);
+  tracker.setBudget(engine::core::MemoryTag::GpuTexture, 2048 * kMiB);
+  tracker.setBudget(engine::core::MemoryTag::Module, 16 * kMiB);
+  tracker.setBudget(engine::core::MemoryTag::Ui, 64 * kMiB);
+  tracker.setBudgetPolicy(options.failOnMemoryBudget
+                              ? engine::core::MemoryBudgetPolicy::Fail
+                              : engine::core::MemoryBudgetPolicy::Warn);
+}
+
+// ImGui allocations are charged to the UI tag. Each block carries its size in
+// a max-aligned header because ImGui's free callback does not pass it back.
+// Exceptions must not cross ImGui, so a refused budget yields nullptr like a
+// failed malloc.
+constexpr std::size_t kImguiAllocationHeader = alignof(std::max_align_t);
+
+void *imguiTrackedAlloc(const std::size_t size, void * /*userData*/) {
+  if (!engine::core::MemoryTracker::instance().tryAllocate(
+          engine::core::MemoryTag::Ui, size)) {
+    return nullptr;
+  }
+  auto *block =
+      static_cast<std::byte *>(std::malloc(size + kImguiAllocationHeader));
+  if (block == nullptr) {
+    engine::core::MemoryTracker::instance().release(
+        engine::core::MemoryTag::Ui, size);
+    return nullptr;
+  }
+  *reinterpret_cast<std::size_t *>(block) = size;
+  return block + kImguiAllocationHeader;
+}
+
+void imguiTrackedFree(void *pointer, void * /*userData*/) {
+  if (pointer == nullptr) {
+    return;
+  }
+  auto *block = static_cast<std::byte *>(pointer) - kImguiAllocationHeader;
+  engine::core::MemoryTracker::instance().release(
+      engine::core::MemoryTag::Ui, *reinterpret_cast<std::size_t *>(block));
+  std::free(block);
+}
+
+[[nodiscard]] SampleOptions parseSampleOptions(const int argc, char **argv) {
+  SampleOptions options{};
+  for (int index = 1; index < argc; ++index) {
+    const std::string_view argument{argv[index]};
+    if (argument.starts_with("--trace=")) {
+      options.tracePath = std::string{argument.substr(8)};
+    } else if (argument.starts_with("--trace-frames=")) {
+      options.traceFrames = sample::common::parseNumericArgument<std::uint32_t>(
+          argument, "--trace-frames=", 1);
+    } else if (argument == "--memory-budget-fail") {
+      options.failOnMemoryBudget = true;
+    } else if (argument.starts_with("--shader-cache=")) {
+      options.shaderCacheDirectory = std::string{argument.substr(15)};
+    } else if (argument == "--no-shader-cache") {
+      options.shaderCacheDirectory.clear();
+    } else if (argument.starts_with("--record-input=")) {
+      options.recordInputPath = std::string{argument.substr(15)};
+    } else if (argument.starts_with("--benchmark=")) {
+      options.benchmarkPath = std::string{argument.substr(12)};
+    } else if (argument.starts_with("--benchmark-report=")) {
+      options.benchmarkReportPath = std::string{argument.substr(19)};
+    } else if (argument.starts_with("--benchmark-warmup=")) {
+      // 0 is valid here: every recorded frame is measured.
+      options.benchmarkWarmupFrames =
+          sample::common::parseNumericArgument<std::uint32_t>(
+              argument, "--benchmark-warmup=", 0);
+    } else if (argument.starts_with("--vsync=")) {
+      const std::string_view mode = argument.substr(8);
+      if (mode == "off") {
+        options.vsync = VsyncMode::Off;
+      } else if (mode == "on") {
+        options.vsync = VsyncMode::On;
+      } else if (mode == "adaptive") {
+        options.vsync = VsyncMode::Adaptive;
+      } else {
+        throw std::runtime_error("--vsync expects off, on or adaptive");
+      }
+    } else if (argument.starts_with("--target-fps=")) {
+      options.targetFps = sample::common::parseNumericArgument<double>(
+          argument, "--target-fps=", 1.0, 1000.0);
+    }
+  }
+  return options;
+}
+
+// Applies mode to the current GL context and returns the mode in effect.
+// Adaptive vsync (swap interval -1) tears instead of waiting a whole refresh
+// when a frame is late; drivers without it fall back to regular vsync.
+VsyncMode applySwapInterval(const VsyncMode mode) {
+  if (mode == VsyncMode::Adaptive && SDL_GL_SetSwapInterval(-1) == 0) {
+    return VsyncMode::Adaptive;
+  }
+  SDL_GL_SetSwapInterval(mode == VsyncMode::Off ? 0 : 1);
+  return mode == VsyncMode::Off ? VsyncMode::Off : VsyncMode::On;
+}
 
 [[nodiscard]] engine::modules::ModuleDescriptor makeDemoModuleDescriptor() {
   return engine::modules::ModuleDescriptor{
@@ -67,7 +213,11 @@ void drawManagerUi(EngineInstanceManager &instanceManager,
                    std::optional<std::uint32_t> &selectedMesh,
                    rendering::MeshRenderEngine &renderer,
                    rendering::SceneLighting &lighting, float (&clearColor)[3],
-                   const std::optional<std::uint32_t> hoveredMesh) {
+                   const std::optional<std::uint32_t> hoveredMesh,
+                   const engine::platform::FramePacingStats &pacing,
+                   const engine::devtools::imgui_tools::IMetricsService &metrics,
+                   std::vector<std::function<void()>> &sceneTasks) {
+  ENGINE_PROFILE_ZONE("drawManagerUi");
   ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
   const ImGuiViewport *viewport = ImGui::GetMainViewport();
   ImGui::SetNextWindowSize(viewport->Size);
@@ -95,6 +245,68 @@ void drawManagerUi(EngineInstanceManager &instanceManager,
     ImGui::TreePop();
   }
 
+  if (ImGui::TreeNode("Frame Pacing")) {
+    if (pacing.targetMs > 0.0) {
+      ImGui::Text("Target: %.2f ms (%.0f Hz)", pacing.targetMs,
+                  1000.0 / pacing.targetMs);
+    } else {
+      ImGui::Text("Target: unpaced");
+    }
+    ImGui::Text("Frame: %.2f ms  Jitter: %.3f ms  Max deviation: %.3f ms",
+                pacing.meanMs, pacing.jitterMs, pacing.maxDeviationMs);
+    ImGui::Text("Spin window: %.2f ms  Missed deadlines: %llu", pacing.spinMs,
+                static_cast<unsigned long long>(pacing.missedDeadlines));
+    ImGui::TreePop();
+  }
+
+  if (ImGui::TreeNode("Frame Timing")) {
+    const auto history = metrics.frameHistory();
+    if (history.empty()) {
+      ImGui::Text("No frame history: build with ENGINE_ENABLE_PROFILING=ON");
+    } else {
+      std::vector<float> cpuMs;
+      std::vector<float> gpuMs;
+      cpuMs.reserve(history.size());
+      for (const auto &sample : history) {
+        cpuMs.push_back(static_cast<float>(sample.cpuFrameMs));
+        if (sample.gpuFrameMs.has_value()) {
+          gpuMs.push_back(static_cast<float>(*sample.gpuFrameMs));
+        }
+      }
+      ImGui::Text("CPU: %.2f ms", history.back().cpuFrameMs);
+      ImGui::PlotLines("CPU ms", cpuMs.data(), static_cast<int>(cpuMs.size()));
+      // GPU times resolve a few frames late; frames without one are left out.
+      if (gpuMs.empty()) {
+        ImGui::Text("GPU: unavailable");
+      } else {
+        ImGui::Text("GPU: %.2f ms", gpuMs.back());
+        ImGui::PlotLines("GPU ms", gpuMs.data(),
+                         static_cast<int>(gpuMs.size()));
+      }
+    }
+    ImGui::TreePop();
+  }
+
+  if (ImGui::TreeNode("Memory")) {
+    constexpr double kMiB = 1024.0 * 1024.0;
+    const auto memory = metrics.memoryStats();
+    ImGui::Text("Resident: %.1f MiB  Virtual: %.1f MiB",
+                static_cast<double>(memory.residentBytes) / kMiB,
+                static_cast<double>(memory.virtualBytes) / kMiB);
+    for (const auto &category : memory.categories) {
+      const bool overBudget =
+          category.budgetBytes != 0 && category.bytes > category.budgetBytes;
+      ImGui::TextColored(overBudget ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f)
+                                    : ImVec4(0.85f, 0.85f, 0.85f, 1.0f),
+                         "%s: %.2f / %.0f MiB (peak %.2f)",
+                         category.name.c_str(),
+                         static_cast<double>(category.bytes) / kMiB,
+                         static_cast<double>(category.budgetBytes) / kMiB,
+                         static_cast<double>(category.peakBytes) / kMiB);
+    }
+    ImGui::TreePop();
+  }
+
   static int selectedConfig = 0;
   static int selectedProfile = 0;
   static int selectedPrimitive = 0;
@@ -121,10 +333,15 @@ void drawManagerUi(EngineInstanceManager &instanceManager,
     auto mesh = createPrimitiveMesh(
         primitiveValues[static_cast<std::size_t>(selectedPrimitive)],
         backpackObjSourceText);
-    instanceManager.createInstanceWithMesh(
-        "instance_" + std::to_string(instanceNameCounter++),
-        configs[static_cast<std::size_t>(selectedConfig)],
-        profiles[static_cast<std::size_t>(selectedProfile)], mesh);
+    // The mesh is uploaded on the scene thread, which owns its GL objects.
+    sceneTasks.push_back(
+        [&instanceManager, mesh = std::move(mesh),
+         name = "instance_" + std::to_string(instanceNameCounter++),
+         config = std::string{configs[static_cast<std::size_t>(selectedConfig)]},
+         profile = std::string{
+             profiles[static_cast<std::size_t>(selectedProfile)]}]() {
+          instanceManager.createInstanceWithMesh(name, config, profile, mesh);
+        });
   }
 
   if (selectedMesh.has_value()) {
@@ -165,13 +382,8 @@ void drawManagerUi(EngineInstanceManager &instanceManager,
         }
 
         if (ImGui::TreeNode("Modules")) {
-          std::vector<engine::modules::ModuleDescriptor> descriptors;
-          descriptors.reserve(instance.modules.size());
-          for (const auto &module : instance.modules) {
-            descriptors.push_back(module.descriptor);
-          }
-
-          const auto validation = moduleManager.validate(descriptors);
+          // Cached until a descriptor changes.
+          const auto &validation = instance.moduleGraph.validate();
           if (!validation.ok) {
             ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f),
                                "Validation has %d issue(s)",
@@ -195,6 +407,7 @@ void drawManagerUi(EngineInstanceManager &instanceManager,
                   ImGui::Button(("Hot Replace##" + moduleNode).c_str())) {
                 ++module.hotSwapGeneration;
                 ++module.descriptor.moduleVersion.patch;
+                instance.moduleGraph.upsert(module.descriptor);
               }
               ImGui::TreePop();
             }
@@ -215,8 +428,26 @@ void drawManagerUi(EngineInstanceManager &instanceManager,
 
 } // namespace
 
-int runSampleApp() {
+int runSampleApp(const int argc, char **argv) {
   try {
+    const SampleOptions options = parseSampleOptions(argc, argv);
+    configureMemoryBudgets(options);
+    const bool benchmarking = !options.benchmarkPath.empty();
+    std::vector<RecordedInputFrame> benchmarkFrames;
+    if (benchmarking) {
+      benchmarkFrames = loadInputRecording(options.benchmarkPath);
+      if (benchmarkFrames.empty()) {
+        throw std::runtime_error("Input recording '" + options.benchmarkPath +
+                                 "' has no frames");
+      }
+      if (options.benchmarkWarmupFrames >= benchmarkFrames.size()) {
+        throw std::runtime_error(
+            "--benchmark-warmup=" +
+            std::to_string(options.benchmarkWarmupFrames) +
+            " leaves no frames to measure: '" + options.benchmarkPath +
+            "' has " + std::to_string(benchmarkFrames.size()));
+      }
+    }
     engine::modules::ModuleManager moduleManager{kEngineApiVersion};
     auto moduleDescriptor = makeDemoModuleDescriptor();
     auto validation = moduleManager.validate({moduleDescriptor});
@@ -227,9 +458,19 @@ int runSampleApp() {
       return 1;
     }
 
+    // Lifecycle calls run in dependency waves on the pool; declared before
+    // the scheduler so the pool outlives it.
+    engine::core::WorkerPool moduleWorkers;
     MeshDemoModule demoModule;
-    demoModule.onLoad();
-    demoModule.onStart();
+    engine::modules::ModuleScheduler moduleScheduler{kEngineApiVersion,
+                                                     moduleWorkers};
+    moduleScheduler.add(moduleDescriptor, demoModule);
+    moduleScheduler.startup();
+    std::cout << "[module] started " << moduleScheduler.timings().size()
+              << " module(s) in " << moduleScheduler.waves().size()
+              << " wave(s): " << moduleScheduler.startupMs()
+              << " ms, critical path " << moduleScheduler.criticalPathMs()
+              << " ms\n";
 
     auto platformBackend = engine::platform::createPlatformBackend();
     auto &windowSystem = platformBackend->windowSystem();
@@ -301,8 +542,12 @@ int runSampleApp() {
           std::string{"SDL_GL_MakeCurrent(manager) failed: "} + SDL_GetError());
     }
 
-    SDL_GL_SetSwapInterval(1);
+    // The main thread paces the manager window itself and keeps pumping
+    // events between its frames; waiting for vsync here would hold input back
+    // from the scene thread for a whole refresh.
+    SDL_GL_SetSwapInterval(0);
 
+    ImGui::SetAllocatorFunctions(imguiTrackedAlloc, imguiTrackedFree);
     ImGui::CreateContext();
     ImGui::StyleColorsDark();
     ImGui_ImplSDL2_InitForOpenGL(managerSdlWindow, managerGlContext);
@@ -314,7 +559,19 @@ int runSampleApp() {
           SDL_GetError());
     }
 
-    rendering::MeshRenderEngine renderer{sceneSdlWindow};
+    engine::render::ProgramBinaryCache programCache{
+        options.shaderCacheDirectory};
+    rendering::MeshRenderEngine renderer{sceneSdlWindow, &programCache};
+    // Read from the manager thread; the profiler and memory tracker it
+    // samples are thread-safe. Trace captures stay with traceCapture below.
+    const engine::devtools::imgui_tools::RuntimeMetricsService metrics;
+    if (programCache.enabled()) {
+      const auto cacheStats = programCache.stats();
+      std::cout << "[shader-cache] " << cacheStats.hits << " hit(s), "
+                << cacheStats.misses << " miss(es), " << cacheStats.rejected
+                << " rejected, " << cacheStats.writes << " written ("
+                << programCache.directory().string() << ")\n";
+    }
     const std::string backpackObjText = backpackObjSource();
     auto baseMesh =
         createPrimitiveMesh(PrimitiveMeshType::Backpack, backpackObjText);
@@ -331,85 +588,250 @@ int runSampleApp() {
     std::optional<std::uint32_t> selectedMesh{initialMeshId};
     renderer.setSelectedMesh(selectedMesh);
 
-    bool running = true;
-    std::uint64_t currentTicks = SDL_GetPerformanceCounter();
-    while (running && !windowSystem.shouldClose(sceneWindowId) &&
-           !windowSystem.shouldClose(managerWindowId)) {
-      const std::uint64_t newTicks = SDL_GetPerformanceCounter();
-      const float deltaSeconds = static_cast<float>(
-          static_cast<double>(newTicks - currentTicks) /
-          static_cast<double>(SDL_GetPerformanceFrequency()));
-      currentTicks = newTicks;
-
-      std::optional<std::uint32_t> lookedAtInFrame;
-
-      SDL_Event event;
-      while (SDL_PollEvent(&event) == 1) {
-        if (event.type == SDL_QUIT) {
-          running = false;
-        }
-        if (event.type == SDL_WINDOWEVENT &&
-            event.window.event == SDL_WINDOWEVENT_CLOSE) {
-          running = false;
-        }
+    ENGINE_PROFILE_THREAD_NAME("main");
 
-        if (event.type == SDL_WINDOWEVENT ||
-            event.type == SDL_MOUSEBUTTONDOWN ||
-            event.type == SDL_MOUSEBUTTONUP || event.type == SDL_MOUSEMOTION ||
-            event.type == SDL_MOUSEWHEEL || event.type == SDL_KEYDOWN ||
-            event.type == SDL_KEYUP || event.type == SDL_TEXTINPUT) {
-          ImGui_ImplSDL2_ProcessEvent(&event);
-        }
+    engine::core::TraceCapture traceCapture{};
+    if (!options.tracePath.empty() &&
+        !traceCapture.request(options.tracePath, options.traceFrames)) {
+      std::cerr << "[trace] --trace needs ENGINE_ENABLE_PROFILING=ON\n";
+    }
 
-        if (event.type == SDL_MOUSEBUTTONDOWN &&
-            event.button.button == SDL_BUTTON_RIGHT) {
-          cameraController.setMouseLookActive(true);
-        }
-        if (event.type == SDL_MOUSEBUTTONUP &&
-            event.button.button == SDL_BUTTON_RIGHT) {
-          cameraController.setMouseLookActive(false);
+    std::optional<InputRecorder> inputRecorder;
+    if (!options.recordInputPath.empty()) {
+      inputRecorder.emplace(options.recordInputPath);
+    }
+    constexpr std::size_t kEventRingCapacity = 1024;
+    engine::platform::PlatformEventRing eventRing{kEventRingCapacity};
+    engine::platform::InputFrameState inputState;
+    windowSystem.setNativeEventObserver([](const void *nativeEvent) {
+      const auto *event = static_cast<const SDL_Event *>(nativeEvent);
+      if (event->type == SDL_WINDOWEVENT ||
+          event->type == SDL_MOUSEBUTTONDOWN ||
+          event->type == SDL_MOUSEBUTTONUP || event->type == SDL_MOUSEMOTION ||
+          event->type == SDL_MOUSEWHEEL || event->type == SDL_KEYDOWN ||
+          event->type == SDL_KEYUP || event->type == SDL_TEXTINPUT) {
+        ImGui_ImplSDL2_ProcessEvent(event);
+      }
+    });
+    std::size_t benchmarkFrame = 0;
+    std::vector<BenchmarkFrameSample> benchmarkSamples;
+    float maxCameraDrift = 0.0f;
+
+    // Guarded by sceneMutex: the renderer's mesh state, the instance manager,
+    // lighting, clear color, selection and the state published below. The UI
+    // never issues GL calls for the scene; work that does (such as uploading a
+    // new instance's mesh) is queued to the scene thread, because vertex
+    // array objects are not shared between contexts.
+    std::mutex sceneMutex;
+    std::vector<std::function<void()>> sceneTasks;
+    std::optional<std::uint32_t> lookedAtInFrame;
+    engine::platform::FramePacingStats scenePacing{};
+
+    std::atomic<bool> running{true};
+    std::atomic<bool> uiWantsMouse{false};
+    std::atomic<bool> uiWantsKeyboard{false};
+    // Relative mouse mode is a window-system call, so the main thread applies
+    // it on the scene thread's behalf.
+    std::atomic<bool> mouseLookActive{false};
+    std::exception_ptr sceneError;
+
+    // The main thread keeps the manager context; the scene context moves to
+    // the scene thread.
+    if (SDL_GL_MakeCurrent(managerSdlWindow, managerGlContext) != 0) {
+      throw std::runtime_error(
+          std::string{"SDL_GL_MakeCurrent(manager) failed: "} + SDL_GetError());
+    }
+
+    // Renders and presents the scene window at its own rate, consuming input
+    // from the event ring. Each frame uploads pending meshes and clears before
+    // draining input, so the camera is latched right before the scene is
+    // submitted.
+    std::jthread sceneThread{[&](const std::stop_token stopToken) {
+      try {
+        ENGINE_PROFILE_THREAD_NAME("scene");
+        if (SDL_GL_MakeCurrent(sceneSdlWindow, sceneGlContext) != 0) {
+          throw std::runtime_error(
+              std::string{"SDL_GL_MakeCurrent(scene thread) failed: "} +
+              SDL_GetError());
         }
-        if (event.type == SDL_MOUSEMOTION) {
-          const bool allowMouseLook = !ImGui::GetIO().WantCaptureMouse;
-          cameraController.handleMouseMotion(event.motion, allowMouseLook);
+        // Benchmarks measure uncapped frame times.
+        const VsyncMode requestedVsync =
+            benchmarking ? VsyncMode::Off : options.vsync;
+        if (applySwapInterval(requestedVsync) != requestedVsync) {
+          std::cout << "[pacing] adaptive vsync unsupported, using vsync on\n";
         }
-        if (event.type == SDL_MOUSEBUTTONDOWN &&
-            event.button.button == SDL_BUTTON_LEFT) {
-          const auto pick = renderer.pickMeshFromScreen(
-              event.button.x, event.button.y, cameraController.camera());
-          if (pick.has_value()) {
-            selectedMesh = pick;
-            renderer.setSelectedMesh(selectedMesh);
+
+        // Benchmarks run unpaced; the pacer still measures their frame
+        // intervals.
+        engine::platform::FramePacer framePacer{
+            engine::platform::FramePacerConfig{
+                .targetHz = benchmarking ? 0.0 : options.targetFps}};
+        float deltaSeconds = 0.0f;
+
+        // Drains the input that arrived since the last call and moves the
+        // camera.
+        const auto latchInput = [&]() {
+          inputState.beginFrame(eventRing);
+          if (inputState.quitRequested()) {
+            running = false;
           }
-        }
-      }
 
-      cameraController.updateFromInput(deltaSeconds,
-                                       SDL_GetKeyboardState(nullptr),
-                                       !ImGui::GetIO().WantCaptureKeyboard);
+          for (const auto &event : inputState.events()) {
+            using engine::platform::KeyState;
+            using engine::platform::PlatformEventType;
+            if (event.type == PlatformEventType::WindowClosed) {
+              running = false;
+            }
 
-      if (SDL_GL_MakeCurrent(sceneSdlWindow, sceneGlContext) != 0) {
-        throw std::runtime_error(
-            std::string{"SDL_GL_MakeCurrent(scene frame) failed: "} +
-            SDL_GetError());
-      }
+            if (event.type == PlatformEventType::Keyboard &&
+                event.keyboard.state == KeyState::Pressed &&
+                !event.keyboard.repeated &&
+                event.keyboard.keyCode == SDLK_F12) {
+              const std::string path =
+                  "quma_trace_" +
+                  std::to_string(
+                      engine::core::Profiler::instance().currentFrameIndex()) +
+                  ".json";
+              if (traceCapture.request(path, options.traceFrames)) {
+                std::cout << "[trace] capturing " << options.traceFrames
+                          << " frame(s) to " << path << '\n';
+              }
+            }
+
+            // A benchmark drives the camera from the recording only.
+            const bool rightButton =
+                event.type == PlatformEventType::Pointer &&
+                event.pointer.button == SDL_BUTTON_RIGHT;
+            if (!benchmarking && rightButton) {
+              const bool active = event.pointer.state == KeyState::Pressed;
+              cameraController.setMouseLookActive(active, false);
+              mouseLookActive = active;
+              if (inputRecorder.has_value()) {
+                inputRecorder->mouseLook(active);
+              }
+            }
+            if (!benchmarking &&
+                event.type == PlatformEventType::PointerMotion) {
+              SDL_MouseMotionEvent motion{};
+              motion.type = SDL_MOUSEMOTION;
+              motion.x = event.pointer.x;
+              motion.y = event.pointer.y;
+              motion.xrel = event.pointer.deltaX;
+              motion.yrel = event.pointer.deltaY;
+              const bool allowMouseLook = !uiWantsMouse;
+              cameraController.handleMouseMotion(motion, allowMouseLook);
+              if (inputRecorder.has_value()) {
+                inputRecorder->mouseMotion(motion, allowMouseLook);
+              }
+            }
+            if (event.type == PlatformEventType::Pointer &&
+                event.pointer.button == SDL_BUTTON_LEFT &&
+                event.pointer.state == KeyState::Pressed) {
+              const auto pick = renderer.pickMeshFromScreen(
+                  event.pointer.x, event.pointer.y, cameraController.camera());
+              if (pick.has_value()) {
+                selectedMesh = pick;
+                renderer.setSelectedMesh(selectedMesh);
+              }
+            }
+          }
 
-      lookedAtInFrame = renderer.findLookedAtMesh(cameraController.camera());
-      renderer.setHoveredMesh(lookedAtInFrame);
+          if (benchmarking) {
+            maxCameraDrift =
+                std::max(maxCameraDrift,
+                         playInputFrame(cameraController,
+                                        benchmarkFrames[benchmarkFrame]));
+          } else {
+            const Uint8 *keyboardState = inputState.keyboardState().data();
+            const bool allowKeyboard = !uiWantsKeyboard;
+            cameraController.updateFromInput(deltaSeconds, keyboardState,
+                                             allowKeyboard);
+            if (inputRecorder.has_value()) {
+              inputRecorder->endFrame(deltaSeconds, keyboardState,
+                                      allowKeyboard, cameraController.camera());
+            }
+          }
+        };
 
-      int sceneWidth = 0;
-      int sceneHeight = 0;
-      SDL_GL_GetDrawableSize(sceneSdlWindow, &sceneWidth, &sceneHeight);
-      renderer.resize(sceneWidth, sceneHeight);
-      renderer.beginFrame(clearColor[0], clearColor[1], clearColor[2]);
-      renderer.renderScene(cameraController.camera(), lighting);
-      renderer.endFrame();
+        while (running && !stopToken.stop_requested()) {
+          deltaSeconds = static_cast<float>(framePacer.waitForNextFrame());
+          const std::uint64_t frameStartTicks = SDL_GetPerformanceCounter();
 
-      if (SDL_GL_MakeCurrent(managerSdlWindow, managerGlContext) != 0) {
-        throw std::runtime_error(
-            std::string{"SDL_GL_MakeCurrent(manager frame) failed: "} +
-            SDL_GetError());
+          {
+            const std::lock_guard lock{sceneMutex};
+            for (const auto &task : sceneTasks) {
+              task();
+            }
+            sceneTasks.clear();
+
+            int sceneWidth = 0;
+            int sceneHeight = 0;
+            SDL_GL_GetDrawableSize(sceneSdlWindow, &sceneWidth, &sceneHeight);
+            renderer.resize(sceneWidth, sceneHeight);
+            renderer.beginFrame(clearColor[0], clearColor[1], clearColor[2]);
+
+            latchInput();
+            lookedAtInFrame =
+                renderer.findLookedAtMesh(cameraController.camera());
+            renderer.setHoveredMesh(lookedAtInFrame);
+            renderer.renderScene(cameraController.camera(), lighting);
+            renderer.endFrame();
+            scenePacing = framePacer.stats();
+          }
+          // The UI thread can take the lock while this one waits for vsync.
+          renderer.present();
+
+          ENGINE_PROFILE_FRAME_MARK();
+          if (const auto traceStatus = traceCapture.poll()) {
+            std::cout << "[trace] " << *traceStatus << '\n';
+          }
+
+          if (benchmarking) {
+            if (benchmarkFrame >= options.benchmarkWarmupFrames) {
+              const auto drawStats = renderer.lastFrameStats();
+              const double frameMs =
+                  static_cast<double>(SDL_GetPerformanceCounter() -
+                                      frameStartTicks) *
+                  1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+              benchmarkSamples.push_back(
+                  {frameMs, drawStats.drawCalls, drawStats.triangles});
+            }
+            if (++benchmarkFrame == benchmarkFrames.size()) {
+              running = false;
+            }
+          }
+        }
+      } catch (...) {
+        sceneError = std::current_exception();
+        running = false;
+      }
+      SDL_GL_MakeCurrent(sceneSdlWindow, nullptr);
+    }};
+
+    using Clock = std::chrono::steady_clock;
+    const auto managerPeriod = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / kManagerFrameHz));
+    Clock::time_point nextManagerFrame = Clock::now();
+    bool cursorCaptured = false;
+    while (running && !windowSystem.shouldClose(sceneWindowId) &&
+           !windowSystem.shouldClose(managerWindowId)) {
+      // Events reach the scene thread through the platform ring; ImGui sees
+      // the raw SDL events through the native observer while they are polled.
+      if (const std::size_t dropped = windowSystem.pollEvents(eventRing);
+          dropped != 0) {
+        std::cerr << "[input] dropped " << dropped << " event(s)\n";
       }
+      if (mouseLookActive != cursorCaptured) {
+        cursorCaptured = !cursorCaptured;
+        SDL_SetRelativeMouseMode(cursorCaptured ? SDL_TRUE : SDL_FALSE);
+      }
+
+      const Clock::time_point now = Clock::now();
+      if (now < nextManagerFrame) {
+        std::this_thread::sleep_for(kEventPollInterval);
+        continue;
+      }
+      nextManagerFrame = std::max(nextManagerFrame + managerPeriod, now);
 
       int managerWidth = 0;
       int managerHeight = 0;
@@ -421,16 +843,48 @@ int runSampleApp() {
       ImGui_ImplOpenGL3_NewFrame();
       ImGui_ImplSDL2_NewFrame();
       ImGui::NewFrame();
-
-      drawManagerUi(instanceManager, moduleManager, backpackObjText,
-                    selectedMesh, renderer, lighting, clearColor,
-                    lookedAtInFrame);
+      {
+        const std::lock_guard lock{sceneMutex};
+        drawManagerUi(instanceManager, moduleManager, backpackObjText,
+                      selectedMesh, renderer, lighting, clearColor,
+                      lookedAtInFrame, scenePacing, metrics, sceneTasks);
+      }
+      uiWantsMouse = ImGui::GetIO().WantCaptureMouse;
+      uiWantsKeyboard = ImGui::GetIO().WantCaptureKeyboard;
 
       ImGui::Render();
       ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
       SDL_GL_SwapWindow(managerSdlWindow);
     }
 
+    running = false;
+    sceneThread.join();
+    if (sceneError) {
+      std::rethrow_exception(sceneError);
+    }
+    if (cursorCaptured) {
+      SDL_SetRelativeMouseMode(SDL_FALSE);
+    }
+
+    std::cout << "[pacing] mean " << scenePacing.meanMs << " ms, jitter "
+              << scenePacing.jitterMs << " ms, max deviation "
+              << scenePacing.maxDeviationMs << " ms, "
+              << scenePacing.missedDeadlines << " missed deadline(s)\n";
+
+    if (inputRecorder.has_value()) {
+      std::cout << "[input] recorded " << inputRecorder->frames()
+                << " frame(s) to " << options.recordInputPath << '\n';
+    }
+    if (benchmarking && benchmarkFrame == benchmarkFrames.size()) {
+      writeBenchmarkReport(options.benchmarkReportPath, options.benchmarkPath,
+                           benchmarkSamples, maxCameraDrift);
+      std::cout << "[benchmark] " << benchmarkSamples.size()
+                << " frame(s) measured, camera drift " << maxCameraDrift
+                << ", report written to " << options.benchmarkReportPath
+                << '\n';
+    }
+
+    windowSystem.setNativeEventObserver({});
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
@@ -440,8 +894,7 @@ int runSampleApp() {
     windowSystem.destroyWindow(managerWindowId);
     windowSystem.destroyWindow(sceneWindowId);
 
-    demoModule.onStop();
-    demoModule.onUnload();
+    moduleScheduler.shutdown();
 
     return 0;
   } catch (const std::exception &exception) {
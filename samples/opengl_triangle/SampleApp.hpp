@@ -2,6 +2,14 @@
 
 namespace sample::app {
 
-int runSampleApp();
+// Options: --trace=<file.json> captures a Chrome trace of the first frames,
+// --trace-frames=<n> sets the capture length (also used by the F12 hotkey),
+// --memory-budget-fail throws instead of warning when a memory budget is exceeded,
+// --record-input=<file> records the camera input of every frame and
+// --benchmark=<file> plays such a recording back with its recorded delta times,
+// then writes frame-time percentiles, draw calls and triangles to
+// --benchmark-report=<file.json> (default benchmark.json) and exits; the first
+// --benchmark-warmup=<n> frames (default 10) are left out of the statistics.
+int runSampleApp(int argc, char** argv);
 
 } // namespace sample::app
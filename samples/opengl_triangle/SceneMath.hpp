@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <utility>
+
+namespace sample::rendering {
+
+struct CameraState {
+  float position[3]{0.0f, 0.0f, 5.0f};
+  float forward[3]{0.0f, 0.0f, -1.0f};
+  float up[3]{0.0f, 1.0f, 0.0f};
+  float fovDegrees = 60.0f;
+  float nearPlane = 0.1f;
+  float farPlane = 150.0f;
+};
+
+// Column-major matrix and vector helpers shared by the renderer, picking and the benchmarks.
+struct Vec3 {
+  float x = 0.0f;
+  float y = 0.0f;
+  float z = 0.0f;
+};
+
+struct Mat4 {
+  std::array<float, 16> value{};
+};
+
+[[nodiscard]] inline Vec3 operator+(const Vec3& a, const Vec3& b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+[[nodiscard]] inline Vec3 operator-(const Vec3& a, const Vec3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+[[nodiscard]] inline Vec3 operator*(const Vec3& a, const float scalar) { return {a.x * scalar, a.y * scalar, a.z * scalar}; }
+
+[[nodiscard]] inline float dot(const Vec3& a, const Vec3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+[[nodiscard]] inline Vec3 cross(const Vec3& a, const Vec3& b) {
+  return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+[[nodiscard]] inline float length(const Vec3& v) { return std::sqrt(dot(v, v)); }
+
+[[nodiscard]] inline Vec3 normalize(const Vec3& v) {
+  const float len = length(v);
+  if (len <= 0.0001f) {
+    return {0.0f, 0.0f, -1.0f};
+  }
+  return v * (1.0f / len);
+}
+
+[[nodiscard]] inline Mat4 identity() {
+  Mat4 matrix{};
+  matrix.value = {1.0f, 0.0f, 0.0f, 0.0f,
+                  0.0f, 1.0f, 0.0f, 0.0f,
+                  0.0f, 0.0f, 1.0f, 0.0f,
+                  0.0f, 0.0f, 0.0f, 1.0f};
+  return matrix;
+}
+
+[[nodiscard]] inline Mat4 multiply(const Mat4& left, const Mat4& right) {
+  Mat4 out{};
+  for (int row = 0; row < 4; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      float sum = 0.0f;
+      for (int k = 0; k < 4; ++k) {
+        sum += left.value[k * 4 + row] * right.value[col * 4 + k];
+      }
+      out.value[col * 4 + row] = sum;
+    }
+  }
+  return out;
+}
+
+[[nodiscard]] inline Mat4 perspective(const float fovRadians, const float aspectRatio, const float nearPlane, const float farPlane) {
+  Mat4 matrix{};
+  const float tanHalf = std::tan(fovRadians * 0.5f);
+  matrix.value = {1.0f / (aspectRatio * tanHalf), 0.0f, 0.0f, 0.0f,
+                  0.0f, 1.0f / tanHalf, 0.0f, 0.0f,
+                  0.0f, 0.0f, -(farPlane + nearPlane) / (farPlane - nearPlane), -1.0f,
+                  0.0f, 0.0f, -(2.0f * farPlane * nearPlane) / (farPlane - nearPlane), 0.0f};
+  return matrix;
+}
+
+[[nodiscard]] inline Mat4 lookAt(const Vec3& eye, const Vec3& center, const Vec3& upHint) {
+  const Vec3 forward = normalize(center - eye);
+  const Vec3 right = normalize(cross(forward, upHint));
+  const Vec3 up = cross(right, forward);
+
+  Mat4 matrix = identity();
+  matrix.value[0] = right.x;
+  matrix.value[1] = up.x;
+  matrix.value[2] = -forward.x;
+  matrix.value[4] = right.y;
+  matrix.value[5] = up.y;
+  matrix.value[6] = -forward.y;
+  matrix.value[8] = right.z;
+  matrix.value[9] = up.z;
+  matrix.value[10] = -forward.z;
+  matrix.value[12] = -dot(right, eye);
+  matrix.value[13] = -dot(up, eye);
+  matrix.value[14] = dot(forward, eye);
+  return matrix;
+}
+
+[[nodiscard]] inline Mat4 translate(const float x, const float y, const float z) {
+  Mat4 matrix = identity();
+  matrix.value[12] = x;
+  matrix.value[13] = y;
+  matrix.value[14] = z;
+  return matrix;
+}
+
+[[nodiscard]] inline Mat4 rotateY(const float radians) {
+  Mat4 matrix = identity();
+  const float c = std::cos(radians);
+  const float s = std::sin(radians);
+  matrix.value[0] = c;
+  matrix.value[2] = -s;
+  matrix.value[8] = s;
+  matrix.value[10] = c;
+  return matrix;
+}
+
+[[nodiscard]] inline Mat4 scaleUniform(const float scale) {
+  Mat4 matrix = identity();
+  matrix.value[0] = scale;
+  matrix.value[5] = scale;
+  matrix.value[10] = scale;
+  return matrix;
+}
+
+[[nodiscard]] inline bool rayIntersectsAabb(const Vec3& rayOrigin,
+                                            const Vec3& rayDirection,
+                                            const Vec3& minBounds,
+                                            const Vec3& maxBounds,
+                                            float& outDistance) {
+  float tMin = 0.0f;
+  float tMax = std::numeric_limits<float>::max();
+
+  auto axisCheck = [&](const float origin, const float direction, const float minVal, const float maxVal) {
+    if (std::abs(direction) < 0.0001f) {
+      return origin >= minVal && origin <= maxVal;
+    }
+
+    float invD = 1.0f / direction;
+    float t0 = (minVal - origin) * invD;
+    float t1 = (maxVal - origin) * invD;
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+    tMin = std::max(tMin, t0);
+    tMax = std::min(tMax, t1);
+    return tMax >= tMin;
+  };
+
+  if (!axisCheck(rayOrigin.x, rayDirection.x, minBounds.x, maxBounds.x)) {
+    return false;
+  }
+  if (!axisCheck(rayOrigin.y, rayDirection.y, minBounds.y, maxBounds.y)) {
+    return false;
+  }
+  if (!axisCheck(rayOrigin.z, rayDirection.z, minBounds.z, maxBounds.z)) {
+    return false;
+  }
+
+  outDistance = tMin;
+  return true;
+}
+
+[[nodiscard]] inline Vec3 createRayDirectionFromScreen(const int mouseX,
+                                                       const int mouseY,
+                                                       const int width,
+                                                       const int height,
+                                                       const CameraState& camera) {
+  const float xNdc = (2.0f * static_cast<float>(mouseX) / static_cast<float>(width)) - 1.0f;
+  const float yNdc = 1.0f - (2.0f * static_cast<float>(mouseY) / static_cast<float>(height));
+
+  const float tanHalf = std::tan(camera.fovDegrees * 0.0174532925f * 0.5f);
+  const float aspect = static_cast<float>(width) / static_cast<float>(height);
+  Vec3 dirCamera{xNdc * aspect * tanHalf, yNdc * tanHalf, -1.0f};
+
+  const Vec3 forward = normalize({camera.forward[0], camera.forward[1], camera.forward[2]});
+  const Vec3 up = normalize({camera.up[0], camera.up[1], camera.up[2]});
+  const Vec3 right = normalize(cross(forward, up));
+
+  Vec3 worldDir = normalize((right * dirCamera.x) + (up * dirCamera.y) + (forward * -dirCamera.z));
+  return worldDir;
+}
+
+struct PickBounds {
+  std::uint32_t id = 0;
+  Vec3 minBounds{};
+  Vec3 maxBounds{};
+};
+
+// Returns the id of the closest candidate whose world-space AABB the ray hits. boundsOf maps an
+// element of candidates to a PickBounds.
+template <typename Range, typename BoundsOf>
+[[nodiscard]] std::optional<std::uint32_t> pickClosest(const Vec3& origin,
+                                                      const Vec3& direction,
+                                                      const Range& candidates,
+                                                      BoundsOf&& boundsOf) {
+  std::optional<std::uint32_t> bestId;
+  float bestDistance = std::numeric_limits<float>::max();
+  for (const auto& candidate : candidates) {
+    const PickBounds bounds = boundsOf(candidate);
+    float distance = 0.0f;
+    if (!rayIntersectsAabb(origin, direction, bounds.minBounds, bounds.maxBounds, distance)) {
+      continue;
+    }
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      bestId = bounds.id;
+    }
+  }
+  return bestId;
+}
+
+} // namespace sample::rendering
@@ -1,5 +1,5 @@
 #include "SampleApp.hpp"
 
-int main() {
-  return sample::app::runSampleApp();
+int main(int argc, char** argv) {
+  return sample::app::runSampleApp(argc, argv);
 }
@@ -0,0 +1,558 @@
+#include "StressScene.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "FrameStatistics.hpp"
+#include "PrimitiveMeshFactory.hpp"
+#include "SampleArguments.hpp"
+#include "SampleAssets.hpp"
+#include "SceneMath.hpp"
+#include "engine/core/Profiler.hpp"
+#include "engine/render/CommandCapture.hpp"
+#include "engine/render/ICommandContext.hpp"
+#include "engine/render/IRenderBackend.hpp"
+#include "engine/render/IRenderDevice.hpp"
+#include "engine/render/PipelineWarmup.hpp"
+#include "engine/render/RenderBackendFactory.hpp"
+#include "engine/render/TextureStreamer.hpp"
+#include "engine/render/software/SoftwareRenderBackend.hpp"
+
+namespace sample::stress {
+namespace {
+
+using rendering::Mat4;
+using rendering::Vec3;
+
+constexpr float kFixedTimeStep = 1.0f / 60.0f;
+constexpr float kInstanceSpacing = 3.0f;
+constexpr float kVerticalFov = 1.0471976f;
+
+enum class FramePhase : std::size_t {
+  Animate,
+  Cull,
+  Upload,
+  Record,
+  Submit,
+  Count,
+};
+
+constexpr std::size_t kPhaseCount = static_cast<std::size_t>(FramePhase::Count);
+constexpr std::array<const char*, kPhaseCount> kPhaseNames{"animate", "cull", "upload", "record", "submit"};
+
+struct GpuMesh {
+  engine::render::BufferHandle vertexBuffer{};
+  engine::render::BufferHandle indexBuffer{};
+  std::uint32_t indexCount = 0;
+  float boundingRadius = 0.0f;
+  rendering::PbrMaterial material;
+};
+
+// Instance state is stored as parallel arrays so the per-frame loops touch only what they need.
+struct InstanceSet {
+  std::vector<Vec3> basePositions;
+  std::vector<float> rotations;
+  std::vector<float> angularSpeeds;
+  std::vector<float> scales;
+  std::vector<std::uint8_t> meshIndices;
+  std::vector<std::uint32_t> animated;
+  std::vector<Mat4> modelMatrices;
+  std::vector<Vec3> positions;
+};
+
+struct Plane {
+  Vec3 normal{};
+  float distance = 0.0f;
+};
+
+struct PhaseSamples {
+  std::array<std::vector<double>, kPhaseCount> phaseMs;
+  std::vector<double> frameMs;
+  std::vector<std::uint32_t> visibleInstances;
+  std::vector<std::uint32_t> drawCalls;
+  std::vector<std::uint64_t> triangles;
+};
+
+using common::computePercentiles;
+using common::Percentiles;
+
+template <typename T>
+[[nodiscard]] double average(const std::vector<T>& values) {
+  double sum = 0.0;
+  for (const T value : values) {
+    sum += static_cast<double>(value);
+  }
+  return values.empty() ? 0.0 : sum / static_cast<double>(values.size());
+}
+
+[[nodiscard]] Mat4 instanceModelMatrix(const Vec3& position, const float rotation, const float scale) {
+  return rendering::multiply(rendering::translate(position.x, position.y, position.z),
+                             rendering::multiply(rendering::rotateY(rotation), rendering::scaleUniform(scale)));
+}
+
+// Gribb/Hartmann plane extraction from a column-major view-projection matrix; normals point inward.
+[[nodiscard]] std::array<Plane, 6> extractFrustumPlanes(const Mat4& viewProjection) {
+  const auto& m = viewProjection.value;
+  const auto row = [&m](const std::size_t index) {
+    return std::array<float, 4>{m[index], m[4 + index], m[8 + index], m[12 + index]};
+  };
+  const std::array<float, 4> x = row(0);
+  const std::array<float, 4> y = row(1);
+  const std::array<float, 4> z = row(2);
+  const std::array<float, 4> w = row(3);
+
+  std::array<Plane, 6> planes{};
+  const auto setPlane = [&planes](const std::size_t index, const std::array<float, 4>& a, const std::array<float, 4>& b, const float sign) {
+    const Vec3 normal{a[0] + sign * b[0], a[1] + sign * b[1], a[2] + sign * b[2]};
+    const float length = rendering::length(normal);
+    const float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+    planes[index] = Plane{normal * inverse, (a[3] + sign * b[3]) * inverse};
+  };
+  setPlane(0, w, x, 1.0f);
+  setPlane(1, w, x, -1.0f);
+  setPlane(2, w, y, 1.0f);
+  setPlane(3, w, y, -1.0f);
+  setPlane(4, w, z, 1.0f);
+  setPlane(5, w, z, -1.0f);
+  return planes;
+}
+
+[[nodiscard]] bool sphereInFrustum(const std::array<Plane, 6>& planes, const Vec3& center, const float radius) {
+  for (const Plane& plane : planes) {
+    if (rendering::dot(plane.normal, center) + plane.distance < -radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+[[nodiscard]] GpuMesh uploadMesh(engine::render::IRenderDevice& device, const rendering::MeshData& mesh, const std::string_view name) {
+  GpuMesh gpuMesh{};
+  gpuMesh.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+  gpuMesh.material = mesh.material;
+  for (const auto& vertex : mesh.vertices) {
+    gpuMesh.boundingRadius = std::max(gpuMesh.boundingRadius,
+                                      rendering::length({vertex.position[0], vertex.position[1], vertex.position[2]}));
+  }
+
+  const std::string vertexName = std::string{name} + " vertices";
+  const std::string indexName = std::string{name} + " indices";
+  engine::render::BufferCreateInfo vertexInfo{};
+  vertexInfo.sizeBytes = mesh.vertices.size() * sizeof(rendering::Vertex);
+  vertexInfo.usage = engine::render::BufferUsage::Vertex;
+  vertexInfo.initialData = reinterpret_cast<const std::byte*>(mesh.vertices.data());
+  vertexInfo.debugName = vertexName;
+  gpuMesh.vertexBuffer = device.createBuffer(vertexInfo);
+
+  engine::render::BufferCreateInfo indexInfo{};
+  indexInfo.sizeBytes = mesh.indices.size() * sizeof(std::uint32_t);
+  indexInfo.usage = engine::render::BufferUsage::Index;
+  indexInfo.initialData = reinterpret_cast<const std::byte*>(mesh.indices.data());
+  indexInfo.debugName = indexName;
+  gpuMesh.indexBuffer = device.createBuffer(indexInfo);
+  return gpuMesh;
+}
+
+// Instances sit on a square grid in the XZ plane with jittered height, rotation and scale. The
+// animated subset is chosen at random so it is spread across the whole scene.
+[[nodiscard]] InstanceSet spawnInstances(const StressSceneOptions& options, const std::size_t meshCount) {
+  std::mt19937 random{options.seed};
+  std::uniform_real_distribution<float> unit{0.0f, 1.0f};
+
+  InstanceSet instances{};
+  const std::uint32_t count = options.instanceCount;
+  instances.basePositions.reserve(count);
+  instances.rotations.reserve(count);
+  instances.angularSpeeds.reserve(count);
+  instances.scales.reserve(count);
+  instances.meshIndices.reserve(count);
+  instances.modelMatrices.reserve(count);
+
+  const auto side = static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<double>(std::max(count, 1U)))));
+  const float halfExtent = static_cast<float>(side) * kInstanceSpacing * 0.5f;
+  for (std::uint32_t index = 0; index < count; ++index) {
+    const float x = static_cast<float>(index % side) * kInstanceSpacing - halfExtent;
+    const float z = static_cast<float>(index / side) * kInstanceSpacing - halfExtent;
+    instances.basePositions.push_back({x, unit(random) * 2.0f, z});
+    instances.rotations.push_back(unit(random) * 6.2831853f);
+    instances.angularSpeeds.push_back(0.5f + unit(random) * 2.0f);
+    instances.scales.push_back(0.4f + unit(random) * 0.6f);
+    instances.meshIndices.push_back(static_cast<std::uint8_t>(random() % meshCount));
+    instances.modelMatrices.push_back(
+        instanceModelMatrix(instances.basePositions.back(), instances.rotations.back(), instances.scales.back()));
+    if (unit(random) < options.animatedFraction) {
+      instances.animated.push_back(index);
+    }
+  }
+  instances.positions = instances.basePositions;
+  return instances;
+}
+
+// Checkerboard whose colour depends on the texture and level, generated per request to stand in for
+// decoding a mip from disk.
+[[nodiscard]] engine::render::StreamedTextureDesc proceduralTexture(const std::uint32_t index, const std::uint32_t size) {
+  engine::render::StreamedTextureDesc desc{};
+  desc.createInfo.extent = {size, size};
+  desc.createInfo.mipLevels = 0;
+  desc.debugName = "stress texture " + std::to_string(index);
+  desc.loadMip = [index, size](const std::uint32_t level) {
+    const std::uint32_t levelSize = std::max(1U, size >> level);
+    std::vector<std::byte> texels(static_cast<std::size_t>(levelSize) * levelSize * 4);
+    for (std::uint32_t y = 0; y < levelSize; ++y) {
+      for (std::uint32_t x = 0; x < levelSize; ++x) {
+        const bool dark = (((x >> 3U) ^ (y >> 3U)) & 1U) != 0;
+        std::byte* texel = texels.data() + (static_cast<std::size_t>(y) * levelSize + x) * 4;
+        texel[0] = static_cast<std::byte>(dark ? 32 : 64 + (index * 37) % 192);
+        texel[1] = static_cast<std::byte>(dark ? 32 : 64 + (level * 53) % 192);
+        texel[2] = static_cast<std::byte>(dark ? 32 : 200);
+        texel[3] = std::byte{255};
+      }
+    }
+    return texels;
+  };
+  return desc;
+}
+
+[[nodiscard]] std::uint32_t parseUnsigned(const std::string_view argument,
+                                         const std::string_view prefix,
+                                         const std::uint32_t minimum = 0) {
+  return common::parseNumericArgument<std::uint32_t>(argument, prefix, minimum);
+}
+
+void writeReportJson(std::ostream& output,
+                     const StressSceneOptions& options,
+                     const std::string_view backendName,
+                     const PhaseSamples& samples) {
+  const auto writePercentiles = [&output](const char* name, const std::vector<double>& values) {
+    const Percentiles stats = computePercentiles(values);
+    output << "    \"" << name << "\": {\"mean\": " << stats.mean << ", \"p50\": " << stats.p50 << ", \"p95\": " << stats.p95
+           << ", \"p99\": " << stats.p99 << ", \"max\": " << stats.max << "}";
+  };
+
+  output << std::fixed << std::setprecision(4);
+  output << "{\n  \"backend\": \"" << backendName << "\",\n  \"instances\": " << options.instanceCount
+         << ",\n  \"animatedFraction\": " << options.animatedFraction << ",\n  \"frames\": " << options.frames
+         << ",\n  \"extent\": [" << options.width << ", " << options.height << "],\n  \"seed\": " << options.seed
+         << ",\n  \"averageVisibleInstances\": " << average(samples.visibleInstances)
+         << ",\n  \"averageDrawCalls\": " << average(samples.drawCalls)
+         << ",\n  \"averageTriangles\": " << average(samples.triangles) << ",\n  \"phasesMs\": {\n";
+  for (std::size_t phase = 0; phase < kPhaseCount; ++phase) {
+    writePercentiles(kPhaseNames[phase], samples.phaseMs[phase]);
+    output << ",\n";
+  }
+  writePercentiles("frame", samples.frameMs);
+  output << "\n  }\n}\n";
+}
+
+void printReport(const StressSceneOptions& options,
+                 const std::string_view backendName,
+                 const std::uint32_t animatedCount,
+                 const PhaseSamples& samples) {
+  std::cout << "Stress scene: " << options.instanceCount << " instances (" << animatedCount << " animated), backend "
+            << backendName << ", " << options.frames << " frames after " << options.warmupFrames << " warm-up, "
+            << options.width << 'x' << options.height << '\n';
+  std::cout << std::fixed << std::setprecision(1) << "visible instances " << average(samples.visibleInstances)
+            << ", draw calls " << average(samples.drawCalls) << ", triangles " << average(samples.triangles)
+            << " (per-frame average)\n";
+
+  std::cout << std::setprecision(3) << std::left << std::setw(10) << "phase (ms)" << std::right << std::setw(10) << "mean"
+            << std::setw(10) << "p50" << std::setw(10) << "p95" << std::setw(10) << "p99" << std::setw(10) << "max" << '\n';
+  const auto printRow = [](const char* name, const std::vector<double>& values) {
+    const Percentiles stats = computePercentiles(values);
+    std::cout << std::left << std::setw(10) << name << std::right << std::setw(10) << stats.mean << std::setw(10) << stats.p50
+              << std::setw(10) << stats.p95 << std::setw(10) << stats.p99 << std::setw(10) << stats.max << '\n';
+  };
+  for (std::size_t phase = 0; phase < kPhaseCount; ++phase) {
+    printRow(kPhaseNames[phase], samples.phaseMs[phase]);
+  }
+  printRow("frame", samples.frameMs);
+}
+
+} // namespace
+
+StressSceneOptions parseStressSceneOptions(const int argc, char** argv) {
+  StressSceneOptions options{};
+  std::vector<std::string_view> arguments;
+  for (int index = 1; index < argc; ++index) {
+    const std::string_view argument{argv[index]};
+    arguments.push_back(argument);
+    if (argument.starts_with("--instances=")) {
+      options.instanceCount = parseUnsigned(argument, "--instances=");
+    } else if (argument.starts_with("--animated=")) {
+      options.animatedFraction = common::parseNumericArgument(argument, "--animated=", 0.0f, 1.0f);
+    } else if (argument.starts_with("--frames=")) {
+      options.frames = parseUnsigned(argument, "--frames=", 1);
+    } else if (argument.starts_with("--warmup=")) {
+      options.warmupFrames = parseUnsigned(argument, "--warmup=");
+    } else if (argument.starts_with("--width=")) {
+      options.width = parseUnsigned(argument, "--width=", 1);
+    } else if (argument.starts_with("--height=")) {
+      options.height = parseUnsigned(argument, "--height=", 1);
+    } else if (argument.starts_with("--seed=")) {
+      options.seed = parseUnsigned(argument, "--seed=");
+    } else if (argument.starts_with("--streamed-textures=")) {
+      options.streamedTextures = parseUnsigned(argument, "--streamed-textures=");
+    } else if (argument.starts_with("--texture-size=")) {
+      options.textureSize = parseUnsigned(argument, "--texture-size=", 1);
+    } else if (argument.starts_with("--texture-budget-mib=")) {
+      options.textureBudgetMiB = parseUnsigned(argument, "--texture-budget-mib=");
+    } else if (argument.starts_with("--report=")) {
+      options.reportPath = std::string{argument.substr(9)};
+    } else if (argument.starts_with("--capture=")) {
+      options.capturePath = std::string{argument.substr(10)};
+    } else if (!argument.starts_with("--render-backend=")) {
+      throw std::runtime_error("Unknown argument '" + std::string{argument} + "'");
+    }
+  }
+
+  options.backend = engine::render::selectRenderBackendType(std::nullopt, arguments, engine::render::RenderBackendType::Null);
+  return options;
+}
+
+int runStressScene(const StressSceneOptions& options) {
+  using engine::render::RenderBackendType;
+  if (options.backend != RenderBackendType::Null && options.backend != RenderBackendType::Software) {
+    throw std::runtime_error("The stress scene runs headless; use --render-backend=null or --render-backend=software");
+  }
+
+  auto backend = engine::render::createRenderBackend(options.backend);
+  auto device = backend->createDevice();
+  if (!options.capturePath.empty()) {
+    device = engine::render::createCapturingRenderDevice(std::move(device), options.capturePath);
+  }
+  auto context = device->createCommandContext();
+
+  engine::render::ShaderCreateInfo vertexShaderInfo{};
+  vertexShaderInfo.stage = engine::render::ShaderStage::Vertex;
+  vertexShaderInfo.debugName = "stress vertex";
+  engine::render::ShaderCreateInfo fragmentShaderInfo{};
+  fragmentShaderInfo.stage = engine::render::ShaderStage::Fragment;
+  fragmentShaderInfo.debugName = "stress fragment";
+  engine::render::GraphicsPipelineCreateInfo pipelineInfo{};
+  pipelineInfo.vertexShader = device->createShader(vertexShaderInfo);
+  pipelineInfo.fragmentShader = device->createShader(fragmentShaderInfo);
+  pipelineInfo.debugName = "stress lit";
+  // Compiles while the meshes load.
+  engine::render::PipelineWarmup pipelineWarmup{*device, std::span{&pipelineInfo, 1}};
+
+  const std::string backpackObj = app::backpackObjSource();
+  std::vector<GpuMesh> meshes;
+  for (const auto type : {app::PrimitiveMeshType::Backpack, app::PrimitiveMeshType::Sphere, app::PrimitiveMeshType::Cone}) {
+    meshes.push_back(uploadMesh(*device, app::createPrimitiveMesh(type, backpackObj), app::primitiveMeshTypeName(type)));
+  }
+
+  InstanceSet instances = spawnInstances(options, meshes.size());
+
+  // Visible instances are grouped per mesh so recording binds each vertex/index buffer once.
+  using DrawConstants = engine::render::SoftwareDrawConstants;
+  std::vector<std::vector<std::uint32_t>> visibleByMesh(meshes.size());
+  std::vector<DrawConstants> drawConstants(std::max(options.instanceCount, 1U));
+
+  engine::render::BufferCreateInfo drawBufferInfo{};
+  drawBufferInfo.sizeBytes = drawConstants.size() * sizeof(DrawConstants);
+  drawBufferInfo.usage = engine::render::BufferUsage::Uniform;
+  drawBufferInfo.cpuVisible = true;
+  drawBufferInfo.debugName = "stress draw constants";
+  const engine::render::BufferHandle drawBuffer = device->createBuffer(drawBufferInfo);
+
+  if (pipelineWarmup.wait().failed != 0) {
+    throw std::runtime_error("The stress scene pipeline failed to build");
+  }
+  const engine::render::PipelineHandle pipeline = pipelineWarmup.take(0);
+
+  const auto side = static_cast<float>(std::ceil(std::sqrt(static_cast<double>(std::max(options.instanceCount, 1U)))));
+  const float sceneRadius = side * kInstanceSpacing * 0.5f;
+  const float aspect = static_cast<float>(options.width) / static_cast<float>(options.height);
+  const Mat4 projection = rendering::perspective(kVerticalFov, aspect, 0.1f, std::max(150.0f, sceneRadius * 4.0f));
+
+  std::optional<engine::render::TextureStreamer> streamer;
+  std::vector<engine::render::StreamedTextureId> streamedTextures;
+  if (options.streamedTextures > 0) {
+    engine::render::TextureStreamerConfig streamerConfig{};
+    streamerConfig.budgetBytes = static_cast<std::size_t>(options.textureBudgetMiB) << 20U;
+    streamer.emplace(*device, streamerConfig);
+    for (std::uint32_t index = 0; index < options.streamedTextures; ++index) {
+      streamedTextures.push_back(streamer->add(proceduralTexture(index, options.textureSize)));
+    }
+  }
+  // Projected diameter in pixels of a unit-radius sphere at distance 1.
+  const float pixelsPerUnit = static_cast<float>(options.height) / std::tan(kVerticalFov * 0.5f);
+
+  PhaseSamples samples{};
+  const std::uint32_t totalFrames = options.warmupFrames + options.frames;
+  for (auto& phase : samples.phaseMs) {
+    phase.reserve(options.frames);
+  }
+
+  using Clock = std::chrono::steady_clock;
+  for (std::uint32_t frame = 0; frame < totalFrames; ++frame) {
+    std::array<Clock::time_point, kPhaseCount + 1> marks{};
+    marks[0] = Clock::now();
+    const float time = static_cast<float>(frame) * kFixedTimeStep;
+
+    {
+      ENGINE_PROFILE_ZONE("Stress::animate");
+      for (const std::uint32_t index : instances.animated) {
+        instances.rotations[index] += instances.angularSpeeds[index] * kFixedTimeStep;
+        Vec3& position = instances.positions[index];
+        position.y = instances.basePositions[index].y + 0.5f * std::sin(time * instances.angularSpeeds[index] + static_cast<float>(index));
+        instances.modelMatrices[index] = instanceModelMatrix(position, instances.rotations[index], instances.scales[index]);
+      }
+    }
+    marks[1] = Clock::now();
+
+    // Scripted camera: one orbit of the scene per run, bobbing between low and high passes. The
+    // path depends only on the frame index, so runs are reproducible.
+    const float pathT = static_cast<float>(frame) / static_cast<float>(totalFrames);
+    const float orbitAngle = pathT * 6.2831853f;
+    const float orbitRadius = sceneRadius * 0.6f + 10.0f;
+    const Vec3 eye{orbitRadius * std::cos(orbitAngle), 8.0f + 0.15f * sceneRadius * (1.0f + std::sin(orbitAngle * 2.0f)),
+                   orbitRadius * std::sin(orbitAngle)};
+    const Vec3 target{0.0f, 0.0f, 0.0f};
+    const Mat4 view = rendering::lookAt(eye, target, {0.0f, 1.0f, 0.0f});
+    const Mat4 viewProjection = rendering::multiply(projection, view);
+
+    std::uint32_t visibleCount = 0;
+    engine::render::TransientAllocation frameConstantsAllocation{};
+    {
+      ENGINE_PROFILE_ZONE("Stress::cull");
+      const std::array<Plane, 6> planes = extractFrustumPlanes(viewProjection);
+      for (auto& visible : visibleByMesh) {
+        visible.clear();
+      }
+      for (std::uint32_t index = 0; index < options.instanceCount; ++index) {
+        const GpuMesh& mesh = meshes[instances.meshIndices[index]];
+        const float radius = mesh.boundingRadius * instances.scales[index];
+        if (sphereInFrustum(planes, instances.positions[index], radius)) {
+          visibleByMesh[instances.meshIndices[index]].push_back(index);
+          if (streamer.has_value()) {
+            const float distance = std::max(rendering::length(instances.positions[index] - eye), 0.1f);
+            streamer->requestScreenSize(streamedTextures[index % streamedTextures.size()], pixelsPerUnit * radius / distance);
+          }
+        }
+      }
+    }
+    marks[2] = Clock::now();
+
+    {
+      ENGINE_PROFILE_ZONE("Stress::upload");
+      for (const auto& visible : visibleByMesh) {
+        for (const std::uint32_t index : visible) {
+          DrawConstants& constants = drawConstants[visibleCount++];
+          const rendering::PbrMaterial& material = meshes[instances.meshIndices[index]].material;
+          std::memcpy(constants.model, instances.modelMatrices[index].value.data(), sizeof(constants.model));
+          std::memcpy(constants.baseColor, material.baseColor, sizeof(material.baseColor));
+          constants.metallic = material.metallic;
+          constants.roughness = material.roughness;
+          constants.ambientOcclusion = material.ambientOcclusion;
+        }
+      }
+
+      engine::render::SoftwareFrameConstants frameConstants{};
+      std::memcpy(frameConstants.view, view.value.data(), sizeof(frameConstants.view));
+      std::memcpy(frameConstants.projection, projection.value.data(), sizeof(frameConstants.projection));
+      frameConstants.cameraPosition[0] = eye.x;
+      frameConstants.cameraPosition[1] = eye.y;
+      frameConstants.cameraPosition[2] = eye.z;
+      frameConstantsAllocation = device->allocateTransient(sizeof(frameConstants));
+      std::memcpy(frameConstantsAllocation.data.data(), &frameConstants, sizeof(frameConstants));
+      device->updateBuffer(drawBuffer, 0, std::as_bytes(std::span{drawConstants.data(), visibleCount}));
+      if (streamer.has_value()) {
+        streamer->update();
+      }
+    }
+    marks[3] = Clock::now();
+
+    {
+      ENGINE_PROFILE_ZONE("Stress::record");
+      context->beginFrame({frame, {options.width, options.height}});
+      context->bindPipeline(pipeline);
+      context->bindUniformBuffer(engine::render::kSoftwareFrameConstantsBinding,
+                                 frameConstantsAllocation.buffer,
+                                 frameConstantsAllocation.offset,
+                                 sizeof(engine::render::SoftwareFrameConstants));
+      std::uint32_t drawIndex = 0;
+      for (std::size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex) {
+        const GpuMesh& mesh = meshes[meshIndex];
+        if (visibleByMesh[meshIndex].empty()) {
+          continue;
+        }
+        context->bindVertexBuffer(mesh.vertexBuffer);
+        context->bindIndexBuffer(mesh.indexBuffer);
+        for (std::size_t visible = 0; visible < visibleByMesh[meshIndex].size(); ++visible, ++drawIndex) {
+          context->bindUniformBuffer(engine::render::kSoftwareDrawConstantsBinding,
+                                     drawBuffer,
+                                     static_cast<std::uint64_t>(drawIndex) * sizeof(DrawConstants),
+                                     sizeof(DrawConstants));
+          context->drawIndexed(mesh.indexCount);
+        }
+      }
+    }
+    marks[4] = Clock::now();
+
+    {
+      ENGINE_PROFILE_ZONE("Stress::submit");
+      context->endFrame();
+    }
+    marks[5] = Clock::now();
+    ENGINE_PROFILE_FRAME_MARK();
+
+    if (frame < options.warmupFrames) {
+      continue;
+    }
+    for (std::size_t phase = 0; phase < kPhaseCount; ++phase) {
+      samples.phaseMs[phase].push_back(std::chrono::duration<double, std::milli>(marks[phase + 1] - marks[phase]).count());
+    }
+    samples.frameMs.push_back(std::chrono::duration<double, std::milli>(marks[kPhaseCount] - marks[0]).count());
+    const engine::render::RenderFrameStats stats = device->frameStats();
+    samples.visibleInstances.push_back(visibleCount);
+    samples.drawCalls.push_back(stats.drawCalls);
+    samples.triangles.push_back(stats.triangles);
+  }
+
+  printReport(options, backend->name(), static_cast<std::uint32_t>(instances.animated.size()), samples);
+  if (streamer.has_value()) {
+    const engine::render::TextureStreamerStats streaming = streamer->stats();
+    std::cout << "texture streaming: " << streaming.textures << " textures, " << (streaming.residentBytes >> 20U) << " / "
+              << (streaming.budgetBytes >> 20U) << " MiB resident, " << streaming.uploads << " uploads, " << streaming.evictions
+              << " evictions\n";
+  }
+  if (!options.reportPath.empty()) {
+    std::ofstream report{options.reportPath, std::ios::binary | std::ios::trunc};
+    writeReportJson(report, options, backend->name(), samples);
+    if (!report) {
+      std::cerr << "Failed to write report to '" << options.reportPath << "'\n";
+      return 1;
+    }
+    std::cout << "Wrote report to '" << options.reportPath << "'\n";
+  }
+  return 0;
+}
+
+int runStressScene(const int argc, char** argv) {
+  try {
+    return runStressScene(parseStressSceneOptions(argc, argv));
+  } catch (const std::exception& exception) {
+    std::cerr << "Stress scene failed: " << exception.what() << '\n';
+    return 1;
+  }
+}
+
+} // namespace sample::stress
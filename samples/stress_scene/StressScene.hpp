@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "engine/render/RenderTypes.hpp"
+
+namespace sample::stress {
+
+struct StressSceneOptions {
+  std::uint32_t instanceCount = 100'000;
+  // Fraction of instances whose transform changes every frame.
+  float animatedFraction = 0.1f;
+  std::uint32_t frames = 300;
+  std::uint32_t warmupFrames = 10;
+  std::uint32_t width = 1280;
+  std::uint32_t height = 720;
+  std::uint32_t seed = 1;
+  engine::render::RenderBackendType backend = engine::render::RenderBackendType::Null;
+  // Procedural textures streamed by the instances' screen size; 0 disables texture streaming.
+  std::uint32_t streamedTextures = 0;
+  std::uint32_t textureSize = 1024;
+  // 0 leaves the streaming budget unlimited.
+  std::uint32_t textureBudgetMiB = 64;
+  // Optional JSON report path; the text summary always goes to stdout.
+  std::string reportPath;
+  // Optional command capture path for engine_sample_capture_replay.
+  std::string capturePath;
+};
+
+[[nodiscard]] StressSceneOptions parseStressSceneOptions(int argc, char** argv);
+
+// Builds the procedural scene, renders options.frames frames along a fixed camera path and
+// prints per-phase CPU time percentiles. Returns the process exit code.
+int runStressScene(const StressSceneOptions& options);
+int runStressScene(int argc, char** argv);
+
+} // namespace sample::stress
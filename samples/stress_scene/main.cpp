@@ -0,0 +1,5 @@
+#include "StressScene.hpp"
+
+int main(int argc, char** argv) {
+  return sample::stress::runStressScene(argc, argv);
+}
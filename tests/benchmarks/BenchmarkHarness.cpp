@@ -0,0 +1,187 @@
+#include "BenchmarkHarness.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <thread>
+
+namespace engine::benchmarks {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+[[nodiscard]] double elapsedNs(const Clock::time_point start, const Clock::time_point end) {
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+// Times `iterations` runs of the body; prepare() is excluded from the measurement.
+[[nodiscard]] double timeIterations(const BenchmarkBody& body, const std::uint64_t iterations) {
+  if (!body.prepare) {
+    const auto start = Clock::now();
+    for (std::uint64_t iteration = 0; iteration < iterations; ++iteration) {
+      body.run();
+    }
+    return elapsedNs(start, Clock::now());
+  }
+
+  double total = 0.0;
+  for (std::uint64_t iteration = 0; iteration < iterations; ++iteration) {
+    body.prepare();
+    const auto start = Clock::now();
+    body.run();
+    total += elapsedNs(start, Clock::now());
+  }
+  return total;
+}
+
+[[nodiscard]] double median(std::vector<double> values) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::sort(values.begin(), values.end());
+  const std::size_t middle = values.size() / 2;
+  return values.size() % 2 != 0 ? values[middle] : (values[middle - 1] + values[middle]) * 0.5;
+}
+
+void writeJsonString(std::ostream& output, const std::string& text) {
+  output << '"';
+  for (const char character : text) {
+    if (character == '"' || character == '\\') {
+      output << '\\';
+    }
+    output << character;
+  }
+  output << '"';
+}
+
+[[nodiscard]] std::string compilerName() {
+#if defined(__clang__)
+  return "clang " __clang_version__;
+#elif defined(__GNUC__)
+  return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+  return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+  return "unknown";
+#endif
+}
+
+} // namespace
+
+BenchmarkResult summarize(std::string name,
+                          const std::uint64_t itemsPerIteration,
+                          const std::uint64_t iterationsPerSample,
+                          std::vector<double> samplesNs) {
+  BenchmarkResult result{};
+  result.name = std::move(name);
+  result.itemsPerIteration = itemsPerIteration;
+  result.iterationsPerSample = iterationsPerSample;
+  if (samplesNs.empty()) {
+    return result;
+  }
+
+  std::vector<double> sorted = samplesNs;
+  std::sort(sorted.begin(), sorted.end());
+  result.medianNs = median(sorted);
+  const auto rank = static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(sorted.size())));
+  result.p99Ns = sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+  result.minNs = sorted.front();
+  result.maxNs = sorted.back();
+
+  double sum = 0.0;
+  std::vector<double> deviations;
+  deviations.reserve(sorted.size());
+  for (const double sample : sorted) {
+    sum += sample;
+    deviations.push_back(std::abs(sample - result.medianNs));
+  }
+  result.meanNs = sum / static_cast<double>(sorted.size());
+  result.madNs = median(std::move(deviations));
+  result.samplesNs = std::move(samplesNs);
+  return result;
+}
+
+std::vector<BenchmarkResult> runBenchmarks(const BenchmarkRegistry& registry,
+                                           const BenchmarkOptions& options,
+                                           std::ostream& log) {
+  std::vector<BenchmarkResult> results;
+  for (const auto& benchmarkCase : registry.cases()) {
+    if (!options.filter.empty() && benchmarkCase.name.find(options.filter) == std::string::npos) {
+      continue;
+    }
+
+    log << "[bench] " << benchmarkCase.name << std::flush;
+    const BenchmarkBody body = benchmarkCase.setup();
+
+    // Calibrate: grow the iteration count until one sample reaches the minimum duration.
+    const double minSampleNs = options.minSampleMs * 1.0e6;
+    std::uint64_t iterations = 1;
+    double calibrationNs = timeIterations(body, iterations);
+    while (calibrationNs < minSampleNs && iterations < (std::uint64_t{1} << 30)) {
+      const double scale = calibrationNs > 0.0 ? std::min(10.0, 1.2 * minSampleNs / calibrationNs) : 10.0;
+      iterations = std::max(iterations + 1, static_cast<std::uint64_t>(static_cast<double>(iterations) * scale));
+      calibrationNs = timeIterations(body, iterations);
+    }
+
+    for (std::uint32_t warmup = 0; warmup < options.warmupSamples; ++warmup) {
+      static_cast<void>(timeIterations(body, iterations));
+    }
+
+    std::vector<double> samples;
+    samples.reserve(options.samples);
+    for (std::uint32_t sample = 0; sample < std::max(1U, options.samples); ++sample) {
+      samples.push_back(timeIterations(body, iterations) / static_cast<double>(iterations));
+    }
+
+    results.push_back(summarize(benchmarkCase.name, benchmarkCase.itemsPerIteration, iterations, std::move(samples)));
+    const auto& result = results.back();
+    log << ": median " << std::fixed << std::setprecision(1) << result.medianNs << " ns, p99 " << result.p99Ns
+        << " ns, MAD " << result.madNs << " ns (" << iterations << " it/sample)\n";
+    log.unsetf(std::ios::floatfield);
+  }
+  return results;
+}
+
+void writeBenchmarkJson(std::ostream& output, const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options) {
+  const std::time_t now = std::time(nullptr);
+  std::tm utc{};
+#if defined(_WIN32)
+  gmtime_s(&utc, &now);
+#else
+  gmtime_r(&now, &utc);
+#endif
+  char timestamp[32]{};
+  std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+
+  output << std::setprecision(17);
+  output << "{\n  \"schemaVersion\": 1,\n  \"context\": {\n    \"timestamp\": \"" << timestamp << "\",\n    \"revision\": ";
+  writeJsonString(output, options.revision);
+  output << ",\n    \"compiler\": ";
+  writeJsonString(output, compilerName());
+  output << ",\n    \"hardwareConcurrency\": " << std::thread::hardware_concurrency()
+         << ",\n    \"profiling\": " << (ENGINE_ENABLE_PROFILING ? "true" : "false")
+         << ",\n    \"samples\": " << options.samples << ",\n    \"minSampleMs\": " << options.minSampleMs
+         << "\n  },\n  \"benchmarks\": [";
+
+  for (std::size_t index = 0; index < results.size(); ++index) {
+    const auto& result = results[index];
+    const double itemsPerSecond =
+        result.medianNs > 0.0 ? static_cast<double>(result.itemsPerIteration) * 1.0e9 / result.medianNs : 0.0;
+    output << (index == 0 ? "\n" : ",\n") << "    {\"name\": ";
+    writeJsonString(output, result.name);
+    output << ", \"unit\": \"ns\", \"itemsPerIteration\": " << result.itemsPerIteration
+           << ", \"iterationsPerSample\": " << result.iterationsPerSample << ", \"median\": " << result.medianNs
+           << ", \"p99\": " << result.p99Ns << ", \"mad\": " << result.madNs << ", \"mean\": " << result.meanNs
+           << ", \"min\": " << result.minNs << ", \"max\": " << result.maxNs
+           << ", \"itemsPerSecond\": " << itemsPerSecond << ", \"samples\": [";
+    for (std::size_t sample = 0; sample < result.samplesNs.size(); ++sample) {
+      output << (sample == 0 ? "" : ", ") << result.samplesNs[sample];
+    }
+    output << "]}";
+  }
+  output << "\n  ]\n}\n";
+}
+
+} // namespace engine::benchmarks
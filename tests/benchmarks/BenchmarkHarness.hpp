@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace engine::benchmarks {
+
+// Prevents the optimizer from discarding a computed value.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink = nullptr;
+  sink = &value;
+#endif
+}
+
+struct BenchmarkOptions {
+  std::string filter;
+  std::string revision;
+  std::uint32_t samples = 25;
+  std::uint32_t warmupSamples = 2;
+  // Fast bodies are repeated until one sample takes at least this long.
+  double minSampleMs = 5.0;
+  // Enables the largest problem sizes (e.g. 10M-face OBJ parsing).
+  bool large = false;
+};
+
+// A prepared benchmark body. run() executes one iteration and is the only timed part; prepare()
+// (if set) runs untimed before every iteration for bodies that consume their input.
+struct BenchmarkBody {
+  std::function<void()> run;
+  std::function<void()> prepare;
+};
+
+struct BenchmarkCase {
+  std::string name;
+  // Work items processed per iteration (faces, rays, events, ...); reported as items/second.
+  std::uint64_t itemsPerIteration = 1;
+  // Builds the input data lazily so only one case's data is alive at a time.
+  std::function<BenchmarkBody()> setup;
+};
+
+struct BenchmarkResult {
+  std::string name;
+  std::uint64_t itemsPerIteration = 1;
+  std::uint64_t iterationsPerSample = 1;
+  std::vector<double> samplesNs;
+  double medianNs = 0.0;
+  double p99Ns = 0.0;
+  double madNs = 0.0;
+  double meanNs = 0.0;
+  double minNs = 0.0;
+  double maxNs = 0.0;
+};
+
+class BenchmarkRegistry {
+public:
+  void add(BenchmarkCase benchmarkCase) { cases_.push_back(std::move(benchmarkCase)); }
+  [[nodiscard]] const std::vector<BenchmarkCase>& cases() const { return cases_; }
+
+private:
+  std::vector<BenchmarkCase> cases_;
+};
+
+// Runs every case whose name contains options.filter and returns per-iteration statistics.
+[[nodiscard]] std::vector<BenchmarkResult> runBenchmarks(const BenchmarkRegistry& registry,
+                                                         const BenchmarkOptions& options,
+                                                         std::ostream& log);
+
+// Summary statistics over raw samples: median, nearest-rank p99, median absolute deviation.
+[[nodiscard]] BenchmarkResult summarize(std::string name,
+                                        std::uint64_t itemsPerIteration,
+                                        std::uint64_t iterationsPerSample,
+                                        std::vector<double> samplesNs);
+
+void writeBenchmarkJson(std::ostream& output, const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options);
+
+void registerObjLoaderBenchmarks(BenchmarkRegistry& registry, const BenchmarkOptions& options);
+void registerSceneMathBenchmarks(BenchmarkRegistry& registry, const BenchmarkOptions& options);
+void registerModuleManagerBenchmarks(BenchmarkRegistry& registry, const BenchmarkOptions& options);
+void registerPlatformEventBenchmarks(BenchmarkRegistry& registry, const BenchmarkOptions& options);
+
+} // namespace engine::benchmarks
@@ -0,0 +1,93 @@
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "BenchmarkHarness.hpp"
+
+#ifndef ENGINE_BENCHMARKS_HAS_SDL
+#define ENGINE_BENCHMARKS_HAS_SDL 0
+#endif
+
+#ifndef ENGINE_BENCHMARKS_GIT_REVISION
+#define ENGINE_BENCHMARKS_GIT_REVISION "unknown"
+#endif
+
+namespace {
+
+void printUsage() {
+  std::cerr << "Usage: engine_benchmarks [--filter=<substring>] [--samples=<n>] [--min-sample-ms=<ms>]\n"
+               "                         [--out=<file.json>] [--revision=<id>] [--large] [--list]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  using namespace engine::benchmarks;
+
+  BenchmarkOptions options{};
+  options.revision = ENGINE_BENCHMARKS_GIT_REVISION;
+  std::string outputPath;
+  bool listOnly = false;
+
+  for (int index = 1; index < argc; ++index) {
+    const std::string_view argument{argv[index]};
+    const auto valueOf = [argument](const std::string_view prefix) { return std::string{argument.substr(prefix.size())}; };
+
+    if (argument.starts_with("--filter=")) {
+      options.filter = valueOf("--filter=");
+    } else if (argument.starts_with("--samples=")) {
+      options.samples = static_cast<std::uint32_t>(std::strtoul(valueOf("--samples=").c_str(), nullptr, 10));
+    } else if (argument.starts_with("--min-sample-ms=")) {
+      options.minSampleMs = std::strtod(valueOf("--min-sample-ms=").c_str(), nullptr);
+    } else if (argument.starts_with("--out=")) {
+      outputPath = valueOf("--out=");
+    } else if (argument.starts_with("--revision=")) {
+      options.revision = valueOf("--revision=");
+    } else if (argument == "--large") {
+      options.large = true;
+    } else if (argument == "--list") {
+      listOnly = true;
+    } else {
+      printUsage();
+      return argument == "--help" ? 0 : 2;
+    }
+  }
+
+  BenchmarkRegistry registry;
+  registerObjLoaderBenchmarks(registry, options);
+  registerSceneMathBenchmarks(registry, options);
+  registerModuleManagerBenchmarks(registry, options);
+#if ENGINE_BENCHMARKS_HAS_SDL
+  registerPlatformEventBenchmarks(registry, options);
+#endif
+
+  if (listOnly) {
+    for (const auto& benchmarkCase : registry.cases()) {
+      std::cout << benchmarkCase.name << '\n';
+    }
+    return 0;
+  }
+
+  try {
+    const auto results = runBenchmarks(registry, options, std::cerr);
+    if (outputPath.empty()) {
+      writeBenchmarkJson(std::cout, results, options);
+      return 0;
+    }
+
+    std::ofstream file{outputPath, std::ios::binary | std::ios::trunc};
+    writeBenchmarkJson(file, results, options);
+    if (!file) {
+      std::cerr << "Failed to write benchmark results to '" << outputPath << "'\n";
+      return 1;
+    }
+    std::cerr << "Wrote " << results.size() << " result(s) to '" << outputPath << "'\n";
+  } catch (const std::exception& exception) {
+    std::cerr << "Benchmark failed: " << exception.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchmarkHarness.hpp"
+#include "engine/modules/ModuleGraph.hpp"
+#include "engine/modules/ModuleManager.hpp"
+#include "engine/modules/ModuleScheduler.hpp"
+
+namespace engine::benchmarks {
+namespace {
+
+constexpr modules::Version kApiVersion{1, 0, 0};
+
+// A valid manifest: every module depends on up to four modules registered before it, so the
+// dependency graph is an acyclic DAG. Modules are shuffled so registration order is not
+// already a startup order.
+[[nodiscard]] std::vector<modules::ModuleDescriptor> makeManifest(const std::uint64_t moduleCount) {
+  std::mt19937 random{42};
+  std::vector<modules::ModuleDescriptor> manifest;
+  manifest.reserve(moduleCount);
+
+  for (std::uint64_t index = 0; index < moduleCount; ++index) {
+    modules::ModuleDescriptor module{};
+    module.id = "engine.module." + std::to_string(index);
+    module.category = "benchmark";
+    module.moduleVersion = {1, 0, 0};
+    module.requiredApiVersion = kApiVersion;
+
+    const std::uint64_t dependencyCount = index == 0 ? 0 : std::min<std::uint64_t>(index, random() % 5);
+    for (std::uint64_t dependency = 0; dependency < dependencyCount; ++dependency) {
+      const std::string dependencyId = "engine.module." + std::to_string(random() % index);
+      if (!module.dependsOn(dependencyId)) {
+        module.dependencies.push_back(dependencyId);
+      }
+    }
+    manifest.push_back(std::move(module));
+  }
+
+  std::shuffle(manifest.begin(), manifest.end(), random);
+  return manifest;
+}
+
+// A graph built from makeManifest(); each iteration edits the next descriptor in turn.
+struct GraphEditState {
+  explicit GraphEditState(const std::uint64_t moduleCount) : manifest(makeManifest(moduleCount)), graph(kApiVersion) {
+    graph.assign(manifest);
+    doNotOptimize(graph.validate().ok);
+  }
+
+  [[nodiscard]] modules::ModuleDescriptor& nextModule() { return manifest[next++ % manifest.size()]; }
+
+  std::vector<modules::ModuleDescriptor> manifest;
+  modules::ModuleGraph graph;
+  std::size_t next = 0;
+};
+
+// Stands in for a module that parses configuration or creates resources in each lifecycle call.
+class BusyModule final : public modules::IModule {
+public:
+  void onLoad() override { work(); }
+  void onStart() override { work(); }
+  void onStop() override { work(); }
+  void onUnload() override { work(); }
+
+private:
+  void work() {
+    std::uint64_t hash = 1469598103934665603ull;
+    for (std::uint32_t step = 0; step < 20'000; ++step) {
+      hash = (hash ^ step) * 1099511628211ull;
+    }
+    doNotOptimize(hash);
+  }
+};
+
+// A makeManifest() graph of BusyModules; each iteration starts and shuts down all of them.
+struct SchedulerState {
+  SchedulerState(const std::uint64_t moduleCount, const std::uint32_t workerCount)
+      : workers(workerCount), scheduler(kApiVersion, workers), modules(moduleCount) {
+    const auto manifest = makeManifest(moduleCount);
+    for (std::size_t index = 0; index < manifest.size(); ++index) {
+      scheduler.add(manifest[index], modules[index]);
+    }
+  }
+
+  core::WorkerPool workers;
+  modules::ModuleScheduler scheduler;
+  std::vector<BusyModule> modules;
+};
+
+} // namespace
+
+void registerModuleManagerBenchmarks(BenchmarkRegistry& registry, const BenchmarkOptions& /*options*/) {
+  for (const std::uint64_t count : {std::uint64_t{100}, std::uint64_t{1'000}, std::uint64_t{10'000}}) {
+    const std::string suffix = std::to_string(count);
+
+    registry.add(BenchmarkCase{"modules/validate/" + suffix, count, [count] {
+                                 auto manifest = std::make_shared<const std::vector<modules::ModuleDescriptor>>(makeManifest(count));
+                                 return BenchmarkBody{[manifest] {
+                                                        const modules::ModuleManager manager{kApiVersion};
+                                                        const auto result = manager.validate(*manifest);
+                                                        doNotOptimize(result.ok);
+                                                      },
+                                                      {}};
+                               }});
+
+    registry.add(BenchmarkCase{"modules/startupOrder/" + suffix, count, [count] {
+                                 auto manifest = std::make_shared<const std::vector<modules::ModuleDescriptor>>(makeManifest(count));
+                                 return BenchmarkBody{[manifest] {
+                                                        const modules::ModuleManager manager{kApiVersion};
+                                                        const auto order = manager.startupOrder(*manifest);
+                                                        doNotOptimize(order.size());
+                                                      },
+                                                      {}};
+                               }});
+
+    // A hot replace: one version bump, revalidating only that module.
+    registry.add(BenchmarkCase{"modules/graph/versionEdit/" + suffix, 1, [count] {
+                                 auto state = std::make_shared<GraphEditState>(count);
+                                 return BenchmarkBody{[state] {
+                                                        modules::ModuleDescriptor& module = state->nextModule();
+                                                        ++module.moduleVersion.patch;
+                                                        state->graph.upsert(module);
+                                                        doNotOptimize(state->graph.validate().ok);
+                                                      },
+                                                      {}};
+                               }});
+
+    // Adding and then removing a dependency on the first module: the startup order is rebuilt.
+    registry.add(BenchmarkCase{"modules/graph/dependencyEdit/" + suffix, 1, [count] {
+                                 auto state = std::make_shared<GraphEditState>(count);
+                                 return BenchmarkBody{[state] {
+                                                        modules::ModuleDescriptor& module = state->nextModule();
+                                                        if (!module.dependsOn("engine.module.0") && module.id != "engine.module.0") {
+                                                          module.dependencies.emplace_back("engine.module.0");
+                                                          state->graph.upsert(module);
+                                                          doNotOptimize(state->graph.validate().ok);
+                                                          module.dependencies.pop_back();
+                                                          state->graph.upsert(module);
+                                                        }
+                                                        doNotOptimize(state->graph.validate().ok);
+                                                      },
+                                                      {}};
+                               }});
+  }
+
+  // One worker runs every lifecycle call inline, as a sequential startup would.
+  for (const std::uint64_t count : {std::uint64_t{100}, std::uint64_t{1'000}}) {
+    for (const std::uint32_t workerCount : {std::uint32_t{1}, std::uint32_t{0}}) {
+      const std::string name =
+          "modules/scheduler/lifecycle/" + std::to_string(count) + (workerCount == 1 ? "/sequential" : "/parallel");
+      registry.add(BenchmarkCase{name, count, [count, workerCount] {
+                                   auto state = std::make_shared<SchedulerState>(count, workerCount);
+                                   return BenchmarkBody{[state] {
+                                                          state->scheduler.startup();
+                                                          state->scheduler.shutdown();
+                                                          doNotOptimize(state->scheduler.startupMs());
+                                                        },
+                                                        {}};
+                                 }});
+    }
+  }
+}
+
+} // namespace engine::benchmarks
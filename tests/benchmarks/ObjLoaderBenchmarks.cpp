@@ -0,0 +1,92 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "BenchmarkHarness.hpp"
+#include "ObjLoader.hpp"
+
+namespace engine::benchmarks {
+namespace {
+
+// Builds a triangulated grid with positions, UVs and normals referenced through `f v/vt/vn`
+// corners, matching what DCC exporters typically emit.
+[[nodiscard]] std::string makeGridObj(const std::uint64_t targetFaces) {
+  std::uint64_t cells = 1;
+  while (cells * cells * 2 < targetFaces) {
+    ++cells;
+  }
+
+  const std::uint64_t verticesPerRow = cells + 1;
+  std::string source;
+  source.reserve(static_cast<std::size_t>(targetFaces) * 64 + verticesPerRow * verticesPerRow * 48);
+  source += "# synthetic benchmark grid\n";
+
+  for (std::uint64_t row = 0; row <= cells; ++row) {
+    for (std::uint64_t column = 0; column <= cells; ++column) {
+      const double u = static_cast<double>(column) / static_cast<double>(cells);
+      const double v = static_cast<double>(row) / static_cast<double>(cells);
+      source += "v " + std::to_string(u * 2.0 - 1.0) + " " + std::to_string((u - 0.5) * (v - 0.5)) + " " +
+                std::to_string(v * 2.0 - 1.0) + "\n";
+      source += "vt " + std::to_string(u) + " " + std::to_string(v) + "\n";
+    }
+  }
+  source += "vn 0.0 1.0 0.0\n";
+
+  std::uint64_t faces = 0;
+  const auto corner = [&source](const std::uint64_t index) {
+    const std::string position = std::to_string(index + 1);
+    source += " " + position + "/" + position + "/1";
+  };
+  for (std::uint64_t row = 0; row < cells && faces < targetFaces; ++row) {
+    for (std::uint64_t column = 0; column < cells && faces < targetFaces; ++column) {
+      const std::uint64_t topLeft = row * verticesPerRow + column;
+      const std::uint64_t bottomLeft = topLeft + verticesPerRow;
+
+      source += "f";
+      corner(topLeft);
+      corner(bottomLeft);
+      corner(topLeft + 1);
+      source += "\n";
+      if (++faces == targetFaces) {
+        break;
+      }
+
+      source += "f";
+      corner(topLeft + 1);
+      corner(bottomLeft);
+      corner(bottomLeft + 1);
+      source += "\n";
+      ++faces;
+    }
+  }
+
+  return source;
+}
+
+[[nodiscard]] std::string faceLabel(const std::uint64_t faces) {
+  return faces >= 1'000'000 ? std::to_string(faces / 1'000'000) + "M" : std::to_string(faces / 1'000) + "K";
+}
+
+} // namespace
+
+void registerObjLoaderBenchmarks(BenchmarkRegistry& registry, const BenchmarkOptions& options) {
+  std::vector<std::uint64_t> faceCounts{1'000, 10'000, 100'000, 1'000'000};
+  if (options.large) {
+    faceCounts.push_back(10'000'000);
+  }
+
+  for (const std::uint64_t faces : faceCounts) {
+    registry.add(BenchmarkCase{"obj/loadObjFromString/" + faceLabel(faces), faces, [faces] {
+                                 auto source = std::make_shared<const std::string>(makeGridObj(faces));
+                                 return BenchmarkBody{[source] {
+                                                        const auto mesh = sample::rendering::loadObjFromString(*source);
+                                                        doNotOptimize(mesh.indices.size());
+                                                      },
+                                                      {}};
+                               }});
+  }
+}
+
+} // namespace engine::benchmarks
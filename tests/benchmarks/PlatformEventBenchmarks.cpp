@@ -0,0 +1,93 @@
+#include <SDL.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "BenchmarkHarness.hpp"
+#include "engine/platform/IPlatformBackend.hpp"
+#include "engine/platform/InputFrameState.hpp"
+#include "engine/platform/PlatformBackendFactory.hpp"
+
+namespace engine::benchmarks {
+namespace {
+
+constexpr std::uint64_t kEventsPerBatch = 1024;
+
+// Fills SDL's queue with a mix of keyboard, pointer and motion events. Runs untimed before each
+// pollEvents() call so every iteration drains a full batch.
+void pushEventBatch() {
+  for (std::uint64_t index = 0; index < kEventsPerBatch; ++index) {
+    SDL_Event event{};
+    switch (index % 4) {
+    case 0:
+    case 1:
+      event.type = (index % 4) == 0 ? SDL_KEYDOWN : SDL_KEYUP;
+      event.key.keysym.sym = static_cast<SDL_Keycode>('a' + (index % 26));
+      event.key.state = event.type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+      break;
+    case 2:
+      event.type = SDL_MOUSEBUTTONDOWN;
+      event.button.button = SDL_BUTTON_LEFT;
+      event.button.state = SDL_PRESSED;
+      event.button.x = static_cast<int>(index);
+      event.button.y = static_cast<int>(index / 2);
+      break;
+    default:
+      event.type = SDL_MOUSEMOTION;
+      event.motion.x = static_cast<int>(index);
+      event.motion.y = static_cast<int>(index / 2);
+      break;
+    }
+    if (SDL_PushEvent(&event) < 0) {
+      throw std::runtime_error(std::string{"SDL_PushEvent failed: "} + SDL_GetError());
+    }
+  }
+}
+
+} // namespace
+
+void registerPlatformEventBenchmarks(BenchmarkRegistry& registry, const BenchmarkOptions& /*options*/) {
+  registry.add(BenchmarkCase{"platform/sdl/pollEvents/" + std::to_string(kEventsPerBatch), kEventsPerBatch, [] {
+                               // The dummy video driver lets the benchmark run on headless machines.
+#if defined(_WIN32)
+                               _putenv_s("SDL_VIDEODRIVER", "dummy");
+#else
+                               setenv("SDL_VIDEODRIVER", "dummy", 0);
+#endif
+                               std::shared_ptr<platform::IPlatformBackend> backend = platform::createPlatformBackend();
+                               auto queue = std::make_shared<platform::PlatformEventQueue>();
+                               queue->reserve(kEventsPerBatch);
+                               return BenchmarkBody{[backend, queue] {
+                                                      backend->windowSystem().pollEvents(*queue);
+                                                      doNotOptimize(queue->size());
+                                                    },
+                                                    [queue] {
+                                                      queue->clear();
+                                                      pushEventBatch();
+                                                    }};
+                             }});
+
+  // Same batch through the lock-free ring, drained by InputFrameState as a frame would. Motion
+  // events are coalesced, so fewer events than pushed reach the frame.
+  registry.add(BenchmarkCase{"platform/sdl/pollEvents/ring/" + std::to_string(kEventsPerBatch), kEventsPerBatch, [] {
+#if defined(_WIN32)
+                               _putenv_s("SDL_VIDEODRIVER", "dummy");
+#else
+                               setenv("SDL_VIDEODRIVER", "dummy", 0);
+#endif
+                               std::shared_ptr<platform::IPlatformBackend> backend = platform::createPlatformBackend();
+                               auto ring = std::make_shared<platform::PlatformEventRing>(kEventsPerBatch);
+                               auto state = std::make_shared<platform::InputFrameState>();
+                               return BenchmarkBody{[backend, ring, state] {
+                                                      doNotOptimize(backend->windowSystem().pollEvents(*ring));
+                                                      state->beginFrame(*ring);
+                                                      doNotOptimize(state->events().size());
+                                                    },
+                                                    [] { pushEventBatch(); }};
+                             }});
+}
+
+} // namespace engine::benchmarks
@@ -0,0 +1,148 @@
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchmarkHarness.hpp"
+#include "SceneMath.hpp"
+
+namespace engine::benchmarks {
+namespace {
+
+using sample::rendering::Mat4;
+using sample::rendering::PickBounds;
+using sample::rendering::Vec3;
+
+constexpr std::uint64_t kBatch = 1024;
+
+// Random AABBs scattered in a cube around the origin, as the picking path would see them.
+[[nodiscard]] std::vector<PickBounds> makeScatteredBounds(const std::uint64_t count) {
+  std::mt19937 random{1234};
+  std::uniform_real_distribution<float> position{-100.0f, 100.0f};
+  std::uniform_real_distribution<float> extent{0.1f, 2.0f};
+
+  std::vector<PickBounds> bounds;
+  bounds.reserve(count);
+  for (std::uint64_t index = 0; index < count; ++index) {
+    const Vec3 center{position(random), position(random), position(random)};
+    const Vec3 half{extent(random), extent(random), extent(random)};
+    bounds.push_back(PickBounds{static_cast<std::uint32_t>(index), center - half, center + half});
+  }
+  return bounds;
+}
+
+[[nodiscard]] std::vector<Vec3> makeRayDirections(const std::uint64_t count) {
+  std::mt19937 random{99};
+  std::uniform_real_distribution<float> component{-1.0f, 1.0f};
+  std::vector<Vec3> directions;
+  directions.reserve(count);
+  for (std::uint64_t index = 0; index < count; ++index) {
+    directions.push_back(sample::rendering::normalize({component(random), component(random), component(random) - 1.5f}));
+  }
+  return directions;
+}
+
+[[nodiscard]] std::string countLabel(const std::uint64_t count) {
+  return count >= 1'000'000 ? std::to_string(count / 1'000'000) + "M" : std::to_string(count / 1'000) + "K";
+}
+
+} // namespace
+
+void registerSceneMathBenchmarks(BenchmarkRegistry& registry, const BenchmarkOptions& /*options*/) {
+  registry.add(BenchmarkCase{"math/multiply", kBatch, [] {
+                               auto matrices = std::make_shared<std::vector<Mat4>>(kBatch + 1);
+                               for (std::uint64_t index = 0; index <= kBatch; ++index) {
+                                 (*matrices)[index] = sample::rendering::multiply(
+                                     sample::rendering::translate(static_cast<float>(index), 1.0f, 2.0f),
+                                     sample::rendering::rotateY(static_cast<float>(index) * 0.01f));
+                               }
+                               return BenchmarkBody{[matrices] {
+                                                      for (std::uint64_t index = 0; index < kBatch; ++index) {
+                                                        const Mat4 product = sample::rendering::multiply(
+                                                            (*matrices)[index], (*matrices)[index + 1]);
+                                                        doNotOptimize(product);
+                                                      }
+                                                    },
+                                                    {}};
+                             }});
+
+  registry.add(BenchmarkCase{"math/lookAt", kBatch, [] {
+                               auto eyes = std::make_shared<std::vector<Vec3>>(makeRayDirections(kBatch));
+                               return BenchmarkBody{[eyes] {
+                                                      for (const Vec3& eye : *eyes) {
+                                                        const Mat4 view = sample::rendering::lookAt(
+                                                            eye * 10.0f, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f});
+                                                        doNotOptimize(view);
+                                                      }
+                                                    },
+                                                    {}};
+                             }});
+
+  registry.add(BenchmarkCase{"math/perspective", kBatch, [] {
+                               return BenchmarkBody{[] {
+                                                      for (std::uint64_t index = 0; index < kBatch; ++index) {
+                                                        const Mat4 projection = sample::rendering::perspective(
+                                                            0.5f + static_cast<float>(index) * 0.001f, 16.0f / 9.0f, 0.1f, 150.0f);
+                                                        doNotOptimize(projection);
+                                                      }
+                                                    },
+                                                    {}};
+                             }});
+
+  // The per-mesh transform chain renderScene builds every frame.
+  registry.add(BenchmarkCase{"math/modelViewProjection", kBatch, [] {
+                               return BenchmarkBody{[] {
+                                                      const Mat4 view = sample::rendering::lookAt(
+                                                          {0.0f, 2.0f, 5.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f});
+                                                      const Mat4 projection =
+                                                          sample::rendering::perspective(1.047f, 16.0f / 9.0f, 0.1f, 150.0f);
+                                                      const Mat4 viewProjection = sample::rendering::multiply(projection, view);
+                                                      for (std::uint64_t index = 0; index < kBatch; ++index) {
+                                                        const float offset = static_cast<float>(index);
+                                                        const Mat4 model = sample::rendering::multiply(
+                                                            sample::rendering::translate(offset, 0.0f, -offset),
+                                                            sample::rendering::multiply(sample::rendering::rotateY(offset * 0.01f),
+                                                                                        sample::rendering::scaleUniform(1.5f)));
+                                                        doNotOptimize(sample::rendering::multiply(viewProjection, model));
+                                                      }
+                                                    },
+                                                    {}};
+                             }});
+
+  registry.add(BenchmarkCase{"picking/rayIntersectsAabb", kBatch, [] {
+                               auto bounds = std::make_shared<std::vector<PickBounds>>(makeScatteredBounds(kBatch));
+                               return BenchmarkBody{[bounds] {
+                                                      const Vec3 origin{0.0f, 0.0f, 150.0f};
+                                                      const Vec3 direction{0.0f, 0.0f, -1.0f};
+                                                      std::uint32_t hits = 0;
+                                                      for (const PickBounds& box : *bounds) {
+                                                        float distance = 0.0f;
+                                                        hits += sample::rendering::rayIntersectsAabb(
+                                                                    origin, direction, box.minBounds, box.maxBounds, distance)
+                                                                    ? 1U
+                                                                    : 0U;
+                                                      }
+                                                      doNotOptimize(hits);
+                                                    },
+                                                    {}};
+                             }});
+
+  for (const std::uint64_t count : {std::uint64_t{1'000}, std::uint64_t{10'000}, std::uint64_t{100'000}, std::uint64_t{1'000'000}}) {
+    registry.add(BenchmarkCase{"picking/pickClosest/" + countLabel(count), count, [count] {
+                                 auto bounds = std::make_shared<std::vector<PickBounds>>(makeScatteredBounds(count));
+                                 auto directions = std::make_shared<std::vector<Vec3>>(makeRayDirections(64));
+                                 auto next = std::make_shared<std::size_t>(0);
+                                 return BenchmarkBody{[bounds, directions, next] {
+                                                        const Vec3 direction = (*directions)[(*next)++ % directions->size()];
+                                                        const auto picked = sample::rendering::pickClosest(
+                                                            {0.0f, 0.0f, 150.0f}, direction, *bounds,
+                                                            [](const PickBounds& box) { return box; });
+                                                        doNotOptimize(picked);
+                                                      },
+                                                      {}};
+                               }});
+  }
+}
+
+} // namespace engine::benchmarks
@@ -0,0 +1,42 @@
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "ContractTests.hpp"
+#include "engine/render/RenderBackendFactory.hpp"
+
+// Runs the contract suites against the backends named with --backend=<name> (repeatable), or
+// against every backend that works without a GPU when none is given.
+int main(int argc, char** argv) {
+  using engine::render::RenderBackendType;
+
+  std::vector<RenderBackendType> backends;
+  bool badBackend = false;
+  const auto options = engine::tests::parseTestOptions(argc, argv, [&](const std::string_view argument) {
+    if (!argument.starts_with("--backend=")) {
+      return false;
+    }
+    const std::optional<RenderBackendType> backend = engine::render::parseRenderBackendType(argument.substr(10));
+    if (!backend.has_value() || *backend == RenderBackendType::Auto) {
+      std::cerr << "Unknown render backend '" << argument.substr(10) << "'\n";
+      badBackend = true;
+      return false;
+    }
+    backends.push_back(*backend);
+    return true;
+  });
+  if (!options.has_value() || badBackend) {
+    std::cerr << "Usage: engine_contract_tests [--backend=null|software]... [--filter=<substring>] [--list]\n";
+    return 2;
+  }
+  if (backends.empty()) {
+    backends = {RenderBackendType::Null, RenderBackendType::Software};
+  }
+
+  engine::tests::TestRegistry registry;
+  for (const RenderBackendType backend : backends) {
+    engine::tests::registerRenderDeviceContractTests(registry, backend);
+  }
+  return engine::tests::runTestMain(registry, *options);
+}
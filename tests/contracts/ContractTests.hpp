@@ -0,0 +1,12 @@
+#pragma once
+
+#include "TestHarness.hpp"
+#include "engine/render/RenderTypes.hpp"
+
+namespace engine::tests {
+
+// IRenderDevice/ICommandContext behaviour every render backend must share. Cases are named
+// "<backend>/<case>" after IRenderBackend::name().
+void registerRenderDeviceContractTests(TestRegistry& registry, render::RenderBackendType backend);
+
+} // namespace engine::tests
@@ -0,0 +1,437 @@
+#include <algorithm>
+#include <cctype>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ContractTests.hpp"
+#include "engine/render/ICommandContext.hpp"
+#include "engine/render/IRenderBackend.hpp"
+#include "engine/render/IRenderDevice.hpp"
+#include "engine/render/RenderBackendFactory.hpp"
+
+namespace engine::tests {
+namespace {
+
+using namespace engine::render;
+
+// Vertices use the layout the sample meshes share: position[3], normal[3], uv[2].
+constexpr std::size_t kFloatsPerVertex = 8;
+constexpr std::uint32_t kVertexCount = 9;
+// Bounds the polling loops for devices that build pipelines in the background.
+constexpr int kMaxPolls = 100000;
+
+struct DeviceFixture {
+  explicit DeviceFixture(const RenderBackendType type)
+      : backend(createRenderBackend(type)), device(backend->createDevice()), context(device->createCommandContext()) {}
+
+  std::unique_ptr<IRenderBackend> backend;
+  std::unique_ptr<IRenderDevice> device;
+  std::unique_ptr<ICommandContext> context;
+};
+
+struct TestPipeline {
+  ShaderHandle vertexShader{};
+  ShaderHandle fragmentShader{};
+  PipelineHandle pipeline{};
+};
+
+[[nodiscard]] std::optional<RenderResourceInfo> findResource(const IRenderDevice& device,
+                                                             const RenderResourceKind kind,
+                                                             const std::uint32_t id) {
+  for (RenderResourceInfo& info : device.resources()) {
+    if (info.kind == kind && info.id == id) {
+      return std::move(info);
+    }
+  }
+  return std::nullopt;
+}
+
+[[nodiscard]] PipelineStatus waitForPipeline(IRenderDevice& device, const PipelineHandle pipeline) {
+  PipelineStatus status = device.pipelineStatus(pipeline);
+  for (int poll = 0; status == PipelineStatus::Pending && poll < kMaxPolls; ++poll) {
+    std::this_thread::yield();
+    status = device.pipelineStatus(pipeline);
+  }
+  return status;
+}
+
+[[nodiscard]] TestPipeline createTrianglePipeline(IRenderDevice& device) {
+  TestPipeline result{};
+  ShaderCreateInfo vertexInfo{};
+  vertexInfo.stage = ShaderStage::Vertex;
+  vertexInfo.debugName = "contract vertex";
+  ShaderCreateInfo fragmentInfo{};
+  fragmentInfo.stage = ShaderStage::Fragment;
+  fragmentInfo.debugName = "contract fragment";
+  result.vertexShader = device.createShader(vertexInfo);
+  result.fragmentShader = device.createShader(fragmentInfo);
+
+  GraphicsPipelineCreateInfo pipelineInfo{};
+  pipelineInfo.vertexShader = result.vertexShader;
+  pipelineInfo.fragmentShader = result.fragmentShader;
+  pipelineInfo.debugName = "contract pipeline";
+  result.pipeline = device.createGraphicsPipeline(pipelineInfo);
+  ENGINE_CHECK(waitForPipeline(device, result.pipeline) == PipelineStatus::Ready);
+  return result;
+}
+
+// Three small triangles inside the default view volume.
+[[nodiscard]] BufferHandle createVertexBuffer(IRenderDevice& device) {
+  std::array<float, kFloatsPerVertex * kVertexCount> vertices{};
+  const float positions[kVertexCount][2] = {{-0.9f, -0.9f}, {-0.5f, -0.9f}, {-0.9f, -0.5f},
+                                            {0.1f, 0.1f},   {0.5f, 0.1f},   {0.1f, 0.5f},
+                                            {-0.5f, 0.2f},  {-0.1f, 0.2f},  {-0.5f, 0.6f}};
+  for (std::uint32_t vertex = 0; vertex < kVertexCount; ++vertex) {
+    float* out = vertices.data() + vertex * kFloatsPerVertex;
+    out[0] = positions[vertex][0];
+    out[1] = positions[vertex][1];
+    out[5] = 1.0f;
+  }
+
+  BufferCreateInfo createInfo{};
+  createInfo.sizeBytes = sizeof(vertices);
+  createInfo.usage = BufferUsage::Vertex;
+  createInfo.initialData = reinterpret_cast<const std::byte*>(vertices.data());
+  createInfo.debugName = "contract vertices";
+  return device.createBuffer(createInfo);
+}
+
+[[nodiscard]] BufferHandle createIndexBuffer(IRenderDevice& device) {
+  const std::array<std::uint32_t, kVertexCount> indices{0, 1, 2, 3, 4, 5, 6, 7, 8};
+  BufferCreateInfo createInfo{};
+  createInfo.sizeBytes = sizeof(indices);
+  createInfo.usage = BufferUsage::Index;
+  createInfo.initialData = reinterpret_cast<const std::byte*>(indices.data());
+  createInfo.debugName = "contract indices";
+  return device.createBuffer(createInfo);
+}
+
+[[nodiscard]] TextureCreateInfo textureInfo(const std::uint32_t firstResidentMip) {
+  TextureCreateInfo createInfo{};
+  createInfo.format = TextureFormat::RGBA8;
+  createInfo.extent = {16, 16};
+  createInfo.mipLevels = 3;
+  createInfo.firstResidentMip = firstResidentMip;
+  createInfo.debugName = "contract texture";
+  return createInfo;
+}
+
+void bufferLifetime(const RenderBackendType type) {
+  DeviceFixture fixture{type};
+  IRenderDevice& device = *fixture.device;
+
+  BufferCreateInfo createInfo{};
+  createInfo.sizeBytes = 256;
+  createInfo.usage = BufferUsage::Uniform;
+  createInfo.cpuVisible = true;
+  createInfo.debugName = "contract uniforms";
+  const BufferHandle first = device.createBuffer(createInfo);
+  createInfo.debugName = "contract uniforms 2";
+  const BufferHandle second = device.createBuffer(createInfo);
+  ENGINE_CHECK(first.id != 0 && second.id != 0 && first.id != second.id);
+
+  const std::optional<RenderResourceInfo> info = findResource(device, RenderResourceKind::Buffer, first.id);
+  ENGINE_CHECK(info.has_value());
+  ENGINE_CHECK(info->debugName == "contract uniforms");
+  ENGINE_CHECK(info->sizeBytes == 256);
+  ENGINE_CHECK(info->usage == BufferUsage::Uniform);
+
+  std::array<std::byte, 64> data{};
+  device.updateBuffer(first, 192, data);
+  ENGINE_CHECK_THROWS(device.updateBuffer(first, 193, data));
+  ENGINE_CHECK_THROWS(device.updateBuffer(BufferHandle{second.id + 1000}, 0, data));
+
+  device.destroyBuffer(first);
+  ENGINE_CHECK(!findResource(device, RenderResourceKind::Buffer, first.id).has_value());
+  ENGINE_CHECK(findResource(device, RenderResourceKind::Buffer, second.id).has_value());
+  ENGINE_CHECK_THROWS(device.updateBuffer(first, 0, data));
+  // Destroying an unknown handle is ignored.
+  device.destroyBuffer(first);
+  device.destroyBuffer(second);
+  ENGINE_CHECK(!findResource(device, RenderResourceKind::Buffer, second.id).has_value());
+}
+
+void queuedUploadsComplete(const RenderBackendType type) {
+  DeviceFixture fixture{type};
+  IRenderDevice& device = *fixture.device;
+  BufferCreateInfo createInfo{};
+  createInfo.sizeBytes = 1024;
+  createInfo.usage = BufferUsage::Vertex;
+  const BufferHandle buffer = device.createBuffer(createInfo);
+
+  const std::vector<std::byte> data(512, std::byte{0x5A});
+  const UploadTicket ticket = device.queueBufferUpload(buffer, 512, data);
+  ENGINE_CHECK_THROWS((void)device.queueBufferUpload(buffer, 513, data));
+
+  bool complete = false;
+  for (std::uint64_t frame = 0; frame < 16 && !complete; ++frame) {
+    fixture.context->beginFrame({frame, {64, 64}});
+    fixture.context->endFrame();
+    complete = device.uploadComplete(ticket);
+  }
+  ENGINE_CHECK(complete);
+  device.destroyBuffer(buffer);
+}
+
+void transientAllocations(const RenderBackendType type) {
+  DeviceFixture fixture{type};
+  IRenderDevice& device = *fixture.device;
+
+  fixture.context->beginFrame({0, {64, 64}});
+  const TransientAllocation small = device.allocateTransient(64, 256);
+  ENGINE_CHECK(small.offset % 256 == 0);
+  ENGINE_CHECK(small.data.size() == 64);
+  std::memset(small.data.data(), 0xAB, small.data.size());
+  ENGINE_CHECK(findResource(device, RenderResourceKind::Buffer, small.buffer.id).has_value());
+  ENGINE_CHECK_THROWS((void)device.allocateTransient(std::uint64_t{1} << 40));
+  fixture.context->endFrame();
+
+  // Space is reclaimed once frames finish, so steady per-frame use never exhausts the ring.
+  for (std::uint64_t frame = 1; frame < 64; ++frame) {
+    fixture.context->beginFrame({frame, {64, 64}});
+    const TransientAllocation allocation = device.allocateTransient(std::uint64_t{1} << 20);
+    ENGINE_CHECK(allocation.data.size() == std::size_t{1} << 20);
+    std::memset(allocation.data.data(), 0, allocation.data.size());
+    fixture.context->endFrame();
+  }
+}
+
+void textureLifetime(const RenderBackendType type) {
+  DeviceFixture fixture{type};
+  IRenderDevice& device = *fixture.device;
+  ENGINE_CHECK(device.supportsTextureFormat(TextureFormat::RGBA8));
+
+  const TextureCreateInfo createInfo = textureInfo(1);
+  const TextureHandle texture = device.createTexture(createInfo);
+  std::optional<RenderResourceInfo> info = findResource(device, RenderResourceKind::Texture, texture.id);
+  ENGINE_CHECK(info.has_value());
+  ENGINE_CHECK(info->debugName == "contract texture");
+  ENGINE_CHECK(info->format == TextureFormat::RGBA8);
+  ENGINE_CHECK(info->extent.width == 16 && info->extent.height == 16);
+  ENGINE_CHECK(info->mipLevels == 3);
+  ENGINE_CHECK(info->firstResidentMip == 1);
+  // Devices may keep non-resident levels allocated, but never charge less than the resident ones.
+  ENGINE_CHECK(info->sizeBytes >= textureByteSize(createInfo, 1) && info->sizeBytes <= textureByteSize(createInfo));
+
+  const std::vector<std::byte> level2(textureMipByteSize(createInfo, 2));
+  device.updateTexture(texture, 2, level2);
+  ENGINE_CHECK_THROWS(device.updateTexture(texture, 1, level2));
+  ENGINE_CHECK_THROWS(device.updateTexture(texture, 3, level2));
+  ENGINE_CHECK_THROWS(device.updateTexture(TextureHandle{texture.id + 1000}, 2, level2));
+
+  const std::vector<std::byte> level0(textureMipByteSize(createInfo, 0));
+  device.updateTexture(texture, 0, level0);
+  device.setTextureResidency(texture, 0);
+  info = findResource(device, RenderResourceKind::Texture, texture.id);
+  ENGINE_CHECK(info.has_value() && info->firstResidentMip == 0);
+  ENGINE_CHECK(info->sizeBytes == textureByteSize(createInfo));
+  device.setTextureResidency(texture, 99);
+  info = findResource(device, RenderResourceKind::Texture, texture.id);
+  ENGINE_CHECK(info.has_value() && info->firstResidentMip == 2);
+
+  device.destroyTexture(texture);
+  ENGINE_CHECK(!findResource(device, RenderResourceKind::Texture, texture.id).has_value());
+  device.destroyTexture(texture);
+}
+
+void textureCreateClampsResidency(const RenderBackendType type) {
+  DeviceFixture fixture{type};
+  IRenderDevice& device = *fixture.device;
+  const TextureHandle texture = device.createTexture(textureInfo(10));
+  const std::optional<RenderResourceInfo> info = findResource(device, RenderResourceKind::Texture, texture.id);
+  ENGINE_CHECK(info.has_value() && info->firstResidentMip == 2);
+
+  TextureCreateInfo singleLevel = textureInfo(0);
+  singleLevel.mipLevels = 0;
+  const TextureHandle single = device.createTexture(singleLevel);
+  const std::optional<RenderResourceInfo> singleInfo = findResource(device, RenderResourceKind::Texture, single.id);
+  ENGINE_CHECK(singleInfo.has_value() && singleInfo->mipLevels == 1);
+  device.destroyTexture(texture);
+  device.destroyTexture(single);
+}
+
+void unsupportedTextureFormatsThrow(const RenderBackendType type) {
+  DeviceFixture fixture{type};
+  IRenderDevice& device = *fixture.device;
+  for (const TextureFormat format : {TextureFormat::BC1, TextureFormat::BC1RGB, TextureFormat::BC3, TextureFormat::BC5,
+                                     TextureFormat::BC7, TextureFormat::ETC2RGB8, TextureFormat::ETC2RGBA8}) {
+    TextureCreateInfo createInfo = textureInfo(0);
+    createInfo.format = format;
+    if (device.supportsTextureFormat(format)) {
+      device.destroyTexture(device.createTexture(createInfo));
+    } else {
+      ENGINE_CHECK_THROWS((void)device.createTexture(createInfo));
+    }
+  }
+}
+
+void pipelineLifetime(const RenderBackendType type) {
+  DeviceFixture fixture{type};
+  IRenderDevice& device = *fixture.device;
+  const TestPipeline test = createTrianglePipeline(device);
+
+  const std::optional<RenderResourceInfo> vertexShader = findResource(device, RenderResourceKind::Shader, test.vertexShader.id);
+  ENGINE_CHECK(vertexShader.has_value() && vertexShader->stage == ShaderStage::Vertex);
+  ENGINE_CHECK(vertexShader->debugName == "contract vertex");
+  const std::optional<RenderResourceInfo> pipeline = findResource(device, RenderResourceKind::Pipeline, test.pipeline.id);
+  ENGINE_CHECK(pipeline.has_value() && pipeline->debugName == "contract pipeline");
+
+  ENGINE_CHECK(device.pipelineStatus(PipelineHandle{test.pipeline.id + 1000}) == PipelineStatus::Failed);
+  GraphicsPipelineCreateInfo missingShaders{};
+  missingShaders.vertexShader = ShaderHandle{test.vertexShader.id + 1000};
+  missingShaders.fragmentShader = test.fragmentShader;
+  ENGINE_CHECK_THROWS((void)device.createGraphicsPipeline(missingShaders));
+
+  device.destroyPipeline(test.pipeline);
+  ENGINE_CHECK(device.pipelineStatus(test.pipeline) == PipelineStatus::Failed);
+  ENGINE_CHECK(!findResource(device, RenderResourceKind::Pipeline, test.pipeline.id).has_value());
+  device.destroyShader(test.vertexShader);
+  device.destroyShader(test.fragmentShader);
+  ENGINE_CHECK(!findResource(device, RenderResourceKind::Shader, test.vertexShader.id).has_value());
+}
+
+void drawStats(const RenderBackendType type) {
+  DeviceFixture fixture{type};
+  IRenderDevice& device = *fixture.device;
+  ICommandContext& context = *fixture.context;
+  const TestPipeline test = createTrianglePipeline(device);
+  const BufferHandle vertices = createVertexBuffer(device);
+  const BufferHandle indices = createIndexBuffer(device);
+
+  context.beginFrame({7, {64, 64}});
+  context.bindPipeline(test.pipeline);
+  context.bindVertexBuffer(vertices);
+  context.bindIndexBuffer(indices);
+  context.drawIndexed(kVertexCount);
+  context.draw(6);
+  // Every instance counts; zero instances draw nothing.
+  context.draw(3, 4);
+  context.draw(3, 0);
+  context.endFrame();
+
+  RenderFrameStats stats = device.frameStats();
+  ENGINE_CHECK(stats.frameIndex == 7);
+  ENGINE_CHECK(stats.drawCalls == 3);
+  ENGINE_CHECK(stats.triangles == 9);
+  ENGINE_CHECK(stats.pipelineBinds == 1);
+  ENGINE_CHECK(stats.drawsSkipped == 0);
+
+  // Stats describe the latest frame only.
+  context.beginFrame({8, {64, 64}});
+  context.endFrame();
+  stats = device.frameStats();
+  ENGINE_CHECK(stats.frameIndex == 8);
+  ENGINE_CHECK(stats.drawCalls == 0 && stats.triangles == 0 && stats.pipelineBinds == 0);
+
+  device.destroyBuffer(vertices);
+  device.destroyBuffer(indices);
+  device.destroyPipeline(test.pipeline);
+}
+
+void drawsWithoutReadyPipelineAreSkipped(const RenderBackendType type) {
+  DeviceFixture fixture{type};
+  IRenderDevice& device = *fixture.device;
+  ICommandContext& context = *fixture.context;
+  const TestPipeline test = createTrianglePipeline(device);
+  const BufferHandle vertices = createVertexBuffer(device);
+  const BufferHandle indices = createIndexBuffer(device);
+
+  context.beginFrame({0, {64, 64}});
+  context.bindVertexBuffer(vertices);
+  context.bindIndexBuffer(indices);
+  context.bindPipeline(PipelineHandle{test.pipeline.id + 1000});
+  context.drawIndexed(kVertexCount);
+  context.draw(3);
+  context.bindPipeline(test.pipeline);
+  context.drawIndexed(3);
+  context.endFrame();
+
+  const RenderFrameStats stats = device.frameStats();
+  ENGINE_CHECK(stats.drawsSkipped == 2);
+  ENGINE_CHECK(stats.drawCalls == 1);
+  ENGINE_CHECK(stats.triangles == 1);
+  ENGINE_CHECK(stats.pipelineBinds == 2);
+
+  device.destroyBuffer(vertices);
+  device.destroyBuffer(indices);
+  device.destroyPipeline(test.pipeline);
+}
+
+// resources() and frameStats() are documented as safe to call from any thread while rendering.
+void introspectionWhileRendering(const RenderBackendType type) {
+  DeviceFixture fixture{type};
+  IRenderDevice& device = *fixture.device;
+  ICommandContext& context = *fixture.context;
+  const TestPipeline test = createTrianglePipeline(device);
+  const BufferHandle vertices = createVertexBuffer(device);
+  const BufferHandle indices = createIndexBuffer(device);
+
+  std::atomic<bool> done{false};
+  std::atomic<std::uint64_t> snapshots{0};
+  std::thread reader{[&] {
+    while (!done.load(std::memory_order_acquire)) {
+      const std::vector<RenderResourceInfo> resources = device.resources();
+      const RenderFrameStats stats = device.frameStats();
+      if (!resources.empty() && stats.drawCalls <= 1) {
+        snapshots.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }};
+
+  for (std::uint64_t frame = 0; frame < 32; ++frame) {
+    BufferCreateInfo scratchInfo{};
+    scratchInfo.sizeBytes = 64;
+    scratchInfo.debugName = "contract scratch";
+    const BufferHandle scratch = device.createBuffer(scratchInfo);
+    context.beginFrame({frame, {64, 64}});
+    context.bindPipeline(test.pipeline);
+    context.bindVertexBuffer(vertices);
+    context.bindIndexBuffer(indices);
+    context.drawIndexed(3);
+    context.endFrame();
+    device.destroyBuffer(scratch);
+  }
+  done.store(true, std::memory_order_release);
+  reader.join();
+
+  ENGINE_CHECK(device.frameStats().frameIndex == 31);
+  device.destroyBuffer(vertices);
+  device.destroyBuffer(indices);
+  device.destroyPipeline(test.pipeline);
+}
+
+} // namespace
+
+void registerRenderDeviceContractTests(TestRegistry& registry, const RenderBackendType backend) {
+  std::string prefix{createRenderBackend(backend)->name()};
+  std::transform(prefix.begin(), prefix.end(), prefix.begin(), [](const char c) { return static_cast<char>(std::tolower(c)); });
+  prefix += '/';
+
+  const std::pair<const char*, void (*)(RenderBackendType)> cases[] = {
+      {"buffer lifetime", bufferLifetime},
+      {"queued uploads complete", queuedUploadsComplete},
+      {"transient allocations", transientAllocations},
+      {"texture lifetime", textureLifetime},
+      {"texture creation clamps residency", textureCreateClampsResidency},
+      {"unsupported texture formats throw", unsupportedTextureFormatsThrow},
+      {"pipeline lifetime", pipelineLifetime},
+      {"draw stats", drawStats},
+      {"draws without a ready pipeline are skipped", drawsWithoutReadyPipelineAreSkipped},
+      {"introspection while rendering", introspectionWhileRendering},
+  };
+  for (const auto& [name, run] : cases) {
+    registry.add(prefix + name, [backend, run = run] { run(backend); });
+  }
+}
+
+} // namespace engine::tests
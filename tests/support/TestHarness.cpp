@@ -0,0 +1,67 @@
+#include "TestHarness.hpp"
+
+#include <exception>
+#include <iostream>
+
+namespace engine::tests {
+
+void failCheck(const char* file, const int line, const std::string& message) {
+  throw TestFailure{std::string{file} + ":" + std::to_string(line) + ": " + message};
+}
+
+std::size_t runTests(const TestRegistry& registry, const TestOptions& options, std::ostream& log) {
+  std::size_t run = 0;
+  std::size_t failed = 0;
+  for (const TestCase& testCase : registry.cases()) {
+    if (!options.filter.empty() && testCase.name.find(options.filter) == std::string::npos) {
+      continue;
+    }
+    ++run;
+    try {
+      testCase.run();
+      log << "[pass] " << testCase.name << '\n';
+    } catch (const std::exception& exception) {
+      ++failed;
+      log << "[FAIL] " << testCase.name << ": " << exception.what() << '\n';
+    } catch (...) {
+      ++failed;
+      log << "[FAIL] " << testCase.name << ": unknown exception\n";
+    }
+  }
+  log << run - failed << '/' << run << " test(s) passed\n";
+  return failed;
+}
+
+std::optional<TestOptions> parseTestOptions(const int argc,
+                                           char** argv,
+                                           const std::function<bool(std::string_view)>& extraArgument) {
+  TestOptions options{};
+  for (int index = 1; index < argc; ++index) {
+    const std::string_view argument{argv[index]};
+    if (argument.starts_with("--filter=")) {
+      options.filter = std::string{argument.substr(std::string_view{"--filter="}.size())};
+    } else if (argument == "--list") {
+      options.listOnly = true;
+    } else if (!extraArgument || !extraArgument(argument)) {
+      std::cerr << "Unknown argument '" << argument << "'\n";
+      return std::nullopt;
+    }
+  }
+  return options;
+}
+
+int runTestMain(const TestRegistry& registry, const TestOptions& options) {
+  if (options.listOnly) {
+    for (const TestCase& testCase : registry.cases()) {
+      std::cout << testCase.name << '\n';
+    }
+    return 0;
+  }
+  if (registry.cases().empty()) {
+    std::cerr << "No tests registered\n";
+    return 1;
+  }
+  return runTests(registry, options, std::cout) == 0 ? 0 : 1;
+}
+
+} // namespace engine::tests
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace engine::tests {
+
+// Thrown by the ENGINE_CHECK macros; the runner reports it and moves on to the next case.
+class TestFailure : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+struct TestCase {
+  std::string name;
+  std::function<void()> run;
+};
+
+class TestRegistry {
+public:
+  void add(std::string name, std::function<void()> run) { cases_.push_back(TestCase{std::move(name), std::move(run)}); }
+  [[nodiscard]] const std::vector<TestCase>& cases() const { return cases_; }
+
+private:
+  std::vector<TestCase> cases_;
+};
+
+struct TestOptions {
+  std::string filter;
+  bool listOnly = false;
+};
+
+[[noreturn]] void failCheck(const char* file, int line, const std::string& message);
+
+// Runs every case whose name contains options.filter and returns the number that failed. A case
+// fails when it throws anything, including TestFailure from a check.
+[[nodiscard]] std::size_t runTests(const TestRegistry& registry, const TestOptions& options, std::ostream& log);
+
+// Parses --filter=<substring> and --list. Any other argument is offered to extraArgument, which
+// returns false to reject it. Returns std::nullopt after reporting a rejected argument.
+[[nodiscard]] std::optional<TestOptions> parseTestOptions(int argc,
+                                                          char** argv,
+                                                          const std::function<bool(std::string_view)>& extraArgument = {});
+
+// Lists or runs the registry as options ask and returns the process exit code.
+[[nodiscard]] int runTestMain(const TestRegistry& registry, const TestOptions& options);
+
+} // namespace engine::tests
+
+#define ENGINE_CHECK(condition) \
+  do { \
+    if (!(condition)) { \
+      ::engine::tests::failCheck(__FILE__, __LINE__, "ENGINE_CHECK(" #condition ") failed"); \
+    } \
+  } while (false)
+
+// Passes when expression throws std::runtime_error, the engine's error type.
+#define ENGINE_CHECK_THROWS(expression) \
+  do { \
+    bool engineCheckThrew = false; \
+    try { \
+      static_cast<void>(expression); \
+    } catch (const std::runtime_error&) { \
+      engineCheckThrew = true; \
+    } \
+    if (!engineCheckThrew) { \
+      ::engine::tests::failCheck(__FILE__, __LINE__, "ENGINE_CHECK_THROWS(" #expression ") did not throw"); \
+    } \
+  } while (false)
@@ -0,0 +1,149 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "UnitTests.hpp"
+#include "engine/render/CommandCapture.hpp"
+#include "engine/render/ICommandContext.hpp"
+#include "engine/render/IRenderBackend.hpp"
+#include "engine/render/RenderBackendFactory.hpp"
+
+namespace engine::tests {
+namespace {
+
+using namespace engine::render;
+
+// Removes the capture file when the test ends, pass or fail.
+class TemporaryCapturePath {
+public:
+  explicit TemporaryCapturePath(const std::string& name)
+      : path_(std::filesystem::temp_directory_path() / ("engine_unit_tests_" + name + ".engcap")) {}
+  TemporaryCapturePath(const TemporaryCapturePath&) = delete;
+  TemporaryCapturePath& operator=(const TemporaryCapturePath&) = delete;
+  ~TemporaryCapturePath() {
+    std::error_code error;
+    std::filesystem::remove(path_, error);
+  }
+
+  [[nodiscard]] const std::filesystem::path& path() const { return path_; }
+
+private:
+  std::filesystem::path path_;
+};
+
+[[nodiscard]] std::unique_ptr<IRenderDevice> createNullDevice() {
+  return createRenderBackend(RenderBackendType::Null)->createDevice();
+}
+
+void recordTwoFrames(IRenderDevice& device) {
+  ShaderCreateInfo vertexInfo{};
+  vertexInfo.stage = ShaderStage::Vertex;
+  ShaderCreateInfo fragmentInfo{};
+  fragmentInfo.stage = ShaderStage::Fragment;
+  GraphicsPipelineCreateInfo pipelineInfo{};
+  pipelineInfo.vertexShader = device.createShader(vertexInfo);
+  pipelineInfo.fragmentShader = device.createShader(fragmentInfo);
+  pipelineInfo.debugName = "captured pipeline";
+  const PipelineHandle pipeline = device.createGraphicsPipeline(pipelineInfo);
+
+  const std::array<float, 24> vertices{};
+  BufferCreateInfo bufferInfo{};
+  bufferInfo.sizeBytes = sizeof(vertices);
+  bufferInfo.initialData = reinterpret_cast<const std::byte*>(vertices.data());
+  const BufferHandle buffer = device.createBuffer(bufferInfo);
+
+  const std::unique_ptr<ICommandContext> context = device.createCommandContext();
+  for (std::uint64_t frame = 0; frame < 2; ++frame) {
+    context->beginFrame({frame, {32, 32}});
+    const TransientAllocation uniforms = device.allocateTransient(64, 256);
+    uniforms.data[0] = std::byte{0x7F};
+    context->bindPipeline(pipeline);
+    context->bindVertexBuffer(buffer);
+    context->bindUniformBuffer(0, uniforms.buffer, uniforms.offset, 64);
+    context->draw(3);
+    context->draw(6, 2);
+    context->endFrame();
+  }
+  device.destroyBuffer(buffer);
+}
+
+void roundTripReplaysFrames() {
+  const TemporaryCapturePath file{"round_trip"};
+  {
+    const std::unique_ptr<IRenderDevice> capturing = createCapturingRenderDevice(createNullDevice(), file.path());
+    recordTwoFrames(*capturing);
+  }
+
+  const CommandCapture capture = CommandCapture::load(file.path());
+  ENGINE_CHECK(capture.frameCount() == 2);
+  ENGINE_CHECK(capture.commandCount() > 0);
+
+  const std::unique_ptr<IRenderDevice> device = createNullDevice();
+  const CommandReplayResult result = capture.replay(*device);
+  ENGINE_CHECK(result.frames.size() == 2);
+  for (std::uint64_t frame = 0; frame < 2; ++frame) {
+    ENGINE_CHECK(result.frames[frame].frameIndex == frame);
+    ENGINE_CHECK(result.frames[frame].drawCalls == 2);
+  }
+  // Replay destroys what the capture left alive; only the null device's transient ring remains.
+  ENGINE_CHECK(device->resources().size() <= 1);
+}
+
+// Hand-written version-2 capture holding one Transient record: opcode 4, context 0, then size,
+// alignment, buffer and offset as single-byte varints and a length-prefixed payload.
+void writeTransientCapture(const std::filesystem::path& path,
+                           const std::uint8_t sizeBytes,
+                           const std::uint8_t alignment,
+                           const std::uint8_t payloadBytes) {
+  std::vector<char> bytes{'E', 'N', 'G', 'C', 'A', 'P', 'T', '\0', 2};
+  const std::array<char, 7> record{4, 0, static_cast<char>(sizeBytes), static_cast<char>(alignment), 1, 0,
+                                   static_cast<char>(payloadBytes)};
+  bytes.insert(bytes.end(), record.begin(), record.end());
+  bytes.insert(bytes.end(), payloadBytes, '\x5A');
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Regression: load() accepted a Transient record whose payload was larger than its range, and
+// replay() copied the payload past the end of the range it allocated.
+void transientPayloadMustMatchRange() {
+  const TemporaryCapturePath file{"transient"};
+  writeTransientCapture(file.path(), 16, 16, 16);
+  ENGINE_CHECK(CommandCapture::load(file.path()).commandCount() == 1);
+
+  writeTransientCapture(file.path(), 8, 16, 64);
+  ENGINE_CHECK_THROWS(CommandCapture::load(file.path()));
+  writeTransientCapture(file.path(), 16, 16, 8);
+  ENGINE_CHECK_THROWS(CommandCapture::load(file.path()));
+  writeTransientCapture(file.path(), 16, 3, 16);
+  ENGINE_CHECK_THROWS(CommandCapture::load(file.path()));
+  writeTransientCapture(file.path(), 16, 0, 16);
+  ENGINE_CHECK_THROWS(CommandCapture::load(file.path()));
+}
+
+// Every record is at least two bytes, so dropping the last byte always cuts one short.
+void truncatedCaptureThrows() {
+  const TemporaryCapturePath file{"truncated"};
+  {
+    const std::unique_ptr<IRenderDevice> capturing = createCapturingRenderDevice(createNullDevice(), file.path());
+    recordTwoFrames(*capturing);
+  }
+  std::filesystem::resize_file(file.path(), std::filesystem::file_size(file.path()) - 1);
+  ENGINE_CHECK_THROWS(CommandCapture::load(file.path()));
+  ENGINE_CHECK_THROWS(CommandCapture::load(file.path().string() + ".missing"));
+}
+
+} // namespace
+
+void registerCommandCaptureTests(TestRegistry& registry) {
+  registry.add("CommandCapture/round trip replays frames", roundTripReplaysFrames);
+  registry.add("CommandCapture/transient payload must match range", transientPayloadMustMatchRange);
+  registry.add("CommandCapture/truncated capture throws", truncatedCaptureThrows);
+}
+
+} // namespace engine::tests
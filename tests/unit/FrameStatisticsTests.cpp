@@ -0,0 +1,49 @@
+#include <vector>
+
+#include "FrameStatistics.hpp"
+#include "UnitTests.hpp"
+
+namespace engine::tests {
+namespace {
+
+using sample::common::computePercentiles;
+using sample::common::Percentiles;
+
+void emptySetIsAllZero() {
+  const Percentiles result = computePercentiles({});
+  ENGINE_CHECK(result.mean == 0.0 && result.p50 == 0.0 && result.p95 == 0.0 && result.p99 == 0.0 && result.max == 0.0);
+}
+
+void nearestRankOnOneToHundred() {
+  std::vector<double> values;
+  for (int value = 100; value >= 1; --value) {
+    values.push_back(value);
+  }
+  const Percentiles result = computePercentiles(values);
+  ENGINE_CHECK(result.mean == 50.5);
+  ENGINE_CHECK(result.p50 == 50.0);
+  ENGINE_CHECK(result.p95 == 95.0);
+  ENGINE_CHECK(result.p99 == 99.0);
+  ENGINE_CHECK(result.max == 100.0);
+}
+
+// Nearest rank never interpolates: every percentile is one of the samples.
+void smallSetsUseSampleValues() {
+  const Percentiles three = computePercentiles({5.0, 1.0, 3.0});
+  ENGINE_CHECK(three.mean == 3.0);
+  ENGINE_CHECK(three.p50 == 3.0);
+  ENGINE_CHECK(three.p95 == 5.0 && three.p99 == 5.0 && three.max == 5.0);
+
+  const Percentiles single = computePercentiles({2.5});
+  ENGINE_CHECK(single.mean == 2.5 && single.p50 == 2.5 && single.p99 == 2.5 && single.max == 2.5);
+}
+
+} // namespace
+
+void registerFrameStatisticsTests(TestRegistry& registry) {
+  registry.add("FrameStatistics/empty set is all zero", emptySetIsAllZero);
+  registry.add("FrameStatistics/nearest rank on 1..100", nearestRankOnOneToHundred);
+  registry.add("FrameStatistics/small sets use sample values", smallSetsUseSampleValues);
+}
+
+} // namespace engine::tests
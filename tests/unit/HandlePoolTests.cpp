@@ -0,0 +1,88 @@
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "UnitTests.hpp"
+#include "engine/render/HandlePool.hpp"
+
+namespace engine::tests {
+namespace {
+
+using render::HandlePool;
+
+void insertFindErase() {
+  HandlePool<std::string> pool;
+  ENGINE_CHECK(pool.find(0) == nullptr);
+  const std::uint32_t first = pool.insert("first");
+  const std::uint32_t second = pool.insert("second");
+  ENGINE_CHECK(first != 0 && second != 0 && first != second);
+  ENGINE_CHECK(pool.size() == 2);
+  ENGINE_CHECK(pool.find(first) != nullptr && *pool.find(first) == "first");
+  ENGINE_CHECK(*std::as_const(pool).find(second) == "second");
+
+  ENGINE_CHECK(pool.erase(first));
+  ENGINE_CHECK(!pool.erase(first));
+  ENGINE_CHECK(!pool.erase(0));
+  ENGINE_CHECK(pool.find(first) == nullptr);
+  ENGINE_CHECK(pool.size() == 1);
+}
+
+void staleIdsDoNotAliasReusedSlots() {
+  HandlePool<int> pool;
+  const std::uint32_t stale = pool.insert(1);
+  ENGINE_CHECK(pool.erase(stale));
+  const std::uint32_t reused = pool.insert(2);
+  // Same slot, new generation.
+  ENGINE_CHECK((reused & render::kHandleIndexMask) == (stale & render::kHandleIndexMask));
+  ENGINE_CHECK(reused != stale);
+  ENGINE_CHECK(pool.find(stale) == nullptr);
+  ENGINE_CHECK(!pool.erase(stale));
+  ENGINE_CHECK(pool.find(reused) != nullptr && *pool.find(reused) == 2);
+  // Ids past the last slot are unknown.
+  ENGINE_CHECK(pool.find(reused + 1) == nullptr);
+}
+
+void forEachVisitsLiveEntriesInSlotOrder() {
+  HandlePool<int> pool;
+  std::vector<std::uint32_t> ids;
+  for (int value = 0; value < 5; ++value) {
+    ids.push_back(pool.insert(value));
+  }
+  ENGINE_CHECK(pool.erase(ids[1]));
+  ENGINE_CHECK(pool.erase(ids[3]));
+
+  std::vector<std::pair<std::uint32_t, int>> visited;
+  pool.forEach([&visited](const std::uint32_t id, const int value) { visited.emplace_back(id, value); });
+  const std::vector<std::pair<std::uint32_t, int>> expected{{ids[0], 0}, {ids[2], 2}, {ids[4], 4}};
+  ENGINE_CHECK(visited == expected);
+}
+
+void exhaustedSlotsAreRetired() {
+  HandlePool<int> pool;
+  std::uint32_t id = pool.insert(0);
+  const std::uint32_t slot = id & render::kHandleIndexMask;
+  for (std::uint32_t generation = 0; generation < render::kMaxHandleGeneration; ++generation) {
+    ENGINE_CHECK(pool.erase(id));
+    id = pool.insert(0);
+    ENGINE_CHECK((id & render::kHandleIndexMask) == slot);
+  }
+  ENGINE_CHECK(id >> render::kHandleIndexBits == render::kMaxHandleGeneration);
+
+  // The last generation is not recycled, so the next insert takes a fresh slot.
+  ENGINE_CHECK(pool.erase(id));
+  const std::uint32_t fresh = pool.insert(0);
+  ENGINE_CHECK((fresh & render::kHandleIndexMask) != slot);
+  ENGINE_CHECK(pool.find(id) == nullptr);
+}
+
+} // namespace
+
+void registerHandlePoolTests(TestRegistry& registry) {
+  registry.add("HandlePool/insert, find and erase", insertFindErase);
+  registry.add("HandlePool/stale ids do not alias reused slots", staleIdsDoNotAliasReusedSlots);
+  registry.add("HandlePool/forEach visits live entries in slot order", forEachVisitsLiveEntriesInSlotOrder);
+  registry.add("HandlePool/exhausted slots are retired", exhaustedSlotsAreRetired);
+}
+
+} // namespace engine::tests
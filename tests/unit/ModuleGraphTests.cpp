@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "UnitTests.hpp"
+#include "engine/modules/ModuleGraph.hpp"
+#include "engine/modules/ModuleManager.hpp"
+
+namespace engine::tests {
+namespace {
+
+using modules::ModuleDescriptor;
+using modules::ModuleGraph;
+using modules::ModuleHandle;
+
+constexpr modules::Version kApiVersion{1, 2, 0};
+
+[[nodiscard]] ModuleDescriptor descriptor(const std::string& id,
+                                          std::vector<std::string> dependencies = {},
+                                          std::vector<std::string> conflicts = {}) {
+  ModuleDescriptor result{};
+  result.id = id;
+  result.requiredApiVersion = kApiVersion;
+  result.dependencies = std::move(dependencies);
+  result.conflicts = std::move(conflicts);
+  return result;
+}
+
+// The two validators report errors in different orders.
+[[nodiscard]] std::vector<std::string> sorted(std::vector<std::string> errors) {
+  std::sort(errors.begin(), errors.end());
+  return errors;
+}
+
+// ModuleManager also reports a cycle whenever a missing dependency or duplicate id leaves modules out
+// of its startup order; ModuleGraph reports only real cycles.
+[[nodiscard]] std::vector<std::string> withoutCycle(std::vector<std::string> errors) {
+  std::erase(errors, std::string{"Module dependency cycle detected"});
+  return sorted(std::move(errors));
+}
+
+[[nodiscard]] std::size_t position(const std::vector<ModuleHandle>& order, const ModuleHandle handle) {
+  return static_cast<std::size_t>(std::find(order.begin(), order.end(), handle) - order.begin());
+}
+
+void matchesModuleManager() {
+  ModuleDescriptor incompatible = descriptor("legacy");
+  incompatible.requiredApiVersion = {2, 0, 0};
+  const std::vector<std::vector<ModuleDescriptor>> manifests{
+      {descriptor("platform"), descriptor("renderer", {"platform"}), descriptor("editor", {"renderer", "platform"})},
+      {descriptor("renderer", {"platform"})},
+      {incompatible, descriptor("platform")},
+      {descriptor("gl", {}, {"vulkan"}), descriptor("vulkan")},
+      {descriptor("a", {"b"}), descriptor("b", {"c"}), descriptor("c", {"a"}), descriptor("d")},
+      {descriptor("platform"), descriptor("platform")},
+  };
+
+  const modules::ModuleManager manager{kApiVersion};
+  ModuleGraph graph{kApiVersion};
+  for (const std::vector<ModuleDescriptor>& manifest : manifests) {
+    const modules::ValidationResult expected = manager.validate(manifest);
+    graph.assign(manifest);
+    const modules::ValidationResult& actual = graph.validate();
+    ENGINE_CHECK(actual.ok == expected.ok);
+    ENGINE_CHECK(withoutCycle(actual.errors) == withoutCycle(expected.errors));
+  }
+  // Only the manifest with a real cycle reports one.
+  graph.assign(manifests[4]);
+  ENGINE_CHECK(graph.validate().errors == std::vector<std::string>{"Module dependency cycle detected"});
+  graph.assign(manifests[1]);
+  ENGINE_CHECK(graph.validate().errors.size() == 1);
+}
+
+void orderAndWavesFollowDependencies() {
+  ModuleGraph graph{kApiVersion};
+  const std::vector<ModuleDescriptor> manifest{descriptor("editor", {"renderer", "platform"}), descriptor("renderer", {"platform"}),
+                                               descriptor("platform"), descriptor("audio")};
+  graph.assign(manifest);
+  ENGINE_CHECK(graph.validate().ok);
+
+  const std::vector<ModuleHandle>& order = graph.startupOrder();
+  ENGINE_CHECK(order.size() == 4);
+  for (const ModuleDescriptor& module : manifest) {
+    for (const std::string& dependency : module.dependencies) {
+      ENGINE_CHECK(position(order, *graph.handle(dependency)) < position(order, *graph.handle(module.id)));
+    }
+  }
+
+  const std::vector<std::vector<ModuleHandle>>& waves = graph.startupWaves();
+  ENGINE_CHECK(waves.size() == 3);
+  ENGINE_CHECK(waves[0].size() == 2);
+  ENGINE_CHECK(waves[1] == std::vector<ModuleHandle>{*graph.handle("renderer")});
+  ENGINE_CHECK(waves[2] == std::vector<ModuleHandle>{*graph.handle("editor")});
+}
+
+void changesRevalidateOnlyAffectedModules() {
+  ModuleGraph graph{kApiVersion};
+  std::vector<ModuleDescriptor> manifest;
+  for (int index = 0; index < 64; ++index) {
+    manifest.push_back(descriptor("module" + std::to_string(index)));
+  }
+  manifest.push_back(descriptor("consumer", {"module0"}));
+  graph.assign(manifest);
+  ENGINE_CHECK(graph.validate().ok);
+  ENGINE_CHECK(graph.lastRevalidatedCount() == manifest.size());
+
+  // Unchanged descriptors are no-ops.
+  graph.assign(manifest);
+  ENGINE_CHECK(graph.validate().ok);
+  ENGINE_CHECK(graph.lastRevalidatedCount() == manifest.size());
+
+  ModuleDescriptor changed = manifest[10];
+  changed.category = "audio";
+  graph.upsert(changed);
+  ENGINE_CHECK(graph.validate().ok);
+  ENGINE_CHECK(graph.lastRevalidatedCount() == 1);
+
+  // Removing a module rechecks only the modules that name it.
+  ENGINE_CHECK(graph.remove("module0"));
+  ENGINE_CHECK(!graph.remove("module0"));
+  const modules::ValidationResult& missing = graph.validate();
+  ENGINE_CHECK(!missing.ok);
+  ENGINE_CHECK(missing.errors == std::vector<std::string>{"Module 'consumer' is missing dependency 'module0'"});
+  ENGINE_CHECK(graph.lastRevalidatedCount() == 1);
+  ENGINE_CHECK(graph.moduleCount() == manifest.size() - 1);
+}
+
+void cyclesAppearAndClearIncrementally() {
+  ModuleGraph graph{kApiVersion};
+  std::vector<ModuleDescriptor> manifest;
+  for (int index = 0; index < 32; ++index) {
+    manifest.push_back(descriptor("module" + std::to_string(index), index == 0 ? std::vector<std::string>{} :
+                                                                                  std::vector<std::string>{"module" + std::to_string(index - 1)}));
+  }
+  graph.assign(manifest);
+  ENGINE_CHECK(graph.validate().ok);
+
+  graph.upsert(descriptor("module0", {"module31"}));
+  const modules::ValidationResult& cyclic = graph.validate();
+  ENGINE_CHECK(!cyclic.ok);
+  ENGINE_CHECK(cyclic.errors == std::vector<std::string>{"Module dependency cycle detected"});
+  ENGINE_CHECK(graph.startupOrder().empty());
+
+  graph.upsert(descriptor("module0"));
+  ENGINE_CHECK(graph.validate().ok);
+  ENGINE_CHECK(graph.startupOrder().size() == manifest.size());
+
+  graph.upsert(descriptor("module0", {"module31"}));
+  ENGINE_CHECK(!graph.validate().ok);
+  ENGINE_CHECK(graph.remove("module15"));
+  const modules::ValidationResult& broken = graph.validate();
+  ENGINE_CHECK(sorted(broken.errors) == std::vector<std::string>{"Module 'module16' is missing dependency 'module15'"});
+}
+
+} // namespace
+
+void registerModuleGraphTests(TestRegistry& registry) {
+  registry.add("ModuleGraph/matches ModuleManager", matchesModuleManager);
+  registry.add("ModuleGraph/order and waves follow dependencies", orderAndWavesFollowDependencies);
+  registry.add("ModuleGraph/changes revalidate only affected modules", changesRevalidateOnlyAffectedModules);
+  registry.add("ModuleGraph/cycles appear and clear incrementally", cyclesAppearAndClearIncrementally);
+}
+
+} // namespace engine::tests
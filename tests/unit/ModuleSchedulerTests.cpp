@@ -0,0 +1,203 @@
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "UnitTests.hpp"
+#include "engine/core/WorkerPool.hpp"
+#include "engine/modules/IModule.hpp"
+#include "engine/modules/ModuleScheduler.hpp"
+
+namespace engine::tests {
+namespace {
+
+using modules::ModuleDescriptor;
+using modules::ModuleScheduler;
+
+constexpr modules::Version kApiVersion{1, 0, 0};
+
+// Lifecycle calls append "<id>.<call>" to a log shared by all modules of a test.
+class LifecycleLog {
+public:
+  void append(const std::string& entry) {
+    std::lock_guard lock{mutex_};
+    entries_.push_back(entry);
+  }
+
+  [[nodiscard]] std::vector<std::string> entries() const {
+    std::lock_guard lock{mutex_};
+    return entries_;
+  }
+
+  [[nodiscard]] bool contains(const std::string& entry) const {
+    std::lock_guard lock{mutex_};
+    for (const std::string& logged : entries_) {
+      if (logged == entry) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<std::string> entries_;
+};
+
+class RecordingModule final : public modules::IModule {
+public:
+  RecordingModule(std::string id, LifecycleLog& log) : id_(std::move(id)), log_(log) {}
+
+  // Names of the calls that log and then throw std::runtime_error("<id>.<call>").
+  std::vector<std::string> throwingCalls;
+
+  void onLoad() override { call("load"); }
+  void onStart() override { call("start"); }
+  void onStop() override { call("stop"); }
+  void onUnload() override { call("unload"); }
+
+private:
+  void call(const std::string& name) {
+    const std::string entry = id_ + "." + name;
+    log_.append(entry);
+    for (const std::string& throwing : throwingCalls) {
+      if (throwing == name) {
+        throw std::runtime_error(entry);
+      }
+    }
+  }
+
+  std::string id_;
+  LifecycleLog& log_;
+};
+
+[[nodiscard]] ModuleDescriptor descriptor(const std::string& id, std::vector<std::string> dependencies = {}) {
+  ModuleDescriptor result{};
+  result.id = id;
+  result.requiredApiVersion = kApiVersion;
+  result.dependencies = std::move(dependencies);
+  return result;
+}
+
+[[nodiscard]] std::string errorMessage(ModuleScheduler& scheduler) {
+  try {
+    scheduler.shutdown();
+  } catch (const std::runtime_error& error) {
+    return error.what();
+  }
+  return {};
+}
+
+void runsWavesInDependencyOrder() {
+  core::WorkerPool workers{2};
+  LifecycleLog log;
+  RecordingModule renderer{"renderer", log};
+  RecordingModule platform{"platform", log};
+  ModuleScheduler scheduler{kApiVersion, workers};
+  scheduler.add(descriptor("renderer", {"platform"}), renderer);
+  scheduler.add(descriptor("platform"), platform);
+
+  scheduler.startup();
+  ENGINE_CHECK(scheduler.waves().size() == 2);
+  ENGINE_CHECK(scheduler.timings()[0].wave == 1 && scheduler.timings()[1].wave == 0);
+  ENGINE_CHECK_THROWS(scheduler.add(descriptor("late"), platform));
+  scheduler.shutdown();
+  const std::vector<std::string> expected{"platform.load", "platform.start", "renderer.load", "renderer.start",
+                                          "renderer.stop", "renderer.unload", "platform.stop", "platform.unload"};
+  ENGINE_CHECK(log.entries() == expected);
+}
+
+void failedStartupShutsDownLoadedModules() {
+  core::WorkerPool workers{1};
+  LifecycleLog log;
+  RecordingModule platform{"platform", log};
+  RecordingModule renderer{"renderer", log};
+  renderer.throwingCalls = {"start"};
+  ModuleScheduler scheduler{kApiVersion, workers};
+  scheduler.add(descriptor("platform"), platform);
+  scheduler.add(descriptor("renderer", {"platform"}), renderer);
+
+  ENGINE_CHECK_THROWS(scheduler.startup());
+  // renderer never started, so it is only unloaded.
+  ENGINE_CHECK(!log.contains("renderer.stop"));
+  ENGINE_CHECK(log.contains("renderer.unload"));
+  ENGINE_CHECK(log.contains("platform.stop") && log.contains("platform.unload"));
+}
+
+// Regression: with one worker, parallelFor() ran a wave inline and stopped at the first module whose
+// onUnload() threw, so the rest of the wave was never unloaded. onStop() errors also lost out to a
+// later onUnload() error from the same module.
+void throwingUnloadStillShutsDownTheWave() {
+  for (const std::uint32_t workerCount : {1U, 3U}) {
+    core::WorkerPool workers{workerCount};
+    LifecycleLog log;
+    RecordingModule audio{"audio", log};
+    RecordingModule input{"input", log};
+    RecordingModule physics{"physics", log};
+    audio.throwingCalls = {"stop", "unload"};
+    ModuleScheduler scheduler{kApiVersion, workers};
+    scheduler.add(descriptor("audio"), audio);
+    scheduler.add(descriptor("input"), input);
+    scheduler.add(descriptor("physics"), physics);
+
+    scheduler.startup();
+    ENGINE_CHECK(errorMessage(scheduler) == "audio.stop");
+    for (const char* id : {"audio", "input", "physics"}) {
+      ENGINE_CHECK(log.contains(std::string{id} + ".unload"));
+    }
+    // A second shutdown() does not repeat the calls.
+    scheduler.shutdown();
+    ENGINE_CHECK(log.entries().size() == 12);
+  }
+}
+
+void invalidGraphThrowsBeforeLifecycleCalls() {
+  core::WorkerPool workers{1};
+  LifecycleLog log;
+  RecordingModule renderer{"renderer", log};
+  ModuleScheduler scheduler{kApiVersion, workers};
+  scheduler.add(descriptor("renderer", {"platform"}), renderer);
+  ENGINE_CHECK_THROWS(scheduler.startup());
+  ENGINE_CHECK(log.entries().empty());
+}
+
+// Regression: the inline path (one worker, or a single task) stopped at the first throwing task.
+void parallelForRunsEveryTaskBeforeRethrowing() {
+  for (const std::uint32_t workerCount : {1U, 4U}) {
+    core::WorkerPool workers{workerCount};
+    std::atomic<std::uint32_t> ran{0};
+    bool threw = false;
+    try {
+      workers.parallelFor(16, [&](const std::uint32_t taskIndex, std::uint32_t /*workerIndex*/) {
+        ran.fetch_add(1, std::memory_order_relaxed);
+        if (taskIndex % 5 == 1) {
+          throw std::runtime_error("task " + std::to_string(taskIndex));
+        }
+      });
+    } catch (const std::runtime_error&) {
+      threw = true;
+    }
+    ENGINE_CHECK(threw);
+    ENGINE_CHECK(ran.load() == 16);
+
+    // The pool stays usable after a failed dispatch.
+    ran = 0;
+    workers.parallelFor(8, [&](std::uint32_t /*taskIndex*/, std::uint32_t /*workerIndex*/) { ran.fetch_add(1); });
+    ENGINE_CHECK(ran.load() == 8);
+  }
+}
+
+} // namespace
+
+void registerModuleSchedulerTests(TestRegistry& registry) {
+  registry.add("ModuleScheduler/runs waves in dependency order", runsWavesInDependencyOrder);
+  registry.add("ModuleScheduler/failed startup shuts down loaded modules", failedStartupShutsDownLoadedModules);
+  registry.add("ModuleScheduler/throwing unload still shuts down the wave", throwingUnloadStillShutsDownTheWave);
+  registry.add("ModuleScheduler/invalid graph throws before lifecycle calls", invalidGraphThrowsBeforeLifecycleCalls);
+  registry.add("WorkerPool/parallelFor runs every task before rethrowing", parallelForRunsEveryTaskBeforeRethrowing);
+}
+
+} // namespace engine::tests
@@ -0,0 +1,71 @@
+#include <memory>
+
+#include "UnitTests.hpp"
+#include "engine/render/ICommandContext.hpp"
+#include "engine/render/IRenderBackend.hpp"
+#include "engine/render/IRenderDevice.hpp"
+#include "engine/render/RenderStats.hpp"
+#include "engine/render/null/NullRenderBackend.hpp"
+
+namespace engine::tests {
+namespace {
+
+using namespace engine::render;
+
+void trianglesFollowTopology() {
+  ENGINE_CHECK(FrameDrawCounters::primitiveTriangleCount(PrimitiveTopology::TriangleList, 9) == 3);
+  ENGINE_CHECK(FrameDrawCounters::primitiveTriangleCount(PrimitiveTopology::TriangleList, 8) == 2);
+  ENGINE_CHECK(FrameDrawCounters::primitiveTriangleCount(PrimitiveTopology::TriangleStrip, 9) == 7);
+  ENGINE_CHECK(FrameDrawCounters::primitiveTriangleCount(PrimitiveTopology::TriangleStrip, 3) == 1);
+  ENGINE_CHECK(FrameDrawCounters::primitiveTriangleCount(PrimitiveTopology::TriangleStrip, 2) == 0);
+  ENGINE_CHECK(FrameDrawCounters::primitiveTriangleCount(PrimitiveTopology::LineList, 9) == 0);
+}
+
+void everyInstanceCounts() {
+  FrameDrawCounters counters;
+  counters.countDraw(PrimitiveTopology::TriangleStrip, 4, 3);
+  counters.countDraw(PrimitiveTopology::LineList, 6, 2);
+  ENGINE_CHECK(counters.drawCalls == 2);
+  ENGINE_CHECK(counters.triangles == 6);
+}
+
+// The null device keeps each pipeline's topology, so its stats match what a GPU would rasterize.
+void nullDeviceCountsByBoundTopology() {
+  const std::unique_ptr<IRenderBackend> backend = createNullRenderBackend();
+  const std::unique_ptr<IRenderDevice> device = backend->createDevice();
+  const std::unique_ptr<ICommandContext> context = device->createCommandContext();
+
+  ShaderCreateInfo vertexInfo{};
+  vertexInfo.stage = ShaderStage::Vertex;
+  ShaderCreateInfo fragmentInfo{};
+  fragmentInfo.stage = ShaderStage::Fragment;
+  GraphicsPipelineCreateInfo pipelineInfo{};
+  pipelineInfo.vertexShader = device->createShader(vertexInfo);
+  pipelineInfo.fragmentShader = device->createShader(fragmentInfo);
+  pipelineInfo.topology = PrimitiveTopology::TriangleStrip;
+  const PipelineHandle strip = device->createGraphicsPipeline(pipelineInfo);
+  pipelineInfo.topology = PrimitiveTopology::LineList;
+  const PipelineHandle lines = device->createGraphicsPipeline(pipelineInfo);
+
+  context->beginFrame({1, {16, 16}});
+  context->bindPipeline(strip);
+  context->draw(5);
+  context->drawIndexed(4, 2);
+  context->bindPipeline(lines);
+  context->draw(8);
+  context->endFrame();
+
+  const RenderFrameStats stats = device->frameStats();
+  ENGINE_CHECK(stats.drawCalls == 3);
+  ENGINE_CHECK(stats.triangles == 3 + 2 * 2);
+}
+
+} // namespace
+
+void registerRenderStatsTests(TestRegistry& registry) {
+  registry.add("RenderStats/triangles follow topology", trianglesFollowTopology);
+  registry.add("RenderStats/every instance counts", everyInstanceCounts);
+  registry.add("RenderStats/null device counts by bound topology", nullDeviceCountsByBoundTopology);
+}
+
+} // namespace engine::tests
@@ -0,0 +1,147 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "UnitTests.hpp"
+#include "engine/render/ICommandContext.hpp"
+#include "engine/render/IRenderBackend.hpp"
+#include "engine/render/IRenderDevice.hpp"
+#include "engine/render/software/SoftwareRenderBackend.hpp"
+
+namespace engine::tests {
+namespace {
+
+using namespace engine::render;
+
+constexpr std::uint32_t kTargetSize = 8;
+constexpr std::uint32_t kClearPixel = 0xFF000000u;
+
+struct Point {
+  float x = 0.0f;
+  float y = 0.0f;
+};
+
+// Renders with the default (identity) frame and draw constants, so positions are in NDC.
+class SoftwareFixture {
+public:
+  SoftwareFixture()
+      : backend_(createSoftwareRenderBackend()), device_(backend_->createDevice()), context_(device_->createCommandContext()) {
+    ShaderCreateInfo vertexInfo{};
+    vertexInfo.stage = ShaderStage::Vertex;
+    ShaderCreateInfo fragmentInfo{};
+    fragmentInfo.stage = ShaderStage::Fragment;
+    GraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.vertexShader = device_->createShader(vertexInfo);
+    pipelineInfo.fragmentShader = device_->createShader(fragmentInfo);
+    pipeline_ = device_->createGraphicsPipeline(pipelineInfo);
+  }
+
+  [[nodiscard]] IRenderDevice& device() { return *device_; }
+
+  [[nodiscard]] BufferHandle createVertices(const std::span<const Point> points) {
+    const std::vector<float> vertices = packVertices(points);
+    BufferCreateInfo createInfo{};
+    createInfo.sizeBytes = vertices.size() * sizeof(float);
+    createInfo.initialData = reinterpret_cast<const std::byte*>(vertices.data());
+    return device_->createBuffer(createInfo);
+  }
+
+  void updateVertices(const BufferHandle buffer, const std::span<const Point> points) {
+    const std::vector<float> vertices = packVertices(points);
+    device_->updateBuffer(buffer, 0, std::as_bytes(std::span{vertices}));
+  }
+
+  void beginDraw(const BufferHandle vertices, const std::uint32_t vertexCount) {
+    context_->beginFrame({frameIndex_++, {kTargetSize, kTargetSize}});
+    context_->bindPipeline(pipeline_);
+    context_->bindVertexBuffer(vertices);
+    context_->draw(vertexCount);
+  }
+
+  // Ends the frame and returns one flag per pixel, top row first: true where a triangle was drawn.
+  [[nodiscard]] std::vector<bool> endDraw() {
+    context_->endFrame();
+    const std::optional<SoftwareFramebufferView> target = softwareColorTarget(*context_);
+    ENGINE_CHECK(target.has_value());
+    std::vector<bool> covered;
+    for (std::uint32_t y = 0; y < kTargetSize; ++y) {
+      for (std::uint32_t x = 0; x < kTargetSize; ++x) {
+        covered.push_back(target->colorRgba8[y * target->rowPitch + x] != kClearPixel);
+      }
+    }
+    return covered;
+  }
+
+  [[nodiscard]] std::vector<bool> render(const std::span<const Point> points) {
+    const BufferHandle vertices = createVertices(points);
+    beginDraw(vertices, static_cast<std::uint32_t>(points.size()));
+    std::vector<bool> covered = endDraw();
+    device_->destroyBuffer(vertices);
+    return covered;
+  }
+
+private:
+  [[nodiscard]] static std::vector<float> packVertices(const std::span<const Point> points) {
+    std::vector<float> vertices;
+    for (const Point& point : points) {
+      // position[3], normal[3], uv[2]; the normal faces the default light.
+      const std::array<float, 8> vertex{point.x, point.y, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f};
+      vertices.insert(vertices.end(), vertex.begin(), vertex.end());
+    }
+    return vertices;
+  }
+
+  std::unique_ptr<IRenderBackend> backend_;
+  std::unique_ptr<IRenderDevice> device_;
+  std::unique_ptr<ICommandContext> context_;
+  PipelineHandle pipeline_{};
+  std::uint64_t frameIndex_ = 0;
+};
+
+constexpr std::array<Point, 3> kLowerRight{{{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}}};
+constexpr std::array<Point, 3> kUpperLeft{{{-1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}}};
+
+// Regression: pixel centers exactly on an edge were accepted by both triangles sharing it. The
+// diagonal here passes through the center of every pixel on it.
+void sharedEdgeCoversEachPixelOnce() {
+  SoftwareFixture fixture;
+  const std::vector<bool> lowerRight = fixture.render(kLowerRight);
+  const std::vector<bool> upperLeft = fixture.render(kUpperLeft);
+  for (std::size_t pixel = 0; pixel < lowerRight.size(); ++pixel) {
+    ENGINE_CHECK(lowerRight[pixel] != upperLeft[pixel]);
+  }
+}
+
+// Regression: draws kept raw pointers into vertex storage and read it only in endFrame(), so
+// updating or destroying the buffer in between changed or freed what the draw rasterized.
+void drawsKeepRecordedBufferContents() {
+  SoftwareFixture fixture;
+  const std::vector<bool> expected = fixture.render(kLowerRight);
+
+  const BufferHandle updated = fixture.createVertices(kLowerRight);
+  fixture.beginDraw(updated, 3);
+  fixture.updateVertices(updated, kUpperLeft);
+  ENGINE_CHECK(fixture.endDraw() == expected);
+  // Later draws see the update.
+  fixture.beginDraw(updated, 3);
+  ENGINE_CHECK(fixture.endDraw() != expected);
+  fixture.device().destroyBuffer(updated);
+
+  const BufferHandle destroyed = fixture.createVertices(kLowerRight);
+  fixture.beginDraw(destroyed, 3);
+  fixture.device().destroyBuffer(destroyed);
+  ENGINE_CHECK(fixture.endDraw() == expected);
+}
+
+} // namespace
+
+void registerSoftwareRasterizerTests(TestRegistry& registry) {
+  registry.add("SoftwareRasterizer/shared edge covers each pixel once", sharedEdgeCoversEachPixelOnce);
+  registry.add("SoftwareRasterizer/draws keep recorded buffer contents", drawsKeepRecordedBufferContents);
+}
+
+} // namespace engine::tests
@@ -0,0 +1,84 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "UnitTests.hpp"
+#include "engine/core/SpscQueue.hpp"
+
+namespace engine::tests {
+namespace {
+
+using core::SpscQueue;
+
+void capacityRoundsUpToPowerOfTwo() {
+  ENGINE_CHECK(SpscQueue<int>{1}.capacity() == 1);
+  ENGINE_CHECK(SpscQueue<int>{5}.capacity() == 8);
+  ENGINE_CHECK(SpscQueue<int>{64}.capacity() == 64);
+  ENGINE_CHECK_THROWS(SpscQueue<int>{0});
+}
+
+void fullAndEmptyAreReported() {
+  SpscQueue<int> queue{4};
+  int value = 0;
+  ENGINE_CHECK(!queue.tryPop(value));
+  for (int pushed = 0; pushed < 4; ++pushed) {
+    ENGINE_CHECK(queue.tryPush(pushed));
+  }
+  ENGINE_CHECK(!queue.tryPush(4));
+  ENGINE_CHECK(queue.size() == 4);
+
+  // Indices wrap many times around the ring while staying in FIFO order.
+  for (int next = 0; next < 100; ++next) {
+    ENGINE_CHECK(queue.tryPop(value) && value == next);
+    ENGINE_CHECK(queue.tryPush(next + 4));
+  }
+  ENGINE_CHECK(queue.size() == 4);
+}
+
+void moveOnlyValues() {
+  SpscQueue<std::unique_ptr<int>> queue{2};
+  ENGINE_CHECK(queue.tryPush(std::make_unique<int>(7)));
+  std::unique_ptr<int> value;
+  ENGINE_CHECK(queue.tryPop(value) && value != nullptr && *value == 7);
+}
+
+void producerAndConsumerThreads() {
+  constexpr std::uint64_t kCount = 200000;
+  SpscQueue<std::uint64_t> queue{64};
+  std::thread producer{[&queue] {
+    for (std::uint64_t value = 1; value <= kCount;) {
+      if (queue.tryPush(value)) {
+        ++value;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }};
+
+  std::uint64_t expected = 1;
+  bool ordered = true;
+  while (expected <= kCount) {
+    std::uint64_t value = 0;
+    if (queue.tryPop(value)) {
+      ordered = ordered && value == expected;
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  ENGINE_CHECK(ordered);
+  ENGINE_CHECK(queue.size() == 0);
+}
+
+} // namespace
+
+void registerSpscQueueTests(TestRegistry& registry) {
+  registry.add("SpscQueue/capacity rounds up to a power of two", capacityRoundsUpToPowerOfTwo);
+  registry.add("SpscQueue/full and empty are reported", fullAndEmptyAreReported);
+  registry.add("SpscQueue/move-only values", moveOnlyValues);
+  registry.add("SpscQueue/producer and consumer threads", producerAndConsumerThreads);
+}
+
+} // namespace engine::tests
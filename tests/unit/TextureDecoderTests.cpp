@@ -0,0 +1,224 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "UnitTests.hpp"
+#include "engine/render/IRenderBackend.hpp"
+#include "engine/render/Ktx2Loader.hpp"
+#include "engine/render/RenderBackendFactory.hpp"
+#include "engine/render/TextureDecoder.hpp"
+
+namespace engine::tests {
+namespace {
+
+using namespace engine::render;
+
+constexpr std::uint32_t kVkFormatBc1RgbUnorm = 131;
+constexpr std::uint32_t kVkFormatBc1RgbaUnorm = 133;
+constexpr std::uint32_t kVkFormatR8G8B8A8Unorm = 37;
+
+// Three-color BC1 block (color0 = blue <= color1 = red): texel 0 is color0 and every other texel
+// uses index 3, which is black, transparent in BC1 and opaque in BC1RGB.
+constexpr std::array<std::uint8_t, 8> kThreeColorBlock{0x1F, 0x00, 0x00, 0xF8, 0xFC, 0xFF, 0xFF, 0xFF};
+
+[[nodiscard]] std::vector<std::byte> toBytes(const std::span<const std::uint8_t> values) {
+  std::vector<std::byte> bytes;
+  for (const std::uint8_t value : values) {
+    bytes.push_back(static_cast<std::byte>(value));
+  }
+  return bytes;
+}
+
+[[nodiscard]] std::array<std::uint8_t, 4> texel(const std::vector<std::byte>& rgba, const std::size_t index) {
+  return {std::to_integer<std::uint8_t>(rgba[index * 4]), std::to_integer<std::uint8_t>(rgba[index * 4 + 1]),
+          std::to_integer<std::uint8_t>(rgba[index * 4 + 2]), std::to_integer<std::uint8_t>(rgba[index * 4 + 3])};
+}
+
+// Removes the file when the test ends, pass or fail.
+class TemporaryKtx2Path {
+public:
+  explicit TemporaryKtx2Path(const std::string& name)
+      : path_(std::filesystem::temp_directory_path() / ("engine_unit_tests_" + name + ".ktx2")) {}
+  TemporaryKtx2Path(const TemporaryKtx2Path&) = delete;
+  TemporaryKtx2Path& operator=(const TemporaryKtx2Path&) = delete;
+  ~TemporaryKtx2Path() {
+    std::error_code error;
+    std::filesystem::remove(path_, error);
+  }
+
+  [[nodiscard]] const std::filesystem::path& path() const { return path_; }
+
+private:
+  std::filesystem::path path_;
+};
+
+struct Ktx2Header {
+  std::uint32_t vkFormat = kVkFormatBc1RgbUnorm;
+  std::uint32_t width = 4;
+  std::uint32_t height = 4;
+  std::uint32_t supercompression = 0;
+};
+
+// 2D KTX2 file with one entry in the level index per element of levels, data stored after it.
+void writeKtx2(const std::filesystem::path& path, const Ktx2Header& header, const std::vector<std::vector<std::byte>>& levels) {
+  std::vector<std::uint8_t> bytes{0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+  const auto put = [&bytes](std::uint64_t value, const std::size_t size) {
+    for (std::size_t index = 0; index < size; ++index, value >>= 8U) {
+      bytes.push_back(static_cast<std::uint8_t>(value & 0xFFU));
+    }
+  };
+  // vkFormat, typeSize, width, height, depth, layers, faces, levels, supercompression.
+  for (const std::uint32_t field : {header.vkFormat, 1U, header.width, header.height, 0U, 0U, 1U,
+                                    static_cast<std::uint32_t>(levels.size()), header.supercompression}) {
+    put(field, 4);
+  }
+  // Empty DFD, key/value and supercompression global data.
+  put(0, 4 * 4 + 8 * 2);
+
+  std::uint64_t offset = bytes.size() + levels.size() * 24;
+  for (const std::vector<std::byte>& level : levels) {
+    put(offset, 8);
+    put(level.size(), 8);
+    put(level.size(), 8);
+    offset += level.size();
+  }
+  for (const std::vector<std::byte>& level : levels) {
+    for (const std::byte value : level) {
+      bytes.push_back(std::to_integer<std::uint8_t>(value));
+    }
+  }
+  std::ofstream file{path, std::ios::binary | std::ios::trunc};
+  file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+void bc1FourColorEndpoints() {
+  // color0 = red > color1 = blue: four-color mode. Row 0 uses indices 0, 1, 2, 3.
+  const std::array<std::uint8_t, 8> block{0x00, 0xF8, 0x1F, 0x00, 0xE4, 0x00, 0x00, 0x00};
+  const std::vector<std::byte> rgba = decodeTextureToRgba8(TextureFormat::BC1, {4, 4}, 1, toBytes(block));
+  ENGINE_CHECK(rgba.size() == 4 * 4 * 4);
+  ENGINE_CHECK((texel(rgba, 0) == std::array<std::uint8_t, 4>{255, 0, 0, 255}));
+  ENGINE_CHECK((texel(rgba, 1) == std::array<std::uint8_t, 4>{0, 0, 255, 255}));
+  ENGINE_CHECK(texel(rgba, 2)[0] > texel(rgba, 2)[2] && texel(rgba, 2)[3] == 255);
+  ENGINE_CHECK(texel(rgba, 3)[0] < texel(rgba, 3)[2] && texel(rgba, 3)[3] == 255);
+}
+
+// Regression: BC1_RGB data decoded its index-3 texels as transparent.
+void bc1RgbIndexThreeIsOpaque() {
+  const std::vector<std::byte> blocks = toBytes(kThreeColorBlock);
+  const std::vector<std::byte> rgb = decodeTextureToRgba8(TextureFormat::BC1RGB, {4, 4}, 1, blocks);
+  const std::vector<std::byte> rgba = decodeTextureToRgba8(TextureFormat::BC1, {4, 4}, 1, blocks);
+  ENGINE_CHECK((texel(rgb, 0) == std::array<std::uint8_t, 4>{0, 0, 255, 255}));
+  ENGINE_CHECK((texel(rgb, 5) == std::array<std::uint8_t, 4>{0, 0, 0, 255}));
+  ENGINE_CHECK(texel(rgba, 5)[3] == 0);
+}
+
+void partialBlocksAndLayers() {
+  // 5x3 needs 2x1 blocks per layer; two layers.
+  std::vector<std::byte> blocks;
+  for (int block = 0; block < 4; ++block) {
+    const std::vector<std::byte> bytes = toBytes(kThreeColorBlock);
+    blocks.insert(blocks.end(), bytes.begin(), bytes.end());
+  }
+  const std::vector<std::byte> rgba = decodeTextureToRgba8(TextureFormat::BC1RGB, {5, 3}, 2, blocks);
+  ENGINE_CHECK(rgba.size() == 5 * 3 * 2 * 4);
+  // Texel 0 of the second block sits at x = 4 of row 0.
+  ENGINE_CHECK((texel(rgba, 4) == std::array<std::uint8_t, 4>{0, 0, 255, 255}));
+  ENGINE_CHECK((texel(rgba, 5 * 3) == std::array<std::uint8_t, 4>{0, 0, 255, 255}));
+
+  ENGINE_CHECK_THROWS((void)decodeTextureToRgba8(TextureFormat::BC1RGB, {5, 3}, 2, std::span{blocks}.first(24)));
+  ENGINE_CHECK_THROWS((void)decodeTextureToRgba8(TextureFormat::RGBA8, {4, 4}, 1, blocks));
+}
+
+void bc5DecodesTwoChannels() {
+  // Red block: endpoints 200/100, all indices 0. Green block: endpoints 50/10, all indices 1.
+  const std::array<std::uint8_t, 16> block{200, 100, 0, 0, 0, 0, 0, 0, 50, 10, 0x49, 0x92, 0x24, 0x49, 0x92, 0x24};
+  const std::vector<std::byte> rgba = decodeTextureToRgba8(TextureFormat::BC5, {4, 4}, 1, toBytes(block));
+  for (std::size_t index = 0; index < 16; ++index) {
+    ENGINE_CHECK((texel(rgba, index) == std::array<std::uint8_t, 4>{200, 10, 0, 255}));
+  }
+}
+
+void ktx2Bc1RgbLoadsOpaque() {
+  const TemporaryKtx2Path file{"bc1_rgb"};
+  const std::vector<std::byte> block = toBytes(kThreeColorBlock);
+  writeKtx2(file.path(), {}, {block, block, block});
+
+  const Ktx2File ktx2 = Ktx2File::open(file.path());
+  ENGINE_CHECK(ktx2.createInfo().format == TextureFormat::BC1RGB);
+  ENGINE_CHECK(ktx2.createInfo().dimension == TextureDimension::Texture2D);
+  ENGINE_CHECK(ktx2.levelCount() == 3 && ktx2.createInfo().mipLevels == 3);
+  ENGINE_CHECK(!ktx2.srgb());
+  ENGINE_CHECK(ktx2.level(2).size() == 8);
+  ENGINE_CHECK_THROWS((void)ktx2.level(3));
+
+  const std::vector<std::byte> rgba = ktx2UploadLevel(ktx2, 0, TextureFormat::RGBA8);
+  ENGINE_CHECK(texel(rgba, 5)[3] == 255);
+  // Coarser levels decode at their own size.
+  ENGINE_CHECK(ktx2UploadLevel(ktx2, 1, TextureFormat::RGBA8).size() == 2 * 2 * 4);
+
+  writeKtx2(file.path(), {kVkFormatBc1RgbaUnorm}, {block});
+  ENGINE_CHECK(Ktx2File::open(file.path()).createInfo().format == TextureFormat::BC1);
+}
+
+void ktx2FallsBackToRgba8() {
+  const TemporaryKtx2Path file{"fallback"};
+  const std::vector<std::byte> block = toBytes(kThreeColorBlock);
+  writeKtx2(file.path(), {}, {block, block, block});
+  const auto ktx2 = std::make_shared<const Ktx2File>(Ktx2File::open(file.path()));
+
+  // The software device samples no block-compressed format.
+  const std::unique_ptr<IRenderDevice> device = createRenderBackend(RenderBackendType::Software)->createDevice();
+  ENGINE_CHECK(ktx2UploadFormat(*device, *ktx2) == TextureFormat::RGBA8);
+  const TextureHandle texture = createTextureFromKtx2(*device, *ktx2, "ktx2 texture");
+  bool found = false;
+  for (const RenderResourceInfo& info : device->resources()) {
+    if (info.kind == RenderResourceKind::Texture && info.id == texture.id) {
+      found = info.format == TextureFormat::RGBA8 && info.mipLevels == 3 && info.debugName == "ktx2 texture";
+    }
+  }
+  ENGINE_CHECK(found);
+
+  const StreamedTextureDesc desc = ktx2StreamedTextureDesc(*device, ktx2, "streamed");
+  ENGINE_CHECK(desc.createInfo.format == TextureFormat::RGBA8);
+  ENGINE_CHECK(desc.loadMip(0).size() == 4 * 4 * 4);
+  device->destroyTexture(texture);
+}
+
+void ktx2RejectsInvalidFiles() {
+  const TemporaryKtx2Path file{"invalid"};
+  const std::vector<std::byte> block = toBytes(kThreeColorBlock);
+
+  writeKtx2(file.path(), {kVkFormatBc1RgbUnorm, 4, 4, 1}, {block});
+  ENGINE_CHECK_THROWS(Ktx2File::open(file.path()));
+  writeKtx2(file.path(), {9999}, {block});
+  ENGINE_CHECK_THROWS(Ktx2File::open(file.path()));
+  // RGBA8 4x4 needs 64 bytes.
+  writeKtx2(file.path(), {kVkFormatR8G8B8A8Unorm}, {block});
+  ENGINE_CHECK_THROWS(Ktx2File::open(file.path()));
+  writeKtx2(file.path(), {}, {block, block, block, block});
+  ENGINE_CHECK_THROWS(Ktx2File::open(file.path()));
+
+  writeKtx2(file.path(), {}, {block});
+  std::filesystem::resize_file(file.path(), std::filesystem::file_size(file.path()) - 1);
+  ENGINE_CHECK_THROWS(Ktx2File::open(file.path()));
+  ENGINE_CHECK_THROWS(Ktx2File::open(file.path().string() + ".missing"));
+}
+
+} // namespace
+
+void registerTextureDecoderTests(TestRegistry& registry) {
+  registry.add("TextureDecoder/BC1 four-color endpoints", bc1FourColorEndpoints);
+  registry.add("TextureDecoder/BC1RGB index 3 is opaque", bc1RgbIndexThreeIsOpaque);
+  registry.add("TextureDecoder/partial blocks and layers", partialBlocksAndLayers);
+  registry.add("TextureDecoder/BC5 decodes two channels", bc5DecodesTwoChannels);
+  registry.add("Ktx2File/BC1_RGB loads opaque", ktx2Bc1RgbLoadsOpaque);
+  registry.add("Ktx2File/falls back to RGBA8", ktx2FallsBackToRgba8);
+  registry.add("Ktx2File/rejects invalid files", ktx2RejectsInvalidFiles);
+}
+
+} // namespace engine::tests
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "UnitTests.hpp"
+#include "engine/render/IRenderBackend.hpp"
+#include "engine/render/RenderBackendFactory.hpp"
+#include "engine/render/TextureStreamer.hpp"
+
+namespace engine::tests {
+namespace {
+
+using namespace engine::render;
+
+// 256x256 RGBA8 has nine levels; with the default 64-texel coarse limit, levels 2..8 stay resident.
+constexpr std::uint32_t kTextureSize = 256;
+constexpr std::uint32_t kCoarseMip = 2;
+
+// Inline loading (workerCount 0) makes every update() deterministic: a load issued by one update
+// is uploaded by the next.
+[[nodiscard]] TextureStreamerConfig inlineConfig(const std::size_t budgetBytes = 0) {
+  TextureStreamerConfig config{};
+  config.workerCount = 0;
+  config.budgetBytes = budgetBytes;
+  config.demandTimeoutUpdates = 2;
+  return config;
+}
+
+[[nodiscard]] TextureCreateInfo textureInfo() {
+  TextureCreateInfo info{};
+  info.format = TextureFormat::RGBA8;
+  info.extent = {kTextureSize, kTextureSize};
+  info.mipLevels = 0;
+  return info;
+}
+
+// Records the levels it was asked for; throws for levels finer than failBelow.
+[[nodiscard]] StreamedTextureDesc describe(std::shared_ptr<std::vector<std::uint32_t>> loaded, const std::uint32_t failBelow = 0) {
+  StreamedTextureDesc desc{};
+  desc.createInfo = textureInfo();
+  desc.debugName = "streamed";
+  TextureCreateInfo fullChain = textureInfo();
+  fullChain.mipLevels = fullMipChainLength(fullChain.extent);
+  desc.loadMip = [loaded = std::move(loaded), failBelow, fullChain](const std::uint32_t mipLevel) {
+    loaded->push_back(mipLevel);
+    if (mipLevel < failBelow) {
+      throw std::runtime_error("mip unavailable");
+    }
+    return std::vector<std::byte>(textureMipByteSize(fullChain, mipLevel));
+  };
+  return desc;
+}
+
+[[nodiscard]] std::unique_ptr<IRenderDevice> createNullDevice() {
+  return createRenderBackend(RenderBackendType::Null)->createDevice();
+}
+
+[[nodiscard]] std::optional<RenderResourceInfo> findTexture(const IRenderDevice& device, const TextureHandle handle) {
+  for (RenderResourceInfo& info : device.resources()) {
+    if (info.kind == RenderResourceKind::Texture && info.id == handle.id) {
+      return std::move(info);
+    }
+  }
+  return std::nullopt;
+}
+
+void addLoadsOnlyCoarseLevels() {
+  const std::unique_ptr<IRenderDevice> device = createNullDevice();
+  TextureStreamer streamer{*device, inlineConfig()};
+  const auto loaded = std::make_shared<std::vector<std::uint32_t>>();
+  const StreamedTextureId id = streamer.add(describe(loaded));
+
+  ENGINE_CHECK(streamer.residentMip(id) == kCoarseMip);
+  ENGINE_CHECK((*loaded == std::vector<std::uint32_t>{2, 3, 4, 5, 6, 7, 8}));
+  const std::optional<RenderResourceInfo> info = findTexture(*device, streamer.texture(id));
+  ENGINE_CHECK(info.has_value() && info->mipLevels == 9 && info->firstResidentMip == kCoarseMip);
+  TextureCreateInfo chain = textureInfo();
+  chain.mipLevels = 9;
+  ENGINE_CHECK(streamer.stats().residentBytes == textureByteSize(chain, kCoarseMip));
+
+  // Without demand nothing else is loaded.
+  for (int update = 0; update < 4; ++update) {
+    streamer.update();
+  }
+  ENGINE_CHECK(loaded->size() == 7);
+  ENGINE_CHECK(streamer.residentMip(id) == kCoarseMip);
+}
+
+void demandStreamsOneLevelPerUpdate() {
+  const std::unique_ptr<IRenderDevice> device = createNullDevice();
+  TextureStreamer streamer{*device, inlineConfig()};
+  const auto loaded = std::make_shared<std::vector<std::uint32_t>>();
+  const StreamedTextureId id = streamer.add(describe(loaded));
+
+  std::vector<std::uint32_t> residency;
+  for (int update = 0; update < 4; ++update) {
+    streamer.requestScreenSize(id, static_cast<float>(kTextureSize));
+    streamer.update();
+    residency.push_back(streamer.residentMip(id));
+  }
+  ENGINE_CHECK((residency == std::vector<std::uint32_t>{2, 1, 0, 0}));
+  ENGINE_CHECK(streamer.stats().uploads == 2);
+  ENGINE_CHECK(findTexture(*device, streamer.texture(id))->firstResidentMip == 0);
+
+  // A half-size request wants level 1 only.
+  const StreamedTextureId half = streamer.add(describe(loaded));
+  for (int update = 0; update < 4; ++update) {
+    streamer.requestScreenSize(half, static_cast<float>(kTextureSize / 2));
+    streamer.update();
+  }
+  ENGINE_CHECK(streamer.residentMip(half) == 1);
+}
+
+void budgetEvictsTexturesNoLongerRequested() {
+  TextureCreateInfo chain = textureInfo();
+  chain.mipLevels = 9;
+  const std::size_t budget = textureByteSize(chain) + textureByteSize(chain, kCoarseMip);
+  const std::unique_ptr<IRenderDevice> device = createNullDevice();
+  TextureStreamer streamer{*device, inlineConfig(budget)};
+  const auto loaded = std::make_shared<std::vector<std::uint32_t>>();
+  const StreamedTextureId first = streamer.add(describe(loaded));
+  const StreamedTextureId second = streamer.add(describe(loaded));
+
+  for (int update = 0; update < 4; ++update) {
+    streamer.requestScreenSize(first, static_cast<float>(kTextureSize));
+    streamer.update();
+  }
+  ENGINE_CHECK(streamer.residentMip(first) == 0);
+
+  for (int update = 0; update < 12; ++update) {
+    streamer.requestScreenSize(second, static_cast<float>(kTextureSize));
+    streamer.update();
+    ENGINE_CHECK(streamer.stats().residentBytes <= budget);
+  }
+  ENGINE_CHECK(streamer.residentMip(second) == 0);
+  ENGINE_CHECK(streamer.residentMip(first) == kCoarseMip);
+  ENGINE_CHECK(streamer.stats().evictions == 2);
+  ENGINE_CHECK(findTexture(*device, streamer.texture(first))->firstResidentMip == kCoarseMip);
+}
+
+void failedLoadsAreNotRetried() {
+  const std::unique_ptr<IRenderDevice> device = createNullDevice();
+  TextureStreamer streamer{*device, inlineConfig()};
+  const auto loaded = std::make_shared<std::vector<std::uint32_t>>();
+  const StreamedTextureId id = streamer.add(describe(loaded, 1));
+
+  for (int update = 0; update < 6; ++update) {
+    streamer.requestScreenSize(id, static_cast<float>(kTextureSize));
+    streamer.update();
+  }
+  ENGINE_CHECK(streamer.residentMip(id) == 1);
+  ENGINE_CHECK(streamer.stats().loadFailures == 1);
+  ENGINE_CHECK(std::count(loaded->begin(), loaded->end(), 0U) == 1);
+}
+
+void workerThreadsStreamTheSameLevels() {
+  const std::unique_ptr<IRenderDevice> device = createNullDevice();
+  TextureStreamerConfig config = inlineConfig();
+  config.workerCount = 2;
+  TextureStreamer streamer{*device, config};
+  const auto loaded = std::make_shared<std::vector<std::uint32_t>>();
+  const StreamedTextureId id = streamer.add(describe(loaded));
+
+  // Loads finish asynchronously, so poll with a generous bound.
+  for (int update = 0; update < 100000 && streamer.residentMip(id) != 0; ++update) {
+    streamer.requestScreenSize(id, static_cast<float>(kTextureSize));
+    streamer.update();
+    std::this_thread::yield();
+  }
+  ENGINE_CHECK(streamer.residentMip(id) == 0);
+}
+
+void removeDestroysTheTexture() {
+  const std::unique_ptr<IRenderDevice> device = createNullDevice();
+  TextureStreamer streamer{*device, inlineConfig()};
+  const auto loaded = std::make_shared<std::vector<std::uint32_t>>();
+  const StreamedTextureId id = streamer.add(describe(loaded));
+  const TextureHandle handle = streamer.texture(id);
+  streamer.remove(id);
+  ENGINE_CHECK(!findTexture(*device, handle).has_value());
+  ENGINE_CHECK(streamer.texture(id).id == 0);
+  ENGINE_CHECK(streamer.stats().residentBytes == 0 && streamer.stats().textures == 0);
+}
+
+} // namespace
+
+void registerTextureStreamerTests(TestRegistry& registry) {
+  registry.add("TextureStreamer/add loads only coarse levels", addLoadsOnlyCoarseLevels);
+  registry.add("TextureStreamer/demand streams one level per update", demandStreamsOneLevelPerUpdate);
+  registry.add("TextureStreamer/budget evicts textures no longer requested", budgetEvictsTexturesNoLongerRequested);
+  registry.add("TextureStreamer/failed loads are not retried", failedLoadsAreNotRetried);
+  registry.add("TextureStreamer/worker threads stream the same levels", workerThreadsStreamTheSameLevels);
+  registry.add("TextureStreamer/remove destroys the texture", removeDestroysTheTexture);
+}
+
+} // namespace engine::tests
@@ -0,0 +1,66 @@
+#include <cstdint>
+#include <optional>
+
+#include "UnitTests.hpp"
+#include "engine/render/TransientRingAllocator.hpp"
+
+namespace engine::tests {
+namespace {
+
+using render::TransientRingAllocator;
+
+void allocationsAreAligned() {
+  TransientRingAllocator ring{1024};
+  ENGINE_CHECK(ring.tryAllocate(10, 16) == std::optional<std::uint64_t>{0});
+  ENGINE_CHECK(ring.tryAllocate(10, 256) == std::optional<std::uint64_t>{256});
+  ENGINE_CHECK(ring.head() == 266);
+  // Alignment padding is charged to the frame.
+  ENGINE_CHECK(ring.frameBytes() == 266);
+  ENGINE_CHECK(!ring.tryAllocate(1025, 16).has_value());
+}
+
+void wrapsPastInFlightFrames() {
+  TransientRingAllocator ring{1024};
+  ENGINE_CHECK(ring.tryAllocate(600, 16) == std::optional<std::uint64_t>{0});
+  ring.endFrame();
+  // Aligning to 608 charges 8 bytes of padding to frame two.
+  ENGINE_CHECK(ring.tryAllocate(300, 16) == std::optional<std::uint64_t>{608});
+  ring.endFrame();
+  ring.retireOldestFrame();
+
+  // The tail past offset 908 is too small, so the allocation wraps and pays for the skipped bytes.
+  ENGINE_CHECK(ring.tryAllocate(200, 16) == std::optional<std::uint64_t>{0});
+  ENGINE_CHECK(ring.usedBytes() == 308 + 116 + 200);
+  // Frame two still occupies [608, 908).
+  ENGINE_CHECK(!ring.tryAllocate(500, 16).has_value());
+  // Exactly fills the gap up to it, alignment padding included.
+  ENGINE_CHECK(ring.tryAllocate(392, 16) == std::optional<std::uint64_t>{208});
+}
+
+// Regression: a drained ring kept its head, so the next large allocation paid wrap-around padding
+// for bytes nothing was using and failed.
+void drainedRingRewinds() {
+  TransientRingAllocator ring{1024};
+  ENGINE_CHECK(ring.tryAllocate(100, 16).has_value());
+  ring.endFrame();
+  ring.retireOldestFrame();
+  ENGINE_CHECK(ring.usedBytes() == 0 && ring.head() == 0);
+  ENGINE_CHECK(ring.tryAllocate(1000, 16) == std::optional<std::uint64_t>{0});
+}
+
+void retiringWithoutFramesThrows() {
+  TransientRingAllocator ring{1024};
+  ENGINE_CHECK_THROWS(ring.retireOldestFrame());
+  ENGINE_CHECK_THROWS(TransientRingAllocator{0});
+}
+
+} // namespace
+
+void registerTransientRingAllocatorTests(TestRegistry& registry) {
+  registry.add("TransientRingAllocator/allocations are aligned", allocationsAreAligned);
+  registry.add("TransientRingAllocator/wraps past in-flight frames", wrapsPastInFlightFrames);
+  registry.add("TransientRingAllocator/drained ring rewinds", drainedRingRewinds);
+  registry.add("TransientRingAllocator/retiring without frames throws", retiringWithoutFramesThrows);
+}
+
+} // namespace engine::tests
@@ -0,0 +1,22 @@
+#include "UnitTests.hpp"
+
+int main(int argc, char** argv) {
+  const auto options = engine::tests::parseTestOptions(argc, argv);
+  if (!options.has_value()) {
+    return 2;
+  }
+
+  engine::tests::TestRegistry registry;
+  engine::tests::registerCommandCaptureTests(registry);
+  engine::tests::registerFrameStatisticsTests(registry);
+  engine::tests::registerHandlePoolTests(registry);
+  engine::tests::registerModuleGraphTests(registry);
+  engine::tests::registerModuleSchedulerTests(registry);
+  engine::tests::registerRenderStatsTests(registry);
+  engine::tests::registerSoftwareRasterizerTests(registry);
+  engine::tests::registerSpscQueueTests(registry);
+  engine::tests::registerTextureDecoderTests(registry);
+  engine::tests::registerTextureStreamerTests(registry);
+  engine::tests::registerTransientRingAllocatorTests(registry);
+  return engine::tests::runTestMain(registry, *options);
+}
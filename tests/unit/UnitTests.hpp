@@ -0,0 +1,20 @@
+#pragma once
+
+#include "TestHarness.hpp"
+
+namespace engine::tests {
+
+// One registration function per subject; UnitTestMain.cpp calls them all.
+void registerCommandCaptureTests(TestRegistry& registry);
+void registerFrameStatisticsTests(TestRegistry& registry);
+void registerHandlePoolTests(TestRegistry& registry);
+void registerModuleGraphTests(TestRegistry& registry);
+void registerModuleSchedulerTests(TestRegistry& registry);
+void registerRenderStatsTests(TestRegistry& registry);
+void registerSoftwareRasterizerTests(TestRegistry& registry);
+void registerSpscQueueTests(TestRegistry& registry);
+void registerTextureDecoderTests(TestRegistry& registry);
+void registerTextureStreamerTests(TestRegistry& registry);
+void registerTransientRingAllocatorTests(TestRegistry& registry);
+
+} // namespace engine::tests